@@ -0,0 +1,377 @@
+///
+/// @file		BatchRunner.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Headless parallel batch runner for many input files
+///
+
+#include <chrono>			// std::chrono::steady_clock
+#include <cstdio>			// fopen, fwrite, fprintf
+#include <map>				// std::map
+#include <thread>			// std::thread::hardware_concurrency
+
+#include <sys/stat.h>		// stat, mkdir
+
+#if defined(WIN32)
+#	include <direct.h>		// _mkdir
+#else
+#	include <glob.h>		// glob
+#endif
+
+#include "BatchRunner.h"
+#include "ParallelFor.h"	// ParallelFor
+#include "Tricycle.h"		// CTricycle, STricycleState
+#include "VirtualGyro.h"	// CVirtualGyro
+#include "MappedFile.h"		// CMappedFile
+#include "RecordParser.h"	// ParseRecordLine
+#include "RecordArchive.h"	// CRecordArchiveReader, IsRecordArchive
+#include "RecordFormat.h"	// FormatPoseLine, FormatContourBlock
+#include "PoseLog.h"		// CPoseLogWriter
+
+///
+/// @brief		constructor
+/// @param		sOutputDir [in] output directory (created if missing)
+/// @param		nThreads [in] number of worker threads (<= 0: hardware)
+/// @param		bBinaryOutput [in] write NN_pose.bin instead of text files
+/// @return		N/A
+///
+CBatchRunner::CBatchRunner(const std::string& sOutputDir, \
+	const int nThreads, const bool bBinaryOutput)
+: m_sOutputDir(sOutputDir)
+, m_nThreads(nThreads)
+, m_bBinaryOutput(bBinaryOutput)
+{
+	if (m_nThreads <= 0)
+		m_nThreads = int(std::thread::hardware_concurrency());
+	if (m_nThreads <= 0)
+		m_nThreads = 1;
+}
+
+///
+/// @brief		add input files by a path or a glob pattern
+/// @param		sPattern [in] path or glob pattern (e.g. "logs/*.csv")
+/// @return		number of added files
+/// @remark		a pattern without a match is added as a path, so that the
+///				missing file is reported by Run()
+///
+int CBatchRunner::AddInput(const std::string& sPattern)
+{
+#if defined(WIN32)
+	m_vInput.push_back(sPattern);
+	return 1;
+#else
+	glob_t g;
+
+	if (glob(sPattern.c_str(), GLOB_NOCHECK, 0, &g) != 0)
+	{
+		m_vInput.push_back(sPattern);
+		return 1;
+	}
+
+	for (size_t i = 0; i < g.gl_pathc; ++i)
+		m_vInput.push_back(g.gl_pathv[i]);
+
+	const int nAdded = int(g.gl_pathc);
+	globfree(&g);
+
+	return nAdded;
+#endif // defined(WIN32)
+}
+
+///
+/// @brief		get the output filename prefix of an input file
+/// @param		sInput [in] input filename
+/// @return		output directory + basename without the extension and
+///				without a trailing "_input" ("a/01_input.csv" -> "out/01")
+///
+std::string CBatchRunner::GetOutputPrefix(const std::string& sInput) const
+{
+	std::string sName = sInput;
+
+	const size_t nSlash = sName.find_last_of("/\\");
+	if (nSlash != std::string::npos)
+		sName = sName.substr(nSlash + 1);
+
+	const size_t nDot = sName.find_last_of('.');
+	if (nDot != std::string::npos && nDot > 0)
+		sName = sName.substr(0, nDot);
+
+	const std::string sSuffix = "_input";
+	if (sName.size() > sSuffix.size() && \
+		!sName.compare(sName.size() - sSuffix.size(), sSuffix.size(), sSuffix))
+		sName = sName.substr(0, sName.size() - sSuffix.size());
+
+	return m_sOutputDir + "/" + sName;
+}
+
+///
+/// @brief		process an input file
+///
+/// @param		nIndex [in] index of the input file
+/// @param		sInput [in] input filename
+/// @param		result [out] number of records and bytes
+///
+/// @return		0 on success, < 0 if occurred error
+///
+/// @remark		Writes <prefix>_pose.txt and <prefix>_contour.txt (same
+///				content as CTestTricycle::Run()) or <prefix>_pose.bin. The
+///				input is a CSV file or a record archive (RecordArchive.h). The
+///				estimator state and the virtual gyro are local to the call.
+///				The gyro takes the error model of the CVirtualGyro singleton
+///				with the seed offset by nIndex, so noisy runs are repeatable
+///				whatever the thread scheduling.
+///
+int CBatchRunner::ProcessFile(const size_t nIndex, const std::string& sInput, \
+	SFileResult& result) const
+{
+	/// memory-mapped input file
+	CMappedFile file;
+
+	/// reader of a record archive input
+	CRecordArchiveReader archive;
+
+	/// isolated estimator of the selected chassis
+	//@{
+	const STricycleChassis& chassis = CTricycle::GetInstance()->GetChassis();
+	const int nIntegrator = CTricycle::GetInstance()->GetIntegrator();
+	STricycleState state;
+	CVirtualGyro gyro;
+	SGyroErrorModel gyroModel = CVirtualGyro::GetInstance()->GetErrorModel();
+	gyroModel.nSeed += nIndex;
+	gyro.SetErrorModel(gyroModel);
+	//@}
+
+	/// output files
+	//@{
+	const std::string sPrefix = GetOutputPrefix(sInput);
+	CPoseLogWriter poseLog;
+	FILE* fpPose = 0;
+	FILE* fpContour = 0;
+	//@}
+
+	/// current record and contour
+	SPoseLogRecord out;
+	SRecord record;
+	bool bValid = false;
+
+	/// formatting buffer
+	char buf[POSE_LINE_MAX + CONTOUR_BLOCK_MAX];
+
+	if (file.Open(sInput) != 0)
+	{
+		fprintf(stderr, "Cannot open the input: %s\n", sInput.c_str());
+		return -1;
+	}
+	result.nBytes = (long long)file.GetSize();
+
+	/// validate a record archive before creating the result files
+	const bool bArchive = IsRecordArchive(file.GetData(), file.GetSize());
+	if (bArchive && archive.Attach(file.GetData(), file.GetSize()) != 0)
+	{
+		fprintf(stderr, "Invalid record archive: %s\n", sInput.c_str());
+		return -1;
+	}
+
+	/// create the result files
+	if (m_bBinaryOutput)
+	{
+		if (poseLog.Open(sPrefix + "_pose.bin") != 0)
+		{
+			fprintf(stderr, "Cannot create %s_pose.bin\n", sPrefix.c_str());
+			return -1;
+		}
+	}
+	else
+	{
+		fpPose = fopen((sPrefix + "_pose.txt").c_str(), "wb");
+		fpContour = fopen((sPrefix + "_contour.txt").c_str(), "wb");
+		if (!fpPose || !fpContour)
+		{
+			fprintf(stderr, "Cannot create %s_*.txt\n", sPrefix.c_str());
+			if (fpPose) fclose(fpPose);
+			if (fpContour) fclose(fpContour);
+			return -1;
+		}
+		setvbuf(fpPose, 0, _IOFBF, BATCH_OUTPUT_BUFFER_SIZE);
+		setvbuf(fpContour, 0, _IOFBF, BATCH_OUTPUT_BUFFER_SIZE);
+
+		fputs("#time\trobot_x\trobot_y\trobot_q\n", fpPose);
+		fputs("#robot_x\trobot_y\t\n#LWheel_x\tLWheel_y\t\n" \
+			"#FWheel_x\tFWheel_y\t\n#RWheel_x\tRWheel_y\t\n" \
+			"#robot_x\trobot_y\n\n", fpContour);
+	}
+
+	/// write the current pose and its contour
+	auto write = [&]() -> int
+	{
+		chassis.pfnGetRobotContour(out.pose, out.posFW, out.posLW, out.posRW);
+
+		if (m_bBinaryOutput)
+			return poseLog.Write(out);
+
+		char* pLine = FormatPoseLine(buf, out.time, out.pose);
+		fwrite(buf, 1, size_t(pLine - buf), fpPose);
+		pLine = FormatContourBlock(buf, out.pose, out.posFW, out.posLW, \
+			out.posRW);
+		fwrite(buf, 1, size_t(pLine - buf), fpContour);
+		return 0;
+	};
+
+	/// initial pose
+	//@{
+	int rc = 0;
+	out.time = 0.;
+	out.pose = state.pose;
+	if (write() != 0)
+		rc = -1;
+	//@}
+
+	/// calculate odometry of a record and write it
+	auto estimate = [&](const SRecord& r)
+	{
+		gyro.UpdateNs(r.time_ns, r.steering_angle, r.encoder_ticks);
+		out.time = Ns2Sec(r.time_ns);
+		out.pose = chassis.pfnEstimateBy[nIntegrator](state, r.time_ns, \
+			r.steering_angle, r.encoder_ticks, gyro.GetAngVel());
+		++result.nRecords;
+
+		if (write() != 0)
+			rc = -1;
+	};
+
+	/// calculate odometry for each record (line or archive chunk)
+	if (bArchive)
+	{
+		std::vector<SRecord> vChunk;
+		for (size_t c = 0; c < archive.GetChunkCount(); ++c)
+		{
+			vChunk.resize(archive.GetChunk(c).count);
+			if (archive.DecodeChunk(c, &vChunk[0]) != 0)
+			{
+				fprintf(stderr, "Corrupted chunk %lu of %s\n", \
+					(unsigned long)c, sInput.c_str());
+				rc = -1;
+				break;
+			}
+			for (size_t i = 0; i < vChunk.size(); ++i)
+				estimate(vChunk[i]);
+		}
+	}
+	else
+	{
+		for (const char* p = file.GetData(), *pEnd = p + file.GetSize(); \
+			p < pEnd; )
+		{
+			p = ParseRecordLine(p, pEnd, record, bValid);
+			if (bValid)
+				estimate(record);
+		}
+	}
+
+	/// close the result files
+	if (m_bBinaryOutput)
+	{
+		if (poseLog.Close() != 0)
+			rc = -1;
+	}
+	else
+	{
+		if (ferror(fpPose) || ferror(fpContour))
+			rc = -1;
+		if (fclose(fpPose) != 0)
+			rc = -1;
+		if (fclose(fpContour) != 0)
+			rc = -1;
+	}
+
+	if (rc != 0)
+		fprintf(stderr, "Error occurred while writing %s\n", sPrefix.c_str());
+
+	return rc;
+}
+
+///
+/// @brief		process all input files and print the aggregate throughput
+/// @param		N/A
+/// @return		number of failed files (0 if all succeeded), -1 if two
+///				input files have the same output prefix or the output
+///				directory cannot be created
+///
+int CBatchRunner::Run()
+{
+	/// result of each file
+	std::vector<SFileResult> vResult(m_vInput.size());
+
+	/// refuse input files that would write the same result files
+	//@{
+	std::map<std::string, size_t> mPrefix;
+	bool bCollision = false;
+	for (size_t i = 0; i < m_vInput.size(); ++i)
+	{
+		const std::pair<std::map<std::string, size_t>::iterator, bool> it = \
+			mPrefix.insert(std::make_pair(GetOutputPrefix(m_vInput[i]), i));
+		if (!it.second)
+		{
+			fprintf(stderr, "Same output prefix %s for %s and %s\n", \
+				it.first->first.c_str(), m_vInput[it.first->second].c_str(), \
+				m_vInput[i].c_str());
+			bCollision = true;
+		}
+	}
+	if (bCollision)
+		return -1;
+	//@}
+
+	/// create the output directory
+	//@{
+#if defined(WIN32)
+	_mkdir(m_sOutputDir.c_str());
+#else
+	mkdir(m_sOutputDir.c_str(), 0755);
+#endif // defined(WIN32)
+	struct stat st;
+	if (stat(m_sOutputDir.c_str(), &st) != 0 || !(st.st_mode & S_IFDIR))
+	{
+		fprintf(stderr, "Cannot create the output directory: %s\n", \
+			m_sOutputDir.c_str());
+		return -1;
+	}
+	//@}
+
+	/// create the shared (read-only) singletons before the workers start
+	CTricycle::GetInstance();
+
+	const std::chrono::steady_clock::time_point tBegin = \
+		std::chrono::steady_clock::now();
+
+	ParallelFor(m_nThreads, m_vInput.size(), [&](const size_t i)
+	{
+		vResult[i].rc = ProcessFile(i, m_vInput[i], vResult[i]);
+	});
+
+	const double fSec = std::chrono::duration<double>( \
+		std::chrono::steady_clock::now() - tBegin).count();
+
+	/// aggregate the results
+	//@{
+	long long nRecords = 0, nBytes = 0;
+	int nFailed = 0;
+	for (size_t i = 0; i < vResult.size(); ++i)
+	{
+		nRecords += vResult[i].nRecords;
+		nBytes += vResult[i].nBytes;
+		if (vResult[i].rc != 0)
+			++nFailed;
+	}
+
+	printf("files: %lu (%d failed), threads: %d, records: %lld, " \
+		"%.3f sec, %.0f records/s, %.1f MB/s\n", \
+		(unsigned long)vResult.size(), nFailed, m_nThreads, nRecords, fSec, \
+		(fSec > 0.) ? nRecords / fSec : 0., \
+		(fSec > 0.) ? nBytes / fSec / 1e6 : 0.);
+	//@}
+
+	return nFailed;
+}
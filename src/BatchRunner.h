@@ -0,0 +1,84 @@
+///
+/// @file		BatchRunner.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Headless parallel batch runner for many input files
+///
+/// @remark		Each input file is processed by one worker thread with its
+///				own estimator state and virtual gyro, so files never share
+///				state and the result of a file does not depend on the number
+///				of threads. Nothing is plotted and nothing waits for a key.
+///
+
+#ifndef _BATCH_RUNNER_H_
+#define _BATCH_RUNNER_H_
+
+#include <string>		// std::string
+#include <vector>		// std::vector
+
+/// size of the output buffer of a result file (bytes)
+#define BATCH_OUTPUT_BUFFER_SIZE	(1 << 18)
+
+/// @brief		Headless parallel batch runner for many input files
+class CBatchRunner
+{
+public:
+	/// constructor
+	explicit CBatchRunner(const std::string& sOutputDir, \
+		const int nThreads = 0, const bool bBinaryOutput = false);
+
+	/// destructor
+	virtual ~CBatchRunner() {}
+
+	/// add input files by a path or a glob pattern
+	int AddInput(const std::string& sPattern);
+
+	/// get the number of input files
+	size_t GetInputCount() const { return m_vInput.size(); }
+
+	/// process all input files and print the aggregate throughput
+	int Run();
+
+	/// get the output filename prefix of an input file
+	std::string GetOutputPrefix(const std::string& sInput) const;
+
+private:
+	/// type definition of the result of a file
+	typedef struct _tagSFileResult
+	{
+		int rc;					///< 0 on success, < 0 if occurred error
+		long long nRecords;		///< number of records
+		long long nBytes;		///< size of the input file (bytes)
+
+		/// default constructor
+		_tagSFileResult() : rc(-1), nRecords(0), nBytes(0) {}
+	} SFileResult;
+
+	/// process an input file
+	int ProcessFile(const size_t nIndex, const std::string& sInput, \
+		SFileResult& result) const;
+
+private:
+	/// non construction-copyable
+	CBatchRunner(const CBatchRunner&);
+
+	/// non copyable
+	const CBatchRunner& operator=(const CBatchRunner&);
+
+private:
+	/// output directory
+	std::string m_sOutputDir;
+
+	/// number of worker threads
+	int m_nThreads;
+
+	/// whether to write the binary pose log instead of the text files
+	bool m_bBinaryOutput;
+
+	/// input files
+	std::vector<std::string> m_vInput;
+};
+
+#endif // _BATCH_RUNNER_H_
@@ -0,0 +1,177 @@
+///
+/// @file		EkfTricycle.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Extended Kalman filter fusing the gyro rate and the steering
+///				kinematics of the Tricycle-drive
+///
+
+#include <cmath>			// fabsf
+
+#include "EkfTricycle.h"
+#include "Tricycle.h"		// CTricycle
+#include "math2.h"			// AngleClamp, SinCos, almostZero, Ns2Sec
+
+///
+/// @brief		constructor
+/// @param		noise [in] noise parameters
+/// @return		N/A
+/// @remark		the geometry is taken from the selected chassis of CTricycle
+///
+CEkfTricycle::CEkfTricycle(const SEkfNoise& noise)
+: m_fDistBtwFrontRear(CTricycle::GetInstance()->GetDistBtwFrontRear())
+, m_fFrontDistPerTick(CTricycle::GetInstance()->GetFrontDistPerTick())
+, m_noise(noise)
+, m_bGyroInput(true)
+{
+	Reset();
+}
+
+///
+/// @brief		reset the state to a known pose
+/// @param		pose [in] initial pose (exact)
+/// @return		void
+///
+void CEkfTricycle::Reset(const SPose& pose)
+{
+	m_x(0, 0) = pose.x;
+	m_x(1, 0) = pose.y;
+	m_x(2, 0) = pose.q;
+	m_x(3, 0) = 0.f;
+
+	m_P = TMatrix<EKF_STATES, EKF_STATES>::Zero();
+
+	m_gyro = SGyroState();
+}
+
+///
+/// @brief		pose estimator
+///
+/// @param		nTimeNs [in] time of reading of the input data (unit: ns)
+/// @param		steering_angle [in] steering wheel angle (unit: rad)
+/// @param		encoder_ticks [in] number of ticks from the traction motor
+///				encoder (unit: ticks (integer))
+/// @param		angular_velocity [in] reading from a gyroscope measuring the
+///				rotation velocity of the platform around the Z axis
+///				(unit: rad/s, not used without SetGyroInput(true))
+///
+/// @return		new estimated pose (x, y, heading) (unit: m, m, rad)
+///
+/// @remark		records without a time difference do not change the state
+///
+SPose CEkfTricycle::EstimateNs(const long long nTimeNs, \
+	const float steering_angle, const int encoder_ticks, \
+	const float angular_velocity)
+{
+	/// time difference since previous time (exact in nanoseconds)
+	const float fDiffTime = float(Ns2Sec(nTimeNs - m_gyro.nPrevTimeNs));
+
+	/// distance of the front steering wheel
+	const float fFrontWheelDist = encoder_ticks * m_fFrontDistPerTick;
+
+	/// rate of the steering kinematics (as CVirtualGyro, noise-free)
+	GyroStep(m_gyro, m_fFrontDistPerTick, m_fDistBtwFrontRear, nTimeNs, \
+		steering_angle, encoder_ticks);
+
+	if (almostZero(fDiffTime))	///< prevent divide by zero
+		return SPose(m_x(0, 0), m_x(1, 0), m_x(2, 0));
+
+	/// 1. predict the angular velocity by the steering kinematics
+	//@{
+	m_x(3, 0) = m_gyro.fAngVel;
+	for (int i = 0; i < EKF_STATES - 1; ++i)
+	{
+		m_P(i, 3) = 0.f;
+		m_P(3, i) = 0.f;
+	}
+	m_P(3, 3) = m_noise.fSteerRateStdev * m_noise.fSteerRateStdev;
+	//@}
+
+	/// 2. update the angular velocity with the gyro rate
+	if (m_bGyroInput)
+	{
+		TMatrix<EKF_MEASUREMENTS, EKF_STATES> H = \
+			TMatrix<EKF_MEASUREMENTS, EKF_STATES>::Zero();
+		H(0, 3) = 1.f;
+
+		TMatrix<EKF_MEASUREMENTS, EKF_MEASUREMENTS> R;
+		R(0, 0) = m_noise.fGyroStdev * m_noise.fGyroStdev;
+
+		/// innovation
+		TMatrix<EKF_MEASUREMENTS, 1> y;
+		y(0, 0) = angular_velocity - m_x(3, 0);
+
+		const TMatrix<EKF_STATES, EKF_MEASUREMENTS> PHt = m_P * H.Transpose();
+		TMatrix<EKF_MEASUREMENTS, EKF_MEASUREMENTS> Sinv;
+		if (Inverse(H * PHt + R, Sinv) == 0)
+		{
+			const TMatrix<EKF_STATES, EKF_MEASUREMENTS> K = PHt * Sinv;
+
+			m_x = m_x + K * y;
+			m_P = (TMatrix<EKF_STATES, EKF_STATES>::Identity() - K * H) * m_P;
+		}
+	}
+
+	/// 3. move along the new heading and propagate the covariance
+	//@{
+	float s, c;
+	SinCos(steering_angle, s, c);
+	const float fDist = fFrontWheelDist * c;
+	const float q = AngleClamp(m_x(2, 0) + m_x(3, 0) * fDiffTime);
+	SinCos(q, s, c);
+
+	m_x(0, 0) += fDist * c;
+	m_x(1, 0) += fDist * s;
+	m_x(2, 0) = q;
+
+	/// Jacobian of the motion
+	TMatrix<EKF_STATES, EKF_STATES> F = \
+		TMatrix<EKF_STATES, EKF_STATES>::Identity();
+	F(0, 2) = -fDist * s;
+	F(0, 3) = -fDist * s * fDiffTime;
+	F(1, 2) = fDist * c;
+	F(1, 3) = fDist * c * fDiffTime;
+	F(2, 3) = fDiffTime;
+
+	/// distance noise along the heading
+	TMatrix<EKF_STATES, 1> G = TMatrix<EKF_STATES, 1>::Zero();
+	G(0, 0) = c;
+	G(1, 0) = s;
+	const float fDistVar = m_noise.fDistStdev * m_noise.fDistStdev \
+		* fabsf(fDist);
+
+	m_P = F * m_P * F.Transpose() + G * G.Transpose() * fDistVar;
+
+	/// keep the covariance symmetric
+	m_P = (m_P + m_P.Transpose()) * 0.5f;
+	//@}
+
+	return SPose(m_x(0, 0), m_x(1, 0), m_x(2, 0));
+}
+
+///
+/// @brief		get the robot pose
+/// @param		pose [out] robot pose (x, y, heading)
+/// @return		void
+///
+void CEkfTricycle::GetRobotPose(SPose& pose) const
+{
+	pose = SPose(m_x(0, 0), m_x(1, 0), m_x(2, 0));
+}
+
+///
+/// @brief		get the covariance of the robot pose
+/// @param		cov [out] covariance of (x, y, heading)
+/// @return		void
+///
+void CEkfTricycle::GetCovariance(SPoseCov& cov) const
+{
+	cov.xx = m_P(0, 0);
+	cov.xy = m_P(0, 1);
+	cov.xq = m_P(0, 2);
+	cov.yy = m_P(1, 1);
+	cov.yq = m_P(1, 2);
+	cov.qq = m_P(2, 2);
+}
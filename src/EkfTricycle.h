@@ -0,0 +1,114 @@
+///
+/// @file		EkfTricycle.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Extended Kalman filter fusing the gyro rate and the steering
+///				kinematics of the Tricycle-drive
+///
+/// @remark		State: x = (x, y, heading, angular velocity).
+///
+///				Each record (1) predicts the angular velocity by the steering
+///				kinematics of the virtual gyro (GyroStep(): d / (2 L) *
+///				sin(average steering) / dt) with the variance of
+///				fSteerRateStdev (process model), (2) updates it with the gyro
+///				rate (angular_velocity) when the input has a gyro
+///				(SetGyroInput()), and (3) moves the pose along the new
+///				heading by the encoder distance, propagating the covariance
+///				with the Jacobian of the motion.
+///
+///				The steering kinematics are used once, as the process model;
+///				the gyro is the only measurement. Without a gyro the pose is
+///				the one of CTricycle (Euler) and the filter adds its
+///				covariance.
+///
+///				All matrices are TMatrix on the stack; EstimateNs() does not
+///				allocate.
+///
+
+#ifndef _EKF_TRICYCLE_H_
+#define _EKF_TRICYCLE_H_
+
+#include "Pose.h"		// SPose, SPoseCov
+#include "Matrix.h"		// TMatrix
+#include "GyroState.h"	// SGyroState
+
+/// number of states (x, y, heading, angular velocity)
+#define EKF_STATES			(4)
+
+/// number of measurements (gyro rate)
+#define EKF_MEASUREMENTS	(1)
+
+/// type definition of the noise parameters of the filter
+typedef struct _tagSEkfNoise
+{
+	float fGyroStdev;		///< std. dev. of the gyro rate (rad/s)
+	float fSteerRateStdev;	///< std. dev. of the steering rate (rad/s)
+	float fDistStdev;		///< std. dev. of the distance (m/sqrt(m))
+
+	/// default constructor
+	_tagSEkfNoise()
+	: fGyroStdev(0.01f), fSteerRateStdev(0.05f), fDistStdev(0.01f) {}
+} SEkfNoise;
+
+/// @brief		Extended Kalman filter pose estimator (one vehicle)
+class CEkfTricycle
+{
+public:
+	/// constructor (geometry of the selected chassis of CTricycle)
+	explicit CEkfTricycle(const SEkfNoise& noise = SEkfNoise());
+
+	/// destructor
+	virtual ~CEkfTricycle() {}
+
+	/// reset the state to a known pose
+	void Reset(const SPose& pose = SPose());
+
+	/// set whether angular_velocity is a gyro reading (default: true)
+	void SetGyroInput(const bool bGyroInput) { m_bGyroInput = bGyroInput; }
+
+	/// pose estimator (fuses angular_velocity and the steering kinematics)
+	SPose EstimateNs(const long long nTimeNs, const float steering_angle, \
+		const int encoder_ticks, const float angular_velocity);
+
+	/// get the robot pose
+	void GetRobotPose(SPose& pose) const;
+
+	/// get the covariance of the robot pose
+	void GetCovariance(SPoseCov& cov) const;
+
+	/// get the estimated angular velocity (rad/s)
+	float GetAngVel() const { return m_x(3, 0); }
+
+private:
+	/// non construction-copyable
+	CEkfTricycle(const CEkfTricycle&);
+
+	/// non copyable
+	const CEkfTricycle& operator=(const CEkfTricycle&);
+
+private:
+	/// distance from front wheel to back axis (m)
+	const float m_fDistBtwFrontRear;
+
+	/// distance per a tick of the front wheel
+	const float m_fFrontDistPerTick;
+
+	/// noise parameters
+	SEkfNoise m_noise;
+
+	/// state (x, y, heading, angular velocity)
+	TMatrix<EKF_STATES, 1> m_x;
+
+	/// covariance of the state
+	TMatrix<EKF_STATES, EKF_STATES> m_P;
+
+	/// whether angular_velocity is a gyro reading
+	bool m_bGyroInput;
+
+	/// steering kinematics (previous timestamp and steering angle)
+	SGyroState m_gyro;
+};
+
+#endif // _EKF_TRICYCLE_H_
@@ -0,0 +1,163 @@
+///
+/// @file		EstimatorJournal.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Journal of input records with periodic estimator checkpoints
+///
+
+#include <algorithm>		// std::lower_bound, std::min, std::max
+
+#include "EstimatorJournal.h"
+
+///
+/// @brief		constructor
+/// @param		chassis [in] chassis of the vehicle (CTricycle::GetChassisAt())
+/// @param		nIntegrator [in] pose integrator (EIntegrator)
+/// @param		nInterval [in] number of records between two checkpoints
+/// @return		N/A
+///
+CEstimatorJournal::CEstimatorJournal(const STricycleChassis& chassis, \
+	const int nIntegrator, const size_t nInterval)
+: m_pChassis(&chassis)
+, m_nIntegrator(nIntegrator)
+, m_nInterval(std::max<size_t>(1, nInterval))
+{
+	Clear();
+}
+
+///
+/// @brief		drop all records and start from a state
+/// @param		initial [in] state before the first record
+/// @return		void
+///
+void CEstimatorJournal::Clear(const SEstimatorState& initial)
+{
+	m_vRecord.clear();
+	m_vPose.clear();
+	m_vCheckpoint.assign(1, initial);
+	m_state = initial;
+	m_nValid = 0;
+	m_nReestimated = 0;
+	m_nEstimated = 0;
+}
+
+///
+/// @brief		add a new record and estimate its pose
+/// @param		record [in] input record (time_ns, steering, ticks)
+/// @return		new estimated pose (x, y, heading) (unit: m, m, rad)
+/// @remark		pending corrections are re-estimated first
+///
+SPose CEstimatorJournal::Append(const SRecord& record)
+{
+	m_vRecord.push_back(record);
+	m_vPose.push_back(SPose());
+
+	Update(m_vRecord.size());
+
+	return m_vPose.back();
+}
+
+///
+/// @brief		replace a past record
+/// @param		nIndex [in] index of the record (0..GetCount()-1)
+/// @param		record [in] corrected record
+/// @return		0 on success, -1 if nIndex is out of range
+/// @remark		Moves the cursor back to the checkpoint at or before nIndex;
+///				the poses from there on are re-estimated on demand.
+///
+int CEstimatorJournal::Correct(const size_t nIndex, const SRecord& record)
+{
+	if (nIndex >= m_vRecord.size())
+		return -1;
+
+	m_vRecord[nIndex] = record;
+
+	if (nIndex < m_nValid)
+	{
+		const size_t nCheckpoint = nIndex / m_nInterval;
+		m_nValid = nCheckpoint * m_nInterval;
+		m_state = m_vCheckpoint[nCheckpoint];
+	}
+
+	return 0;
+}
+
+///
+/// @brief		find the first record at or after a timestamp
+/// @param		nTimeNs [in] timestamp (ns)
+/// @return		index of the record (GetCount() if none)
+/// @remark		the timestamps of the records must not decrease
+///
+size_t CEstimatorJournal::Find(const long long nTimeNs) const
+{
+	std::vector<SRecord>::const_iterator it = std::lower_bound( \
+		m_vRecord.begin(), m_vRecord.end(), nTimeNs, \
+		[](const SRecord& r, const long long t) { return r.time_ns < t; });
+
+	return size_t(it - m_vRecord.begin());
+}
+
+///
+/// @brief		get the pose of a record
+/// @param		nIndex [in] index of the record (0..GetCount()-1)
+/// @param		pose [out] estimated pose (x, y, heading) (unit: m, m, rad)
+/// @return		0 on success, -1 if nIndex is out of range
+/// @remark		re-estimates from the cursor up to nIndex only
+///
+int CEstimatorJournal::GetPose(const size_t nIndex, SPose& pose)
+{
+	if (nIndex >= m_vRecord.size())
+		return -1;
+
+	Update(nIndex + 1);
+
+	pose = m_vPose[nIndex];
+	return 0;
+}
+
+///
+/// @brief		get the state after the last record
+/// @param		N/A
+/// @return		state of the estimator
+///
+const SEstimatorState& CEstimatorJournal::GetState()
+{
+	Update(m_vRecord.size());
+
+	return m_state;
+}
+
+///
+/// @brief		estimate the records up to nEnd from the cursor
+/// @param		nEnd [in] index after the last record to estimate
+/// @return		void
+/// @remark		saves the state at every checkpoint it passes; the
+///				checkpoints after the cursor are overwritten before use
+///
+void CEstimatorJournal::Update(const size_t nEnd)
+{
+	for (size_t i = m_nValid; i < nEnd; ++i)
+	{
+		if (i % m_nInterval == 0)
+		{
+			const size_t nCheckpoint = i / m_nInterval;
+			if (nCheckpoint < m_vCheckpoint.size())
+				m_vCheckpoint[nCheckpoint] = m_state;
+			else
+				m_vCheckpoint.push_back(m_state);
+		}
+
+		m_vPose[i] = Step(*m_pChassis, m_nIntegrator, m_state, m_vRecord[i]);
+	}
+
+	if (nEnd > m_nValid)
+	{
+		if (m_nValid < m_nEstimated)
+			m_nReestimated += \
+				(long long)(std::min(nEnd, m_nEstimated) - m_nValid);
+		m_nEstimated = std::max(m_nEstimated, nEnd);
+		m_nValid = nEnd;
+	}
+}
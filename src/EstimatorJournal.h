@@ -0,0 +1,123 @@
+///
+/// @file		EstimatorJournal.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Journal of input records with periodic estimator checkpoints
+///				(late corrections without a full replay)
+///
+/// @remark		The journal keeps every input record, the pose estimated for
+///				it and, every nInterval records, a copy of the estimator state
+///				(SEstimatorState: pose, compensations, previous timestamp and
+///				the gyro angle and previous steering) before that record.
+///
+///				Correct() replaces a past record and only moves the cursor of
+///				valid poses back to the checkpoint at or before it; nothing is
+///				re-estimated yet. The poses are re-estimated from there on
+///				demand (GetPose(), GetState(), Append()), so several
+///				corrections cost one pass, and reading the pose of a corrected
+///				record costs at most nInterval steps plus the distance to it,
+///				whatever the length of the log. The re-estimated poses are
+///				identical to those of a full replay of the corrected log.
+///
+
+#ifndef _ESTIMATOR_JOURNAL_H_
+#define _ESTIMATOR_JOURNAL_H_
+
+#include <cstddef>			// size_t
+#include <vector>			// std::vector
+
+#include "Record.h"			// SRecord
+#include "Tricycle.h"		// STricycleChassis, SEstimatorState, Step
+
+/// default number of records between two checkpoints
+#define JOURNAL_CHECKPOINT_INTERVAL	(256)
+
+/// @brief		Journal of input records with periodic estimator checkpoints
+class CEstimatorJournal
+{
+public:
+	/// constructor
+	explicit CEstimatorJournal(const STricycleChassis& chassis, \
+		const int nIntegrator = INTEGRATOR_EULER, \
+		const size_t nInterval = JOURNAL_CHECKPOINT_INTERVAL);
+
+	/// destructor
+	virtual ~CEstimatorJournal() {}
+
+	/// drop all records and start from a state
+	void Clear(const SEstimatorState& initial = SEstimatorState());
+
+	/// add a new record and estimate its pose
+	SPose Append(const SRecord& record);
+
+	/// replace a past record (re-estimated on demand)
+	int Correct(const size_t nIndex, const SRecord& record);
+
+	/// find the first record at or after a timestamp
+	size_t Find(const long long nTimeNs) const;
+
+	/// get the pose of a record (re-estimates up to it if needed)
+	int GetPose(const size_t nIndex, SPose& pose);
+
+	/// get the state after the last record (re-estimates if needed)
+	const SEstimatorState& GetState();
+
+	/// get the number of records
+	size_t GetCount() const { return m_vRecord.size(); }
+
+	/// get a record
+	const SRecord& GetRecord(const size_t nIndex) const \
+		{ return m_vRecord[nIndex]; }
+
+	/// get the number of records whose poses are up to date
+	size_t GetValidCount() const { return m_nValid; }
+
+	/// get the number of records estimated again since Clear()
+	long long GetReestimatedCount() const { return m_nReestimated; }
+
+private:
+	/// estimate the records up to nEnd (exclusive) from the cursor
+	void Update(const size_t nEnd);
+
+private:
+	/// non construction-copyable
+	CEstimatorJournal(const CEstimatorJournal&);
+
+	/// non copyable
+	const CEstimatorJournal& operator=(const CEstimatorJournal&);
+
+private:
+	/// chassis of the vehicle
+	const STricycleChassis* m_pChassis;
+
+	/// pose integrator (EIntegrator)
+	int m_nIntegrator;
+
+	/// number of records between two checkpoints
+	size_t m_nInterval;
+
+	/// input records
+	std::vector<SRecord> m_vRecord;
+
+	/// estimated pose of each record (valid below m_nValid)
+	std::vector<SPose> m_vPose;
+
+	/// [k]: state before the record k * m_nInterval
+	std::vector<SEstimatorState> m_vCheckpoint;
+
+	/// state after the record m_nValid - 1
+	SEstimatorState m_state;
+
+	/// number of records whose poses are up to date (cursor)
+	size_t m_nValid;
+
+	/// number of records estimated again after a correction
+	long long m_nReestimated;
+
+	/// number of records estimated at least once (end of the first pass)
+	size_t m_nEstimated;
+};
+
+#endif // _ESTIMATOR_JOURNAL_H_
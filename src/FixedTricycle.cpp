@@ -0,0 +1,256 @@
+///
+/// @file		FixedTricycle.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Fixed-point (integer only) pose estimator and virtual gyro for
+///				controllers without an FPU
+///
+
+#include <cassert>			// assert
+#include <cmath>			// floor
+
+#include "FixedTricycle.h"
+#include "math2.h"			// M_PI
+
+/// sin(M_PI / 2 * i / FIXED_SIN_TABLE_SIZE) in Q2.30, i = 0..SIZE, and one
+/// entry past M_PI / 2 for the interpolation at the end of the quadrant
+static const fix30_t s_nSinTable[FIXED_SIN_TABLE_SIZE + 2] =
+{
+	0, 3294193, 6588356, 9882456, 13176464, 16470347,
+	19764076, 23057618, 26350943, 29644021, 32936819, 36229307,
+	39521455, 42813230, 46104602, 49395541, 52686014, 55975992,
+	59265442, 62554335, 65842639, 69130324, 72417357, 75703709,
+	78989349, 82274245, 85558366, 88841683, 92124163, 95405776,
+	98686491, 101966277, 105245103, 108522939, 111799753, 115075515,
+	118350194, 121623759, 124896179, 128167423, 131437462, 134706263,
+	137973796, 141240030, 144504935, 147768480, 151030634, 154291367,
+	157550647, 160808445, 164064728, 167319468, 170572633, 173824192,
+	177074115, 180322371, 183568930, 186813762, 190056834, 193298119,
+	196537583, 199775198, 203010932, 206244756, 209476638, 212706549,
+	215934457, 219160334, 222384147, 225605867, 228825464, 232042906,
+	235258165, 238471210, 241682010, 244890535, 248096755, 251300640,
+	254502159, 257701283, 260897982, 264092224, 267283981, 270473223,
+	273659918, 276844038, 280025552, 283204430, 286380643, 289554160,
+	292724951, 295892988, 299058239, 302220676, 305380268, 308536985,
+	311690799, 314841679, 317989595, 321134518, 324276419, 327415267,
+	330551034, 333683689, 336813204, 339939549, 343062693, 346182609,
+	349299266, 352412636, 355522689, 358629395, 361732726, 364832652,
+	367929144, 371022173, 374111709, 377197725, 380280190, 383359076,
+	386434353, 389505993, 392573967, 395638246, 398698801, 401755603,
+	404808624, 407857835, 410903207, 413944711, 416982319, 420016002,
+	423045732, 426071480, 429093217, 432110916, 435124548, 438134084,
+	441139496, 444140756, 447137835, 450130706, 453119340, 456103710,
+	459083786, 462059541, 465030947, 467997976, 470960600, 473918791,
+	476872522, 479821764, 482766489, 485706671, 488642281, 491573292,
+	494499676, 497421405, 500338453, 503250791, 506158392, 509061229,
+	511959275, 514852502, 517740883, 520624391, 523502998, 526376678,
+	529245404, 532109148, 534967884, 537821584, 540670223, 543513772,
+	546352205, 549185496, 552013618, 554836544, 557654248, 560466703,
+	563273883, 566075761, 568872310, 571663506, 574449320, 577229728,
+	580004702, 582774218, 585538248, 588296766, 591049748, 593797166,
+	596538995, 599275210, 602005783, 604730691, 607449906, 610163404,
+	612871159, 615573145, 618269338, 620959711, 623644239, 626322897,
+	628995660, 631662503, 634323400, 636978327, 639627258, 642270169,
+	644907034, 647537830, 650162530, 652781111, 655393548, 657999816,
+	660599890, 663193747, 665781362, 668362709, 670937767, 673506508,
+	676068911, 678624950, 681174602, 683717842, 686254647, 688784993,
+	691308855, 693826211, 696337036, 698841307, 701339000, 703830092,
+	706314559, 708792378, 711263525, 713727978, 716185713, 718636707,
+	721080937, 723518380, 725949013, 728372813, 730789757, 733199822,
+	735602987, 737999228, 740388522, 742770848, 745146182, 747514503,
+	749875788, 752230015, 754577161, 756917205, 759250125, 761575898,
+	763894504, 766205919, 768510122, 770807092, 773096806, 775379244,
+	777654384, 779922204, 782182683, 784435800, 786681534, 788919863,
+	791150767, 793374223, 795590213, 797798714, 799999706, 802193167,
+	804379079, 806557419, 808728167, 810891304, 813046808, 815194659,
+	817334838, 819467323, 821592095, 823709135, 825818421, 827919934,
+	830013654, 832099562, 834177638, 836247863, 838310216, 840364679,
+	842411232, 844449856, 846480531, 848503239, 850517961, 852524677,
+	854523370, 856514019, 858496606, 860471112, 862437520, 864395810,
+	866345964, 868287963, 870221790, 872147426, 874064853, 875974054,
+	877875009, 879767701, 881652112, 883528225, 885396022, 887255485,
+	889106597, 890949341, 892783698, 894609652, 896427186, 898236282,
+	900036924, 901829095, 903612776, 905387953, 907154608, 908912725,
+	910662286, 912403276, 914135678, 915859476, 917574653, 919281194,
+	920979082, 922668302, 924348837, 926020672, 927683790, 929338177,
+	930983817, 932620694, 934248793, 935868098, 937478595, 939080267,
+	940673101, 942257081, 943832191, 945398418, 946955747, 948504163,
+	950043650, 951574196, 953095785, 954608403, 956112036, 957606670,
+	959092290, 960568883, 962036435, 963494932, 964944360, 966384706,
+	967815955, 969238095, 970651112, 972054994, 973449725, 974835295,
+	976211688, 977578894, 978936898, 980285688, 981625251, 982955574,
+	984276646, 985588453, 986890984, 988184225, 989468165, 990742793,
+	992008094, 993264059, 994510675, 995747930, 996975812, 998194311,
+	999403415, 1000603111, 1001793390, 1002974239, 1004145648, 1005307605,
+	1006460100, 1007603122, 1008736660, 1009860704, 1010975242, 1012080264,
+	1013175761, 1014261721, 1015338134, 1016404991, 1017462281, 1018509994,
+	1019548121, 1020576651, 1021595575, 1022604883, 1023604567, 1024594615,
+	1025575020, 1026545772, 1027506862, 1028458280, 1029400018, 1030332067,
+	1031254418, 1032167062, 1033069992, 1033963197, 1034846671, 1035720404,
+	1036584389, 1037438617, 1038283080, 1039117770, 1039942680, 1040757802,
+	1041563127, 1042358649, 1043144360, 1043920252, 1044686319, 1045442553,
+	1046188946, 1046925492, 1047652185, 1048369016, 1049075980, 1049773069,
+	1050460278, 1051137599, 1051805027, 1052462555, 1053110176, 1053747885,
+	1054375676, 1054993543, 1055601479, 1056199480, 1056787540, 1057365653,
+	1057933813, 1058492016, 1059040255, 1059578527, 1060106826, 1060625146,
+	1061133483, 1061631833, 1062120190, 1062598550, 1063066909, 1063525261,
+	1063973603, 1064411931, 1064840240, 1065258526, 1065666786, 1066065015,
+	1066453210, 1066831367, 1067199483, 1067557554, 1067905576, 1068243547,
+	1068571464, 1068889322, 1069197120, 1069494854, 1069782521, 1070060120,
+	1070327646, 1070585099, 1070832474, 1071069770, 1071296985, 1071514117,
+	1071721163, 1071918122, 1072104991, 1072281769, 1072448455, 1072605046,
+	1072751542, 1072887940, 1073014240, 1073130440, 1073236540, 1073332538,
+	1073418433, 1073494225, 1073559913, 1073615496, 1073660973, 1073696345,
+	1073721611, 1073736771, 1073741824, 1073736771,
+};
+
+/// bits of the angle within a quadrant (30) below the table index
+#define FIXED_SIN_FRAC_BITS		(30 - 9)
+
+static_assert((1 << (30 - FIXED_SIN_FRAC_BITS)) == FIXED_SIN_TABLE_SIZE, \
+	"FIXED_SIN_FRAC_BITS must match FIXED_SIN_TABLE_SIZE");
+
+/// curvature correction of the interpolation: h^2 / 2 in Q0.32, where h is
+/// the width of a segment (M_PI / 2 / FIXED_SIN_TABLE_SIZE)
+#define FIXED_SIN_CURVATURE		(20213)
+
+///
+/// @brief		sine of a binary angle
+/// @param		a [in] binary angle (2^32 = one turn)
+/// @return		sine (Q2.30), error < 1e-8
+/// @remark		The quarter-wave table is mirrored into the other quadrants
+///				and interpolated linearly. A chord of the sine is always on
+///				the side of the axis by sin * h^2 / 2 * f * (1 - f) at the
+///				fraction f of the segment; the correction adds it back, so
+///				the heading does not drift by a bias on long runs.
+///
+fix30_t FixedSin(const bam_t a)
+{
+	const uint32_t nQuadrant = a >> 30;
+	uint32_t r = a & 0x3fffffffU;
+
+	/// 2nd and 4th quadrants: sin(M_PI / 2 + t) = sin(M_PI / 2 - t)
+	if (nQuadrant & 1)
+		r = 0x40000000U - r;
+
+	const uint32_t i = r >> FIXED_SIN_FRAC_BITS;
+	const int64_t nFrac = int64_t(r & ((1U << FIXED_SIN_FRAC_BITS) - 1));
+	const int64_t s = s_nSinTable[i] + (((s_nSinTable[i + 1] - \
+		s_nSinTable[i]) * nFrac) >> FIXED_SIN_FRAC_BITS);
+
+	/// f * (1 - f) in Q.FIXED_SIN_FRAC_BITS, then the curvature correction
+	const int64_t nBow = (nFrac * ((1 << FIXED_SIN_FRAC_BITS) - nFrac)) \
+		>> FIXED_SIN_FRAC_BITS;
+	const fix30_t nSin = fix30_t(s + ((((s * FIXED_SIN_CURVATURE) >> 32) \
+		* nBow) >> FIXED_SIN_FRAC_BITS));
+
+	/// 3rd and 4th quadrants: sin(M_PI + t) = -sin(t)
+	return (nQuadrant & 2) ? -nSin : nSin;
+}
+
+///
+/// @brief		make the constants of a chassis
+/// @param		dFrontDistPerTick [in] distance per a tick of the front wheel
+///				(m, < 0.25)
+/// @param		dDistBtwFrontRear [in] distance from front wheel to back axis
+///				(m, > dFrontDistPerTick / (4 * M_PI / 1024))
+/// @return		constants of the chassis
+/// @remark		host only (floating point); a controller keeps the result as
+///				constants. Both bounds keep the product of any int32 tick
+///				count and a constant below 2^61 (FixedMulQ30()).
+///
+SFixedChassis MakeFixedChassis(const double dFrontDistPerTick, \
+	const double dDistBtwFrontRear)
+{
+	SFixedChassis chassis;
+
+	/// any int32 tick count times the distance stays below 2^61
+	assert(dFrontDistPerTick > 0. && dFrontDistPerTick < 0.25);
+
+	chassis.nDistPerTick = int64_t(floor(dFrontDistPerTick * 4294967296. \
+		+ 0.5));
+	chassis.nTurnPerTick = int64_t(floor(dFrontDistPerTick \
+		/ (2. * dDistBtwFrontRear) / (2. * M_PI) * 4294967296. * 256. + 0.5));
+
+	/// any int32 tick count times the turn stays below 2^61 as well
+	assert(dDistBtwFrontRear > 0. && chassis.nTurnPerTick < (1LL << 30));
+
+	return chassis;
+}
+
+///
+/// @brief		update the gyro and estimate the pose of a record
+///
+/// @param		chassis [in] constants of the chassis
+/// @param		state [in/out] state of the estimator
+/// @param		nTimeNs [in] time of reading of the input data (unit: ns)
+/// @param		nSteer [in] steering wheel angle (binary angle, signed)
+/// @param		nTicks [in] number of ticks from the traction motor encoder
+///
+/// @return		void
+///
+/// @remark		Step() with the Euler integrator: the gyro turns by the
+///				distance of the front wheel times the sine of the average
+///				steering angle over 2 * r, the heading takes the turn, and the
+///				robot moves by the distance times the cosine of the steering
+///				angle along the new heading.
+///
+void FixedStep(const SFixedChassis& chassis, SFixedState& state, \
+	const int64_t nTimeNs, const int32_t nSteer, const int32_t nTicks)
+{
+	/// time difference since previous time (exact in nanoseconds)
+	const int64_t nDiffNs = nTimeNs - state.nPrevTimeNs;
+	state.nPrevTimeNs = nTimeNs;
+
+	/// gyro: turn over the record with the average steering angle (steering
+	/// angles are within +-M_PI / 2, so the sum does not overflow)
+	//@{
+	const bam_t nAvgSteer = bam_t((int64_t(state.nPrevSteer) + nSteer) >> 1);
+	const bam_t nTurn = bam_t(FixedMulQ30(int64_t(nTicks) \
+		* chassis.nTurnPerTick, FixedSin(nAvgSteer)) >> 8);
+	state.nGyroAngle += nTurn;
+	state.nPrevSteer = nSteer;
+	//@}
+
+	/// no time difference: neither turn nor move (as the float estimator)
+	if (nDiffNs < FIXED_ZERO_TIME_NS)
+		return;
+
+	/// heading (wraps around at +-M_PI)
+	state.q += nTurn;
+
+	/// distance along the heading (Q32.32 m)
+	const int64_t nDist = FixedMulQ30(int64_t(nTicks) * chassis.nDistPerTick, \
+		FixedCos(bam_t(nSteer)));
+
+	/// update the robot position
+	state.x += FixedMulQ30(nDist, FixedCos(state.q));
+	state.y += FixedMulQ30(nDist, FixedSin(state.q));
+}
+
+///
+/// @brief		convert an angle in radians to a binary angle
+/// @param		dRad [in] angle (rad)
+/// @return		binary angle (signed, 2^32 = one turn)
+///
+int32_t FixedRad2Bam(const double dRad)
+{
+	const double dTurn = dRad / (2. * M_PI);
+
+	return int32_t(uint32_t(int64_t(floor((dTurn - floor(dTurn)) \
+		* 4294967296. + 0.5))));
+}
+
+///
+/// @brief		get the pose in float
+/// @param		state [in] state of the estimator
+/// @return		pose (x, y, heading) (unit: m, m, rad in [-M_PI..+M_PI))
+///
+SPose FixedGetPose(const SFixedState& state)
+{
+	return SPose(float(double(state.x) / 4294967296.), \
+		float(double(state.y) / 4294967296.), \
+		float(double(int32_t(state.q)) * (M_PI / 2147483648.)));
+}
@@ -0,0 +1,126 @@
+///
+/// @file		FixedTricycle.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Fixed-point (integer only) pose estimator and virtual gyro for
+///				controllers without an FPU
+///
+/// @remark		Same model as Step() with the Euler integrator and the
+///				noise-free virtual gyro (GyroStep()), in integer arithmetic:
+///
+///				- angles are binary angles (bam_t, 2^32 = one turn), so the
+///				  clamping to [-M_PI..+M_PI) is the wrap-around of the integer
+///				- sine and cosine are Q2.30, from a quarter-wave table of
+///				  FIXED_SIN_TABLE_SIZE segments with linear interpolation
+///				- the position is accumulated in Q32.32 meters (int64_t), and
+///				  reported in Q16.16 (fix16_t) or float
+///				- every product of a 64-bit value and a Q2.30 factor goes
+///				  through FixedMulQ30() (split multiply). MakeFixedChassis()
+///				  bounds the distance per tick (< 0.25 m) and the turn per
+///				  tick (distance per tick / r < 4 * M_PI / 1024, about
+///				  0.0123), so encoder_ticks times either constant stays below
+///				  2^61 for any int32 tick count
+///
+///				The per-chassis constants (SFixedChassis) are made on the host
+///				by MakeFixedChassis(); a controller stores them as constants.
+///				The heading change of the gyro is applied directly, because
+///				the angular velocity is multiplied back by the same time
+///				difference. Nothing here uses float except the conversions
+///				for the host.
+///
+
+#ifndef _FIXED_TRICYCLE_H_
+#define _FIXED_TRICYCLE_H_
+
+#include <cstdint>			// int32_t, int64_t, uint32_t
+
+#include "Pose.h"			// SPose
+
+/// type definition of a Q16.16 value
+typedef int32_t fix16_t;
+
+/// type definition of a Q2.30 value (sine and cosine)
+typedef int32_t fix30_t;
+
+/// type definition of a binary angle (2^32 = one turn)
+typedef uint32_t bam_t;
+
+/// number of segments of the quarter-wave sine table (power of 2)
+#define FIXED_SIN_TABLE_SIZE	(512)
+
+/// time differences below this are zero, as almostZero() of the float
+/// estimator (FLT_EPSILON sec)
+#define FIXED_ZERO_TIME_NS		(120)
+
+/// type definition of the constants of a chassis
+typedef struct _tagSFixedChassis
+{
+	int64_t nDistPerTick;	///< front wheel distance per tick (Q0.32 m)
+	int64_t nTurnPerTick;	///< heading change per tick at full steering
+							///< (bam_t Q.8, dist per tick / (2 * r),
+							///< < 2^30)
+} SFixedChassis;
+
+/// type definition of the state of the fixed-point estimator
+typedef struct _tagSFixedState
+{
+	int64_t x;				///< robot x (Q32.32 m)
+	int64_t y;				///< robot y (Q32.32 m)
+	bam_t q;				///< robot heading
+	bam_t nGyroAngle;		///< gyro angle
+	int32_t nPrevSteer;		///< previous steering angle (bam_t, signed)
+	int64_t nPrevTimeNs;	///< previous timestamp (ns)
+
+	/// default constructor (origin at time 0)
+	_tagSFixedState()
+	: x(0), y(0), q(0), nGyroAngle(0), nPrevSteer(0), nPrevTimeNs(0)
+	{}
+} SFixedState;
+
+///
+/// @brief		multiply a 64-bit value by a Q2.30 factor
+/// @param		a [in] value (any Q format, |a| < 2^61)
+/// @param		b [in] factor (Q2.30)
+/// @return		a * b in the Q format of a (rounded toward -infinity)
+/// @remark		split into 32-bit halves, so no 128-bit product is needed
+///
+inline int64_t FixedMulQ30(const int64_t a, const fix30_t b)
+{
+	const int64_t nHigh = a >> 32;
+	const int64_t nLow = int64_t(uint64_t(a) & 0xffffffffULL);
+
+	return nHigh * b * 4 + ((nLow * b) >> 30);
+}
+
+/// sine of a binary angle (Q2.30)
+fix30_t FixedSin(const bam_t a);
+
+/// cosine of a binary angle (Q2.30)
+inline fix30_t FixedCos(const bam_t a) { return FixedSin(a + 0x40000000U); }
+
+/// make the constants of a chassis (host)
+SFixedChassis MakeFixedChassis(const double dFrontDistPerTick, \
+	const double dDistBtwFrontRear);
+
+/// update the gyro and estimate the pose of a record
+void FixedStep(const SFixedChassis& chassis, SFixedState& state, \
+	const int64_t nTimeNs, const int32_t nSteer, const int32_t nTicks);
+
+/// convert an angle in radians to a binary angle (host)
+int32_t FixedRad2Bam(const double dRad);
+
+/// get the pose in Q16.16 meters and a binary angle
+inline void FixedGetPose(const SFixedState& state, fix16_t& x, fix16_t& y, \
+	bam_t& q)
+{
+	x = fix16_t(state.x >> 16);
+	y = fix16_t(state.y >> 16);
+	q = state.q;
+}
+
+/// get the pose in float (host)
+SPose FixedGetPose(const SFixedState& state);
+
+#endif // _FIXED_TRICYCLE_H_
@@ -0,0 +1,245 @@
+///
+/// @file		FleetTricycle.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Batch pose estimator for a fleet of Tricycle-drive vehicles
+///
+
+#include <algorithm>		// std::fill, std::max
+#include <cfloat>			// FLT_EPSILON
+
+#include "FleetTricycle.h"
+#include "Tricycle.h"		// CTricycle
+#include "SimdMath.h"		// vfloat, vSinCos, vAngleWrap, SIMD_LANES
+#include "math2.h"			// AngleClamp, AngleDiff, SinCos, almostZero
+
+/// number of vehicles per vector
+#define FLEET_LANES		SIMD_LANES
+
+
+///
+/// @brief		constructor
+/// @param		nVehicles [in] number of vehicles
+/// @return		N/A
+/// @remark		the geometry is taken from the selected chassis of CTricycle
+///
+CFleetTricycle::CFleetTricycle(const int nVehicles)
+: m_nVehicles(nVehicles > 0 ? nVehicles : 0)
+, m_nPadded((m_nVehicles + FLEET_LANES - 1) / FLEET_LANES * FLEET_LANES)
+, m_fDistBtwFrontRear(CTricycle::GetInstance()->GetDistBtwFrontRear())
+, m_fFrontDistPerTick(CTricycle::GetInstance()->GetFrontDistPerTick())
+{
+	/// keep at least one lane block so that GetX() etc. are always valid
+	const int nSize = std::max(m_nPadded, FLEET_LANES);
+
+	m_vX.resize(nSize);
+	m_vY.resize(nSize);
+	m_vQ.resize(nSize);
+	m_vPrevTimeNs.resize(nSize);
+	m_vGyroAngle.resize(nSize);
+	m_vPrevSteer.resize(nSize);
+
+	Reset();
+}
+
+///
+/// @brief		get the number of SIMD lanes used by the kernel
+/// @param		N/A
+/// @return		8 (AVX2), 4 (SSE2) or 1 (scalar fallback)
+///
+int CFleetTricycle::GetLanes()
+{
+	return FLEET_LANES;
+}
+
+///
+/// @brief		reset all vehicle states (pose, gyro, previous time)
+/// @param		N/A
+/// @return		void
+///
+void CFleetTricycle::Reset()
+{
+	std::fill(m_vX.begin(), m_vX.end(), 0.f);
+	std::fill(m_vY.begin(), m_vY.end(), 0.f);
+	std::fill(m_vQ.begin(), m_vQ.end(), 0.f);
+	std::fill(m_vPrevTimeNs.begin(), m_vPrevTimeNs.end(), 0LL);
+	std::fill(m_vGyroAngle.begin(), m_vGyroAngle.end(), 0.f);
+	std::fill(m_vPrevSteer.begin(), m_vPrevSteer.end(), 0.f);
+}
+
+///
+/// @brief		advance all vehicles by one record each
+///
+/// @param		pTimeNs [in] time of reading per vehicle (unit: ns)
+/// @param		pSteerRad [in] steering wheel angle per vehicle (unit: rad)
+/// @param		pEncoderTicks [in] encoder ticks per vehicle (unit: ticks)
+/// @param		pGyroError [in] angle error added to the virtual gyro per
+///				vehicle (noise and drift of the step, unit: rad) or 0
+///
+/// @return		void
+///
+/// @remark		Each array must hold GetSize() values. Every lane performs
+///				CVirtualGyro::Update() followed by CTricycle::Estimate() with
+///				the same operation order as the scalar code. Only sine and
+///				cosine differ (polynomial instead of SinCos()), so poses
+///				agree with the scalar path within a few ULP per step. The
+///				gyro error enters where CVirtualGyro adds its noise and drift.
+///				The vectors run the kernels of SinCosN() and AngleClampN()
+///				(vSinCos(), vAngleWrap()) in registers, without the arrays.
+///				The time differences are taken in nanoseconds, as
+///				EstimateNs(), and converted to float per lane.
+///
+void CFleetTricycle::Estimate(const long long* pTimeNs, const float* pSteerRad, \
+	const int* pEncoderTicks, const float* pGyroError)
+{
+	/// vehicles handled by full vectors read directly from the inputs
+	const int nFull = m_nVehicles / FLEET_LANES * FLEET_LANES;
+
+	/// input lanes for the last partial vector (padded with zero records)
+	long long nTailTime[FLEET_LANES] = { 0, };
+	float fTailSteer[FLEET_LANES] = { 0.f, };
+	int   nTailTicks[FLEET_LANES] = { 0, };
+	float fTailError[FLEET_LANES] = { 0.f, };
+	//@{
+	for (int i = nFull; i < m_nVehicles; ++i)
+	{
+		nTailTime[i - nFull]  = pTimeNs[i];
+		fTailSteer[i - nFull] = pSteerRad[i];
+		nTailTicks[i - nFull] = pEncoderTicks[i];
+		if (pGyroError)
+			fTailError[i - nFull] = pGyroError[i];
+	}
+	//@}
+
+	for (int i = 0; i < m_nPadded; i += FLEET_LANES)
+	{
+		const bool bTail = (i >= nFull);
+		const long long* pT = bTail ? nTailTime : pTimeNs + i;
+		const float* pS = bTail ? fTailSteer : pSteerRad + i;
+		const int*   pN = bTail ? nTailTicks : pEncoderTicks + i;
+		const float* pE = bTail ? fTailError : \
+			(pGyroError ? pGyroError + i : 0);
+
+		/// time difference since previous time (exact in nanoseconds)
+		//@{
+		float fDiffTime[FLEET_LANES];
+		for (int k = 0; k < FLEET_LANES; ++k)
+		{
+			fDiffTime[k] = float(Ns2Sec(pT[k] - m_vPrevTimeNs[i + k]));
+			m_vPrevTimeNs[i + k] = pT[k];
+		}
+		//@}
+
+#if (SIMD_ENABLED)
+		const vfloat vZero = vSet(0.f);
+		const vfloat vTwo = vSet(2.f);
+
+		vfloat s = vLoad(pS);
+		vfloat n = vInt2Float(viLoad(pN));
+		vfloat q = vLoad(&m_vQ[i]);
+		vfloat a = vLoad(&m_vGyroAngle[i]);
+		vfloat sPrev = vLoad(&m_vPrevSteer[i]);
+
+		/// almostZero() of the time difference is v < eps
+		vfloat dt = vLoad(fDiffTime);
+		vfloat bZero = vLess(dt, vSet(FLT_EPSILON));
+
+		/// distance of the front steering wheel
+		vfloat dist = vMul(n, vSet(m_fFrontDistPerTick));
+
+		/// virtual gyro: angle difference with averaged steering angle
+		//@{
+		vfloat sinSteerAvg, cosSteerAvg;
+		vSinCos(vDiv(vAdd(sPrev, s), vTwo), sinSteerAvg, cosSteerAvg);
+		vfloat da = vDiv(dist, vTwo);
+		da = vDiv(da, vSet(m_fDistBtwFrontRear));
+		da = vMul(da, sinSteerAvg);
+		if (pE)
+			da = vAdd(da, vLoad(pE));
+
+		vfloat w = vAngleWrap(vSub(vAdd(a, da), a));
+		w = vSelect(bZero, w, vDiv(w, dt));
+		a = vAngleWrap(vAdd(a, da));
+		//@}
+
+		/// front wheel velocity (m/s)
+		vfloat vel = vSelect(bZero, vZero, vDiv(dist, dt));
+
+		/// heading with the gyro angular velocity
+		q = vAngleWrap(vAdd(q, vMul(w, dt)));
+
+		/// differences of robot position (x, y)
+		//@{
+		vfloat sinSteer, cosSteer, sinQ, cosQ;
+		vSinCos(s, sinSteer, cosSteer);
+		vSinCos(q, sinQ, cosQ);
+		vfloat d = vMul(vMul(vel, dt), cosSteer);
+		vStore(&m_vX[i], vAdd(vLoad(&m_vX[i]), vMul(d, cosQ)));
+		vStore(&m_vY[i], vAdd(vLoad(&m_vY[i]), vMul(d, sinQ)));
+		//@}
+
+		/// update the states for the next time
+		vStore(&m_vQ[i], q);
+		vStore(&m_vGyroAngle[i], a);
+		vStore(&m_vPrevSteer[i], s);
+#else // (SIMD_ENABLED)
+		for (int k = 0; k < FLEET_LANES; ++k)
+		{
+			const int v = i + k;
+
+			float fFrontWheelDist = pN[k] * m_fFrontDistPerTick;
+
+			/// sine of the average and cosine of the steering angle
+			float fSinSteerAvg, fCosSteerAvg, fSinSteer, fCosSteer;
+			SinCos((m_vPrevSteer[v] + pS[k]) / 2.f, fSinSteerAvg, fCosSteerAvg);
+			SinCos(pS[k], fSinSteer, fCosSteer);
+
+			/// virtual gyro
+			//@{
+			float fDiffAngleRad = fFrontWheelDist / 2.f;
+			fDiffAngleRad /= m_fDistBtwFrontRear;
+			fDiffAngleRad *= fSinSteerAvg;
+			if (pE)
+				fDiffAngleRad += pE[k];
+
+			float fW = AngleDiff<float>(m_vGyroAngle[v], \
+				m_vGyroAngle[v] + fDiffAngleRad);
+			fW = AngleClamp(fW);
+			if (!almostZero<float>(fDiffTime[k]))
+				fW /= fDiffTime[k];
+			m_vGyroAngle[v] = AngleClamp(m_vGyroAngle[v] + fDiffAngleRad);
+			//@}
+
+			float fFrontWheelVel = 0.f;
+			if (!almostZero(fDiffTime[k]))
+				fFrontWheelVel = fFrontWheelDist / fDiffTime[k];
+
+			m_vQ[v] = AngleClamp(m_vQ[v] + fW * fDiffTime[k]);
+
+			float fSinQ, fCosQ;
+			SinCos(m_vQ[v], fSinQ, fCosQ);
+			float fDist = (fFrontWheelVel * fDiffTime[k]) * fCosSteer;
+			m_vX[v] += fDist * fCosQ;
+			m_vY[v] += fDist * fSinQ;
+
+			m_vPrevSteer[v] = pS[k];
+		}
+#endif // (SIMD_ENABLED)
+	}
+}
+
+///
+/// @brief		get the pose of a vehicle
+/// @param		nIndex [in] vehicle index [0..GetSize())
+/// @param		pose [out] robot pose (x, y, heading)
+/// @return		void
+///
+void CFleetTricycle::GetRobotPose(const int nIndex, SPose& pose) const
+{
+	if (nIndex < 0 || nIndex >= m_nVehicles)
+		return;
+
+	pose = SPose(m_vX[nIndex], m_vY[nIndex], m_vQ[nIndex]);
+}
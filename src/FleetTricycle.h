@@ -0,0 +1,86 @@
+///
+/// @file		FleetTricycle.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Batch pose estimator for a fleet of Tricycle-drive vehicles
+///
+/// @remark		Vehicle states are kept in structure-of-arrays form and all
+///				vehicles are advanced with one call using AVX2 (8 lanes) or
+///				SSE2 (4 lanes) instructions. Each lane reproduces the scalar
+///				CVirtualGyro::Update() + CTricycle::Estimate() sequence.
+///
+
+#ifndef _FLEET_TRICYCLE_H_
+#define _FLEET_TRICYCLE_H_
+
+#include <vector>		// std::vector
+
+#include "Pose.h"		// SPose
+
+/// @brief		Batch pose estimator for N Tricycle-drive vehicles
+class CFleetTricycle
+{
+public:
+	/// constructor
+	explicit CFleetTricycle(const int nVehicles);
+
+	/// destructor
+	virtual ~CFleetTricycle() {}
+
+	/// get the number of vehicles
+	int GetSize() const { return m_nVehicles; }
+
+	/// get the number of SIMD lanes used by the kernel
+	static int GetLanes();
+
+	/// reset all vehicle states (pose, gyro, previous time)
+	void Reset();
+
+	/// advance all vehicles by one record each
+	void Estimate(const long long* pTimeNs, const float* pSteerRad, \
+		const int* pEncoderTicks, const float* pGyroError = 0);
+
+	/// get the pose of a vehicle
+	void GetRobotPose(const int nIndex, SPose& pose) const;
+
+	/// get the pose arrays (x, y, heading) of all vehicles
+	//@{
+	const float* GetX() const { return &m_vX[0]; }
+	const float* GetY() const { return &m_vY[0]; }
+	const float* GetQ() const { return &m_vQ[0]; }
+	//@}
+
+private:
+	/// non construction-copyable
+	CFleetTricycle(const CFleetTricycle&);
+
+	/// non copyable
+	const CFleetTricycle& operator=(const CFleetTricycle&);
+
+private:
+	/// number of vehicles
+	const int m_nVehicles;
+
+	/// number of vehicles padded to a multiple of the SIMD lanes
+	const int m_nPadded;
+
+	/// distance from front wheel to back axis (m)
+	const float m_fDistBtwFrontRear;
+
+	/// distance per a tick of the front wheel
+	const float m_fFrontDistPerTick;
+
+	/// vehicle states (structure of arrays)
+	//@{
+	std::vector<float> m_vX;			///< position x (m)
+	std::vector<float> m_vY;			///< position y (m)
+	std::vector<float> m_vQ;			///< heading angle (rad)
+	std::vector<long long> m_vPrevTimeNs;	///< previous timestamp (ns)
+	std::vector<float> m_vGyroAngle;	///< virtual gyro angle (rad)
+	std::vector<float> m_vPrevSteer;	///< previous steering angle (rad)
+	//@}
+};
+
+#endif // _FLEET_TRICYCLE_H_
@@ -0,0 +1,95 @@
+///
+/// @file		GyroState.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		State and update of the virtual gyro as a value type and a
+///				pure function
+///
+/// @remark		The model is the one of CVirtualGyro (see VirtualGyro.cpp):
+///				the heading change is made from the encoder ticks and the
+///				average of the previous and current steering angles.
+///
+
+#ifndef _GYRO_STATE_H_
+#define _GYRO_STATE_H_
+
+#include "math2.h"			// AngleClamp, AngleDiff, SinCos, almostZero, Ns2Sec
+
+/// @brief		state of the virtual gyro (value type, see GyroStep())
+typedef struct _tagSGyroState
+{
+	float fAngVel;			///< angular velocity of the gyro (rad/s)
+	float fAngleRad;		///< gyro angle (rad)
+	long long nPrevTimeNs;	///< previous timestamp (ns)
+	float fPrevSteerRad;	///< previous steering angle (rad)
+
+	/// default constructor (at rest at time 0)
+	_tagSGyroState()
+	: fAngVel(0.f), fAngleRad(0.f), nPrevTimeNs(0), fPrevSteerRad(0.f)
+	{}
+} SGyroState;
+
+///
+/// @brief		update the state of the virtual gyro with a record
+///
+/// @param		gyro [in/out] state of the gyro
+/// @param		fFrontDistPerTick [in] distance per a tick of the front wheel
+///				(m)
+/// @param		fDistBtwFrontRear [in] distance from front wheel to back axis
+///				(m)
+/// @param		nTimeNs [in] current time (ns)
+/// @param		fSteerRad [in] steering angle of the front wheel (rad)
+/// @param		nEncoderTicks [in] encoder ticks
+/// @param		fNoiseRad [in] noise added to the angle change (rad)
+/// @param		fDriftRadPerSec [in] signed drift of the angle (rad/s, < 0: CW)
+///
+/// @return		void
+///
+/// @remark		Pure function of its arguments (no singleton, no static), so
+///				it inlines into the caller and independent states may run on
+///				any number of threads. CVirtualGyro::UpdateNs() adds the noise
+///				of its error model.
+///
+inline void GyroStep(SGyroState& gyro, const float fFrontDistPerTick, \
+	const float fDistBtwFrontRear, const long long nTimeNs, \
+	const float fSteerRad, const int nEncoderTicks, \
+	const float fNoiseRad = 0.f, const float fDriftRadPerSec = 0.f)
+{
+	/// difference since previous time (s), exact in nanoseconds
+	const float fDiffTime = float(Ns2Sec(nTimeNs - gyro.nPrevTimeNs));
+
+	/// make the gyro angle (rad) with the average steering angle
+	float fSinSteer, fCosSteer;
+	SinCos((gyro.fPrevSteerRad + fSteerRad) / 2.f, fSinSteer, fCosSteer);
+	float fDiffAngleRad = (nEncoderTicks * fFrontDistPerTick) / 2.f;
+	fDiffAngleRad /= fDistBtwFrontRear;
+	fDiffAngleRad *= fSinSteer;
+
+	/// gaussian noise and unidirectional drift over the time difference
+	//@{
+	if (fNoiseRad != 0.f)
+		fDiffAngleRad += fNoiseRad;
+	if (fDriftRadPerSec != 0.f && !almostZero<float>(fDiffTime))
+		fDiffAngleRad += fDriftRadPerSec * fDiffTime;
+	//@}
+
+	/// update the angular velocity of the gyro
+	//@{
+	gyro.fAngVel = AngleDiff<float>(gyro.fAngleRad, \
+		gyro.fAngleRad + fDiffAngleRad);
+	gyro.fAngVel = AngleClamp(gyro.fAngVel);
+	if (!almostZero<float>(fDiffTime))	///< prevent divide by zero
+		gyro.fAngVel /= fDiffTime;		///< angular velocity (rad/s)
+	//@}
+
+	/// gyro angle, clamped between [-M_PI..+M_PI)
+	gyro.fAngleRad = AngleClamp(gyro.fAngleRad + fDiffAngleRad);
+
+	/// timestamp and steering angle for the next time
+	gyro.nPrevTimeNs = nTimeNs;
+	gyro.fPrevSteerRad = fSteerRad;
+}
+
+#endif // _GYRO_STATE_H_
@@ -0,0 +1,157 @@
+///
+/// @file		MappedFile.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Read-only memory-mapped file
+///
+
+#if defined(WIN32)
+#	include <windows.h>		// CreateFileMapping, MapViewOfFile
+#else
+#	include <fcntl.h>		// open
+#	include <sys/mman.h>	// mmap, munmap, madvise
+#	include <sys/stat.h>	// fstat
+#	include <unistd.h>		// close
+#endif
+
+#include "MappedFile.h"
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CMappedFile::CMappedFile()
+: m_pData(0)
+, m_nSize(0)
+, m_bOpen(false)
+#if defined(WIN32)
+, m_hFile(INVALID_HANDLE_VALUE)
+, m_hMapping(0)
+#endif
+{
+}
+
+///
+/// @brief		destructor
+/// @param		N/A
+/// @return		N/A
+///
+CMappedFile::~CMappedFile()
+{
+	Close();
+}
+
+///
+/// @brief		map a file into memory (read-only)
+/// @param		sFilename [in] filename to map
+/// @return		0 on success, -1 if occurred error
+/// @remark		an empty file is opened successfully with GetData() == 0
+///
+int CMappedFile::Open(const std::string& sFilename)
+{
+	/// close the previous file
+	Close();
+
+#if defined(WIN32)
+	m_hFile = ::CreateFileA(sFilename.c_str(), GENERIC_READ, FILE_SHARE_READ, \
+		NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (m_hFile == INVALID_HANDLE_VALUE)
+		return -1;
+
+	LARGE_INTEGER size;
+	if (!::GetFileSizeEx(m_hFile, &size))
+	{
+		Close();
+		return -1;
+	}
+	m_nSize = size_t(size.QuadPart);
+	m_bOpen = true;
+
+	/// nothing to map for an empty file
+	if (m_nSize == 0)
+		return 0;
+
+	m_hMapping = ::CreateFileMapping(m_hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (!m_hMapping)
+	{
+		Close();
+		return -1;
+	}
+
+	m_pData = static_cast<const char*>( \
+		::MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+	if (!m_pData)
+	{
+		Close();
+		return -1;
+	}
+#else // defined(WIN32)
+	int fd = open(sFilename.c_str(), O_RDONLY);
+	if (fd == -1)
+		return -1;
+
+	struct stat st;
+	if (fstat(fd, &st) == -1)
+	{
+		close(fd);
+		return -1;
+	}
+	m_nSize = size_t(st.st_size);
+	m_bOpen = true;
+
+	/// nothing to map for an empty file
+	if (m_nSize == 0)
+	{
+		close(fd);
+		return 0;
+	}
+
+	void* p = mmap(0, m_nSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	/// the mapping stays valid after closing the descriptor
+	close(fd);
+
+	if (p == MAP_FAILED)
+	{
+		m_nSize = 0;
+		m_bOpen = false;
+		return -1;
+	}
+
+	/// the file is scanned from the beginning to the end
+	madvise(p, m_nSize, MADV_SEQUENTIAL);
+
+	m_pData = static_cast<const char*>(p);
+#endif // defined(WIN32)
+
+	return 0;
+}
+
+///
+/// @brief		unmap the file
+/// @param		N/A
+/// @return		void
+///
+void CMappedFile::Close()
+{
+#if defined(WIN32)
+	if (m_pData)
+		::UnmapViewOfFile(m_pData);
+	if (m_hMapping)
+		::CloseHandle(m_hMapping);
+	if (m_hFile != INVALID_HANDLE_VALUE)
+		::CloseHandle(m_hFile);
+	m_hMapping = 0;
+	m_hFile = INVALID_HANDLE_VALUE;
+#else // defined(WIN32)
+	if (m_pData)
+		munmap(const_cast<char*>(m_pData), m_nSize);
+#endif // defined(WIN32)
+
+	m_pData = 0;
+	m_nSize = 0;
+	m_bOpen = false;
+}
@@ -0,0 +1,67 @@
+///
+/// @file		MappedFile.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Read-only memory-mapped file
+///
+
+#ifndef _MAPPED_FILE_H_
+#define _MAPPED_FILE_H_
+
+#include <cstddef>		// size_t
+#include <string>		// std::string
+
+/// @brief		Read-only memory-mapped file
+class CMappedFile
+{
+public:
+	/// constructor
+	explicit CMappedFile();
+
+	/// destructor
+	virtual ~CMappedFile();
+
+	/// map a file into memory
+	int Open(const std::string& sFilename);
+
+	/// unmap the file
+	void Close();
+
+	/// get the first byte of the mapped file (0 if empty or not opened)
+	const char* GetData() const { return m_pData; }
+
+	/// get the size of the mapped file (bytes)
+	size_t GetSize() const { return m_nSize; }
+
+	/// check whether a file is opened
+	bool IsOpen() const { return m_bOpen; }
+
+private:
+	/// non construction-copyable
+	CMappedFile(const CMappedFile&);
+
+	/// non copyable
+	const CMappedFile& operator=(const CMappedFile&);
+
+private:
+	/// first byte of the mapped file
+	const char* m_pData;
+
+	/// size of the mapped file (bytes)
+	size_t m_nSize;
+
+	/// whether a file is opened
+	bool m_bOpen;
+
+#if defined(WIN32)
+	/// file handle
+	void* m_hFile;
+
+	/// file mapping handle
+	void* m_hMapping;
+#endif // defined(WIN32)
+};
+
+#endif // _MAPPED_FILE_H_
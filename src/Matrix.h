@@ -0,0 +1,173 @@
+///
+/// @file		Matrix.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Fixed-size matrix template for small filters (stack only)
+///
+/// @remark		Dimensions are template arguments, so a matrix is a plain
+///				array of R x C elements without any heap allocation and all
+///				loops have compile-time trip counts. Intended for the small
+///				matrices of the EKF (up to about 8 x 8).
+///
+
+#ifndef _MATRIX_H_
+#define _MATRIX_H_
+
+#include <cmath>		// fabs
+
+/// @brief		Fixed-size R x C matrix (value type, copyable)
+template<int R, int C, typename T = float>
+class TMatrix
+{
+public:
+	/// constructor (elements are not initialized)
+	TMatrix() {}
+
+	/// get the zero matrix
+	static TMatrix Zero()
+	{
+		TMatrix a;
+		for (int r = 0; r < R; ++r)
+			for (int c = 0; c < C; ++c)
+				a.m_a[r][c] = T(0);
+		return a;
+	}
+
+	/// get the identity matrix
+	static TMatrix Identity()
+	{
+		TMatrix a = Zero();
+		for (int i = 0; i < R && i < C; ++i)
+			a.m_a[i][i] = T(1);
+		return a;
+	}
+
+	/// access an element
+	//@{
+	T& operator()(const int r, const int c) { return m_a[r][c]; }
+	const T& operator()(const int r, const int c) const { return m_a[r][c]; }
+	//@}
+
+	/// element-wise sum
+	TMatrix operator+(const TMatrix& b) const
+	{
+		TMatrix a;
+		for (int r = 0; r < R; ++r)
+			for (int c = 0; c < C; ++c)
+				a.m_a[r][c] = m_a[r][c] + b.m_a[r][c];
+		return a;
+	}
+
+	/// element-wise difference
+	TMatrix operator-(const TMatrix& b) const
+	{
+		TMatrix a;
+		for (int r = 0; r < R; ++r)
+			for (int c = 0; c < C; ++c)
+				a.m_a[r][c] = m_a[r][c] - b.m_a[r][c];
+		return a;
+	}
+
+	/// scale
+	TMatrix operator*(const T s) const
+	{
+		TMatrix a;
+		for (int r = 0; r < R; ++r)
+			for (int c = 0; c < C; ++c)
+				a.m_a[r][c] = m_a[r][c] * s;
+		return a;
+	}
+
+	/// matrix product (R x C) * (C x K)
+	template<int K>
+	TMatrix<R, K, T> operator*(const TMatrix<C, K, T>& b) const
+	{
+		TMatrix<R, K, T> a;
+		for (int r = 0; r < R; ++r)
+		{
+			for (int k = 0; k < K; ++k)
+			{
+				T sum = T(0);
+				for (int c = 0; c < C; ++c)
+					sum += m_a[r][c] * b(c, k);
+				a(r, k) = sum;
+			}
+		}
+		return a;
+	}
+
+	/// transpose
+	TMatrix<C, R, T> Transpose() const
+	{
+		TMatrix<C, R, T> a;
+		for (int r = 0; r < R; ++r)
+			for (int c = 0; c < C; ++c)
+				a(c, r) = m_a[r][c];
+		return a;
+	}
+
+private:
+	/// elements (row major)
+	T m_a[R][C];
+};
+
+///
+/// @brief		invert a square matrix (Gauss-Jordan with partial pivoting)
+/// @param		a [in] matrix to invert
+/// @param		inv [out] inverse matrix
+/// @return		0 on success, -1 if the matrix is singular
+///
+template<int N, typename T>
+int Inverse(const TMatrix<N, N, T>& a, TMatrix<N, N, T>& inv)
+{
+	TMatrix<N, N, T> w = a;
+
+	inv = TMatrix<N, N, T>::Identity();
+
+	for (int c = 0; c < N; ++c)
+	{
+		/// pivot: the largest element of the column
+		int p = c;
+		for (int r = c + 1; r < N; ++r)
+			if (fabs(w(r, c)) > fabs(w(p, c)))
+				p = r;
+		if (w(p, c) == T(0))
+			return -1;
+
+		/// swap the rows
+		if (p != c)
+		{
+			for (int k = 0; k < N; ++k)
+			{
+				T t = w(c, k); w(c, k) = w(p, k); w(p, k) = t;
+				t = inv(c, k); inv(c, k) = inv(p, k); inv(p, k) = t;
+			}
+		}
+
+		/// normalize the pivot row and eliminate the column
+		const T s = T(1) / w(c, c);
+		for (int k = 0; k < N; ++k)
+		{
+			w(c, k) *= s;
+			inv(c, k) *= s;
+		}
+		for (int r = 0; r < N; ++r)
+		{
+			if (r == c)
+				continue;
+
+			const T f = w(r, c);
+			for (int k = 0; k < N; ++k)
+			{
+				w(r, k) -= f * w(c, k);
+				inv(r, k) -= f * inv(c, k);
+			}
+		}
+	}
+
+	return 0;
+}
+
+#endif // _MATRIX_H_
@@ -0,0 +1,258 @@
+///
+/// @file		MonteCarlo.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Monte Carlo pose uncertainty of noisy virtual gyro replays
+///
+
+#include <algorithm>		// std::fill, std::max, std::min
+#include <cmath>			// sqrt, atan2
+#include <thread>			// std::thread::hardware_concurrency
+
+#include "MonteCarlo.h"
+#include "FleetTricycle.h"	// CFleetTricycle
+#include "ParallelFor.h"	// ParallelFor
+#include "Random.h"			// CRandom
+#include "math2.h"			// AngleClamp, AngleClampN, almostZero
+
+///
+/// @brief		constructor
+/// @param		model [in] error model of the virtual gyro
+/// @param		nRuns [in] number of realizations (K)
+/// @param		nThreads [in] number of worker threads (<= 0: hardware threads)
+/// @return		N/A
+///
+CMonteCarlo::CMonteCarlo(const SGyroErrorModel& model, const int nRuns, \
+	const int nThreads)
+: m_model(model)
+, m_nRuns(nRuns > 0 ? nRuns : 0)
+, m_nThreads(nThreads)
+{
+	if (m_nThreads <= 0)
+		m_nThreads = int(std::thread::hardware_concurrency());
+	if (m_nThreads <= 0)
+		m_nThreads = 1;
+}
+
+///
+/// @brief		replay a batch of realizations and add their moments
+///
+/// @param		pRecord [in] records (shared by all threads, read only)
+/// @param		nRecords [in] number of records
+/// @param		nBatch [in] batch index
+/// @param		pSum [in/out] moments of the thread (nRecords entries)
+///
+/// @return		void
+///
+/// @remark		The gyro error of a step is the drift of the time difference
+///				plus gaussian noise, as CVirtualGyro::Update() adds them.
+///				Batch b draws its noise from a generator seeded with
+///				nSeed + b, so the result does not depend on the threads.
+///
+void CMonteCarlo::RunBatch(const SRecord* pRecord, const size_t nRecords, \
+	const size_t nBatch, SMoments* pSum) const
+{
+	const int nSize = std::min(MC_BATCH_SIZE, \
+		m_nRuns - int(nBatch) * MC_BATCH_SIZE);
+
+	/// realizations of the batch and their noise
+	CFleetTricycle fleet(nSize);
+	CRandom random(m_model.nSeed + nBatch);
+
+	/// inputs of all lanes (the same record) and gyro errors
+	//@{
+	std::vector<long long> vTimeNs(nSize);
+	std::vector<float> vSteer(nSize);
+	std::vector<int>   vTicks(nSize);
+	std::vector<float> vError(nSize);
+	//@}
+
+	/// heading deviations of the lanes
+	std::vector<float> vDiffQ(nSize);
+
+	long long nPrevTimeNs = 0;
+
+	for (size_t i = 0; i < nRecords; ++i)
+	{
+		const SRecord& r = pRecord[i];
+
+		std::fill(vTimeNs.begin(), vTimeNs.end(), r.time_ns);
+		std::fill(vSteer.begin(), vSteer.end(), r.steering_angle);
+		std::fill(vTicks.begin(), vTicks.end(), r.encoder_ticks);
+
+		/// gyro error: drift (same for all lanes) and noise
+		//@{
+		const float fDiffTime = float(Ns2Sec(r.time_ns - nPrevTimeNs));
+		float fDrift = 0.f;
+		if (m_model.bApplyDrift && !almostZero<float>(fDiffTime))
+			fDrift = (m_model.nDriftDir ? -1.f : 1.f) \
+				* m_model.fDriftRadPerSec * fDiffTime;
+		nPrevTimeNs = r.time_ns;
+
+		if (m_model.bApplyNoise)
+			random.FillGaussian(&vError[0], nSize, fDrift, \
+				m_model.fNoiseStdev);
+		else
+			std::fill(vError.begin(), vError.end(), fDrift);
+		//@}
+
+		fleet.Estimate(&vTimeNs[0], &vSteer[0], &vTicks[0], &vError[0]);
+
+		/// moments of the deviations from the reference
+		//@{
+		const float* pX = fleet.GetX();
+		const float* pY = fleet.GetY();
+		const float* pQ = fleet.GetQ();
+		const SPose& ref = m_vRef[i];
+		SMoments m;
+
+		/// shortest heading differences, wrapped as one array
+		for (int k = 0; k < nSize; ++k)
+			vDiffQ[k] = pQ[k] - ref.q;
+		AngleClampN(&vDiffQ[0], &vDiffQ[0], size_t(nSize));
+
+		for (int k = 0; k < nSize; ++k)
+		{
+			const double dx = double(pX[k]) - double(ref.x);
+			const double dy = double(pY[k]) - double(ref.y);
+			const double dq = double(vDiffQ[k]);
+
+			m.x += dx;
+			m.y += dy;
+			m.q += dq;
+			m.xx += dx * dx;
+			m.xy += dx * dy;
+			m.xq += dx * dq;
+			m.yy += dy * dy;
+			m.yq += dy * dq;
+			m.qq += dq * dq;
+		}
+
+		SMoments& s = pSum[i];
+		s.x += m.x;
+		s.y += m.y;
+		s.q += m.q;
+		s.xx += m.xx;
+		s.xy += m.xy;
+		s.xq += m.xq;
+		s.yy += m.yy;
+		s.yq += m.yq;
+		s.qq += m.qq;
+		//@}
+	}
+}
+
+///
+/// @brief		replay the records through all realizations
+///
+/// @param		pRecord [in] records
+/// @param		nRecords [in] number of records
+///
+/// @return		0 on success, -1 if occurred error
+///
+/// @remark		Deviations are taken from a noiseless reference run of the
+///				same kernel, in double, so that the sums do not cancel. The
+///				heading deviation is the shortest angle difference. Thread t
+///				takes the batches t, t + T, ... and the thread sums are merged
+///				in order, so a run is repeatable for a number of threads.
+///
+int CMonteCarlo::Run(const SRecord* pRecord, const size_t nRecords)
+{
+	if (!pRecord || !nRecords || m_nRuns <= 0)
+		return -1;
+
+	/// 1. noiseless reference
+	//@{
+	m_vRef.resize(nRecords);
+	{
+		CFleetTricycle ref(1);
+		for (size_t i = 0; i < nRecords; ++i)
+		{
+			const SRecord& r = pRecord[i];
+			ref.Estimate(&r.time_ns, &r.steering_angle, &r.encoder_ticks);
+			ref.GetRobotPose(0, m_vRef[i]);
+		}
+	}
+	//@}
+
+	/// 2. realizations, batches spread over the threads
+	//@{
+	const size_t nBatches = (size_t(m_nRuns) + MC_BATCH_SIZE - 1) \
+		/ MC_BATCH_SIZE;
+	const size_t nThreads = std::min(size_t(m_nThreads), nBatches);
+	std::vector<SMoments> vSum(nThreads * nRecords);
+
+	ParallelFor(int(nThreads), nThreads, [&](const size_t t)
+	{
+		for (size_t b = t; b < nBatches; b += nThreads)
+			RunBatch(pRecord, nRecords, b, &vSum[t * nRecords]);
+	});
+	//@}
+
+	/// 3. mean and (sample) covariance after each record
+	//@{
+	const double n = double(m_nRuns);
+	const double nDof = (m_nRuns > 1) ? double(m_nRuns - 1) : 1.;
+
+	m_vMean.resize(nRecords);
+	m_vCov.resize(nRecords);
+	for (size_t i = 0; i < nRecords; ++i)
+	{
+		SMoments s = vSum[i];
+		for (size_t t = 1; t < nThreads; ++t)
+		{
+			const SMoments& u = vSum[t * nRecords + i];
+			s.x += u.x;
+			s.y += u.y;
+			s.q += u.q;
+			s.xx += u.xx;
+			s.xy += u.xy;
+			s.xq += u.xq;
+			s.yy += u.yy;
+			s.yq += u.yq;
+			s.qq += u.qq;
+		}
+
+		const double mx = s.x / n;
+		const double my = s.y / n;
+		const double mq = s.q / n;
+		const SPose& ref = m_vRef[i];
+
+		m_vMean[i] = SPose(float(ref.x + mx), float(ref.y + my), \
+			AngleClamp(float(ref.q + mq)));
+
+		SPoseCov& c = m_vCov[i];
+		c.xx = float((s.xx - n * mx * mx) / nDof);
+		c.xy = float((s.xy - n * mx * my) / nDof);
+		c.xq = float((s.xq - n * mx * mq) / nDof);
+		c.yy = float((s.yy - n * my * my) / nDof);
+		c.yq = float((s.yq - n * my * mq) / nDof);
+		c.qq = float((s.qq - n * mq * mq) / nDof);
+	}
+	//@}
+
+	return 0;
+}
+
+///
+/// @brief		get the 1-sigma error ellipse of the position
+/// @param		cov [in] pose covariance
+/// @param		fMajor [out] semi-major axis (m)
+/// @param		fMinor [out] semi-minor axis (m)
+/// @param		fAngle [out] angle of the major axis from the x axis (rad)
+/// @return		void
+/// @remark		eigen decomposition of the 2 x 2 position covariance
+///
+void CMonteCarlo::GetErrorEllipse(const SPoseCov& cov, float& fMajor, \
+	float& fMinor, float& fAngle)
+{
+	const double m = 0.5 * (double(cov.xx) + double(cov.yy));
+	const double h = 0.5 * (double(cov.xx) - double(cov.yy));
+	const double d = sqrt(h * h + double(cov.xy) * double(cov.xy));
+
+	fMajor = float(sqrt(std::max(m + d, 0.)));
+	fMinor = float(sqrt(std::max(m - d, 0.)));
+	fAngle = float(0.5 * atan2(2. * double(cov.xy), 2. * h));
+}
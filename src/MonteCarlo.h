@@ -0,0 +1,107 @@
+///
+/// @file		MonteCarlo.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Monte Carlo pose uncertainty of noisy virtual gyro replays
+///
+/// @remark		Replays one record array through K realizations of the
+///				virtual gyro error model (SGyroErrorModel) and keeps only the
+///				per-record mean pose and covariance. Realizations run as the
+///				SIMD lanes of CFleetTricycle, batches of them on all cores.
+///				Each thread accumulates the moments of its batches, so the
+///				memory is O(records x threads) whatever K is.
+///
+
+#ifndef _MONTE_CARLO_H_
+#define _MONTE_CARLO_H_
+
+#include <cstddef>			// size_t
+#include <vector>			// std::vector
+
+#include "Pose.h"			// SPose, SPoseCov
+#include "Record.h"			// SRecord
+#include "VirtualGyro.h"	// SGyroErrorModel
+
+/// number of realizations per batch (a fleet, a noise generator)
+#define MC_BATCH_SIZE		(256)
+
+/// @brief		Monte Carlo pose uncertainty of noisy virtual gyro replays
+class CMonteCarlo
+{
+public:
+	/// constructor (nThreads <= 0: number of hardware threads)
+	explicit CMonteCarlo(const SGyroErrorModel& model, const int nRuns, \
+		const int nThreads = 0);
+
+	/// destructor
+	virtual ~CMonteCarlo() {}
+
+	/// get the number of realizations
+	int GetRuns() const { return m_nRuns; }
+
+	/// get the number of worker threads
+	int GetThreads() const { return m_nThreads; }
+
+	/// replay the records through all realizations
+	int Run(const SRecord* pRecord, const size_t nRecords);
+
+	/// get the number of records of the last Run()
+	size_t GetSize() const { return m_vMean.size(); }
+
+	/// get the mean pose and the covariance after a record
+	//@{
+	const SPose& GetMean(const size_t i) const { return m_vMean[i]; }
+	const SPoseCov& GetCovariance(const size_t i) const { return m_vCov[i]; }
+	//@}
+
+	/// get the 1-sigma error ellipse of the position
+	static void GetErrorEllipse(const SPoseCov& cov, float& fMajor, \
+		float& fMinor, float& fAngle);
+
+private:
+	/// type definition of the sums of the deviations from the reference
+	typedef struct _tagSMoments
+	{
+		double x, y, q;				///< sums of the deviations
+		double xx, xy, xq, yy, yq, qq;	///< sums of the products
+
+		/// default constructor
+		_tagSMoments()
+		: x(0.), y(0.), q(0.), xx(0.), xy(0.), xq(0.), yy(0.), yq(0.), qq(0.)
+		{}
+	} SMoments;
+
+	/// replay a batch of realizations and add their moments
+	void RunBatch(const SRecord* pRecord, const size_t nRecords, \
+		const size_t nBatch, SMoments* pSum) const;
+
+private:
+	/// non construction-copyable
+	CMonteCarlo(const CMonteCarlo&);
+
+	/// non copyable
+	const CMonteCarlo& operator=(const CMonteCarlo&);
+
+private:
+	/// error model of the virtual gyro (seed of batch b: nSeed + b)
+	SGyroErrorModel m_model;
+
+	/// number of realizations
+	int m_nRuns;
+
+	/// number of worker threads
+	int m_nThreads;
+
+	/// noiseless reference pose after each record
+	std::vector<SPose> m_vRef;
+
+	/// mean pose and covariance after each record
+	//@{
+	std::vector<SPose> m_vMean;
+	std::vector<SPoseCov> m_vCov;
+	//@}
+};
+
+#endif // _MONTE_CARLO_H_
@@ -0,0 +1,82 @@
+///
+/// @file		OdometryProtocol.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Binary protocol of the local odometry service (Unix domain
+///				socket)
+///
+/// @remark		A client sends fixed-size request frames and receives one
+///				response frame per request, in order (native little-endian
+///				byte order, no framing beyond the fixed sizes). A connection
+///				carries up to ODOM_MAX_STREAMS vehicle streams, each with its
+///				own estimator state and virtual gyro:
+///
+///				ODOM_REQ_OPEN     (re)open a stream; encoder_ticks holds the
+///				                  chassis index (bits 0..7) and the
+///				                  integrator (bits 8..15); the response
+///				                  holds the initial pose
+///				ODOM_REQ_ESTIMATE one input record; the response holds the
+///				                  estimated pose
+///				ODOM_REQ_CLOSE    close a stream
+///
+///				A client may send many requests before reading the responses;
+///				requests that arrive together are estimated in one pass.
+///
+
+#ifndef _ODOMETRY_PROTOCOL_H_
+#define _ODOMETRY_PROTOCOL_H_
+
+#include <cstdint>			// uint16_t, uint32_t, int64_t
+
+/// default path of the socket
+#define ODOM_DEFAULT_SOCKET		"/tmp/tricycle.sock"
+
+/// maximum number of streams per connection
+#define ODOM_MAX_STREAMS		(256)
+
+/// types of a request (SOdomRequest::type)
+enum EOdomRequest
+{
+	ODOM_REQ_OPEN = 1,		///< open a stream
+	ODOM_REQ_ESTIMATE,		///< estimate the pose of a record
+	ODOM_REQ_CLOSE,			///< close a stream
+};
+
+/// status of a response (SOdomResponse::status)
+enum EOdomStatus
+{
+	ODOM_OK = 0,			///< success
+	ODOM_ERR_STREAM = -1,	///< stream out of range or not opened
+	ODOM_ERR_TYPE = -2,		///< unknown request type
+	ODOM_ERR_ARG = -3,		///< unknown chassis or integrator
+};
+
+/// type definition of a request frame (24 bytes)
+typedef struct _tagSOdomRequest
+{
+	uint16_t type;				///< EOdomRequest
+	uint16_t stream;			///< stream of the connection
+	uint32_t seq;				///< echoed in the response
+	int64_t  time_ns;			///< time of reading (ns)
+	float    steering_angle;	///< steering wheel angle (rad)
+	int32_t  encoder_ticks;		///< ticks (OPEN: chassis | integrator << 8)
+} SOdomRequest;
+
+/// type definition of a response frame (24 bytes)
+typedef struct _tagSOdomResponse
+{
+	uint16_t type;				///< type of the request
+	uint16_t stream;			///< stream of the request
+	uint32_t seq;				///< sequence number of the request
+	int32_t  status;			///< EOdomStatus
+	float    x;					///< robot x (m)
+	float    y;					///< robot y (m)
+	float    q;					///< robot heading (rad)
+} SOdomResponse;
+
+static_assert(sizeof(SOdomRequest) == 24, "SOdomRequest must be 24 bytes");
+static_assert(sizeof(SOdomResponse) == 24, "SOdomResponse must be 24 bytes");
+
+#endif // _ODOMETRY_PROTOCOL_H_
@@ -0,0 +1,758 @@
+///
+/// @file		OdometryServer.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Local odometry service: many vehicle streams per process over
+///				a Unix domain socket (server and client)
+///
+
+#include <chrono>			// std::chrono::steady_clock
+#include <cstdio>			// fprintf
+#include <cstring>			// memcpy, memset, strncpy
+
+#if !defined(WIN32)
+#	include <errno.h>		// errno, EAGAIN, EINTR
+#	include <signal.h>		// sigset_t, sigprocmask
+#	include <sys/socket.h>	// socket, bind, listen, accept, send, recv
+#	include <sys/un.h>		// sockaddr_un
+#	include <unistd.h>		// close, unlink, read
+#endif
+
+#if defined(__linux__)
+#	include <sys/epoll.h>	// epoll_create1, epoll_ctl, epoll_wait
+#	include <sys/signalfd.h>	// signalfd, signalfd_siginfo
+#endif
+
+#include "OdometryServer.h"
+
+///
+/// @brief		get the time of the steady clock
+/// @param		N/A
+/// @return		time (ns)
+///
+static inline long long NowNs()
+{
+	return (long long)std::chrono::duration_cast<std::chrono::nanoseconds>( \
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+///
+/// @brief		reset the statistics
+/// @param		N/A
+/// @return		void
+///
+void SOdomLatency::Reset()
+{
+	nCount = 0;
+	nSumNs = 0;
+	nMaxNs = 0;
+	memset(nBucket, 0, sizeof(nBucket));
+}
+
+///
+/// @brief		add a latency
+/// @param		nNs [in] latency (ns)
+/// @return		void
+///
+void SOdomLatency::Add(const long long nNs)
+{
+	int nBucketIdx = 0;
+	while (nBucketIdx < ODOM_LATENCY_BUCKETS - 1 && (nNs >> nBucketIdx))
+		++nBucketIdx;
+
+	++nCount;
+	nSumNs += nNs;
+	if (nNs > nMaxNs)
+		nMaxNs = nNs;
+	++nBucket[nBucketIdx];
+}
+
+///
+/// @brief		get a percentile of the latencies
+/// @param		dPercent [in] percentile (0..100)
+/// @return		upper bound of the bucket of the percentile (ns), at most the
+///				largest latency
+///
+long long SOdomLatency::GetPercentileNs(const double dPercent) const
+{
+	const double dRank = nCount * dPercent / 100.;
+	long long nSum = 0;
+
+	for (int i = 0; i < ODOM_LATENCY_BUCKETS; ++i)
+	{
+		nSum += nBucket[i];
+		if (nSum >= dRank && nSum > 0)
+		{
+			const long long nUpper = (1LL << i);
+			return (nUpper < nMaxNs) ? nUpper : nMaxNs;
+		}
+	}
+
+	return nMaxNs;
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+COdometryServer::COdometryServer()
+: m_nListenFd(-1)
+, m_nEpollFd(-1)
+, m_nSignalFd(-1)
+, m_nNextId(1)
+{
+}
+
+///
+/// @brief		destructor (closes the clients and removes the socket)
+/// @param		N/A
+/// @return		N/A
+///
+COdometryServer::~COdometryServer()
+{
+	Cleanup();
+}
+
+#if defined(__linux__)
+
+///
+/// @brief		serve a socket until SIGINT or SIGTERM
+///
+/// @param		sPath [in] path of the socket (replaced if it exists)
+///
+/// @return		0 on success (stopped by a signal), -1 if occurred error
+///
+/// @remark		Single-threaded: the estimation of a batch is a few hundred
+///				nanoseconds per request, far below the cost of the system
+///				calls it replaces.
+///
+int COdometryServer::Run(const std::string& sPath)
+{
+	Cleanup();
+
+	/// address of the socket
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (sPath.size() >= sizeof(addr.sun_path))
+	{
+		fprintf(stderr, "Socket path too long: %s\n", sPath.c_str());
+		return -1;
+	}
+	strncpy(addr.sun_path, sPath.c_str(), sizeof(addr.sun_path) - 1);
+
+	/// listening socket
+	//@{
+	m_nListenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+	if (m_nListenFd < 0)
+	{
+		fprintf(stderr, "Cannot create the socket\n");
+		return -1;
+	}
+
+	unlink(sPath.c_str());
+	if (bind(m_nListenFd, (struct sockaddr*)&addr, sizeof(addr)) != 0 || \
+		listen(m_nListenFd, SOMAXCONN) != 0)
+	{
+		fprintf(stderr, "Cannot listen on %s\n", sPath.c_str());
+		Cleanup();
+		return -1;
+	}
+	m_sPath = sPath;
+	//@}
+
+	/// SIGINT and SIGTERM as a file descriptor
+	//@{
+	sigset_t mask;
+	sigemptyset(&mask);
+	sigaddset(&mask, SIGINT);
+	sigaddset(&mask, SIGTERM);
+	sigprocmask(SIG_BLOCK, &mask, 0);
+	m_nSignalFd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+	//@}
+
+	/// epoll set of the listening socket and the signals
+	//@{
+	m_nEpollFd = epoll_create1(EPOLL_CLOEXEC);
+	if (m_nEpollFd < 0 || m_nSignalFd < 0)
+	{
+		fprintf(stderr, "Cannot create the epoll set\n");
+		Cleanup();
+		return -1;
+	}
+
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = EPOLLIN;
+	ev.data.ptr = &m_nListenFd;
+	epoll_ctl(m_nEpollFd, EPOLL_CTL_ADD, m_nListenFd, &ev);
+	ev.data.ptr = &m_nSignalFd;
+	epoll_ctl(m_nEpollFd, EPOLL_CTL_ADD, m_nSignalFd, &ev);
+	//@}
+
+	fprintf(stderr, "Serving odometry on %s\n", m_sPath.c_str());
+
+	struct epoll_event events[ODOM_MAX_EVENTS];
+	long long nReportNs = NowNs() + ODOM_STATS_INTERVAL_SEC * 1000000000LL;
+	bool bStop = false;
+
+	while (!bStop)
+	{
+		const int nEvents = epoll_wait(m_nEpollFd, events, ODOM_MAX_EVENTS, \
+			1000);
+		if (nEvents < 0 && errno != EINTR)
+		{
+			fprintf(stderr, "epoll_wait failed\n");
+			break;
+		}
+
+		const long long nNowNs = NowNs();
+		m_vBatch.clear();
+		m_vDirty.clear();
+
+		/// collect the frames of all ready clients
+		for (int i = 0; i < nEvents; ++i)
+		{
+			void* p = events[i].data.ptr;
+
+			if (p == &m_nListenFd)
+			{
+				Accept();
+				continue;
+			}
+
+			if (p == &m_nSignalFd)
+			{
+				struct signalfd_siginfo info;
+				while (read(m_nSignalFd, &info, sizeof(info)) > 0)
+					bStop = true;
+				continue;
+			}
+
+			SOdomClient* pClient = static_cast<SOdomClient*>(p);
+
+			/// responses sent: read the client again
+			if ((events[i].events & EPOLLOUT) && Flush(pClient) < 0)
+				pClient->bHungUp = true;
+
+			if (!pClient->bHungUp && (events[i].events & \
+				(EPOLLIN | EPOLLHUP | EPOLLERR)) && \
+				pClient->nOutPos == pClient->vOut.size() && \
+				Receive(pClient, nNowNs) < 0)
+				pClient->bHungUp = true;
+		}
+
+		/// one estimation pass over the batch, then one send per client
+		//@{
+		Process();
+
+		for (size_t i = 0; i < m_vDirty.size(); ++i)
+		{
+			SOdomClient* pClient = m_vDirty[i];
+			if (pClient->bHungUp)
+				pClient->nFlushNs = NowNs();
+			else if (Flush(pClient) < 0)
+				pClient->bHungUp = true;
+		}
+
+		for (size_t i = 0; i < m_vBatch.size(); ++i)
+		{
+			SOdomClient* pClient = m_vBatch[i].pClient;
+			const long long nNs = pClient->nFlushNs - m_vBatch[i].nRecvNs;
+			pClient->latency.Add(nNs);
+			pClient->interval.Add(nNs);
+		}
+		//@}
+
+		/// close the clients that hung up or failed
+		for (size_t i = 0; i < m_vClient.size(); )
+		{
+			if (m_vClient[i]->bHungUp)
+				Disconnect(m_vClient[i]);
+			else
+				++i;
+		}
+
+		/// periodic latency report
+		if (nNowNs >= nReportNs)
+		{
+			for (size_t i = 0; i < m_vClient.size(); ++i)
+			{
+				if (m_vClient[i]->interval.nCount)
+					Report(m_vClient[i], m_vClient[i]->interval, "last");
+				m_vClient[i]->interval.Reset();
+			}
+			nReportNs = nNowNs + ODOM_STATS_INTERVAL_SEC * 1000000000LL;
+		}
+	}
+
+	Cleanup();
+
+	return 0;
+}
+
+///
+/// @brief		accept the pending connections
+/// @param		N/A
+/// @return		void
+///
+void COdometryServer::Accept()
+{
+	for (;;)
+	{
+		const int fd = accept4(m_nListenFd, 0, 0, SOCK_NONBLOCK | SOCK_CLOEXEC);
+		if (fd < 0)
+			return;
+
+		SOdomClient* pClient = new SOdomClient;
+		pClient->fd = fd;
+		pClient->nId = m_nNextId++;
+		pClient->nOutPos = 0;
+		pClient->nFlushNs = 0;
+		pClient->bHungUp = false;
+		memset(pClient->pStream, 0, sizeof(pClient->pStream));
+
+		struct epoll_event ev;
+		memset(&ev, 0, sizeof(ev));
+		ev.events = EPOLLIN;
+		ev.data.ptr = pClient;
+		if (epoll_ctl(m_nEpollFd, EPOLL_CTL_ADD, fd, &ev) != 0)
+		{
+			close(fd);
+			delete pClient;
+			continue;
+		}
+
+		m_vClient.push_back(pClient);
+	}
+}
+
+///
+/// @brief		read the frames of a client into the batch
+/// @param		pClient [in] client
+/// @param		nNowNs [in] time of the wakeup (ns)
+/// @return		0 on success, -1 if the client hung up or failed
+///
+int COdometryServer::Receive(SOdomClient* pClient, const long long nNowNs)
+{
+	/// read what is available (at most ODOM_READ_MAX bytes)
+	//@{
+	int rc = 0;
+	size_t nRead = 0;
+	while (nRead < ODOM_READ_MAX)
+	{
+		const size_t nOld = pClient->vIn.size();
+		pClient->vIn.resize(nOld + 16 * 1024);
+		const ssize_t n = recv(pClient->fd, &pClient->vIn[nOld], \
+			pClient->vIn.size() - nOld, 0);
+		pClient->vIn.resize(nOld + ((n > 0) ? size_t(n) : 0));
+
+		if (n > 0)
+		{
+			nRead += size_t(n);
+			continue;
+		}
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))
+			rc = -1;
+		break;
+	}
+	//@}
+
+	/// complete frames into the batch
+	//@{
+	const size_t nFrames = pClient->vIn.size() / sizeof(SOdomRequest);
+	for (size_t i = 0; i < nFrames; ++i)
+	{
+		SOdomJob job;
+		job.pClient = pClient;
+		memcpy(&job.request, &pClient->vIn[i * sizeof(SOdomRequest)], \
+			sizeof(SOdomRequest));
+		job.nRecvNs = nNowNs;
+		m_vBatch.push_back(job);
+	}
+	pClient->vIn.erase(pClient->vIn.begin(), \
+		pClient->vIn.begin() + nFrames * sizeof(SOdomRequest));
+	//@}
+
+	return rc;
+}
+
+///
+/// @brief		send the queued responses of a client
+/// @param		pClient [in] client
+/// @return		0 on success (all sent, or the rest waits for EPOLLOUT), -1 if
+///				occurred error
+/// @remark		Reading the client stops while responses are queued.
+///
+int COdometryServer::Flush(SOdomClient* pClient)
+{
+	while (pClient->nOutPos < pClient->vOut.size())
+	{
+		const ssize_t n = send(pClient->fd, &pClient->vOut[pClient->nOutPos], \
+			pClient->vOut.size() - pClient->nOutPos, MSG_NOSIGNAL);
+		if (n > 0)
+		{
+			pClient->nOutPos += size_t(n);
+			continue;
+		}
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			break;
+		return -1;
+	}
+	pClient->nFlushNs = NowNs();
+
+	/// wait for EPOLLOUT (partial) or EPOLLIN (all sent)
+	//@{
+	const bool bPending = pClient->nOutPos < pClient->vOut.size();
+	if (!bPending)
+	{
+		pClient->vOut.clear();
+		pClient->nOutPos = 0;
+	}
+
+	struct epoll_event ev;
+	memset(&ev, 0, sizeof(ev));
+	ev.events = bPending ? EPOLLOUT : EPOLLIN;
+	ev.data.ptr = pClient;
+	if (epoll_ctl(m_nEpollFd, EPOLL_CTL_MOD, pClient->fd, &ev) != 0)
+		return -1;
+	//@}
+
+	return 0;
+}
+
+#else
+
+///
+/// @brief		serve a socket (not available on this platform)
+/// @param		sPath [in] path of the socket
+/// @return		-1
+///
+int COdometryServer::Run(const std::string& sPath)
+{
+	(void)sPath;
+	fprintf(stderr, "The odometry server needs Linux (epoll)\n");
+	return -1;
+}
+
+void COdometryServer::Accept() {}
+
+int COdometryServer::Receive(SOdomClient*, const long long) { return -1; }
+
+int COdometryServer::Flush(SOdomClient*) { return -1; }
+
+#endif // defined(__linux__)
+
+///
+/// @brief		estimate the batch and queue the responses
+/// @param		N/A
+/// @return		void
+/// @remark		Requests are handled in arrival order, so the records of a
+///				stream are estimated in order.
+///
+void COdometryServer::Process()
+{
+	for (size_t i = 0; i < m_vBatch.size(); ++i)
+	{
+		SOdomClient* pClient = m_vBatch[i].pClient;
+		SOdomResponse response;
+
+		Handle(pClient, m_vBatch[i].request, response);
+
+		if (pClient->vOut.empty())
+			m_vDirty.push_back(pClient);
+
+		const size_t nOld = pClient->vOut.size();
+		pClient->vOut.resize(nOld + sizeof(response));
+		memcpy(&pClient->vOut[nOld], &response, sizeof(response));
+	}
+}
+
+///
+/// @brief		handle a request of a client
+/// @param		pClient [in] client
+/// @param		request [in] request frame
+/// @param		response [out] response frame
+/// @return		void
+///
+void COdometryServer::Handle(SOdomClient* pClient, \
+	const SOdomRequest& request, SOdomResponse& response)
+{
+	response.type = request.type;
+	response.stream = request.stream;
+	response.seq = request.seq;
+	response.status = ODOM_OK;
+	response.x = response.y = response.q = 0.f;
+
+	if (request.stream >= ODOM_MAX_STREAMS)
+	{
+		response.status = ODOM_ERR_STREAM;
+		return;
+	}
+
+	SOdomStream*& pStream = pClient->pStream[request.stream];
+
+	switch (request.type)
+	{
+	case ODOM_REQ_OPEN:
+	{
+		const int nChassis = request.encoder_ticks & 0xff;
+		const int nIntegrator = (request.encoder_ticks >> 8) & 0xff;
+		if (nChassis >= CTricycle::GetChassisCount() || \
+			nIntegrator >= INTEGRATOR_COUNT)
+		{
+			response.status = ODOM_ERR_ARG;
+			return;
+		}
+
+		delete pStream;
+		pStream = new SOdomStream;
+		pStream->pChassis = &CTricycle::GetChassisAt(nChassis);
+		pStream->nIntegrator = nIntegrator;
+
+		/// error model of the process, seeded per stream
+		SGyroErrorModel gyroModel = CVirtualGyro::GetInstance()->GetErrorModel();
+		gyroModel.nSeed += request.stream;
+		pStream->gyro.SetErrorModel(gyroModel);
+		pStream->gyro.SetChassis(pStream->pChassis);
+		break;
+	}
+
+	case ODOM_REQ_ESTIMATE:
+		if (!pStream)
+		{
+			response.status = ODOM_ERR_STREAM;
+			return;
+		}
+		pStream->gyro.UpdateNs(request.time_ns, request.steering_angle, \
+			request.encoder_ticks);
+		pStream->pChassis->pfnEstimateBy[pStream->nIntegrator](pStream->state, \
+			request.time_ns, request.steering_angle, request.encoder_ticks, \
+			pStream->gyro.GetAngVel());
+		break;
+
+	case ODOM_REQ_CLOSE:
+		if (!pStream)
+		{
+			response.status = ODOM_ERR_STREAM;
+			return;
+		}
+		delete pStream;
+		pStream = 0;
+		return;
+
+	default:
+		response.status = ODOM_ERR_TYPE;
+		return;
+	}
+
+	response.x = pStream->state.pose.x;
+	response.y = pStream->state.pose.y;
+	response.q = pStream->state.pose.q;
+}
+
+///
+/// @brief		close a client and report its latency
+/// @param		pClient [in] client (deleted)
+/// @return		void
+///
+void COdometryServer::Disconnect(SOdomClient* pClient)
+{
+	if (pClient->latency.nCount)
+		Report(pClient, pClient->latency, "total");
+
+	for (size_t i = 0; i < m_vClient.size(); ++i)
+	{
+		if (m_vClient[i] == pClient)
+		{
+			m_vClient.erase(m_vClient.begin() + i);
+			break;
+		}
+	}
+
+#if !defined(WIN32)
+	close(pClient->fd);
+#endif
+
+	for (int i = 0; i < ODOM_MAX_STREAMS; ++i)
+		delete pClient->pStream[i];
+	delete pClient;
+}
+
+///
+/// @brief		print the latency of a client
+/// @param		pClient [in] client
+/// @param		latency [in] statistics
+/// @param		szWhen [in] "total" or "last" (periodic report)
+/// @return		void
+///
+void COdometryServer::Report(const SOdomClient* pClient, \
+	const SOdomLatency& latency, const char* szWhen) const
+{
+	fprintf(stderr, "client %d (%s): %lld requests, latency mean %.1f us, " \
+		"p99 <= %.1f us, max %.1f us\n", pClient->nId, szWhen, latency.nCount, \
+		latency.nCount ? latency.nSumNs / 1e3 / latency.nCount : 0., \
+		latency.GetPercentileNs(99.) / 1e3, latency.nMaxNs / 1e3);
+}
+
+///
+/// @brief		release the resources of Run()
+/// @param		N/A
+/// @return		void
+///
+void COdometryServer::Cleanup()
+{
+	while (!m_vClient.empty())
+		Disconnect(m_vClient.back());
+
+#if !defined(WIN32)
+	if (m_nEpollFd >= 0)
+		close(m_nEpollFd);
+	if (m_nSignalFd >= 0)
+		close(m_nSignalFd);
+	if (m_nListenFd >= 0)
+		close(m_nListenFd);
+	if (!m_sPath.empty())
+		unlink(m_sPath.c_str());
+#endif
+
+	m_nEpollFd = -1;
+	m_nSignalFd = -1;
+	m_nListenFd = -1;
+	m_sPath.clear();
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+COdometryClient::COdometryClient()
+: m_fd(-1)
+{
+}
+
+///
+/// @brief		destructor (closes the connection)
+/// @param		N/A
+/// @return		N/A
+///
+COdometryClient::~COdometryClient()
+{
+	Close();
+}
+
+///
+/// @brief		connect to a server
+/// @param		sPath [in] path of the socket
+/// @return		0 on success, -1 if occurred error
+///
+int COdometryClient::Connect(const std::string& sPath)
+{
+	Close();
+
+#if defined(WIN32)
+	(void)sPath;
+	return -1;
+#else
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (sPath.size() >= sizeof(addr.sun_path))
+		return -1;
+	strncpy(addr.sun_path, sPath.c_str(), sizeof(addr.sun_path) - 1);
+
+	m_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (m_fd < 0)
+		return -1;
+
+	if (connect(m_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0)
+	{
+		Close();
+		return -1;
+	}
+
+	return 0;
+#endif
+}
+
+///
+/// @brief		close the connection
+/// @param		N/A
+/// @return		void
+///
+void COdometryClient::Close()
+{
+#if !defined(WIN32)
+	if (m_fd >= 0)
+		close(m_fd);
+#endif
+	m_fd = -1;
+}
+
+///
+/// @brief		send requests
+/// @param		pRequest [in] requests
+/// @param		nCount [in] number of requests
+/// @return		0 on success, -1 if occurred error
+///
+int COdometryClient::Send(const SOdomRequest* pRequest, const size_t nCount)
+{
+#if defined(WIN32)
+	(void)pRequest; (void)nCount;
+	return -1;
+#else
+	const char* p = reinterpret_cast<const char*>(pRequest);
+	size_t nLeft = nCount * sizeof(SOdomRequest);
+
+	while (nLeft > 0)
+	{
+		const ssize_t n = send(m_fd, p, nLeft, MSG_NOSIGNAL);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+		p += n;
+		nLeft -= size_t(n);
+	}
+
+	return 0;
+#endif
+}
+
+///
+/// @brief		receive responses (blocks until nCount are received)
+/// @param		pResponse [out] responses
+/// @param		nCount [in] number of responses
+/// @return		0 on success, -1 if occurred error (or the server closed)
+///
+int COdometryClient::Receive(SOdomResponse* pResponse, const size_t nCount)
+{
+#if defined(WIN32)
+	(void)pResponse; (void)nCount;
+	return -1;
+#else
+	char* p = reinterpret_cast<char*>(pResponse);
+	size_t nLeft = nCount * sizeof(SOdomResponse);
+
+	while (nLeft > 0)
+	{
+		const ssize_t n = recv(m_fd, p, nLeft, 0);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return -1;
+		p += n;
+		nLeft -= size_t(n);
+	}
+
+	return 0;
+#endif
+}
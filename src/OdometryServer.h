@@ -0,0 +1,211 @@
+///
+/// @file		OdometryServer.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Local odometry service: many vehicle streams per process over
+///				a Unix domain socket (server and client)
+///
+/// @remark		The server waits on one epoll set for the listening socket,
+///				the clients and SIGINT/SIGTERM (signalfd). At each wakeup it
+///				reads every ready client, collects all complete request frames
+///				(OdometryProtocol.h) into one batch, estimates the batch in one
+///				pass and then writes the responses with one send() per client.
+///				A client whose responses cannot be sent is not read until they
+///				are (back-pressure instead of unbounded buffers).
+///
+///				Each stream owns its estimator state (STricycleState), chassis,
+///				integrator and virtual gyro, so the CTricycle and CVirtualGyro
+///				singletons are only read for the defaults (gyro error model).
+///
+///				The latency of a request is measured from the read of its frame
+///				to the send of its response, and reported per client (count,
+///				mean, p99, max) on stderr when the client disconnects and every
+///				ODOM_STATS_INTERVAL_SEC seconds. The server runs on Linux only
+///				(Run() fails elsewhere); the client on any POSIX system.
+///
+
+#ifndef _ODOMETRY_SERVER_H_
+#define _ODOMETRY_SERVER_H_
+
+#include <string>			// std::string
+#include <vector>			// std::vector
+
+#include "OdometryProtocol.h"	// SOdomRequest, SOdomResponse
+#include "Tricycle.h"		// STricycleChassis, STricycleState
+#include "VirtualGyro.h"	// CVirtualGyro
+
+/// maximum number of events per epoll wakeup
+#define ODOM_MAX_EVENTS			(64)
+
+/// maximum number of bytes read from a client per wakeup (fairness)
+#define ODOM_READ_MAX			(64 * 1024)
+
+/// interval of the periodic latency report (sec)
+#define ODOM_STATS_INTERVAL_SEC	(10)
+
+/// number of buckets of the latency histogram (log2 of ns)
+#define ODOM_LATENCY_BUCKETS	(40)
+
+/// type definition of a vehicle stream
+typedef struct _tagSOdomStream
+{
+	/// chassis of the vehicle
+	const STricycleChassis* pChassis;
+
+	/// pose integrator (EIntegrator)
+	int nIntegrator;
+
+	/// estimator state
+	STricycleState state;
+
+	/// virtual gyro of the vehicle
+	CVirtualGyro gyro;
+} SOdomStream;
+
+/// type definition of the latency statistics of a client
+typedef struct _tagSOdomLatency
+{
+	long long nCount;		///< number of requests
+	long long nSumNs;		///< sum of the latencies (ns)
+	long long nMaxNs;		///< largest latency (ns)
+	long long nBucket[ODOM_LATENCY_BUCKETS];	///< [i]: < 2^i ns
+
+	_tagSOdomLatency() { Reset(); }
+	void Reset();
+	void Add(const long long nNs);
+	long long GetPercentileNs(const double dPercent) const;
+} SOdomLatency;
+
+/// type definition of a connected client
+typedef struct _tagSOdomClient
+{
+	int fd;						///< socket
+	int nId;					///< number of the connection (for reports)
+	std::vector<char> vIn;		///< received bytes (partial frame at the end)
+	std::vector<char> vOut;		///< responses not sent yet
+	size_t nOutPos;				///< sent bytes of vOut
+	long long nFlushNs;			///< time of the last send (steady clock, ns)
+	bool bHungUp;				///< closed after the current wakeup
+	SOdomStream* pStream[ODOM_MAX_STREAMS];	///< streams (0: not opened)
+	SOdomLatency latency;		///< since the connection
+	SOdomLatency interval;		///< since the last periodic report
+} SOdomClient;
+
+/// type definition of a request of a batch
+typedef struct _tagSOdomJob
+{
+	SOdomClient* pClient;		///< client of the request
+	SOdomRequest request;		///< request frame
+	long long nRecvNs;			///< time of the read of the frame (ns)
+} SOdomJob;
+
+/// @brief		Odometry server (one process per host)
+class COdometryServer
+{
+public:
+	/// constructor
+	explicit COdometryServer();
+
+	/// destructor (closes the clients and removes the socket)
+	virtual ~COdometryServer();
+
+	/// serve a socket until SIGINT or SIGTERM
+	int Run(const std::string& sPath = ODOM_DEFAULT_SOCKET);
+
+private:
+	/// accept the pending connections
+	void Accept();
+
+	/// read the frames of a client into the batch
+	int Receive(SOdomClient* pClient, const long long nNowNs);
+
+	/// estimate the batch and queue the responses
+	void Process();
+
+	/// handle a request of a client
+	void Handle(SOdomClient* pClient, const SOdomRequest& request, \
+		SOdomResponse& response);
+
+	/// send the queued responses of a client
+	int Flush(SOdomClient* pClient);
+
+	/// close a client and report its latency
+	void Disconnect(SOdomClient* pClient);
+
+	/// print the latency of a client
+	void Report(const SOdomClient* pClient, const SOdomLatency& latency, \
+		const char* szWhen) const;
+
+	/// release the resources of Run()
+	void Cleanup();
+
+private:
+	/// non construction-copyable
+	COdometryServer(const COdometryServer&);
+
+	/// non copyable
+	const COdometryServer& operator=(const COdometryServer&);
+
+private:
+	/// path of the socket
+	std::string m_sPath;
+
+	/// listening socket (-1 if not opened)
+	int m_nListenFd;
+
+	/// epoll set (-1 if not created)
+	int m_nEpollFd;
+
+	/// SIGINT/SIGTERM (-1 if not created)
+	int m_nSignalFd;
+
+	/// connected clients
+	std::vector<SOdomClient*> m_vClient;
+
+	/// requests of the current wakeup
+	std::vector<SOdomJob> m_vBatch;
+
+	/// clients with queued responses in the current wakeup
+	std::vector<SOdomClient*> m_vDirty;
+
+	/// number of the next connection
+	int m_nNextId;
+};
+
+/// @brief		Odometry client (blocking)
+class COdometryClient
+{
+public:
+	/// constructor
+	explicit COdometryClient();
+
+	/// destructor (closes the connection)
+	virtual ~COdometryClient();
+
+	/// connect to a server
+	int Connect(const std::string& sPath = ODOM_DEFAULT_SOCKET);
+
+	/// close the connection
+	void Close();
+
+	/// send requests
+	int Send(const SOdomRequest* pRequest, const size_t nCount);
+
+	/// receive responses (blocks until nCount are received)
+	int Receive(SOdomResponse* pResponse, const size_t nCount);
+
+private:
+	/// non construction-copyable
+	COdometryClient(const COdometryClient&);
+
+	/// non copyable
+	const COdometryClient& operator=(const COdometryClient&);
+
+private:
+	/// socket (-1 if not connected)
+	int m_fd;
+};
+
+#endif // _ODOMETRY_SERVER_H_
@@ -0,0 +1,49 @@
+///
+/// @file		ParallelFor.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Minimal parallel loop over task indices on std::thread
+///
+
+#ifndef _PARALLEL_FOR_H_
+#define _PARALLEL_FOR_H_
+
+#include <atomic>		// std::atomic
+#include <cstddef>		// size_t
+#include <thread>		// std::thread
+#include <vector>		// std::vector
+
+///
+/// @brief		run a task for each index [0..nTasks) on worker threads
+/// @param		nThreads [in] number of threads (the caller included)
+/// @param		nTasks [in] number of tasks
+/// @param		task [in] callable with a task index
+/// @return		void
+/// @remark		tasks are taken from a shared counter (dynamic scheduling)
+///
+template<typename F>
+void ParallelFor(const int nThreads, const size_t nTasks, F task)
+{
+	std::atomic<size_t> nNext(0);
+
+	/// worker: take the next task until none is left
+	auto worker = [&]()
+	{
+		for (size_t i = nNext++; i < nTasks; i = nNext++)
+			task(i);
+	};
+
+	std::vector<std::thread> vThread;
+	for (int i = 1; i < nThreads && size_t(i) < nTasks; ++i)
+		vThread.push_back(std::thread(worker));
+
+	/// the calling thread works too
+	worker();
+
+	for (size_t i = 0; i < vThread.size(); ++i)
+		vThread[i].join();
+}
+
+#endif // _PARALLEL_FOR_H_
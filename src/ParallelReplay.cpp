@@ -0,0 +1,254 @@
+///
+/// @file		ParallelReplay.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Offline replay of a record array on all cores (prefix scan)
+///
+
+#include <algorithm>		// std::min
+#include <thread>			// std::thread
+
+#include "ParallelReplay.h"
+#include "ParallelFor.h"		// ParallelFor
+#include "Tricycle.h"		// CTricycle
+#include "math2.h"			// AngleClamp, SinCos, SinCosN, almostZero
+
+///
+/// @brief		constructor
+/// @param		nThreads [in] number of worker threads (<= 0: hardware threads)
+/// @return		N/A
+/// @remark		the geometry is taken from the selected chassis of CTricycle
+///
+CParallelReplay::CParallelReplay(const int nThreads)
+: m_nThreads(nThreads)
+, m_fDistBtwFrontRear(CTricycle::GetInstance()->GetDistBtwFrontRear())
+, m_fFrontDistPerTick(CTricycle::GetInstance()->GetFrontDistPerTick())
+{
+	if (m_nThreads <= 0)
+		m_nThreads = int(std::thread::hardware_concurrency());
+	if (m_nThreads <= 0)
+		m_nThreads = 1;
+}
+
+///
+/// @brief		integrate a chunk of records from a start pose
+///
+/// @param		pRecord [in] all records
+/// @param		nBegin [in] first record of the chunk
+/// @param		nEnd [in] end of the chunk (exclusive)
+/// @param		start [in] pose before the first record of the chunk
+/// @param		pPose [out] pose after each record (heading clamped)
+/// @param		end [out] pose after the last record (heading not clamped)
+///
+/// @return		void
+///
+/// @remark		The previous time and steering angle come from the record
+///				before the chunk, so chunks are independent of each other.
+///				The sine of the averaged steering angle and the cosine of the
+///				steering angle do not depend on the pose, so they are computed
+///				per block of records with SinCosN() (absolute error below
+///				8e-8 against sinf and cosf).
+///
+void CParallelReplay::IntegrateChunk(const SRecord* pRecord, \
+	const size_t nBegin, const size_t nEnd, const SChunkPose& start, \
+	SPose* pPose, SChunkPose& end) const
+{
+	/// previous timestamp (zero before the first record)
+	long long nPrevTimeNs = nBegin ? pRecord[nBegin - 1].time_ns : 0;
+
+	double x = start.x;
+	double y = start.y;
+	double q = start.q;
+
+	/// steering angles of a block and their sine/cosine
+	//@{
+	float fSteerAvg[REPLAY_TRIG_BLOCK];
+	float fSteer[REPLAY_TRIG_BLOCK];
+	float fSinSteerAvg[REPLAY_TRIG_BLOCK];
+	float fCosSteer[REPLAY_TRIG_BLOCK];
+	float fUnused[REPLAY_TRIG_BLOCK];
+	//@}
+
+	for (size_t b = nBegin; b < nEnd; b += REPLAY_TRIG_BLOCK)
+	{
+		const size_t n = std::min<size_t>(REPLAY_TRIG_BLOCK, nEnd - b);
+
+		for (size_t k = 0; k < n; ++k)
+		{
+			const float fPrev = (b + k) ? pRecord[b + k - 1].steering_angle \
+				: 0.f;
+
+			fSteer[k] = pRecord[b + k].steering_angle;
+			fSteerAvg[k] = (fPrev + fSteer[k]) / 2.f;
+		}
+		SinCosN(fSteerAvg, fSinSteerAvg, fUnused, n);
+		SinCosN(fSteer, fUnused, fCosSteer, n);
+
+		for (size_t k = 0; k < n; ++k)
+		{
+			const size_t i = b + k;
+			const SRecord& r = pRecord[i];
+
+			/// time difference and distance of the front wheel
+			float fDiffTime = float(Ns2Sec(r.time_ns - nPrevTimeNs));
+			float fFrontWheelDist = r.encoder_ticks * m_fFrontDistPerTick;
+
+			/// virtual gyro angular velocity (CVirtualGyro::Update)
+			//@{
+			float fDiffAngleRad = fFrontWheelDist / 2.f;
+			fDiffAngleRad /= m_fDistBtwFrontRear;
+			fDiffAngleRad *= fSinSteerAvg[k];
+
+			float fW = AngleClamp(fDiffAngleRad);
+			if (!almostZero<float>(fDiffTime))
+				fW /= fDiffTime;
+			//@}
+
+			/// front wheel velocity (m/s)
+			float fFrontWheelVel = 0.f;
+			if (!almostZero(fDiffTime))
+				fFrontWheelVel = fFrontWheelDist / fDiffTime;
+
+			/// heading first, then move along the new heading (Estimate)
+			//@{
+			q += double(fW * fDiffTime);
+
+			const double d = double((fFrontWheelVel * fDiffTime) \
+				* fCosSteer[k]);
+			double sq, cq;
+			SinCos(q, sq, cq);
+			x += d * cq;
+			y += d * sq;
+			//@}
+
+			pPose[i] = SPose(float(x), float(y), float(AngleClamp(q)));
+
+			nPrevTimeNs = r.time_ns;
+		}
+	}
+
+	end.x = x;
+	end.y = y;
+	end.q = q;
+}
+
+///
+/// @brief		rotate and translate the local poses of a chunk
+/// @param		pPose [in/out] poses (local frame -> global frame)
+/// @param		nBegin [in] first pose of the chunk
+/// @param		nEnd [in] end of the chunk (exclusive)
+/// @param		start [in] global pose of the chunk origin
+/// @return		void
+///
+void CParallelReplay::TransformChunk(SPose* pPose, const size_t nBegin, \
+	const size_t nEnd, const SChunkPose& start)
+{
+	double s, c;
+	SinCos(start.q, s, c);
+
+	for (size_t i = nBegin; i < nEnd; ++i)
+	{
+		const double lx = pPose[i].x;
+		const double ly = pPose[i].y;
+
+		pPose[i].x = float(start.x + c * lx - s * ly);
+		pPose[i].y = float(start.y + s * lx + c * ly);
+		pPose[i].q = float(AngleClamp(start.q + pPose[i].q));
+	}
+}
+
+///
+/// @brief		estimate the pose after each record in parallel
+///
+/// @param		pRecord [in] records
+/// @param		nRecords [in] number of records
+/// @param		pPose [out] pose after each record (nRecords poses)
+/// @param		poseInit [in] pose before the first record
+///
+/// @return		0 on success, -1 if occurred error
+///
+/// @remark		Local poses are stored as float relative to the chunk start,
+///				so their rounding is bounded by the extent of one chunk.
+///				Against RunSequential() the poses agree within one or two
+///				float ULPs (5e-4 m at 8 km, 2.4e-7 rad on 5M records).
+///
+int CParallelReplay::Run(const SRecord* pRecord, const size_t nRecords, \
+	SPose* pPose, const SPose& poseInit)
+{
+	if (!nRecords)
+		return 0;
+	if (!pRecord || !pPose)
+		return -1;
+
+	const size_t nChunks = (nRecords + REPLAY_CHUNK_SIZE - 1) / REPLAY_CHUNK_SIZE;
+	m_vChunkEnd.resize(nChunks);
+	m_vChunkStart.resize(nChunks);
+
+	/// 1. integrate each chunk in its local frame
+	ParallelFor(m_nThreads, nChunks, [&](const size_t c)
+	{
+		const SChunkPose zero = { 0., 0., 0. };
+		const size_t nBegin = c * REPLAY_CHUNK_SIZE;
+		const size_t nEnd = std::min(nRecords, nBegin + REPLAY_CHUNK_SIZE);
+
+		IntegrateChunk(pRecord, nBegin, nEnd, zero, pPose, m_vChunkEnd[c]);
+	});
+
+	/// 2. compose the chunk start poses (sequential over chunks only)
+	//@{
+	m_vChunkStart[0].x = poseInit.x;
+	m_vChunkStart[0].y = poseInit.y;
+	m_vChunkStart[0].q = poseInit.q;
+	for (size_t c = 0; c + 1 < nChunks; ++c)
+	{
+		const SChunkPose& s = m_vChunkStart[c];
+		const SChunkPose& e = m_vChunkEnd[c];
+		SChunkPose& next = m_vChunkStart[c + 1];
+
+		double sq, cq;
+		SinCos(s.q, sq, cq);
+
+		next.x = s.x + cq * e.x - sq * e.y;
+		next.y = s.y + sq * e.x + cq * e.y;
+		next.q = AngleClamp(s.q + e.q);
+	}
+	//@}
+
+	/// 3. move each chunk to its global start pose
+	ParallelFor(m_nThreads, nChunks, [&](const size_t c)
+	{
+		const size_t nBegin = c * REPLAY_CHUNK_SIZE;
+		const size_t nEnd = std::min(nRecords, nBegin + REPLAY_CHUNK_SIZE);
+
+		TransformChunk(pPose, nBegin, nEnd, m_vChunkStart[c]);
+	});
+
+	return 0;
+}
+
+///
+/// @brief		estimate the pose after each record on one thread
+/// @param		pRecord [in] records
+/// @param		nRecords [in] number of records
+/// @param		pPose [out] pose after each record (nRecords poses)
+/// @param		poseInit [in] pose before the first record
+/// @return		0 on success, -1 if occurred error
+/// @remark		reference of Run(): same increments, one running sum
+///
+int CParallelReplay::RunSequential(const SRecord* pRecord, \
+	const size_t nRecords, SPose* pPose, const SPose& poseInit) const
+{
+	if (!nRecords)
+		return 0;
+	if (!pRecord || !pPose)
+		return -1;
+
+	SChunkPose start = { poseInit.x, poseInit.y, poseInit.q };
+	SChunkPose end;
+
+	IntegrateChunk(pRecord, 0, nRecords, start, pPose, end);
+
+	return 0;
+}
@@ -0,0 +1,103 @@
+///
+/// @file		ParallelReplay.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Offline replay of a record array on all cores (prefix scan)
+///
+/// @remark		The heading is a running sum of the gyro increments and the
+///				position a running sum of rotated displacements, so poses can
+///				be integrated per chunk and composed afterwards:
+///
+///				1. each chunk is integrated from the pose (0, 0, 0) in
+///				   parallel, and its local poses and end pose are stored
+///				2. the chunk start poses are composed sequentially
+///				   (P[c+1] = P[c] + R(P[c].q) * end[c])
+///				3. the local poses of each chunk are rotated and translated
+///				   by the chunk start pose in parallel
+///
+///				Per-record increments use the same float operations as
+///				CVirtualGyro::Update() + CTricycle::Estimate(); the sums are
+///				accumulated in double.
+///
+
+#ifndef _PARALLEL_REPLAY_H_
+#define _PARALLEL_REPLAY_H_
+
+#include <cstddef>		// size_t
+#include <vector>		// std::vector
+
+#include "Pose.h"		// SPose
+#include "Record.h"		// SRecord
+
+/// number of records per chunk
+#define REPLAY_CHUNK_SIZE	(16384)
+
+/// number of records whose sine/cosine are computed at once (SinCosN)
+#define REPLAY_TRIG_BLOCK	(256)
+
+/// @brief		Offline replay of a record array on all cores
+class CParallelReplay
+{
+public:
+	/// constructor (nThreads <= 0: number of hardware threads)
+	explicit CParallelReplay(const int nThreads = 0);
+
+	/// destructor
+	virtual ~CParallelReplay() {}
+
+	/// get the number of worker threads
+	int GetThreads() const { return m_nThreads; }
+
+	/// estimate the pose after each record in parallel
+	int Run(const SRecord* pRecord, const size_t nRecords, SPose* pPose, \
+		const SPose& poseInit = SPose());
+
+	/// estimate the pose after each record on one thread (reference)
+	int RunSequential(const SRecord* pRecord, const size_t nRecords, \
+		SPose* pPose, const SPose& poseInit = SPose()) const;
+
+private:
+	/// type definition of the end pose of a chunk in its local frame
+	typedef struct _tagSChunkPose
+	{
+		double x;	///< position x (unit: m)
+		double y;	///< position y (unit: m)
+		double q;	///< heading angle, not clamped (unit: rad)
+	} SChunkPose;
+
+	/// integrate a chunk from a start pose
+	void IntegrateChunk(const SRecord* pRecord, const size_t nBegin, \
+		const size_t nEnd, const SChunkPose& start, SPose* pPose, \
+		SChunkPose& end) const;
+
+	/// rotate and translate the local poses of a chunk
+	static void TransformChunk(SPose* pPose, const size_t nBegin, \
+		const size_t nEnd, const SChunkPose& start);
+
+private:
+	/// non construction-copyable
+	CParallelReplay(const CParallelReplay&);
+
+	/// non copyable
+	const CParallelReplay& operator=(const CParallelReplay&);
+
+private:
+	/// number of worker threads
+	int m_nThreads;
+
+	/// distance from front wheel to back axis (m)
+	const float m_fDistBtwFrontRear;
+
+	/// distance per a tick of the front wheel
+	const float m_fFrontDistPerTick;
+
+	/// end pose of each chunk in its local frame
+	std::vector<SChunkPose> m_vChunkEnd;
+
+	/// start pose of each chunk in the global frame
+	std::vector<SChunkPose> m_vChunkStart;
+};
+
+#endif // _PARALLEL_REPLAY_H_
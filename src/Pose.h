@@ -24,19 +24,40 @@ typedef struct _tagSPos
 		: x(fX), y(fY) {}
 } SPos;
 
-/// type definition to represent the 2D pose of the robot
-typedef struct _tagSPose
+/// @brief		2D pose of the robot over a scalar type (float or double)
+template<typename T>
+struct TPose
 {
-	float x;	///< position x (unit: m)
-	float y;	///< position y (unit: m)
-	float q;	///< heading angle (unit: rad)
+	T x;	///< position x (unit: m)
+	T y;	///< position y (unit: m)
+	T q;	///< heading angle (unit: rad)
 
 	/// default constructor
-	_tagSPose() : x(0.f), y(0.f), q(0.f) {}
+	TPose() : x(T(0)), y(T(0)), q(T(0)) {}
 
 	/// constructor
-	_tagSPose(const float fX, const float fY, const float fQ)
+	TPose(const T fX, const T fY, const T fQ)
 	: x(fX), y(fY), q(fQ) {}
-} SPose;
+};
+
+/// type definition to represent the 2D pose of the robot
+typedef TPose<float> SPose;
+
+/// type definition to represent the 2D pose of the robot in double
+typedef TPose<double> SPoseD;
+
+/// type definition to represent the covariance of SPose (symmetric 3 x 3)
+typedef struct _tagSPoseCov
+{
+	float xx;	///< variance of x (unit: m^2)
+	float xy;	///< covariance of x and y (unit: m^2)
+	float xq;	///< covariance of x and heading (unit: m rad)
+	float yy;	///< variance of y (unit: m^2)
+	float yq;	///< covariance of y and heading (unit: m rad)
+	float qq;	///< variance of heading (unit: rad^2)
+
+	/// default constructor
+	_tagSPoseCov() : xx(0.f), xy(0.f), xq(0.f), yy(0.f), yq(0.f), qq(0.f) {}
+} SPoseCov;
 
 #endif // _POSE_H_
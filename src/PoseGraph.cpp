@@ -0,0 +1,573 @@
+///
+/// @file		PoseGraph.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Pose-graph back end: odometry, loop-closure and absolute
+///				constraints solved by Gauss-Newton (sparse block Cholesky)
+///
+
+#include <cmath>			// sin, cos, sqrt, fabs, floor
+#include <algorithm>		// std::min, std::max, std::sort, std::lower_bound
+#include <utility>			// std::pair
+
+#include "PoseGraph.h"
+#include "math2.h"			// AngleClamp
+
+///
+/// @brief		compute the error and the Jacobians of an edge
+/// @param		edge [in] constraint
+/// @param		vPose [in] poses of the nodes
+/// @param		e [out] error (x, y, heading)
+/// @param		pA [out] Jacobian by node i (NULL: not computed)
+/// @param		pB [out] Jacobian by node j (NULL: not computed)
+/// @return		void
+/// @remark		relative: e = (R_i^T (t_j - t_i), q_j - q_i) - z;
+///				absolute: e = (t_i, q_i) - z
+///
+static void Linearize(const SPoseGraphEdge& edge, \
+	const std::vector<SPoseD>& vPose, TPoseVector& e, TPoseBlock* pA = NULL, \
+	TPoseBlock* pB = NULL)
+{
+	const SPoseD& pi = vPose[edge.i];
+
+	if (edge.j == POSE_GRAPH_ABSOLUTE)
+	{
+		e(0, 0) = pi.x - edge.z.x;
+		e(1, 0) = pi.y - edge.z.y;
+		e(2, 0) = AngleClamp<double>(pi.q - edge.z.q);
+		if (pA)
+			*pA = TPoseBlock::Identity();
+		return;
+	}
+
+	const SPoseD& pj = vPose[edge.j];
+	const double c = cos(pi.q);
+	const double s = sin(pi.q);
+	const double dx = pj.x - pi.x;
+	const double dy = pj.y - pi.y;
+
+	e(0, 0) = +c * dx + s * dy - edge.z.x;
+	e(1, 0) = -s * dx + c * dy - edge.z.y;
+	e(2, 0) = AngleClamp<double>(pj.q - pi.q - edge.z.q);
+
+	if (pA)
+	{
+		TPoseBlock& A = *pA;
+		A(0, 0) = -c; A(0, 1) = -s; A(0, 2) = -s * dx + c * dy;
+		A(1, 0) = +s; A(1, 1) = -c; A(1, 2) = -c * dx - s * dy;
+		A(2, 0) = 0.; A(2, 1) = 0.; A(2, 2) = -1.;
+	}
+	if (pB)
+	{
+		TPoseBlock& B = *pB;
+		B(0, 0) = +c; B(0, 1) = +s; B(0, 2) = 0.;
+		B(1, 0) = -s; B(1, 1) = +c; B(1, 2) = 0.;
+		B(2, 0) = 0.; B(2, 1) = 0.; B(2, 2) = 1.;
+	}
+}
+
+///
+/// @brief		factor a symmetric 3 x 3 block and invert the factor
+/// @param		D [in] symmetric positive definite block
+/// @param		Linv [out] inverse of the lower Cholesky factor L (D = L L^T)
+/// @return		0 on success, -1 if D is not positive definite
+///
+static int CholeskyInverse(const TPoseBlock& D, TPoseBlock& Linv)
+{
+	double d;
+
+	if ((d = D(0, 0)) <= 0.)
+		return -1;
+	const double l00 = sqrt(d);
+	const double l10 = D(1, 0) / l00;
+	const double l20 = D(2, 0) / l00;
+	if ((d = D(1, 1) - l10 * l10) <= 0.)
+		return -1;
+	const double l11 = sqrt(d);
+	const double l21 = (D(2, 1) - l20 * l10) / l11;
+	if ((d = D(2, 2) - l20 * l20 - l21 * l21) <= 0.)
+		return -1;
+	const double l22 = sqrt(d);
+
+	Linv(0, 0) = 1. / l00;
+	Linv(1, 1) = 1. / l11;
+	Linv(2, 2) = 1. / l22;
+	Linv(1, 0) = -l10 * Linv(0, 0) * Linv(1, 1);
+	Linv(2, 1) = -l21 * Linv(1, 1) * Linv(2, 2);
+	Linv(2, 0) = -(l20 * Linv(0, 0) + l21 * Linv(1, 0)) * Linv(2, 2);
+	Linv(0, 1) = Linv(0, 2) = Linv(1, 2) = 0.;
+
+	return 0;
+}
+
+///
+/// @brief		scale the rows of a Jacobian by a diagonal information
+/// @param		info [in] information of x, y and heading
+/// @param		J [in] Jacobian
+/// @return		Omega * J
+///
+static TPoseBlock Weight(const double info[3], const TPoseBlock& J)
+{
+	TPoseBlock W;
+	for (int r = 0; r < 3; ++r)
+		for (int c = 0; c < 3; ++c)
+			W(r, c) = info[r] * J(r, c);
+	return W;
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CPoseGraph::CPoseGraph()
+{
+	Clear();
+}
+
+///
+/// @brief		drop all nodes and edges
+/// @param		N/A
+/// @return		void
+///
+void CPoseGraph::Clear()
+{
+	m_vPose.clear();
+	m_vLin.clear();
+	m_vEdge.clear();
+	m_vReach.clear();
+	m_vFirst.clear();
+	m_vOffset.assign(1, 0);
+	m_vBlock.clear();
+	m_vRhs.clear();
+	m_vDelta.clear();
+	m_nAbsolute = 0;
+	m_bGauge = false;
+	m_gauge = SPoseD();
+	m_nFactored = 0;
+	m_nLinearized = 0;
+	m_nLastRows = 0;
+}
+
+///
+/// @brief		add a node with its initial estimate
+/// @param		pose [in] initial estimate (x, y, heading) (unit: m, m, rad)
+/// @return		index of the node
+///
+size_t CPoseGraph::AddNode(const SPoseD& pose)
+{
+	const size_t n = m_vPose.size();
+
+	if (n == 0)
+		m_gauge = pose;
+
+	m_vPose.push_back(pose);
+	m_vLin.push_back(pose);
+	m_vFirst.push_back(n);
+	m_vRhs.push_back(TPoseVector::Zero());
+	m_vDelta.push_back(TPoseVector::Zero());
+
+	return n;
+}
+
+///
+/// @brief		add the next pose of an odometry trajectory
+/// @param		prev [in] previous odometry pose (x, y, heading)
+/// @param		cur [in] current odometry pose (x, y, heading)
+/// @param		sigmaXY [in] standard deviation of the motion along x, y (m)
+/// @param		sigmaQ [in] standard deviation of the turn (rad)
+/// @return		index of the new node
+/// @remark		The first call adds the node of cur alone. The next ones add
+///				a node at the estimate of the last node moved by the motion
+///				from prev to cur, and the edge of that motion.
+///
+size_t CPoseGraph::AddOdometry(const SPoseD& prev, const SPoseD& cur, \
+	const double sigmaXY, const double sigmaQ)
+{
+	if (m_vPose.empty())
+		return AddNode(cur);
+
+	/// motion from prev to cur in the frame of prev
+	const double c = cos(prev.q);
+	const double s = sin(prev.q);
+	const double dx = cur.x - prev.x;
+	const double dy = cur.y - prev.y;
+	const SPoseD z(c * dx + s * dy, -s * dx + c * dy, \
+		AngleClamp<double>(cur.q - prev.q));
+
+	/// apply it to the estimate of the last node
+	const SPoseD& last = m_vPose.back();
+	const double cl = cos(last.q);
+	const double sl = sin(last.q);
+	const size_t n = AddNode(SPoseD(last.x + cl * z.x - sl * z.y, \
+		last.y + sl * z.x + cl * z.y, AngleClamp<double>(last.q + z.q)));
+
+	AddRelative(n - 1, n, z, sigmaXY, sigmaQ);
+
+	return n;
+}
+
+///
+/// @brief		add a relative edge (odometry or loop closure)
+/// @param		i [in] first node
+/// @param		j [in] second node
+/// @param		z [in] pose of j in the frame of i (x, y, heading)
+/// @param		sigmaXY [in] standard deviation of x, y (m)
+/// @param		sigmaQ [in] standard deviation of the heading (rad)
+/// @return		0 on success, -1 on invalid nodes or deviations
+///
+int CPoseGraph::AddRelative(const size_t i, const size_t j, const SPoseD& z, \
+	const double sigmaXY, const double sigmaQ)
+{
+	if (i >= m_vPose.size() || j >= m_vPose.size() || i == j)
+		return -1;
+	if (!(sigmaXY > 0.) || !(sigmaQ > 0.))
+		return -1;
+
+	SPoseGraphEdge edge;
+	edge.i = unsigned(i);
+	edge.j = unsigned(j);
+	edge.z = z;
+	edge.info[0] = edge.info[1] = 1. / (sigmaXY * sigmaXY);
+	edge.info[2] = 1. / (sigmaQ * sigmaQ);
+
+	return AddEdge(edge);
+}
+
+///
+/// @brief		add an absolute edge (e.g. a dock marker)
+/// @param		i [in] node
+/// @param		z [in] pose of the node in the world (x, y, heading)
+/// @param		sigmaXY [in] standard deviation of x, y (m)
+/// @param		sigmaQ [in] standard deviation of the heading (rad)
+/// @return		0 on success, -1 on an invalid node or deviations
+///
+int CPoseGraph::AddAbsolute(const size_t i, const SPoseD& z, \
+	const double sigmaXY, const double sigmaQ)
+{
+	if (i >= m_vPose.size())
+		return -1;
+	if (!(sigmaXY > 0.) || !(sigmaQ > 0.))
+		return -1;
+
+	SPoseGraphEdge edge;
+	edge.i = unsigned(i);
+	edge.j = POSE_GRAPH_ABSOLUTE;
+	edge.z = z;
+	edge.info[0] = edge.info[1] = 1. / (sigmaXY * sigmaXY);
+	edge.info[2] = 1. / (sigmaQ * sigmaQ);
+
+	return AddEdge(edge);
+}
+
+///
+/// @brief		add an edge and widen the envelope of its row
+/// @param		edge [in] validated constraint
+/// @return		0
+///
+int CPoseGraph::AddEdge(const SPoseGraphEdge& edge)
+{
+	unsigned nRow = edge.i;
+
+	if (edge.j == POSE_GRAPH_ABSOLUTE)
+		++m_nAbsolute;
+	else
+	{
+		nRow = std::max(edge.i, edge.j);
+		m_vFirst[nRow] = std::min<size_t>(m_vFirst[nRow], \
+			std::min(edge.i, edge.j));
+	}
+
+	m_vReach.push_back(m_vReach.empty() ? nRow : \
+		std::max(m_vReach.back(), nRow));
+	m_vEdge.push_back(edge);
+	return 0;
+}
+
+///
+/// @brief		relinearize every edge and iterate Gauss-Newton
+/// @param		nMaxIterations [in] largest number of iterations
+/// @return		number of iterations, -1 if the system is singular
+/// @remark		Solves the headings alone, then the positions with the
+///				headings held: the errors are linear in either, so the two
+///				solves remove the drift of an odometry that turned by
+///				radians, from which Gauss-Newton would not converge. Stops
+///				when no pose moves more than POSE_GRAPH_EPSILON.
+///
+int CPoseGraph::Optimize(const int nMaxIterations)
+{
+	int nIter = 0;
+
+	m_vLin = m_vPose;
+	UnwrapHeadings();
+	if (Solve(0, POSE_GRAPH_STEP_HEADING) < 0)
+		return -1;
+	m_vLin = m_vPose;
+	if (Solve(0, POSE_GRAPH_STEP_POSITION) < 0)
+		return -1;
+
+	while (nIter < nMaxIterations)
+	{
+		m_vLin = m_vPose;
+		if (Solve(0) < 0)
+			return -1;
+		++nIter;
+
+		double dMax = 0.;
+		for (size_t i = 0; i < m_vDelta.size(); ++i)
+			for (int k = 0; k < 3; ++k)
+				dMax = std::max(dMax, fabs(m_vDelta[i](k, 0)));
+		if (dMax < POSE_GRAPH_EPSILON)
+			break;
+	}
+
+	return nIter;
+}
+
+///
+/// @brief		choose the whole turns of the heading errors of the absolute
+///				edges for the heading step
+/// @param		N/A
+/// @return		void
+/// @remark		The heading error of a fix is known up to whole turns. The
+///				correction of the odometry changes by less than half a turn
+///				from a fix to the next along the nodes, so each fix takes the
+///				turns that bring its error nearest to the one of the
+///				previous fix; the odometry may have turned by any angle
+///				between the first and the last fix.
+///
+void CPoseGraph::UnwrapHeadings()
+{
+	std::vector<std::pair<unsigned, size_t> > vFix;
+	for (size_t k = 0; k < m_vEdge.size(); ++k)
+	{
+		if (m_vEdge[k].j == POSE_GRAPH_ABSOLUTE)
+			vFix.push_back(std::make_pair(m_vEdge[k].i, k));
+	}
+	std::sort(vFix.begin(), vFix.end());
+
+	m_vTurn.assign(m_vEdge.size(), 0.);
+
+	double dPrev = 0.;
+	for (size_t n = 0; n < vFix.size(); ++n)
+	{
+		const size_t k = vFix[n].second;
+		const double dError = AngleClamp<double>( \
+			m_vLin[m_vEdge[k].i].q - m_vEdge[k].z.q);
+
+		if (n > 0)
+			m_vTurn[k] = (M_PI + M_PI) * \
+				floor((dPrev - dError) / (M_PI + M_PI) + 0.5);
+		dPrev = dError + m_vTurn[k];
+	}
+}
+
+///
+/// @brief		solve with the nodes and edges added since the last solve
+/// @param		N/A
+/// @return		0 on success, -1 if the system is singular
+/// @remark		Keeps the linearization of the old nodes: the rows before
+///				the first node of a new edge are neither rebuilt nor factored
+///				again (see the remark of PoseGraph.h).
+///
+int CPoseGraph::Update()
+{
+	if (m_nFactored == m_vPose.size() && m_nLinearized == m_vEdge.size())
+	{
+		m_nLastRows = 0;
+		return 0;
+	}
+
+	size_t r0 = m_nFactored;
+	for (size_t k = m_nLinearized; k < m_vEdge.size(); ++k)
+	{
+		const SPoseGraphEdge& edge = m_vEdge[k];
+		r0 = std::min<size_t>(r0, (edge.j == POSE_GRAPH_ABSOLUTE) ? \
+			edge.i : std::min(edge.i, edge.j));
+	}
+
+	return Solve(r0);
+}
+
+///
+/// @brief		rebuild, factor and solve from a block row
+/// @param		nFirstRow [in] first block row to rebuild
+/// @param		nStep [in] variables to move (EPoseGraphStep); the held ones
+///				get a unit diagonal and no error, so they do not move
+/// @return		0 on success, -1 if the system is singular
+/// @remark		The rows before nFirstRow keep their factor and forward
+///				substitution; their edges are linearized at the same point,
+///				so the rebuilt rows are those of a full solve. Solves
+///				H delta = -b and moves the estimate to m_vLin + delta.
+///
+int CPoseGraph::Solve(const size_t nFirstRow, const int nStep)
+{
+	const size_t N = m_vPose.size();
+	const bool bGauge = (m_nAbsolute == 0);
+
+	size_t r0 = std::min(nFirstRow, m_nFactored);
+	if (bGauge != m_bGauge || nStep != POSE_GRAPH_STEP_FULL)
+		r0 = 0;
+
+	/// envelope of the rows from r0
+	m_vOffset.resize(N + 1);
+	for (size_t j = r0; j < N; ++j)
+		m_vOffset[j + 1] = m_vOffset[j] + (j - m_vFirst[j] + 1);
+	m_vBlock.resize(m_vOffset[N]);
+	std::fill(m_vBlock.begin() + m_vOffset[r0], m_vBlock.end(), \
+		TPoseBlock::Zero());
+	std::fill(m_vRhs.begin() + r0, m_vRhs.end(), TPoseVector::Zero());
+	for (size_t j = r0; j < N && nStep == POSE_GRAPH_STEP_HEADING; ++j)
+		Block(j, j)(0, 0) = Block(j, j)(1, 1) = 1.;
+	for (size_t j = r0; j < N && nStep == POSE_GRAPH_STEP_POSITION; ++j)
+		Block(j, j)(2, 2) = 1.;
+
+	/// information of the moved variables
+	const double use[3] = \
+		{ (nStep == POSE_GRAPH_STEP_HEADING) ? 0. : 1., \
+		  (nStep == POSE_GRAPH_STEP_HEADING) ? 0. : 1., \
+		  (nStep == POSE_GRAPH_STEP_POSITION) ? 0. : 1. };
+
+	/// normal equations of the rows from r0 (H, -b); the edges before
+	/// the first one reaching row r0 are skipped at once
+	TPoseVector e;
+	TPoseBlock A, B;
+	const size_t nFirstEdge = size_t(std::lower_bound(m_vReach.begin(), \
+		m_vReach.end(), unsigned(r0)) - m_vReach.begin());
+	for (size_t k = nFirstEdge; k < m_vEdge.size(); ++k)
+	{
+		const SPoseGraphEdge& edge = m_vEdge[k];
+		const double info[3] = { use[0] * edge.info[0], \
+			use[1] * edge.info[1], use[2] * edge.info[2] };
+
+		if (edge.j == POSE_GRAPH_ABSOLUTE)
+		{
+			if (edge.i < r0)
+				continue;
+
+			Linearize(edge, m_vLin, e, &A);
+			if (nStep == POSE_GRAPH_STEP_HEADING)
+				e(2, 0) += m_vTurn[k];
+			const TPoseBlock At = A.Transpose();
+			Block(edge.i, edge.i) = Block(edge.i, edge.i) + \
+				At * Weight(info, A);
+			for (int r = 0; r < 3; ++r)
+				e(r, 0) *= info[r];
+			m_vRhs[edge.i] = m_vRhs[edge.i] - At * e;
+			continue;
+		}
+
+		const size_t hi = std::max(edge.i, edge.j);
+		const size_t lo = std::min(edge.i, edge.j);
+		if (hi < r0)
+			continue;
+
+		Linearize(edge, m_vLin, e, &A, &B);
+		if (nStep == POSE_GRAPH_STEP_POSITION)
+			A(0, 2) = A(1, 2) = A(2, 2) = B(2, 2) = 0.;
+		const TPoseBlock& Jhi = (hi == edge.i) ? A : B;
+		const TPoseBlock& Jlo = (hi == edge.i) ? B : A;
+		const TPoseBlock JhiT = Jhi.Transpose();
+		const TPoseBlock WJlo = Weight(info, Jlo);
+
+		Block(hi, hi) = Block(hi, hi) + JhiT * Weight(info, Jhi);
+		Block(hi, lo) = Block(hi, lo) + JhiT * WJlo;
+		for (int r = 0; r < 3; ++r)
+			e(r, 0) *= info[r];
+		m_vRhs[hi] = m_vRhs[hi] - JhiT * e;
+		if (lo >= r0)
+		{
+			Block(lo, lo) = Block(lo, lo) + Jlo.Transpose() * WJlo;
+			m_vRhs[lo] = m_vRhs[lo] - Jlo.Transpose() * e;
+		}
+	}
+
+	/// gauge: hold node 0 at its first estimate
+	if (bGauge && r0 == 0 && N > 0)
+	{
+		Block(0, 0) = Block(0, 0) + \
+			TPoseBlock::Identity() * POSE_GRAPH_GAUGE_INFO;
+		m_vRhs[0](0, 0) -= POSE_GRAPH_GAUGE_INFO * (m_vLin[0].x - m_gauge.x);
+		m_vRhs[0](1, 0) -= POSE_GRAPH_GAUGE_INFO * (m_vLin[0].y - m_gauge.y);
+		m_vRhs[0](2, 0) -= POSE_GRAPH_GAUGE_INFO * \
+			AngleClamp<double>(m_vLin[0].q - m_gauge.q);
+	}
+
+	/// block Cholesky H = L L^T by rows (in place, the diagonal blocks
+	/// hold L_jj^-1) and forward substitution L y = -b
+	for (size_t j = r0; j < N; ++j)
+	{
+		const size_t f = m_vFirst[j];
+
+		for (size_t k = f; k < j; ++k)
+		{
+			TPoseBlock S = Block(j, k);
+			for (size_t m = std::max(f, m_vFirst[k]); m < k; ++m)
+				S = S - Block(j, m) * Block(k, m).Transpose();
+			Block(j, k) = S * Block(k, k).Transpose();
+		}
+
+		TPoseBlock D = Block(j, j);
+		TPoseVector y = m_vRhs[j];
+		for (size_t m = f; m < j; ++m)
+		{
+			const TPoseBlock& Ljm = Block(j, m);
+			D = D - Ljm * Ljm.Transpose();
+			y = y - Ljm * m_vRhs[m];
+		}
+
+		if (CholeskyInverse(D, Block(j, j)) < 0)
+		{
+			/// the rows before j hold the factor of this step only
+			m_nFactored = (nStep == POSE_GRAPH_STEP_FULL) ? \
+				std::min(m_nFactored, j) : 0;
+			return -1;
+		}
+		m_vRhs[j] = Block(j, j) * y;
+	}
+
+	/// back substitution L^T delta = y (the rows after j are done, so
+	/// the pose of j is final)
+	m_vDelta = m_vRhs;
+	for (size_t j = N; j-- > 0; )
+	{
+		const TPoseVector d = Block(j, j).Transpose() * m_vDelta[j];
+		m_vDelta[j] = d;
+		for (size_t m = m_vFirst[j]; m < j; ++m)
+			m_vDelta[m] = m_vDelta[m] - Block(j, m).Transpose() * d;
+
+		m_vPose[j].x = m_vLin[j].x + d(0, 0);
+		m_vPose[j].y = m_vLin[j].y + d(1, 0);
+		m_vPose[j].q = AngleClamp<double>(m_vLin[j].q + d(2, 0));
+	}
+
+	m_bGauge = bGauge;
+	m_nFactored = (nStep == POSE_GRAPH_STEP_FULL) ? N : 0;
+	m_nLinearized = m_vEdge.size();
+	m_nLastRows = N - r0;
+
+	return 0;
+}
+
+///
+/// @brief		get the sum of the squared weighted errors at the estimate
+/// @param		N/A
+/// @return		sum of e^T Omega e over the edges
+///
+double CPoseGraph::GetError() const
+{
+	double dError = 0.;
+
+	TPoseVector e;
+	for (size_t k = 0; k < m_vEdge.size(); ++k)
+	{
+		const SPoseGraphEdge& edge = m_vEdge[k];
+		Linearize(edge, m_vPose, e);
+		for (int r = 0; r < 3; ++r)
+			dError += edge.info[r] * e(r, 0) * e(r, 0);
+	}
+
+	return dError;
+}
@@ -0,0 +1,213 @@
+///
+/// @file		PoseGraph.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Pose-graph back end: odometry, loop-closure and absolute
+///				constraints solved by Gauss-Newton (sparse block Cholesky)
+///
+/// @remark		The nodes are poses (x, y, heading) in the order of the
+///				trajectory. A relative edge constrains the pose of node j in
+///				the frame of node i (odometry between consecutive poses, or a
+///				loop closure); an absolute edge constrains the pose of a node
+///				in the world (e.g. a dock marker). Each edge has a diagonal
+///				information matrix (1 / sigma^2 of x, y and heading).
+///
+///				The normal equations are stored as 3 x 3 blocks in envelope
+///				(skyline) form: block row j keeps the columns from its
+///				farthest neighbor i < j to j. Odometry alone is block
+///				tridiagonal, so a row holds two blocks and the factorization
+///				and solves cost O(N); a loop closure (i, j) only widens row j,
+///				and the Cholesky factor never fills outside the envelope.
+///
+///				Optimize() first solves the headings alone, then the
+///				positions with the headings held (both are linear problems,
+///				so a trajectory that drifted by radians and kilometers is
+///				brought close to the optimum in two solves), then relinearizes
+///				every edge at the current estimate and iterates. The heading
+///				drift between two consecutive absolute edges (and along a
+///				loop closure) must stay below half a turn.
+///
+///				Update() keeps the linearization of the old nodes, linearizes
+///				the new edges only, and rebuilds and factors the block rows
+///				from the first node touched by a new edge; the rows before it
+///				and their forward substitution are kept, so adding poses at
+///				the end of a shift costs the new rows plus one back
+///				substitution. Call Optimize() again after large corrections
+///				(e.g. a loop closure) to relinearize.
+///
+///				Without an absolute edge, node 0 is held at its first
+///				estimate by a stiff prior (POSE_GRAPH_GAUGE_INFO), which fixes
+///				the free translation and rotation of the graph.
+///
+
+#ifndef _POSE_GRAPH_H_
+#define _POSE_GRAPH_H_
+
+#include <cstddef>			// size_t
+#include <vector>			// std::vector
+
+#include "Pose.h"			// SPoseD
+#include "Matrix.h"			// TMatrix
+
+/// largest number of Gauss-Newton iterations of Optimize()
+#define POSE_GRAPH_MAX_ITERATIONS	(10)
+
+/// Optimize() stops when no pose moves more than this (m, rad)
+#define POSE_GRAPH_EPSILON			(1e-9)
+
+/// information of the prior that holds node 0 without absolute edges
+#define POSE_GRAPH_GAUGE_INFO		(1e10)
+
+/// second node of an absolute edge
+#define POSE_GRAPH_ABSOLUTE			(~0U)
+
+/// variables moved by a solve
+enum EPoseGraphStep
+{
+	POSE_GRAPH_STEP_FULL = 0,	///< positions and headings (Gauss-Newton)
+	POSE_GRAPH_STEP_HEADING,	///< headings alone (positions held)
+	POSE_GRAPH_STEP_POSITION,	///< positions alone (headings held)
+};
+
+/// type definition of a block of the normal equations
+typedef TMatrix<3, 3, double> TPoseBlock;
+
+/// type definition of a vector of a node (x, y, heading)
+typedef TMatrix<3, 1, double> TPoseVector;
+
+/// type definition of a constraint
+typedef struct _tagSPoseGraphEdge
+{
+	unsigned i;			///< first node
+	unsigned j;			///< second node (POSE_GRAPH_ABSOLUTE: absolute)
+	SPoseD   z;			///< pose of j in the frame of i, or pose of i
+	double   info[3];	///< information of x, y and heading (1 / sigma^2)
+} SPoseGraphEdge;
+
+/// @brief		Pose graph with a sparse Gauss-Newton solver
+class CPoseGraph
+{
+public:
+	/// constructor
+	explicit CPoseGraph();
+
+	/// destructor
+	virtual ~CPoseGraph() {}
+
+	/// drop all nodes and edges
+	void Clear();
+
+	/// add a node with its initial estimate
+	size_t AddNode(const SPoseD& pose);
+
+	/// add the next pose of an odometry trajectory (node and edge)
+	size_t AddOdometry(const SPoseD& prev, const SPoseD& cur, \
+		const double sigmaXY, const double sigmaQ);
+
+	/// add a relative edge (odometry or loop closure)
+	int AddRelative(const size_t i, const size_t j, const SPoseD& z, \
+		const double sigmaXY, const double sigmaQ);
+
+	/// add an absolute edge (e.g. a dock marker)
+	int AddAbsolute(const size_t i, const SPoseD& z, const double sigmaXY, \
+		const double sigmaQ);
+
+	/// relinearize every edge and iterate Gauss-Newton
+	int Optimize(const int nMaxIterations = POSE_GRAPH_MAX_ITERATIONS);
+
+	/// solve with the new nodes and edges (incremental)
+	int Update();
+
+	/// get the number of nodes
+	size_t GetCount() const { return m_vPose.size(); }
+
+	/// get the number of edges
+	size_t GetEdgeCount() const { return m_vEdge.size(); }
+
+	/// get the estimate of a node
+	const SPoseD& GetPose(const size_t i) const { return m_vPose[i]; }
+
+	/// get the sum of the squared weighted errors at the estimate
+	double GetError() const;
+
+	/// get the number of blocks of the envelope
+	size_t GetBlockCount() const { return m_vBlock.size(); }
+
+	/// get the number of block rows factored by the last solve
+	size_t GetFactoredRows() const { return m_nLastRows; }
+
+private:
+	/// add an edge and widen the envelope of its row
+	int AddEdge(const SPoseGraphEdge& edge);
+
+	/// choose the whole turns of the heading errors of the fixes
+	void UnwrapHeadings();
+
+	/// rebuild, factor and solve from a block row
+	int Solve(const size_t nFirstRow, \
+		const int nStep = POSE_GRAPH_STEP_FULL);
+
+	/// get the block (row, col) of the envelope (col <= row)
+	TPoseBlock& Block(const size_t nRow, const size_t nCol) \
+		{ return m_vBlock[m_vOffset[nRow] + (nCol - m_vFirst[nRow])]; }
+
+private:
+	/// non construction-copyable
+	CPoseGraph(const CPoseGraph&);
+
+	/// non copyable
+	const CPoseGraph& operator=(const CPoseGraph&);
+
+private:
+	/// estimate of each node (linearization point + solution)
+	std::vector<SPoseD> m_vPose;
+
+	/// linearization point of each node
+	std::vector<SPoseD> m_vLin;
+
+	/// constraints
+	std::vector<SPoseGraphEdge> m_vEdge;
+
+	/// largest block row of the edges up to each edge (prefix maximum)
+	std::vector<unsigned> m_vReach;
+
+	/// first block column of each block row (envelope)
+	std::vector<size_t> m_vFirst;
+
+	/// first block of each block row (m_vOffset[N]: number of blocks)
+	std::vector<size_t> m_vOffset;
+
+	/// normal matrix, then its Cholesky factor (inverse diagonal blocks)
+	std::vector<TPoseBlock> m_vBlock;
+
+	/// right-hand side, then the forward substitution
+	std::vector<TPoseVector> m_vRhs;
+
+	/// solution of the last solve
+	std::vector<TPoseVector> m_vDelta;
+
+	/// whole turns added to the heading error of each edge (heading step)
+	std::vector<double> m_vTurn;
+
+	/// number of absolute edges
+	size_t m_nAbsolute;
+
+	/// prior on node 0 (no absolute edge) in the factored rows
+	bool m_bGauge;
+
+	/// estimate of node 0 held by the prior
+	SPoseD m_gauge;
+
+	/// number of block rows with a valid factor and forward substitution
+	size_t m_nFactored;
+
+	/// number of edges in the factor
+	size_t m_nLinearized;
+
+	/// number of block rows factored by the last solve
+	size_t m_nLastRows;
+};
+
+#endif // _POSE_GRAPH_H_
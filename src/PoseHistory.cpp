@@ -0,0 +1,266 @@
+///
+/// @file		PoseHistory.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Fixed-capacity history of timestamped poses with interpolated
+///				queries
+///
+
+#include <cmath>			// fabsf
+
+#include "PoseHistory.h"
+#include "math2.h"			// AngleClamp, AngleDiff, SinCos
+
+/// sequence number of a slot being written
+#define SLOT_BUSY	(~uint64_t(0))
+
+///
+/// @brief		get sin(a) / a and (1 - cos(a)) / a (series near zero)
+/// @param		a [in] angle (rad)
+/// @param		s [out] sin(a) / a
+/// @param		c [out] (1 - cos(a)) / a
+/// @return		void
+///
+static inline void SinCosOverAngle(const float a, float& s, float& c)
+{
+	if (fabsf(a) < 1e-3f)
+	{
+		s = 1.f - a * a / 6.f;
+		c = a / 2.f - a * a * a / 24.f;
+	}
+	else
+	{
+		float fSin, fCos;
+		SinCos(a, fSin, fCos);
+		s = fSin / a;
+		c = (1.f - fCos) / a;
+	}
+}
+
+///
+/// @brief		interpolate two poses on SE(2) (constant twist)
+/// @param		a [in] pose at u = 0
+/// @param		b [in] pose at u = 1
+/// @param		u [in] ratio [0..1]
+/// @return		interpolated pose
+/// @remark		the motion from a to b is taken as a circular arc, which is
+///				the path of the vehicle with a constant steering angle
+///
+static SPose InterpolateSE2(const SPose& a, const SPose& b, const float u)
+{
+	/// relative motion a -> b in the frame of a
+	//@{
+	float sa, ca;
+	SinCos(a.q, sa, ca);
+	const float dx =  ca * (b.x - a.x) + sa * (b.y - a.y);
+	const float dy = -sa * (b.x - a.x) + ca * (b.y - a.y);
+	const float dq = AngleDiff(a.q, b.q);
+	//@}
+
+	/// twist of the relative motion (log map): rho = V(dq)^-1 * (dx, dy)
+	//@{
+	float s, c;
+	SinCosOverAngle(dq, s, c);
+	const float det = s * s + c * c;
+	const float rx = ( s * dx + c * dy) / det;
+	const float ry = (-c * dx + s * dy) / det;
+	//@}
+
+	/// scaled twist back to a motion (exp map): V(u dq) * (u rho)
+	//@{
+	SinCosOverAngle(u * dq, s, c);
+	const float tx = u * (s * rx - c * ry);
+	const float ty = u * (c * rx + s * ry);
+	//@}
+
+	return SPose(a.x + ca * tx - sa * ty, a.y + sa * tx + ca * ty, \
+		AngleClamp(a.q + u * dq));
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CPoseHistory::CPoseHistory()
+: m_nCount(0)
+, m_nBegin(0)
+, m_fLastTime(0.)
+{
+	for (int i = 0; i < POSE_HISTORY_SIZE; ++i)
+		m_slot[i].seq.store(SLOT_BUSY, std::memory_order_relaxed);
+}
+
+///
+/// @brief		drop all poses
+/// @param		N/A
+/// @return		void
+/// @remark		writer thread only
+///
+void CPoseHistory::Clear()
+{
+	m_nBegin.store(m_nCount.load(std::memory_order_relaxed), \
+		std::memory_order_release);
+}
+
+///
+/// @brief		add a pose
+/// @param		time [in] timestamp (sec)
+/// @param		pose [in] pose at the timestamp
+/// @return		void
+/// @remark		writer thread only. Timestamps must not decrease; a smaller
+///				timestamp than the last one restarts the history.
+///
+void CPoseHistory::Push(const double time, const SPose& pose)
+{
+	const uint64_t n = m_nCount.load(std::memory_order_relaxed);
+	SSlot& slot = m_slot[n & (POSE_HISTORY_SIZE - 1)];
+
+	if (time < m_fLastTime)
+		m_nBegin.store(n, std::memory_order_release);
+	m_fLastTime = time;
+
+	/// mark busy, write the entry, then publish its index
+	slot.seq.store(SLOT_BUSY, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.time.store(time, std::memory_order_relaxed);
+	slot.x.store(pose.x, std::memory_order_relaxed);
+	slot.y.store(pose.y, std::memory_order_relaxed);
+	slot.q.store(pose.q, std::memory_order_relaxed);
+	slot.seq.store(n, std::memory_order_release);
+
+	m_nCount.store(n + 1, std::memory_order_release);
+}
+
+///
+/// @brief		copy the entry of an index
+/// @param		nIndex [in] index of the entry
+/// @param		time [out] timestamp (sec)
+/// @param		pose [out] pose
+/// @return		true if the entry was read, false if it was overwritten
+///
+bool CPoseHistory::ReadSlot(const uint64_t nIndex, double& time, \
+	SPose& pose) const
+{
+	const SSlot& slot = m_slot[nIndex & (POSE_HISTORY_SIZE - 1)];
+
+	if (slot.seq.load(std::memory_order_acquire) != nIndex)
+		return false;
+
+	time = slot.time.load(std::memory_order_relaxed);
+	pose.x = slot.x.load(std::memory_order_relaxed);
+	pose.y = slot.y.load(std::memory_order_relaxed);
+	pose.q = slot.q.load(std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	return slot.seq.load(std::memory_order_relaxed) == nIndex;
+}
+
+///
+/// @brief		get the pose at a timestamp
+/// @param		time [in] timestamp (sec)
+/// @param		pose [out] pose at the timestamp
+/// @return		0 on success, -1 if the timestamp is out of the history
+/// @remark		wait-free; poses between two entries are interpolated on
+///				SE(2)
+///
+int CPoseHistory::Query(const double time, SPose& pose) const
+{
+	const uint64_t nEnd = m_nCount.load(std::memory_order_acquire);
+	const uint64_t nBegin = m_nBegin.load(std::memory_order_acquire);
+
+	/// search range [lo..hi] of valid indices
+	uint64_t lo = (nEnd > POSE_HISTORY_SIZE) ? nEnd - POSE_HISTORY_SIZE : 0;
+	if (lo < nBegin)
+		lo = nBegin;
+	if (lo >= nEnd)
+		return -1;
+	uint64_t hi = nEnd - 1;
+
+	/// newest entry: no extrapolation beyond it
+	double fTime = 0.;
+	SPose poseA, poseB;
+	if (!ReadSlot(hi, fTime, poseB) || time > fTime)
+		return -1;
+	if (time == fTime)
+	{
+		pose = poseB;
+		return 0;
+	}
+
+	/// find the last entry at or before the timestamp
+	/// (invariant: entries > hi are after the timestamp)
+	for (uint64_t nFound = nEnd; ; )
+	{
+		if (lo > hi)
+		{
+			if (nFound == nEnd)
+				return -1;	///< older than the history
+
+			lo = nFound;
+			break;
+		}
+
+		const uint64_t mid = lo + (hi - lo) / 2;
+		if (!ReadSlot(mid, fTime, poseA))
+		{
+			lo = mid + 1;	///< overwritten: left the history
+			continue;
+		}
+
+		if (fTime <= time)
+		{
+			nFound = mid;
+			lo = mid + 1;
+		}
+		else
+		{
+			if (!mid)
+				return -1;
+			hi = mid - 1;
+		}
+	}
+
+	/// interpolate between the entry and the next one
+	//@{
+	double fTimeA = 0., fTimeB = 0.;
+	if (!ReadSlot(lo, fTimeA, poseA) || !ReadSlot(lo + 1, fTimeB, poseB))
+		return -1;
+
+	if (fTimeA == time || fTimeB <= fTimeA)
+		pose = poseA;
+	else
+		pose = InterpolateSE2(poseA, poseB, \
+			float((time - fTimeA) / (fTimeB - fTimeA)));
+	//@}
+
+	return 0;
+}
+
+///
+/// @brief		get the time range of the history
+/// @param		fOldest [out] timestamp of the oldest entry (sec)
+/// @param		fNewest [out] timestamp of the newest entry (sec)
+/// @return		0 on success, -1 if the history is empty
+///
+int CPoseHistory::GetRange(double& fOldest, double& fNewest) const
+{
+	const uint64_t nEnd = m_nCount.load(std::memory_order_acquire);
+	uint64_t nBegin = m_nBegin.load(std::memory_order_acquire);
+	SPose pose;
+
+	if (nEnd > POSE_HISTORY_SIZE && nBegin < nEnd - POSE_HISTORY_SIZE)
+		nBegin = nEnd - POSE_HISTORY_SIZE;
+
+	/// the oldest slot may be overwritten meanwhile: take the next one
+	for (; nBegin < nEnd; ++nBegin)
+		if (ReadSlot(nBegin, fOldest, pose))
+			break;
+
+	if (nBegin >= nEnd || !ReadSlot(nEnd - 1, fNewest, pose))
+		return -1;
+
+	return 0;
+}
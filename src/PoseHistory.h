@@ -0,0 +1,87 @@
+///
+/// @file		PoseHistory.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Fixed-capacity history of timestamped poses with interpolated
+///				queries
+///
+/// @remark		One writer (the estimator) pushes poses with non-decreasing
+///				timestamps; any number of reader threads query the pose at a
+///				past timestamp. Each slot is guarded by its own sequence
+///				number (seqlock); a reader never retries or blocks, so a query
+///				finishes in O(log N) steps. A slot overwritten during a query
+///				only means that its entry left the history, which the search
+///				treats as "too old".
+///
+
+#ifndef _POSE_HISTORY_H_
+#define _POSE_HISTORY_H_
+
+#include <atomic>		// std::atomic
+#include <cstdint>		// uint64_t
+
+#include "Pose.h"		// SPose
+
+/// number of poses in the history (power of 2)
+#define POSE_HISTORY_SIZE	(4096)
+
+/// @brief		Fixed-capacity history of timestamped poses
+class CPoseHistory
+{
+public:
+	/// constructor
+	explicit CPoseHistory();
+
+	/// destructor
+	virtual ~CPoseHistory() {}
+
+	/// writer: drop all poses
+	void Clear();
+
+	/// writer: add a pose (a decreasing timestamp restarts the history)
+	void Push(const double time, const SPose& pose);
+
+	/// reader: get the pose at a timestamp (SE(2) interpolation)
+	int Query(const double time, SPose& pose) const;
+
+	/// reader: get the time range of the history
+	int GetRange(double& fOldest, double& fNewest) const;
+
+private:
+	/// type definition of a slot of the ring
+	typedef struct _tagSSlot
+	{
+		std::atomic<uint64_t> seq;	///< index of the entry (~0: being written)
+		std::atomic<double> time;	///< timestamp (sec)
+		std::atomic<float> x;		///< position x (m)
+		std::atomic<float> y;		///< position y (m)
+		std::atomic<float> q;		///< heading angle (rad)
+	} SSlot;
+
+	/// reader: copy the entry of an index (false if it was overwritten)
+	bool ReadSlot(const uint64_t nIndex, double& time, SPose& pose) const;
+
+private:
+	/// non construction-copyable
+	CPoseHistory(const CPoseHistory&);
+
+	/// non copyable
+	const CPoseHistory& operator=(const CPoseHistory&);
+
+private:
+	/// slots of the ring
+	SSlot m_slot[POSE_HISTORY_SIZE];
+
+	/// number of pushed entries (index of the next entry)
+	std::atomic<uint64_t> m_nCount;
+
+	/// index of the first valid entry (after Clear() or a time reset)
+	std::atomic<uint64_t> m_nBegin;
+
+	/// writer: timestamp of the last entry
+	double m_fLastTime;
+};
+
+#endif // _POSE_HISTORY_H_
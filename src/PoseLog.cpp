@@ -0,0 +1,314 @@
+///
+/// @file		PoseLog.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Indexed binary log of robot poses and contours
+///
+
+#include <algorithm>		// std::upper_bound
+#include <cstddef>			// offsetof
+#include <cstring>			// memcpy, memcmp, memset
+
+#include "PoseLog.h"
+
+/// magic string of the header
+static const char s_szHeaderMagic[8] = "TRCPOSE";
+
+/// magic string of the trailer
+static const char s_szTrailerMagic[8] = "TRCPIDX";
+
+/// size of the fields of a record (the padding after them is written as 0)
+static const size_t s_nRecordFields = offsetof(SPoseLogRecord, posRW) + \
+	sizeof(SPos);
+
+///
+/// @brief		compare a timestamp with the time of a record
+/// @param		time [in] timestamp
+/// @param		record [in] pose record
+/// @return		true if time < record.time
+///
+static inline bool TimeLess(const double time, const SPoseLogRecord& record)
+{
+	return time < record.time;
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CPoseLogWriter::CPoseLogWriter()
+: m_fp(0)
+, m_nBuffered(0)
+, m_nRecords(0)
+, m_bError(false)
+{
+}
+
+///
+/// @brief		destructor (closes the file)
+/// @param		N/A
+/// @return		N/A
+///
+CPoseLogWriter::~CPoseLogWriter()
+{
+	Close();
+}
+
+///
+/// @brief		create a log file and write the header
+/// @param		sFilename [in] filename to create
+/// @return		0 on success, -1 if occurred error
+///
+int CPoseLogWriter::Open(const std::string& sFilename)
+{
+	/// close the previous file
+	Close();
+
+	m_fp = fopen(sFilename.c_str(), "wb");
+	if (!m_fp)
+		return -1;
+
+	/// records are collected in our own buffer
+	setvbuf(m_fp, 0, _IONBF, 0);
+
+	m_vBuffer.resize(POSE_LOG_BUFFER_SIZE);
+	m_nBuffered = 0;
+	m_nRecords = 0;
+	m_vIndex.clear();
+	m_bError = false;
+
+	/// write the header
+	//@{
+	SPoseLogHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, s_szHeaderMagic, sizeof(header.magic));
+	header.version = POSE_LOG_VERSION;
+	header.recordSize = sizeof(SPoseLogRecord);
+	header.blockSize = POSE_LOG_BLOCK_SIZE;
+
+	memcpy(&m_vBuffer[0], &header, sizeof(header));
+	m_nBuffered = sizeof(header);
+	//@}
+
+	return 0;
+}
+
+///
+/// @brief		append a record
+/// @param		record [in] pose record
+/// @return		0 on success, -1 if occurred error
+///
+int CPoseLogWriter::Write(const SPoseLogRecord& record)
+{
+	if (!m_fp || m_bError)
+		return -1;
+
+	/// index the first timestamp of each block
+	if (m_nRecords % POSE_LOG_BLOCK_SIZE == 0)
+		m_vIndex.push_back(record.time);
+
+	/// write the buffer out if the record does not fit
+	if (m_nBuffered + sizeof(record) > m_vBuffer.size())
+		if (Flush() != 0)
+			return -1;
+
+	memcpy(&m_vBuffer[m_nBuffered], &record, s_nRecordFields);
+	memset(&m_vBuffer[m_nBuffered + s_nRecordFields], 0, \
+		sizeof(record) - s_nRecordFields);
+	m_nBuffered += sizeof(record);
+	++m_nRecords;
+
+	return 0;
+}
+
+///
+/// @brief		write the buffered records to the file
+/// @param		N/A
+/// @return		0 on success, -1 if occurred error
+///
+int CPoseLogWriter::Flush()
+{
+	if (m_nBuffered && \
+		fwrite(&m_vBuffer[0], 1, m_nBuffered, m_fp) != m_nBuffered)
+		m_bError = true;
+
+	m_nBuffered = 0;
+
+	return m_bError ? -1 : 0;
+}
+
+///
+/// @brief		write the block index and the trailer and close the file
+/// @param		N/A
+/// @return		0 on success, -1 if occurred error
+///
+int CPoseLogWriter::Close()
+{
+	if (!m_fp)
+		return 0;
+
+	/// records written so far
+	Flush();
+
+	/// write the block index and the trailer
+	//@{
+	SPoseLogTrailer trailer;
+	memset(&trailer, 0, sizeof(trailer));
+	trailer.recordCount = m_nRecords;
+	trailer.indexOffset = sizeof(SPoseLogHeader) + \
+		m_nRecords * sizeof(SPoseLogRecord);
+	trailer.blockCount = m_vIndex.size();
+	memcpy(trailer.magic, s_szTrailerMagic, sizeof(trailer.magic));
+
+	if (!m_vIndex.empty() && fwrite(&m_vIndex[0], sizeof(double), \
+		m_vIndex.size(), m_fp) != m_vIndex.size())
+		m_bError = true;
+	if (fwrite(&trailer, sizeof(trailer), 1, m_fp) != 1)
+		m_bError = true;
+	//@}
+
+	if (fclose(m_fp) != 0)
+		m_bError = true;
+	m_fp = 0;
+
+	/// release the buffers
+	std::vector<char>().swap(m_vBuffer);
+	std::vector<double>().swap(m_vIndex);
+
+	return m_bError ? -1 : 0;
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CPoseLogReader::CPoseLogReader()
+: m_pRecords(0)
+, m_nRecords(0)
+, m_pIndex(0)
+, m_nBlocks(0)
+, m_nBlockSize(POSE_LOG_BLOCK_SIZE)
+{
+}
+
+///
+/// @brief		map a log file and validate its header, index and trailer
+/// @param		sFilename [in] filename to open
+/// @return		0 on success, -1 if occurred error
+///
+int CPoseLogReader::Open(const std::string& sFilename)
+{
+	Close();
+
+	if (m_file.Open(sFilename) != 0)
+		return -1;
+
+	const char* pData = m_file.GetData();
+	const size_t nSize = m_file.GetSize();
+
+	/// header and trailer
+	//@{
+	if (nSize < sizeof(SPoseLogHeader) + sizeof(SPoseLogTrailer))
+	{
+		Close();
+		return -1;
+	}
+
+	SPoseLogHeader header;
+	SPoseLogTrailer trailer;
+	memcpy(&header, pData, sizeof(header));
+	memcpy(&trailer, pData + nSize - sizeof(trailer), sizeof(trailer));
+
+	if (memcmp(header.magic, s_szHeaderMagic, sizeof(header.magic)) || \
+		memcmp(trailer.magic, s_szTrailerMagic, sizeof(trailer.magic)) || \
+		header.version != POSE_LOG_VERSION || \
+		header.recordSize != sizeof(SPoseLogRecord) || \
+		header.blockSize == 0)
+	{
+		Close();
+		return -1;
+	}
+	//@}
+
+	/// check that the records and the index fill the file exactly
+	//@{
+	const unsigned long long nBlocks = \
+		(trailer.recordCount + header.blockSize - 1) / header.blockSize;
+	if (trailer.blockCount != nBlocks || \
+		trailer.indexOffset != sizeof(SPoseLogHeader) + \
+			trailer.recordCount * sizeof(SPoseLogRecord) || \
+		trailer.indexOffset + nBlocks * sizeof(double) + \
+			sizeof(SPoseLogTrailer) != nSize)
+	{
+		Close();
+		return -1;
+	}
+	//@}
+
+	m_pRecords = reinterpret_cast<const SPoseLogRecord*>( \
+		pData + sizeof(SPoseLogHeader));
+	m_nRecords = size_t(trailer.recordCount);
+	m_pIndex = reinterpret_cast<const double*>(pData + trailer.indexOffset);
+	m_nBlocks = size_t(nBlocks);
+	m_nBlockSize = header.blockSize;
+
+	return 0;
+}
+
+///
+/// @brief		unmap the log file
+/// @param		N/A
+/// @return		void
+///
+void CPoseLogReader::Close()
+{
+	m_file.Close();
+
+	m_pRecords = 0;
+	m_nRecords = 0;
+	m_pIndex = 0;
+	m_nBlocks = 0;
+}
+
+///
+/// @brief		find the last record at or before a timestamp
+/// @param		time [in] timestamp (unit: sec)
+/// @param		record [out] found pose record
+/// @param		pIndex [out] position of the found record (optional)
+/// @return		0 on success, -1 if time is before the first record or no
+///				file is opened
+/// @remark		O(log n): binary search over the block index, then inside
+///				the block. Only the pages of one block are touched.
+///
+int CPoseLogReader::Find(const double time, SPoseLogRecord& record, \
+	size_t* pIndex) const
+{
+	if (!m_nRecords)
+		return -1;
+
+	/// block whose first timestamp is the last one <= time
+	//@{
+	const double* pBlock = std::upper_bound(m_pIndex, m_pIndex + m_nBlocks, time);
+	if (pBlock == m_pIndex)
+		return -1;
+	const size_t nBlock = size_t(pBlock - m_pIndex) - 1;
+	//@}
+
+	/// record with the last timestamp <= time in the block
+	//@{
+	const SPoseLogRecord* pBegin = m_pRecords + nBlock * m_nBlockSize;
+	const SPoseLogRecord* pEnd = m_pRecords + \
+		std::min(m_nRecords, (nBlock + 1) * m_nBlockSize);
+	const SPoseLogRecord* pFound = std::upper_bound(pBegin, pEnd, time, TimeLess);
+	//@}
+
+	record = *(pFound - 1);
+	if (pIndex)
+		*pIndex = size_t(pFound - 1 - m_pRecords);
+
+	return 0;
+}
@@ -0,0 +1,179 @@
+///
+/// @file		PoseLog.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Indexed binary log of robot poses and contours
+///
+/// @remark		File layout (native little-endian byte order):
+///
+///				+----------------------+ 0
+///				| SPoseLogHeader       |
+///				+----------------------+ sizeof(SPoseLogHeader)
+///				| SPoseLogRecord * N   | fixed-size records
+///				+----------------------+ index offset
+///				| double * B           | first timestamp of each block
+///				+----------------------+
+///				| SPoseLogTrailer      |
+///				+----------------------+ end of file
+///
+///				A block holds POSE_LOG_BLOCK_SIZE records. Timestamps must be
+///				non-decreasing. CPoseLogReader maps the file and finds the
+///				pose at a timestamp by binary search over the block index and
+///				then inside the block.
+///
+
+#ifndef _POSE_LOG_H_
+#define _POSE_LOG_H_
+
+#include <cstdio>			// FILE
+#include <string>			// std::string
+#include <vector>			// std::vector
+
+#include "Pose.h"			// SPos, SPose
+#include "MappedFile.h"		// CMappedFile
+
+/// number of records per index block
+#define POSE_LOG_BLOCK_SIZE		(4096)
+
+/// size of the write buffer (bytes)
+#define POSE_LOG_BUFFER_SIZE	(1 << 20)
+
+/// version of the file format
+#define POSE_LOG_VERSION		(2)
+
+/// type definition of a pose record (48 bytes)
+typedef struct _tagSPoseLogRecord
+{
+	double time;	///< timestamp (unit: sec, from the ns time of the record)
+	SPose  pose;	///< robot pose (x, y, heading)
+	SPos   posFW;	///< position of the front wheel
+	SPos   posLW;	///< position of the left wheel
+	SPos   posRW;	///< position of the right wheel
+} SPoseLogRecord;
+
+/// type definition of the file header (32 bytes)
+typedef struct _tagSPoseLogHeader
+{
+	char     magic[8];		///< "TRCPOSE" + '\0'
+	unsigned version;		///< POSE_LOG_VERSION
+	unsigned recordSize;	///< sizeof(SPoseLogRecord)
+	unsigned blockSize;		///< records per index block
+	unsigned reserved[3];	///< zero
+} SPoseLogHeader;
+
+/// type definition of the file trailer (32 bytes)
+typedef struct _tagSPoseLogTrailer
+{
+	unsigned long long recordCount;	///< number of records
+	unsigned long long indexOffset;	///< offset of the block index (bytes)
+	unsigned long long blockCount;	///< number of index entries
+	char               magic[8];	///< "TRCPIDX" + '\0'
+} SPoseLogTrailer;
+
+/// @brief		Buffered writer of the binary pose log
+class CPoseLogWriter
+{
+public:
+	/// constructor
+	explicit CPoseLogWriter();
+
+	/// destructor (closes the file)
+	virtual ~CPoseLogWriter();
+
+	/// create a log file
+	int Open(const std::string& sFilename);
+
+	/// append a record
+	int Write(const SPoseLogRecord& record);
+
+	/// write the index and close the file
+	int Close();
+
+private:
+	/// write the buffered records to the file
+	int Flush();
+
+private:
+	/// non construction-copyable
+	CPoseLogWriter(const CPoseLogWriter&);
+
+	/// non copyable
+	const CPoseLogWriter& operator=(const CPoseLogWriter&);
+
+private:
+	/// file pointer
+	FILE* m_fp;
+
+	/// write buffer
+	std::vector<char> m_vBuffer;
+
+	/// number of bytes in the write buffer
+	size_t m_nBuffered;
+
+	/// number of written records
+	unsigned long long m_nRecords;
+
+	/// first timestamp of each block
+	std::vector<double> m_vIndex;
+
+	/// whether an error occurred while writing
+	bool m_bError;
+};
+
+/// @brief		Memory-mapped reader of the binary pose log
+class CPoseLogReader
+{
+public:
+	/// constructor
+	explicit CPoseLogReader();
+
+	/// destructor
+	virtual ~CPoseLogReader() {}
+
+	/// map a log file and validate its header, index and trailer
+	int Open(const std::string& sFilename);
+
+	/// unmap the log file
+	void Close();
+
+	/// get the number of records
+	size_t GetCount() const { return m_nRecords; }
+
+	/// get a record by its position
+	const SPoseLogRecord& GetRecord(const size_t nIndex) const \
+		{ return m_pRecords[nIndex]; }
+
+	/// find the last record at or before a timestamp
+	int Find(const double time, SPoseLogRecord& record, \
+		size_t* pIndex = 0) const;
+
+private:
+	/// non construction-copyable
+	CPoseLogReader(const CPoseLogReader&);
+
+	/// non copyable
+	const CPoseLogReader& operator=(const CPoseLogReader&);
+
+private:
+	/// mapped log file
+	CMappedFile m_file;
+
+	/// first record
+	const SPoseLogRecord* m_pRecords;
+
+	/// number of records
+	size_t m_nRecords;
+
+	/// first timestamp of each block
+	const double* m_pIndex;
+
+	/// number of index entries
+	size_t m_nBlocks;
+
+	/// records per index block
+	size_t m_nBlockSize;
+};
+
+#endif // _POSE_LOG_H_
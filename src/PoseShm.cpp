@@ -0,0 +1,366 @@
+///
+/// @file		PoseShm.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Live poses and contours in POSIX shared memory (publisher and
+///				subscriber)
+///
+
+#include <cstring>			// memcpy, memcmp, memset
+#include <new>				// placement new
+
+#if !defined(WIN32)
+#	include <fcntl.h>		// O_CREAT, O_RDWR, O_RDONLY
+#	include <sys/mman.h>	// shm_open, shm_unlink, mmap, munmap
+#	include <sys/stat.h>	// fstat
+#	include <unistd.h>		// ftruncate, close, getpid
+#endif
+
+#include "PoseShm.h"
+
+/// magic string of the header
+static const char s_szMagic[8] = "TRCSHM";
+
+/// sequence number of a slot being written
+#define SLOT_BUSY	(~uint64_t(0))
+
+/// size of the segment (bytes)
+static const size_t s_nSegmentSize = sizeof(SPoseShmHeader) + \
+	POSE_SHM_RING_SIZE * sizeof(SPoseShmSlot);
+
+/// the segment is shared between processes, so the atomics must not use locks
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2, "64-bit atomics must be lock-free");
+
+/// a slot holds its sequence number, the time and the fields in a cache line
+static_assert(sizeof(SPoseShmSlot) == 64, "a slot must fit a cache line");
+
+///
+/// @brief		make a POSIX shared-memory name ("/name")
+/// @param		sName [in] name with or without the leading '/'
+/// @return		name with the leading '/'
+///
+static inline std::string ShmName(const std::string& sName)
+{
+	return (!sName.empty() && sName[0] == '/') ? sName : "/" + sName;
+}
+
+///
+/// @brief		copy a record into the fields of a slot
+/// @param		record [in] record
+/// @param		v [out] POSE_SHM_FIELDS floats (the time is stored apart)
+/// @return		void
+///
+static inline void Record2Fields(const SPoseLogRecord& record, float* v)
+{
+	v[0] = record.pose.x;
+	v[1] = record.pose.y;
+	v[2] = record.pose.q;
+	v[3] = record.posFW.x;
+	v[4] = record.posFW.y;
+	v[5] = record.posLW.x;
+	v[6] = record.posLW.y;
+	v[7] = record.posRW.x;
+	v[8] = record.posRW.y;
+}
+
+///
+/// @brief		copy the fields of a slot into a record
+/// @param		v [in] POSE_SHM_FIELDS floats (the time is read apart)
+/// @param		record [out] record
+/// @return		void
+///
+static inline void Fields2Record(const float* v, SPoseLogRecord& record)
+{
+	record.pose = SPose(v[0], v[1], v[2]);
+	record.posFW = SPos(v[3], v[4]);
+	record.posLW = SPos(v[5], v[6]);
+	record.posRW = SPos(v[7], v[8]);
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CPoseShmPublisher::CPoseShmPublisher()
+: m_pHeader(0)
+, m_pSlot(0)
+, m_nCount(0)
+{
+}
+
+///
+/// @brief		destructor (unmaps and removes the segment)
+/// @param		N/A
+/// @return		N/A
+///
+CPoseShmPublisher::~CPoseShmPublisher()
+{
+	Close();
+}
+
+///
+/// @brief		create (or reset) a shared-memory segment
+/// @param		sName [in] name of the segment
+/// @return		0 on success, -1 if occurred error
+/// @remark		subscribers that mapped a previous segment of the same name
+///				must open it again
+///
+int CPoseShmPublisher::Open(const std::string& sName)
+{
+	Close();
+
+#if defined(WIN32)
+	(void)sName;
+	return -1;
+#else
+	m_sName = ShmName(sName);
+
+	/// a new segment (the previous one stays with its subscribers)
+	shm_unlink(m_sName.c_str());
+	const int fd = shm_open(m_sName.c_str(), O_CREAT | O_RDWR, 0644);
+	if (fd < 0)
+		return -1;
+
+	void* p = MAP_FAILED;
+	if (ftruncate(fd, off_t(s_nSegmentSize)) == 0)
+		p = mmap(0, s_nSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED)
+	{
+		shm_unlink(m_sName.c_str());
+		return -1;
+	}
+
+	/// construct the header and the slots, then publish the magic string
+	//@{
+	m_pHeader = new (p) SPoseShmHeader;
+	m_pHeader->version = POSE_SHM_VERSION;
+	m_pHeader->ringSize = POSE_SHM_RING_SIZE;
+	m_pHeader->slotSize = sizeof(SPoseShmSlot);
+	m_pHeader->publisherPid = unsigned(getpid());
+	m_pHeader->count.store(0, std::memory_order_relaxed);
+
+	m_pSlot = reinterpret_cast<SPoseShmSlot*>(m_pHeader + 1);
+	for (int i = 0; i < POSE_SHM_RING_SIZE; ++i)
+	{
+		SPoseShmSlot* pSlot = new (m_pSlot + i) SPoseShmSlot;
+		pSlot->seq.store(SLOT_BUSY, std::memory_order_relaxed);
+	}
+
+	std::atomic_thread_fence(std::memory_order_release);
+	memcpy(m_pHeader->magic, s_szMagic, sizeof(s_szMagic));
+	//@}
+
+	m_nCount = 0;
+
+	return 0;
+#endif
+}
+
+///
+/// @brief		unmap and remove the segment
+/// @param		N/A
+/// @return		void
+///
+void CPoseShmPublisher::Close()
+{
+	if (!m_pHeader)
+		return;
+
+#if !defined(WIN32)
+	munmap(m_pHeader, s_nSegmentSize);
+	shm_unlink(m_sName.c_str());
+#endif
+
+	m_pHeader = 0;
+	m_pSlot = 0;
+}
+
+///
+/// @brief		publish a record
+/// @param		record [in] time, pose and contour
+/// @return		void
+/// @remark		wait-free (publisher thread only); does nothing if no
+///				segment is opened
+///
+void CPoseShmPublisher::Publish(const SPoseLogRecord& record)
+{
+	if (!m_pHeader)
+		return;
+
+	const uint64_t n = m_nCount;
+	SPoseShmSlot& slot = m_pSlot[n & (POSE_SHM_RING_SIZE - 1)];
+
+	float v[POSE_SHM_FIELDS];
+	Record2Fields(record, v);
+
+	/// mark busy, write the record, then publish its index
+	slot.seq.store(SLOT_BUSY, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.time.store(record.time, std::memory_order_relaxed);
+	for (int i = 0; i < POSE_SHM_FIELDS; ++i)
+		slot.field[i].store(v[i], std::memory_order_relaxed);
+	slot.seq.store(n, std::memory_order_release);
+
+	m_nCount = n + 1;
+	m_pHeader->count.store(n + 1, std::memory_order_release);
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CPoseShmSubscriber::CPoseShmSubscriber()
+: m_pHeader(0)
+, m_pSlot(0)
+, m_nSize(0)
+{
+}
+
+///
+/// @brief		destructor (unmaps the segment)
+/// @param		N/A
+/// @return		N/A
+///
+CPoseShmSubscriber::~CPoseShmSubscriber()
+{
+	Close();
+}
+
+///
+/// @brief		map a segment read-only and validate its header
+/// @param		sName [in] name of the segment
+/// @return		0 on success, -1 if occurred error (no publisher yet)
+///
+int CPoseShmSubscriber::Open(const std::string& sName)
+{
+	Close();
+
+#if defined(WIN32)
+	(void)sName;
+	return -1;
+#else
+	const int fd = shm_open(ShmName(sName).c_str(), O_RDONLY, 0);
+	if (fd < 0)
+		return -1;
+
+	struct stat st;
+	void* p = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && size_t(st.st_size) == s_nSegmentSize)
+		p = mmap(0, s_nSegmentSize, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (p == MAP_FAILED)
+		return -1;
+
+	m_pHeader = static_cast<const SPoseShmHeader*>(p);
+	m_pSlot = reinterpret_cast<const SPoseShmSlot*>(m_pHeader + 1);
+	m_nSize = s_nSegmentSize;
+
+	/// the magic string is written last by the publisher
+	const bool bValid = !memcmp(m_pHeader->magic, s_szMagic, \
+		sizeof(s_szMagic));
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (!bValid || m_pHeader->version != POSE_SHM_VERSION || \
+		m_pHeader->ringSize != POSE_SHM_RING_SIZE || \
+		m_pHeader->slotSize != sizeof(SPoseShmSlot))
+	{
+		Close();
+		return -1;
+	}
+
+	return 0;
+#endif
+}
+
+///
+/// @brief		unmap the segment
+/// @param		N/A
+/// @return		void
+///
+void CPoseShmSubscriber::Close()
+{
+	if (!m_pHeader)
+		return;
+
+#if !defined(WIN32)
+	munmap(const_cast<SPoseShmHeader*>(m_pHeader), m_nSize);
+#endif
+
+	m_pHeader = 0;
+	m_pSlot = 0;
+	m_nSize = 0;
+}
+
+///
+/// @brief		get the number of published records
+/// @param		N/A
+/// @return		number of records (0 if no segment is opened)
+///
+uint64_t CPoseShmSubscriber::GetCount() const
+{
+	return m_pHeader ? m_pHeader->count.load(std::memory_order_acquire) : 0;
+}
+
+///
+/// @brief		get the record of an index
+/// @param		nIndex [in] index of the record (0..GetCount()-1)
+/// @param		record [out] time, pose and contour
+/// @return		0 on success, -1 if not published yet, -2 if overwritten
+///				(more than POSE_SHM_RING_SIZE records behind)
+/// @remark		never blocks the publisher; copies the slot once
+///
+int CPoseShmSubscriber::Read(const uint64_t nIndex, \
+	SPoseLogRecord& record) const
+{
+	if (!m_pHeader || nIndex >= GetCount())
+		return -1;
+
+	const SPoseShmSlot& slot = m_pSlot[nIndex & (POSE_SHM_RING_SIZE - 1)];
+
+	if (slot.seq.load(std::memory_order_acquire) != nIndex)
+		return -2;
+
+	const double time = slot.time.load(std::memory_order_relaxed);
+	float v[POSE_SHM_FIELDS];
+	for (int i = 0; i < POSE_SHM_FIELDS; ++i)
+		v[i] = slot.field[i].load(std::memory_order_relaxed);
+
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (slot.seq.load(std::memory_order_relaxed) != nIndex)
+		return -2;
+
+	record.time = time;
+	Fields2Record(v, record);
+	return 0;
+}
+
+///
+/// @brief		get the latest record
+/// @param		record [out] time, pose and contour
+/// @param		pIndex [out] index of the record (optional)
+/// @return		0 on success, -1 if nothing was published (or the publisher
+///				overwrote the slot POSE_SHM_READ_RETRIES times in a row)
+///
+int CPoseShmSubscriber::GetLatest(SPoseLogRecord& record, \
+	uint64_t* pIndex) const
+{
+	for (int nRetry = 0; nRetry < POSE_SHM_READ_RETRIES; ++nRetry)
+	{
+		const uint64_t nCount = GetCount();
+		if (!nCount)
+			return -1;
+
+		if (Read(nCount - 1, record) == 0)
+		{
+			if (pIndex)
+				*pIndex = nCount - 1;
+			return 0;
+		}
+	}
+
+	return -1;
+}
@@ -0,0 +1,162 @@
+///
+/// @file		PoseShm.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Live poses and contours in POSIX shared memory (publisher and
+///				subscriber)
+///
+/// @remark		One publisher (the estimator) writes each pose and contour
+///				into a ring of POSE_SHM_RING_SIZE slots in a shared-memory
+///				segment; any number of processes map the segment read-only.
+///				Each slot is guarded by its own sequence number (seqlock), as
+///				in CPoseHistory: the publisher never waits for a reader, and a
+///				reader only retries if its slot was overwritten while being
+///				copied. A pose is visible to the readers as soon as Publish()
+///				returns (a few stores, no system call).
+///
+///				Segment layout (one cache line per slot):
+///
+///				+-----------------------+ 0
+///				| SPoseShmHeader        | magic, version, ring size, count
+///				+-----------------------+ sizeof(SPoseShmHeader)
+///				| SPoseShmSlot * R      | ring of the latest R records
+///				+-----------------------+
+///
+///				Subscribers link the tricycle_shm library (this file and
+///				PoseShm.cpp). Not available on Windows (Open() fails).
+///
+
+#ifndef _POSE_SHM_H_
+#define _POSE_SHM_H_
+
+#include <atomic>			// std::atomic
+#include <cstdint>			// uint64_t
+#include <string>			// std::string
+
+#include "PoseLog.h"		// SPoseLogRecord
+
+/// number of records in the ring (power of 2)
+#define POSE_SHM_RING_SIZE		(1024)
+
+/// number of floats of a record after the time (pose, 3 wheel positions)
+#define POSE_SHM_FIELDS			(9)
+
+/// maximum number of retries of a reader whose slot is overwritten
+#define POSE_SHM_READ_RETRIES	(16)
+
+/// version of the segment layout
+#define POSE_SHM_VERSION		(2)
+
+/// default name of the shared-memory segment
+#define POSE_SHM_DEFAULT_NAME	"/tricycle_pose"
+
+/// type definition of the segment header (two cache lines)
+typedef struct alignas(64) _tagSPoseShmHeader
+{
+	char     magic[8];		///< "TRCSHM" + '\0'
+	unsigned version;		///< POSE_SHM_VERSION
+	unsigned ringSize;		///< POSE_SHM_RING_SIZE
+	unsigned slotSize;		///< sizeof(SPoseShmSlot)
+	unsigned publisherPid;	///< process id of the publisher
+
+	/// number of published records (index of the next record)
+	alignas(64) std::atomic<uint64_t> count;
+} SPoseShmHeader;
+
+/// type definition of a slot of the ring (one cache line)
+typedef struct alignas(64) _tagSPoseShmSlot
+{
+	std::atomic<uint64_t> seq;	///< index of the record (~0: being written)
+	std::atomic<double> time;	///< timestamp of the record (sec)
+	std::atomic<float> field[POSE_SHM_FIELDS];	///< pose and contour
+} SPoseShmSlot;
+
+/// @brief		Publisher of live poses (one per segment)
+class CPoseShmPublisher
+{
+public:
+	/// constructor
+	explicit CPoseShmPublisher();
+
+	/// destructor (unmaps and removes the segment)
+	virtual ~CPoseShmPublisher();
+
+	/// create (or reset) a shared-memory segment
+	int Open(const std::string& sName = POSE_SHM_DEFAULT_NAME);
+
+	/// unmap and remove the segment
+	void Close();
+
+	/// check whether a segment is opened
+	bool IsOpen() const { return m_pHeader != 0; }
+
+	/// publish a record (wait-free)
+	void Publish(const SPoseLogRecord& record);
+
+private:
+	/// non construction-copyable
+	CPoseShmPublisher(const CPoseShmPublisher&);
+
+	/// non copyable
+	const CPoseShmPublisher& operator=(const CPoseShmPublisher&);
+
+private:
+	/// name of the segment
+	std::string m_sName;
+
+	/// header of the mapped segment
+	SPoseShmHeader* m_pHeader;
+
+	/// slots of the ring
+	SPoseShmSlot* m_pSlot;
+
+	/// number of published records
+	uint64_t m_nCount;
+};
+
+/// @brief		Subscriber of live poses (any number per segment)
+class CPoseShmSubscriber
+{
+public:
+	/// constructor
+	explicit CPoseShmSubscriber();
+
+	/// destructor (unmaps the segment)
+	virtual ~CPoseShmSubscriber();
+
+	/// map a segment read-only and validate its header
+	int Open(const std::string& sName = POSE_SHM_DEFAULT_NAME);
+
+	/// unmap the segment
+	void Close();
+
+	/// get the number of published records
+	uint64_t GetCount() const;
+
+	/// get the latest record
+	int GetLatest(SPoseLogRecord& record, uint64_t* pIndex = 0) const;
+
+	/// get the record of an index (for readers that want every record)
+	int Read(const uint64_t nIndex, SPoseLogRecord& record) const;
+
+private:
+	/// non construction-copyable
+	CPoseShmSubscriber(const CPoseShmSubscriber&);
+
+	/// non copyable
+	const CPoseShmSubscriber& operator=(const CPoseShmSubscriber&);
+
+private:
+	/// header of the mapped segment
+	const SPoseShmHeader* m_pHeader;
+
+	/// slots of the ring
+	const SPoseShmSlot* m_pSlot;
+
+	/// size of the mapping (bytes)
+	size_t m_nSize;
+};
+
+#endif // _POSE_SHM_H_
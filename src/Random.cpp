@@ -0,0 +1,156 @@
+///
+/// @file		Random.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Seedable random number generator (xoshiro256**)
+///
+
+#include <cmath>			// logf, sqrtf
+
+#include "Random.h"
+#include "math2.h"			// M_PI, SinCos
+#include "SimdMath.h"		// vLog, vSqrt, vSinCos, SIMD_LANES
+
+static_assert(RANDOM_GAUSS_GROUP % SIMD_LANES == 0, \
+	"RANDOM_GAUSS_GROUP must be a multiple of SIMD_LANES");
+
+///
+/// @brief		split a 64-bit uniform draw into two floats
+/// @param		nBits [in] random bits
+/// @param		fU1 [out] uniform float between (0..1] (for the logarithm)
+/// @param		fU2 [out] uniform float between [0..1)
+/// @return		void
+///
+static inline void SplitUniform(const uint64_t nBits, float& fU1, float& fU2)
+{
+	/// 24-bit integers (signed conversion is a single instruction)
+	fU1 = float(int32_t(nBits >> 40) + 1) * (1.f / 16777216.f);
+	fU2 = float(int32_t((nBits >> 16) & 0xFFFFFF)) * (1.f / 16777216.f);
+}
+
+///
+/// @brief		restart the sequence from a seed
+/// @param		nSeed [in] seed (any value, 0 included)
+/// @return		void
+/// @remark		the state is expanded from the seed by SplitMix64
+///
+void CRandom::Seed(const uint64_t nSeed)
+{
+	uint64_t x = nSeed;
+
+	for (int i = 0; i < 4; ++i)
+	{
+		uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		m_nState[i] = z ^ (z >> 31);
+	}
+
+	m_fCachedGauss = 0.f;
+	m_bCachedGauss = false;
+}
+
+///
+/// @brief		get a gaussian random float (Box-Muller method)
+/// @param		fMean [in] mean value
+/// @param		fStdev [in] standard deviation value
+/// @return		gaussian random float
+/// @remark		A draw gives a pair of samples, the second one is returned by
+///				the next call. The tails are cut at 5.8 sigma (24-bit
+///				uniforms).
+///
+float CRandom::Gaussian(const float fMean, const float fStdev)
+{
+	if (m_bCachedGauss)
+	{
+		m_bCachedGauss = false;
+		return fMean + fStdev * m_fCachedGauss;
+	}
+
+	float fU1, fU2, fSin, fCos;
+	SplitUniform(Next(), fU1, fU2);
+
+	const float r = sqrtf(-2.f * logf(fU1));
+	SinCos(float(2. * M_PI) * fU2, fSin, fCos);
+
+	m_fCachedGauss = r * fSin;
+	m_bCachedGauss = true;
+
+	return fMean + fStdev * (r * fCos);
+}
+
+///
+/// @brief		make a Box-Muller group of standard normal floats
+/// @param		pOut [out] 2 * RANDOM_GAUSS_GROUP floats (cosine parts, then
+///				sine parts)
+/// @return		void
+/// @remark		The group size does not depend on the SIMD width, so SSE2,
+///				AVX2 and scalar builds give the same sequence (up to the few
+///				ULP between vLog/vSinCos and logf/sinf/cosf).
+///
+void CRandom::MakeGaussGroup(float* pOut)
+{
+	float fU1[RANDOM_GAUSS_GROUP];
+	float fU2[RANDOM_GAUSS_GROUP];
+
+	for (int k = 0; k < RANDOM_GAUSS_GROUP; ++k)
+		SplitUniform(Next(), fU1[k], fU2[k]);
+
+#if (SIMD_ENABLED)
+	for (int k = 0; k < RANDOM_GAUSS_GROUP; k += SIMD_LANES)
+	{
+		vfloat s, c;
+		vfloat r = vSqrt(vMul(vSet(-2.f), vLog(vLoad(fU1 + k))));
+		vSinCos(vMul(vLoad(fU2 + k), vSet(float(2. * M_PI))), s, c);
+
+		vStore(pOut + k, vMul(r, c));
+		vStore(pOut + RANDOM_GAUSS_GROUP + k, vMul(r, s));
+	}
+#else // (SIMD_ENABLED)
+	for (int k = 0; k < RANDOM_GAUSS_GROUP; ++k)
+	{
+		float fSin, fCos;
+		const float r = sqrtf(-2.f * logf(fU1[k]));
+		SinCos(float(2. * M_PI) * fU2[k], fSin, fCos);
+
+		pOut[k] = r * fCos;
+		pOut[RANDOM_GAUSS_GROUP + k] = r * fSin;
+	}
+#endif // (SIMD_ENABLED)
+}
+
+///
+/// @brief		fill an array with gaussian random floats
+/// @param		pOut [out] gaussian random floats
+/// @param		n [in] number of floats
+/// @param		fMean [in] mean value
+/// @param		fStdev [in] standard deviation value
+/// @return		void
+/// @remark		Box-Muller over groups of RANDOM_GAUSS_GROUP pairs with the
+///				SIMD logarithm and sine/cosine. The samples of a partial last
+///				group are dropped, so a sequence depends only on the seed and
+///				the sizes of the calls.
+///
+void CRandom::FillGaussian(float* pOut, const size_t n, const float fMean, \
+	const float fStdev)
+{
+	const size_t nGroup = 2 * RANDOM_GAUSS_GROUP;
+	float fGroup[2 * RANDOM_GAUSS_GROUP];
+	size_t i = 0;
+
+	for (; i + nGroup <= n; i += nGroup)
+	{
+		MakeGaussGroup(pOut + i);
+		for (size_t k = i; k < i + nGroup; ++k)
+			pOut[k] = fMean + fStdev * pOut[k];
+	}
+
+	if (i < n)
+	{
+		MakeGaussGroup(fGroup);
+		for (size_t k = i; k < n; ++k)
+			pOut[k] = fMean + fStdev * fGroup[k - i];
+	}
+}
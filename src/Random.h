@@ -0,0 +1,101 @@
+///
+/// @file		Random.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Seedable random number generator (xoshiro256**)
+///
+/// @remark		Each instance owns its state, so generators need no locking
+///				between threads and the same seed always gives the same
+///				sequence (unlike rand()/srand(time(0)) of math2.h). Gaussian
+///				samples are made in blocks by a SIMD Box-Muller kernel.
+///
+
+#ifndef _RANDOM_H_
+#define _RANDOM_H_
+
+#include <cstddef>		// size_t
+#include <cstdint>		// uint64_t
+
+/// default seed
+#define RANDOM_DEFAULT_SEED		(20160829ULL)
+
+/// number of (cos, sin) pairs of a Box-Muller group of FillGaussian()
+#define RANDOM_GAUSS_GROUP		(8)
+
+/// @brief		Seedable random number generator (xoshiro256**)
+class CRandom
+{
+public:
+	/// constructor
+	explicit CRandom(const uint64_t nSeed = RANDOM_DEFAULT_SEED)
+	{ Seed(nSeed); }
+
+	/// destructor
+	virtual ~CRandom() {}
+
+	/// restart the sequence from a seed
+	void Seed(const uint64_t nSeed);
+
+	/// get the next 64 random bits
+	uint64_t Next();
+
+	/// get a uniform random float between [0..1)
+	float Uniform()
+	{ return float(int32_t(Next() >> 40)) * (1.f / 16777216.f); }
+
+	/// get a gaussian random float
+	float Gaussian(const float fMean, const float fStdev);
+
+	/// fill an array with gaussian random floats (SIMD)
+	void FillGaussian(float* pOut, const size_t n, const float fMean, \
+		const float fStdev);
+
+private:
+	/// rotate left
+	static uint64_t Rotl(const uint64_t x, const int k)
+	{ return (x << k) | (x >> (64 - k)); }
+
+	/// make a Box-Muller group of standard normal floats
+	void MakeGaussGroup(float* pOut);
+
+private:
+	/// non construction-copyable
+	CRandom(const CRandom&);
+
+	/// non copyable
+	const CRandom& operator=(const CRandom&);
+
+private:
+	/// generator state
+	uint64_t m_nState[4];
+
+	/// second standard normal float of the last pair of Gaussian()
+	//@{
+	float m_fCachedGauss;
+	bool m_bCachedGauss;
+	//@}
+};
+
+///
+/// @brief		get the next 64 random bits
+/// @param		N/A
+/// @return		random bits
+///
+inline uint64_t CRandom::Next()
+{
+	const uint64_t nResult = Rotl(m_nState[1] * 5, 7) * 9;
+	const uint64_t t = m_nState[1] << 17;
+
+	m_nState[2] ^= m_nState[0];
+	m_nState[3] ^= m_nState[1];
+	m_nState[1] ^= m_nState[2];
+	m_nState[0] ^= m_nState[3];
+	m_nState[2] ^= t;
+	m_nState[3] = Rotl(m_nState[3], 45);
+
+	return nResult;
+}
+
+#endif // _RANDOM_H_
@@ -0,0 +1,36 @@
+///
+/// @file		Record.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		input record of the pose estimator (a line of NN_input.csv)
+///
+
+#ifndef _RECORD_H_
+#define _RECORD_H_
+
+/// type definition to represent an input record
+///
+/// @remark		time_ns keeps the timestamp exactly as written in the input
+///				(a float second loses 4 ms after 12 hours). Time differences
+///				must be taken from time_ns; time is kept for output.
+///
+typedef struct _tagSRecord
+{
+	long long time_ns;			///< time of reading (unit: ns, exact)
+	float time;					///< time of reading (unit: sec)
+	float steering_angle;		///< steering wheel angle (unit: rad)
+	int   encoder_ticks;		///< encoder ticks (unit: ticks)
+	float angular_velocity;		///< gyro reading (unit: rad/s)
+
+	/// default constructor
+	explicit _tagSRecord()
+	: time_ns(0)
+	, time(0.f)
+	, steering_angle(0.f)
+	, encoder_ticks(0)
+	, angular_velocity(0.f) {}
+} SRecord;
+
+#endif // _RECORD_H_
@@ -0,0 +1,571 @@
+///
+/// @file		RecordArchive.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Chunked columnar archive of input records (SRecord)
+///
+
+#include <algorithm>		// std::min, std::max, std::remove_if
+#include <cmath>			// fabs, floor
+#include <cstring>			// memcpy, memcmp, memset
+
+#include "RecordArchive.h"
+#include "math2.h"			// Ns2Sec
+
+/// magic string of the header
+static const char s_szHeaderMagic[8] = "TRCARCH";
+
+/// magic string of the trailer
+static const char s_szTrailerMagic[8] = "TRCAIDX";
+
+/// columns of a chunk
+enum
+{
+	COLUMN_TIME = 0,		///< timestamp (delta of delta, ns)
+	COLUMN_STEERING,		///< quantized steering angle (delta)
+	COLUMN_TICKS,			///< encoder ticks (delta)
+	COLUMN_ANGVEL			///< quantized angular velocity (delta)
+};
+
+///
+/// @brief		append a signed integer as a zigzag varint
+/// @param		v [in/out] column
+/// @param		n [in] value
+/// @return		void
+/// @remark		7 bits per byte, so small deltas of either sign take 1 byte
+///
+static inline void PutVarint(std::vector<unsigned char>& v, const long long n)
+{
+	unsigned long long u = (static_cast<unsigned long long>(n) << 1) \
+		^ static_cast<unsigned long long>(n >> 63);
+
+	while (u >= 0x80)
+	{
+		v.push_back(static_cast<unsigned char>(u | 0x80));
+		u >>= 7;
+	}
+	v.push_back(static_cast<unsigned char>(u));
+}
+
+///
+/// @brief		read a zigzag varint
+/// @param		p [in/out] position in the column
+/// @param		pEnd [in] end of the column
+/// @param		n [out] value
+/// @return		true on success, false if the column is corrupted
+///
+static inline bool GetVarint(const unsigned char*& p, \
+	const unsigned char* pEnd, long long& n)
+{
+	unsigned long long u = 0;
+
+	for (int nShift = 0; nShift < 64; nShift += 7)
+	{
+		if (p >= pEnd)
+			return false;
+
+		const unsigned char c = *p++;
+		u |= static_cast<unsigned long long>(c & 0x7F) << nShift;
+		if (!(c & 0x80))
+		{
+			n = static_cast<long long>(u >> 1) ^ -static_cast<long long>(u & 1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+///
+/// @brief		quantize an angle
+/// @param		v [in] angle (rad) or angular velocity (rad/s)
+/// @param		dQuantum [in] quantum
+/// @return		nearest multiple of the quantum (0 for inf, nan)
+///
+static inline long long Quantize(const float v, const double dQuantum)
+{
+	const double d = double(v) / dQuantum;
+
+	return (fabs(d) < 4e18) ? static_cast<long long>(floor(d + 0.5)) : 0;
+}
+
+///
+/// @brief		check whether a buffer starts with the header of a record
+///				archive
+/// @param		pData [in] beginning of the buffer
+/// @param		nSize [in] size of the buffer (bytes)
+/// @return		true if the magic string of the header matches
+///
+bool IsRecordArchive(const char* pData, const size_t nSize)
+{
+	return nSize >= sizeof(SRecordArchiveHeader) && \
+		!memcmp(pData, s_szHeaderMagic, sizeof(s_szHeaderMagic));
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CRecordArchiveWriter::CRecordArchiveWriter()
+: m_fp(0)
+, m_dQuantum(RECORD_ARCHIVE_QUANTUM)
+, m_nOffset(0)
+, m_nRecords(0)
+, m_bError(false)
+{
+}
+
+///
+/// @brief		destructor (closes the file)
+/// @param		N/A
+/// @return		N/A
+///
+CRecordArchiveWriter::~CRecordArchiveWriter()
+{
+	Close();
+}
+
+///
+/// @brief		create an archive file and write the header
+/// @param		sFilename [in] filename to create
+/// @param		dQuantum [in] quantum of the steering angle and angular
+///				velocity (rad, rad/s)
+/// @param		nFlags [in] flags of the header (RECORD_ARCHIVE_FLAG_*)
+/// @return		0 on success, -1 if occurred error
+///
+int CRecordArchiveWriter::Open(const std::string& sFilename, \
+	const double dQuantum, const unsigned nFlags)
+{
+	/// close the previous file
+	Close();
+
+	if (!(dQuantum > 0.))
+		return -1;
+
+	m_fp = fopen(sFilename.c_str(), "wb");
+	if (!m_fp)
+		return -1;
+
+	m_dQuantum = dQuantum;
+	m_vRecord.clear();
+	m_vRecord.reserve(RECORD_ARCHIVE_CHUNK_SIZE);
+	m_vChunk.clear();
+	m_nRecords = 0;
+	m_bError = false;
+
+	/// write the header
+	//@{
+	SRecordArchiveHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, s_szHeaderMagic, sizeof(header.magic));
+	header.version = RECORD_ARCHIVE_VERSION;
+	header.chunkSize = RECORD_ARCHIVE_CHUNK_SIZE;
+	header.quantum = dQuantum;
+	header.flags = nFlags;
+
+	if (fwrite(&header, sizeof(header), 1, m_fp) != 1)
+		m_bError = true;
+	m_nOffset = sizeof(header);
+	//@}
+
+	return m_bError ? -1 : 0;
+}
+
+///
+/// @brief		append a record
+/// @param		record [in] input record
+/// @return		0 on success, -1 if occurred error
+///
+int CRecordArchiveWriter::Write(const SRecord& record)
+{
+	if (!m_fp || m_bError)
+		return -1;
+
+	m_vRecord.push_back(record);
+	++m_nRecords;
+
+	if (m_vRecord.size() == RECORD_ARCHIVE_CHUNK_SIZE)
+		return Flush();
+
+	return 0;
+}
+
+///
+/// @brief		encode the buffered records as a chunk and write it
+/// @param		N/A
+/// @return		0 on success, -1 if occurred error
+///
+int CRecordArchiveWriter::Flush()
+{
+	if (m_vRecord.empty())
+		return m_bError ? -1 : 0;
+
+	SRecordArchiveChunk chunk;
+	memset(&chunk, 0, sizeof(chunk));
+	chunk.offset = m_nOffset;
+	chunk.count = unsigned(m_vRecord.size());
+	chunk.timeMin = chunk.timeMax = m_vRecord[0].time_ns;
+	chunk.steerMin = chunk.steerMax = float(double(Quantize( \
+		m_vRecord[0].steering_angle, m_dQuantum)) * m_dQuantum);
+	chunk.ticksMin = chunk.ticksMax = m_vRecord[0].encoder_ticks;
+
+	for (int c = 0; c < RECORD_ARCHIVE_COLUMNS; ++c)
+		m_vColumn[c].clear();
+
+	/// encode the columns (each chunk starts from zero)
+	//@{
+	long long nPrevTime = 0, nPrevDelta = 0;
+	long long nPrevSteer = 0, nPrevTicks = 0, nPrevAngVel = 0;
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+	{
+		const SRecord& r = m_vRecord[i];
+
+		const long long nDelta = r.time_ns - nPrevTime;
+		PutVarint(m_vColumn[COLUMN_TIME], nDelta - nPrevDelta);
+		nPrevTime = r.time_ns;
+		nPrevDelta = nDelta;
+
+		const long long nSteer = Quantize(r.steering_angle, m_dQuantum);
+		PutVarint(m_vColumn[COLUMN_STEERING], nSteer - nPrevSteer);
+		nPrevSteer = nSteer;
+
+		PutVarint(m_vColumn[COLUMN_TICKS], r.encoder_ticks - nPrevTicks);
+		nPrevTicks = r.encoder_ticks;
+
+		const long long nAngVel = Quantize(r.angular_velocity, m_dQuantum);
+		PutVarint(m_vColumn[COLUMN_ANGVEL], nAngVel - nPrevAngVel);
+		nPrevAngVel = nAngVel;
+
+		chunk.timeMin = std::min(chunk.timeMin, r.time_ns);
+		chunk.timeMax = std::max(chunk.timeMax, r.time_ns);
+		/// statistics of the decoded angle (an archive of the decoded
+		/// records is the same file)
+		const float fSteer = float(double(nSteer) * m_dQuantum);
+		chunk.steerMin = std::min(chunk.steerMin, fSteer);
+		chunk.steerMax = std::max(chunk.steerMax, fSteer);
+		chunk.ticksMin = std::min(chunk.ticksMin, r.encoder_ticks);
+		chunk.ticksMax = std::max(chunk.ticksMax, r.encoder_ticks);
+	}
+	//@}
+
+	/// write the columns
+	for (int c = 0; c < RECORD_ARCHIVE_COLUMNS; ++c)
+	{
+		const std::vector<unsigned char>& v = m_vColumn[c];
+		if (fwrite(&v[0], 1, v.size(), m_fp) != v.size())
+			m_bError = true;
+		chunk.size[c] = unsigned(v.size());
+		m_nOffset += v.size();
+	}
+
+	m_vChunk.push_back(chunk);
+	m_vRecord.clear();
+
+	return m_bError ? -1 : 0;
+}
+
+///
+/// @brief		write the last chunk, the chunk index and the trailer and
+///				close the file
+/// @param		N/A
+/// @return		0 on success, -1 if occurred error
+/// @remark		the chunk index is aligned to 8 bytes
+///
+int CRecordArchiveWriter::Close()
+{
+	if (!m_fp)
+		return 0;
+
+	/// records written so far
+	Flush();
+
+	/// write the padding, the chunk index and the trailer
+	//@{
+	static const char s_szPadding[8] = { 0 };
+	const size_t nPadding = size_t((8 - m_nOffset % 8) % 8);
+	if (nPadding && fwrite(s_szPadding, 1, nPadding, m_fp) != nPadding)
+		m_bError = true;
+
+	SRecordArchiveTrailer trailer;
+	memset(&trailer, 0, sizeof(trailer));
+	trailer.recordCount = m_nRecords;
+	trailer.indexOffset = m_nOffset + nPadding;
+	trailer.chunkCount = m_vChunk.size();
+	memcpy(trailer.magic, s_szTrailerMagic, sizeof(trailer.magic));
+
+	if (!m_vChunk.empty() && fwrite(&m_vChunk[0], \
+		sizeof(SRecordArchiveChunk), m_vChunk.size(), m_fp) != m_vChunk.size())
+		m_bError = true;
+	if (fwrite(&trailer, sizeof(trailer), 1, m_fp) != 1)
+		m_bError = true;
+	//@}
+
+	if (fclose(m_fp) != 0)
+		m_bError = true;
+	m_fp = 0;
+
+	/// release the buffers
+	std::vector<SRecord>().swap(m_vRecord);
+	std::vector<SRecordArchiveChunk>().swap(m_vChunk);
+	for (int c = 0; c < RECORD_ARCHIVE_COLUMNS; ++c)
+		std::vector<unsigned char>().swap(m_vColumn[c]);
+
+	return m_bError ? -1 : 0;
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CRecordArchiveReader::CRecordArchiveReader()
+: m_pData(0)
+, m_dQuantum(RECORD_ARCHIVE_QUANTUM)
+, m_nFlags(0)
+, m_pChunks(0)
+, m_nChunks(0)
+, m_nRecords(0)
+{
+}
+
+///
+/// @brief		map an archive file and validate its header, index and
+///				trailer
+/// @param		sFilename [in] filename to open
+/// @return		0 on success, -1 if occurred error
+///
+int CRecordArchiveReader::Open(const std::string& sFilename)
+{
+	Close();
+
+	if (m_file.Open(sFilename) != 0)
+		return -1;
+
+	if (Attach(m_file.GetData(), m_file.GetSize()) != 0)
+	{
+		Close();
+		return -1;
+	}
+
+	return 0;
+}
+
+///
+/// @brief		validate an archive in a buffer kept by the caller
+/// @param		pData [in] beginning of the archive (aligned to 8 bytes)
+/// @param		nSize [in] size of the archive (bytes)
+/// @return		0 on success, -1 if the buffer is not a valid archive
+/// @remark		the buffer must stay valid while the reader is used
+///
+int CRecordArchiveReader::Attach(const char* pData, const size_t nSize)
+{
+	m_pData = 0;
+	m_nFlags = 0;
+	m_pChunks = 0;
+	m_nChunks = 0;
+	m_nRecords = 0;
+
+	/// header and trailer
+	//@{
+	if (!pData || \
+		nSize < sizeof(SRecordArchiveHeader) + sizeof(SRecordArchiveTrailer))
+		return -1;
+
+	SRecordArchiveHeader header;
+	SRecordArchiveTrailer trailer;
+	memcpy(&header, pData, sizeof(header));
+	memcpy(&trailer, pData + nSize - sizeof(trailer), sizeof(trailer));
+
+	if (memcmp(header.magic, s_szHeaderMagic, sizeof(header.magic)) || \
+		memcmp(trailer.magic, s_szTrailerMagic, sizeof(trailer.magic)) || \
+		header.version != RECORD_ARCHIVE_VERSION || \
+		header.chunkSize == 0 || !(header.quantum > 0.))
+		return -1;
+	//@}
+
+	/// check that the chunk index fills the file up to the trailer
+	//@{
+	const unsigned long long nIndexSize = nSize - sizeof(trailer) \
+		- sizeof(header);
+	if (trailer.indexOffset % 8 || trailer.indexOffset < sizeof(header) || \
+		trailer.chunkCount > nIndexSize / sizeof(SRecordArchiveChunk) || \
+		trailer.indexOffset + trailer.chunkCount \
+			* sizeof(SRecordArchiveChunk) + sizeof(trailer) != nSize)
+		return -1;
+	//@}
+
+	/// check that the chunks lie before the index and hold all records
+	//@{
+	const SRecordArchiveChunk* pChunks = \
+		reinterpret_cast<const SRecordArchiveChunk*>(pData + trailer.indexOffset);
+	unsigned long long nRecords = 0;
+	for (size_t i = 0; i < size_t(trailer.chunkCount); ++i)
+	{
+		const SRecordArchiveChunk& chunk = pChunks[i];
+
+		unsigned long long nEnd = chunk.offset;
+		for (int c = 0; c < RECORD_ARCHIVE_COLUMNS; ++c)
+			nEnd += chunk.size[c];
+		if (chunk.offset < sizeof(header) || nEnd > trailer.indexOffset || \
+			chunk.count == 0 || chunk.count > header.chunkSize)
+			return -1;
+
+		nRecords += chunk.count;
+	}
+	if (nRecords != trailer.recordCount)
+		return -1;
+	//@}
+
+	m_pData = pData;
+	m_dQuantum = header.quantum;
+	m_nFlags = header.flags;
+	m_pChunks = pChunks;
+	m_nChunks = size_t(trailer.chunkCount);
+	m_nRecords = size_t(trailer.recordCount);
+
+	return 0;
+}
+
+///
+/// @brief		unmap the archive file
+/// @param		N/A
+/// @return		void
+///
+void CRecordArchiveReader::Close()
+{
+	m_file.Close();
+
+	m_pData = 0;
+	m_nFlags = 0;
+	m_pChunks = 0;
+	m_nChunks = 0;
+	m_nRecords = 0;
+}
+
+///
+/// @brief		decode a chunk
+/// @param		nChunk [in] chunk (0..GetChunkCount()-1)
+/// @param		pRecord [out] GetChunk(nChunk).count records
+/// @return		0 on success, -1 if the chunk is corrupted
+///
+int CRecordArchiveReader::DecodeChunk(const size_t nChunk, \
+	SRecord* pRecord) const
+{
+	const SRecordArchiveChunk& chunk = m_pChunks[nChunk];
+
+	/// columns of the chunk
+	//@{
+	const unsigned char* p[RECORD_ARCHIVE_COLUMNS];
+	const unsigned char* pEnd[RECORD_ARCHIVE_COLUMNS];
+	const unsigned char* pColumn = \
+		reinterpret_cast<const unsigned char*>(m_pData + chunk.offset);
+	for (int c = 0; c < RECORD_ARCHIVE_COLUMNS; ++c)
+	{
+		p[c] = pColumn;
+		pColumn += chunk.size[c];
+		pEnd[c] = pColumn;
+	}
+	//@}
+
+	long long nTime = 0, nDelta = 0;
+	long long nSteer = 0, nTicks = 0, nAngVel = 0;
+	long long n = 0;
+	for (unsigned i = 0; i < chunk.count; ++i)
+	{
+		SRecord& r = pRecord[i];
+
+		if (!GetVarint(p[COLUMN_TIME], pEnd[COLUMN_TIME], n))
+			return -1;
+		nDelta += n;
+		nTime += nDelta;
+		r.time_ns = nTime;
+		r.time = float(Ns2Sec(nTime));
+
+		if (!GetVarint(p[COLUMN_STEERING], pEnd[COLUMN_STEERING], n))
+			return -1;
+		nSteer += n;
+		r.steering_angle = float(double(nSteer) * m_dQuantum);
+
+		if (!GetVarint(p[COLUMN_TICKS], pEnd[COLUMN_TICKS], n))
+			return -1;
+		nTicks += n;
+		r.encoder_ticks = int(nTicks);
+
+		if (!GetVarint(p[COLUMN_ANGVEL], pEnd[COLUMN_ANGVEL], n))
+			return -1;
+		nAngVel += n;
+		r.angular_velocity = float(double(nAngVel) * m_dQuantum);
+	}
+
+	return 0;
+}
+
+///
+/// @brief		decode all records and append them
+/// @param		vRecord [out] vector to append records to
+/// @return		number of appended records, -1 if a chunk is corrupted
+/// @remark		the chunks are decoded in place at the end of the vector
+///
+int CRecordArchiveReader::Read(std::vector<SRecord>& vRecord) const
+{
+	const size_t nBegin = vRecord.size();
+	vRecord.resize(nBegin + m_nRecords);
+
+	size_t nPos = nBegin;
+	for (size_t i = 0; i < m_nChunks; ++i)
+	{
+		if (DecodeChunk(i, &vRecord[nPos]) != 0)
+		{
+			vRecord.resize(nBegin);
+			return -1;
+		}
+		nPos += m_pChunks[i].count;
+	}
+
+	return int(m_nRecords);
+}
+
+///
+/// @brief		decode the records in a time range and append them
+/// @param		nBeginNs [in] first timestamp of the range (ns)
+/// @param		nEndNs [in] last timestamp of the range (ns, inclusive)
+/// @param		vRecord [out] vector to append records to
+/// @return		number of appended records, -1 if a chunk is corrupted
+/// @remark		chunks whose [timeMin..timeMax] is out of the range are not
+///				decoded
+///
+int CRecordArchiveReader::ReadRange(const long long nBeginNs, \
+	const long long nEndNs, std::vector<SRecord>& vRecord) const
+{
+	const size_t nBegin = vRecord.size();
+
+	for (size_t i = 0; i < m_nChunks; ++i)
+	{
+		const SRecordArchiveChunk& chunk = m_pChunks[i];
+		if (chunk.timeMax < nBeginNs || chunk.timeMin > nEndNs)
+			continue;
+
+		const size_t nPos = vRecord.size();
+		vRecord.resize(nPos + chunk.count);
+		if (DecodeChunk(i, &vRecord[nPos]) != 0)
+		{
+			vRecord.resize(nBegin);
+			return -1;
+		}
+
+		/// drop the records out of the range at the edges of the range
+		if (chunk.timeMin < nBeginNs || chunk.timeMax > nEndNs)
+		{
+			vRecord.erase(std::remove_if(vRecord.begin() + nPos, \
+				vRecord.end(), [=](const SRecord& r)
+				{
+					return r.time_ns < nBeginNs || r.time_ns > nEndNs;
+				}), vRecord.end());
+		}
+	}
+
+	return int(vRecord.size() - nBegin);
+}
@@ -0,0 +1,227 @@
+///
+/// @file		RecordArchive.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Chunked columnar archive of input records (SRecord)
+///
+/// @remark		File layout (native little-endian byte order):
+///
+///				+------------------------------+ 0
+///				| SRecordArchiveHeader         |
+///				+------------------------------+ sizeof(SRecordArchiveHeader)
+///				| chunk 0: time | steering |   | RECORD_ARCHIVE_COLUMNS
+///				|          ticks | ang. vel.   | columns one after another
+///				| chunk 1 ...                  |
+///				+------------------------------+ index offset
+///				| SRecordArchiveChunk * C      | offset, sizes and statistics
+///				+------------------------------+
+///				| SRecordArchiveTrailer        |
+///				+------------------------------+ end of file
+///
+///				A chunk holds up to RECORD_ARCHIVE_CHUNK_SIZE records. Each
+///				column is a sequence of zigzag varints: the timestamp as the
+///				delta of its delta (ns; 1 byte at a fixed sample rate), the
+///				encoder ticks as a delta, and the steering angle and angular
+///				velocity as deltas of values quantized by the quantum of the
+///				header. A chunk decodes on its own, and its min/max statistics
+///				let a time range skip it without decoding. Only the angles are
+///				lossy (error <= quantum / 2).
+///
+
+#ifndef _RECORD_ARCHIVE_H_
+#define _RECORD_ARCHIVE_H_
+
+#include <cstdio>			// FILE
+#include <string>			// std::string
+#include <vector>			// std::vector
+
+#include "Record.h"			// SRecord
+#include "MappedFile.h"		// CMappedFile
+
+/// number of records per chunk
+#define RECORD_ARCHIVE_CHUNK_SIZE	(4096)
+
+/// number of columns of a chunk (time, steering, ticks, angular velocity)
+#define RECORD_ARCHIVE_COLUMNS		(4)
+
+/// default quantum of the steering angle and angular velocity (rad, rad/s)
+#define RECORD_ARCHIVE_QUANTUM		(1e-6)
+
+/// version of the file format
+#define RECORD_ARCHIVE_VERSION		(1)
+
+/// flag of the header: the angular velocity column came from the input
+/// (otherwise it is zero and the input had no gyro)
+#define RECORD_ARCHIVE_FLAG_GYRO	(1U)
+
+/// type definition of the file header (32 bytes)
+typedef struct _tagSRecordArchiveHeader
+{
+	char     magic[8];		///< "TRCARCH" + '\0'
+	unsigned version;		///< RECORD_ARCHIVE_VERSION
+	unsigned chunkSize;		///< records per chunk
+	double   quantum;		///< quantum of the angles (rad, rad/s)
+	unsigned flags;			///< RECORD_ARCHIVE_FLAG_*
+	unsigned reserved;		///< zero
+} SRecordArchiveHeader;
+
+/// type definition of an entry of the chunk index (64 bytes)
+typedef struct _tagSRecordArchiveChunk
+{
+	unsigned long long offset;	///< offset of the chunk (bytes)
+	unsigned count;				///< number of records
+	unsigned size[RECORD_ARCHIVE_COLUMNS];	///< bytes of each column
+	unsigned reserved;			///< zero
+	long long timeMin;			///< smallest timestamp (ns)
+	long long timeMax;			///< largest timestamp (ns)
+	float steerMin;				///< smallest decoded steering angle (rad)
+	float steerMax;				///< largest decoded steering angle (rad)
+	int   ticksMin;				///< smallest encoder ticks
+	int   ticksMax;				///< largest encoder ticks
+} SRecordArchiveChunk;
+
+/// type definition of the file trailer (32 bytes)
+typedef struct _tagSRecordArchiveTrailer
+{
+	unsigned long long recordCount;	///< number of records
+	unsigned long long indexOffset;	///< offset of the chunk index (bytes)
+	unsigned long long chunkCount;	///< number of chunks
+	char               magic[8];	///< "TRCAIDX" + '\0'
+} SRecordArchiveTrailer;
+
+/// check whether a buffer starts with the header of a record archive
+bool IsRecordArchive(const char* pData, const size_t nSize);
+
+/// @brief		Writer of the record archive (one chunk buffered)
+class CRecordArchiveWriter
+{
+public:
+	/// constructor
+	explicit CRecordArchiveWriter();
+
+	/// destructor (closes the file)
+	virtual ~CRecordArchiveWriter();
+
+	/// create an archive file
+	int Open(const std::string& sFilename, \
+		const double dQuantum = RECORD_ARCHIVE_QUANTUM, \
+		const unsigned nFlags = 0);
+
+	/// append a record
+	int Write(const SRecord& record);
+
+	/// write the chunk index and close the file
+	int Close();
+
+private:
+	/// encode the buffered records as a chunk and write it
+	int Flush();
+
+private:
+	/// non construction-copyable
+	CRecordArchiveWriter(const CRecordArchiveWriter&);
+
+	/// non copyable
+	const CRecordArchiveWriter& operator=(const CRecordArchiveWriter&);
+
+private:
+	/// file pointer
+	FILE* m_fp;
+
+	/// quantum of the angles (rad, rad/s)
+	double m_dQuantum;
+
+	/// records of the current chunk
+	std::vector<SRecord> m_vRecord;
+
+	/// encoded columns of the current chunk
+	std::vector<unsigned char> m_vColumn[RECORD_ARCHIVE_COLUMNS];
+
+	/// index of the written chunks
+	std::vector<SRecordArchiveChunk> m_vChunk;
+
+	/// offset of the next chunk (bytes)
+	unsigned long long m_nOffset;
+
+	/// number of written records
+	unsigned long long m_nRecords;
+
+	/// whether an error occurred while writing
+	bool m_bError;
+};
+
+/// @brief		Memory-mapped reader of the record archive
+class CRecordArchiveReader
+{
+public:
+	/// constructor
+	explicit CRecordArchiveReader();
+
+	/// destructor
+	virtual ~CRecordArchiveReader() {}
+
+	/// map an archive file and validate its header, index and trailer
+	int Open(const std::string& sFilename);
+
+	/// validate an archive in a buffer kept by the caller
+	int Attach(const char* pData, const size_t nSize);
+
+	/// unmap the archive file
+	void Close();
+
+	/// get the number of records
+	size_t GetCount() const { return m_nRecords; }
+
+	/// get the flags of the header (RECORD_ARCHIVE_FLAG_*)
+	unsigned GetFlags() const { return m_nFlags; }
+
+	/// get the number of chunks
+	size_t GetChunkCount() const { return m_nChunks; }
+
+	/// get an entry of the chunk index
+	const SRecordArchiveChunk& GetChunk(const size_t nChunk) const \
+		{ return m_pChunks[nChunk]; }
+
+	/// decode a chunk into GetChunk(nChunk).count records
+	int DecodeChunk(const size_t nChunk, SRecord* pRecord) const;
+
+	/// decode all records and append them
+	int Read(std::vector<SRecord>& vRecord) const;
+
+	/// decode the records in a time range and append them
+	int ReadRange(const long long nBeginNs, const long long nEndNs, \
+		std::vector<SRecord>& vRecord) const;
+
+private:
+	/// non construction-copyable
+	CRecordArchiveReader(const CRecordArchiveReader&);
+
+	/// non copyable
+	const CRecordArchiveReader& operator=(const CRecordArchiveReader&);
+
+private:
+	/// mapped archive file (not opened after Attach())
+	CMappedFile m_file;
+
+	/// first byte of the archive
+	const char* m_pData;
+
+	/// quantum of the angles (rad, rad/s)
+	double m_dQuantum;
+
+	/// flags of the header (RECORD_ARCHIVE_FLAG_*)
+	unsigned m_nFlags;
+
+	/// chunk index
+	const SRecordArchiveChunk* m_pChunks;
+
+	/// number of chunks
+	size_t m_nChunks;
+
+	/// number of records
+	size_t m_nRecords;
+};
+
+#endif // _RECORD_ARCHIVE_H_
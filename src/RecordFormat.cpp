@@ -0,0 +1,133 @@
+///
+/// @file		RecordFormat.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Fast text formatting of output records (NN_pose.txt,
+///				NN_contour.txt)
+///
+
+#include <cmath>			// rint, fabs, floor
+#include <cstdio>			// snprintf
+#include <cstring>			// memcpy
+
+#include "RecordFormat.h"
+
+///
+/// @brief		format a value with 6 decimals (same as printf("%f"))
+///
+/// @param		p [out] output buffer (at least 48 characters)
+/// @param		v [in] value (a float or a timestamp in seconds)
+///
+/// @return		end of the formatted text (not null-terminated)
+///
+/// @remark		Below 10^12, v * 1e6 differs from the exact product by less
+///				than 10^-4, so rint() rounds it half-to-even like printf
+///				except near a tie. Ties, huge values, NaN and infinity use
+///				snprintf.
+///
+char* FormatFixed6(char* p, const double v)
+{
+	const double d = v * 1e6;
+
+	if (!(fabs(d) < 1e12) || fabs(fabs(d) - floor(fabs(d)) - 0.5) < 1e-3)
+		return p + snprintf(p, 48, "%f", v);
+
+	/// sign (printf keeps the sign of negative values rounding to zero)
+	if (std::signbit(v))
+		*p++ = '-';
+
+	unsigned long long n = (unsigned long long)rint(fabs(d));
+
+	/// integer part (reversed), then the 6 decimals
+	//@{
+	char digits[24];
+	int nDigits = 0;
+	unsigned long long nInt = n / 1000000ull;
+	unsigned nFrac = unsigned(n % 1000000ull);
+
+	do
+	{
+		digits[nDigits++] = char('0' + nInt % 10);
+		nInt /= 10;
+	} while (nInt);
+
+	while (nDigits)
+		*p++ = digits[--nDigits];
+
+	*p++ = '.';
+	for (int i = 5; i >= 0; --i)
+	{
+		p[i] = char('0' + nFrac % 10);
+		nFrac /= 10;
+	}
+	//@}
+
+	return p + 6;
+}
+
+///
+/// @brief		format a line of NN_pose.txt
+/// @param		p [out] output buffer (at least POSE_LINE_MAX characters)
+/// @param		time [in] timestamp (sec)
+/// @param		pose [in] robot pose
+/// @return		end of the formatted text (not null-terminated)
+///
+char* FormatPoseLine(char* p, const double time, const SPose& pose)
+{
+	p = FormatFixed6(p, time);
+	*p++ = '\t';
+	p = FormatFixed6(p, pose.x);
+	*p++ = '\t';
+	p = FormatFixed6(p, pose.y);
+	*p++ = '\t';
+	p = FormatFixed6(p, pose.q);
+	*p++ = '\n';
+
+	return p;
+}
+
+///
+/// @brief		format a point line ("x\ty\n")
+/// @param		p [out] output buffer
+/// @param		x [in] position x (m)
+/// @param		y [in] position y (m)
+/// @return		end of the formatted text
+///
+static inline char* FormatPoint(char* p, const float x, const float y)
+{
+	p = FormatFixed6(p, x);
+	*p++ = '\t';
+	p = FormatFixed6(p, y);
+	*p++ = '\n';
+
+	return p;
+}
+
+///
+/// @brief		format a block of NN_contour.txt
+///
+/// @param		p [out] output buffer (at least CONTOUR_BLOCK_MAX characters)
+/// @param		pose [in] robot pose
+/// @param		posFW [in] position of the front wheel
+/// @param		posLW [in] position of the left wheel
+/// @param		posRW [in] position of the right wheel
+///
+/// @return		end of the formatted text (not null-terminated)
+///
+/// @remark		robot, left, front, right, robot and a blank line, as
+///				CTestTricycle::Write()
+///
+char* FormatContourBlock(char* p, const SPose& pose, const SPos& posFW, \
+	const SPos& posLW, const SPos& posRW)
+{
+	p = FormatPoint(p, pose.x, pose.y);
+	p = FormatPoint(p, posLW.x, posLW.y);
+	p = FormatPoint(p, posFW.x, posFW.y);
+	p = FormatPoint(p, posRW.x, posRW.y);
+	p = FormatPoint(p, pose.x, pose.y);
+	*p++ = '\n';
+
+	return p;
+}
@@ -0,0 +1,36 @@
+///
+/// @file		RecordFormat.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Fast text formatting of output records (NN_pose.txt,
+///				NN_contour.txt)
+///
+/// @remark		The output is byte-identical to printf("%f") and to
+///				std::ostream with std::fixed, which the result files used so
+///				far, but needs no locale, stream or format-string handling.
+///
+
+#ifndef _RECORD_FORMAT_H_
+#define _RECORD_FORMAT_H_
+
+#include "Pose.h"		// SPos, SPose
+
+/// maximum length of a formatted pose line (FormatPoseLine())
+#define POSE_LINE_MAX		(4 * 48)
+
+/// maximum length of a formatted contour block (FormatContourBlock())
+#define CONTOUR_BLOCK_MAX	(10 * 48 + 8)
+
+/// format a value with 6 decimals (same as printf("%f")), not terminated
+char* FormatFixed6(char* p, const double v);
+
+/// format a line of NN_pose.txt ("time\tx\ty\tq\n"), not terminated
+char* FormatPoseLine(char* p, const double time, const SPose& pose);
+
+/// format a block of NN_contour.txt (5 points and a blank line)
+char* FormatContourBlock(char* p, const SPose& pose, const SPos& posFW, \
+	const SPos& posLW, const SPos& posRW);
+
+#endif // _RECORD_FORMAT_H_
@@ -0,0 +1,519 @@
+///
+/// @file		RecordParser.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		In-place parser for input records (NN_input.csv)
+///
+
+#include <climits>			// INT_MIN, INT_MAX
+#include <cmath>			// fabs
+#include <cstdlib>			// strtod
+#include <cstring>			// memchr, memcpy
+#include <string>			// std::string
+
+#include "RecordParser.h"
+#include "math2.h"			// Sec2Ns
+
+//==============================================================================
+//
+// Format of the input file
+// ------------------------
+//
+//     #comment
+//     time,steering_angle,encoder_ticks[,angular_velocity]
+//
+// Lines starting with '#' and blank lines are skipped. Both "\n" and "\r\n"
+// line endings are accepted. Missing fields are read as zero.
+//
+//==============================================================================
+
+/// exactly representable powers of 10 in double (fast path of ParseFloat)
+static const double s_dPow10[] =
+{
+	1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/// powers of 10 in integer (exact conversion to nanoseconds)
+static const unsigned long long s_nPow10[] =
+{
+	1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+	10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+	100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+	100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+	100000000000000000ULL, 1000000000000000000ULL
+};
+
+///
+/// @brief		check whether a character is a decimal digit
+/// @param		c [in] character
+/// @return		true: digit, false: not a digit
+///
+static inline bool isDigit(const char c)
+{
+	return (unsigned(c - '0') < 10u);
+}
+
+///
+/// @brief		check whether a character is a blank in a field
+/// @param		c [in] character
+/// @return		true: blank, false: not a blank
+///
+static inline bool isBlank(const char c)
+{
+	return (c == ' ' || c == '\t' || c == '\r');
+}
+
+///
+/// @brief		accumulate decimal digits into an integer
+/// @param		p [in] first character to scan
+/// @param		pEnd [in] end of the buffer
+/// @param		n [in/out] accumulated value (wraps after 19 digits)
+/// @return		position of the first non-digit character
+/// @remark		eight digits are converted at once (SWAR) when available
+///
+static inline const char* ScanDigits(const char* p, const char* pEnd, \
+	unsigned long long& n)
+{
+#if defined(_WIN32) || (defined(__BYTE_ORDER__) && \
+	(__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__))
+	while (pEnd - p >= 8)
+	{
+		unsigned long long v;
+		memcpy(&v, p, 8);
+
+		/// all eight bytes must be '0'..'9'
+		if ((((v & 0xF0F0F0F0F0F0F0F0ULL) | \
+			(((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4)) \
+			!= 0x3333333333333333ULL))
+			break;
+
+		/// combine digits pairwise: 1-digit -> 2-digit -> 4-digit -> 8-digit
+		v = ((v & 0x0F0F0F0F0F0F0F0FULL) * 2561) >> 8;
+		v = ((v & 0x00FF00FF00FF00FFULL) * 6553601) >> 16;
+		v = ((v & 0x0000FFFF0000FFFFULL) * 42949672960001ULL) >> 32;
+
+		n = n * 100000000ULL + v;
+		p += 8;
+	}
+#endif
+
+	for (; p < pEnd && isDigit(*p); ++p)
+		n = n * 10 + unsigned(*p - '0');
+
+	return p;
+}
+
+///
+/// @brief		convert a field with strtod() (slow path of ParseFloat)
+/// @param		p [in] beginning of the field
+/// @param		pEnd [in] end of the field
+/// @return		converted value
+///
+static double ParseFloatSlow(const char* p, const char* pEnd)
+{
+	/// strtod() needs a null-terminated string
+	std::string str(p, pEnd);
+
+	return strtod(str.c_str(), 0);
+}
+
+///
+/// @brief		convert a value in seconds to nanoseconds (slow path)
+/// @param		d [in] value (sec)
+/// @return		value (ns), 0 if out of the range of 64 bits (incl. inf, nan)
+///
+static long long Sec2NsChecked(const double d)
+{
+	return (fabs(d) < 9.2e9) ? Sec2Ns(d) : 0;
+}
+
+///
+/// @brief		convert a decimal number in seconds to nanoseconds exactly
+/// @param		nMantissa [in] digits of the number
+/// @param		nExp10 [in] decimal exponent (value = nMantissa x 10^nExp10)
+/// @param		bNegative [in] whether the number is negative
+/// @param		ns [out] value (ns), rounded half away from zero
+/// @return		true on success, false if it does not fit in 64 bits
+///
+static inline bool Dec2Ns(const unsigned long long nMantissa, \
+	const int nExp10, const bool bNegative, long long& ns)
+{
+	/// exponent of the number in nanoseconds
+	const int nExp = nExp10 + 9;
+	unsigned long long n = 0;
+
+	if (nExp >= 0)
+	{
+		if (nExp > 18 || nMantissa > 9223372036854775807ULL / s_nPow10[nExp])
+			return false;
+		n = nMantissa * s_nPow10[nExp];
+	}
+	else
+	{
+		if (nExp < -18)
+			return false;
+		const unsigned long long nDiv = s_nPow10[-nExp];
+		n = nMantissa / nDiv;
+		n += (nMantissa % nDiv >= nDiv / 2) ? 1 : 0;
+	}
+
+	ns = bNegative ? -(long long)n : (long long)n;
+	return true;
+}
+
+///
+/// @brief		find the end of a field (',' or end of the line)
+/// @param		p [in] position in the field
+/// @param		pEnd [in] end of the buffer
+/// @return		end of the field
+///
+static inline const char* FieldEnd(const char* p, const char* pEnd)
+{
+	while (p < pEnd && *p != ',' && *p != '\n')
+		++p;
+
+	return p;
+}
+
+///
+/// @brief		scan a floating-point number at the beginning of a field
+/// @param		p [in] beginning of the field
+/// @param		pEnd [in] end of the buffer (or the field)
+/// @param		f [out] converted value (0 if the field is not a number)
+/// @param		pNs [out] value x 1e9 as an integer (timestamps in ns) or 0
+/// @return		position where the scan stopped
+/// @remark		Decimal numbers whose digits fit in 53 bits with an exponent
+///				within 1e+-22 are converted exactly by one double
+///				multiplication or division (Clinger's fast path), so the
+///				result equals float(atof()). Other numbers (long mantissa,
+///				hex, inf, nan) fall back to strtod(). The nanoseconds are
+///				taken from the decimal digits, so they are exact up to 292
+///				years.
+///
+static inline const char* ScanFloat(const char* p, const char* pEnd, float& f, \
+	long long* pNs = 0)
+{
+	const char* pField = p;
+
+	/// skip leading blanks
+	while (p < pEnd && isBlank(*p))
+		++p;
+
+	/// sign
+	//@{
+	bool bNegative = false;
+	if (p < pEnd && (*p == '-' || *p == '+'))
+	{
+		bNegative = (*p == '-');
+		++p;
+	}
+	//@}
+
+	unsigned long long nMantissa = 0;	///< all digits of the number
+	int nExp10 = 0;						///< decimal exponent
+
+	/// integer part
+	const char* pDigits = p;
+	p = ScanDigits(p, pEnd, nMantissa);
+	int nDigits = int(p - pDigits);
+
+	/// fraction part
+	if (p < pEnd && *p == '.')
+	{
+		pDigits = ++p;
+		p = ScanDigits(p, pEnd, nMantissa);
+		nExp10 = -int(p - pDigits);
+		nDigits -= nExp10;
+	}
+	const bool bAnyDigit = (nDigits > 0);
+
+	/// "inf", "nan", ".e" etc.
+	if (!bAnyDigit)
+	{
+		f = 0.f;
+		if (pNs)
+			*pNs = 0;
+		if (p < pEnd && (*p == 'i' || *p == 'I' || *p == 'n' || *p == 'N'))
+		{
+			p = FieldEnd(p, pEnd);
+			f = float(ParseFloatSlow(pField, p));
+		}
+		return p;
+	}
+
+	/// hexadecimal number ("0x...")
+	if (p < pEnd && (*p == 'x' || *p == 'X'))
+	{
+		p = FieldEnd(p, pEnd);
+		const double d = ParseFloatSlow(pField, p);
+		f = float(d);
+		if (pNs)
+			*pNs = Sec2NsChecked(d);
+		return p;
+	}
+
+	/// exponent part (ignored if no digits follow as atof() does)
+	if (p < pEnd && (*p == 'e' || *p == 'E'))
+	{
+		const char* q = p + 1;
+		bool bExpNegative = false;
+		if (q < pEnd && (*q == '-' || *q == '+'))
+		{
+			bExpNegative = (*q == '-');
+			++q;
+		}
+		if (q < pEnd && isDigit(*q))
+		{
+			int nExp = 0;
+			for (; q < pEnd && isDigit(*q); ++q)
+				if (nExp < 100000)
+					nExp = nExp * 10 + (*q - '0');
+			nExp10 += bExpNegative ? -nExp : nExp;
+			p = q;
+		}
+	}
+
+	/// fast path (exact conversion)
+	if (nDigits <= 19 && nMantissa <= (1ULL << 53) && \
+		nExp10 >= -22 && nExp10 <= 22)
+	{
+		double d = double(nMantissa);
+		if (nExp10 < 0)
+			d /= s_dPow10[-nExp10];
+		else
+			d *= s_dPow10[nExp10];
+		f = float(bNegative ? -d : d);
+		if (pNs && !Dec2Ns(nMantissa, nExp10, bNegative, *pNs))
+			*pNs = Sec2NsChecked(bNegative ? -d : d);
+		return p;
+	}
+
+	p = FieldEnd(p, pEnd);
+	const double d = ParseFloatSlow(pField, p);
+	f = float(d);
+	if (pNs && !(nDigits <= 19 && Dec2Ns(nMantissa, nExp10, bNegative, *pNs)))
+		*pNs = Sec2NsChecked(d);
+	return p;
+}
+
+/// significant digits accumulated by ScanInt() (more than int32 holds)
+#define SCAN_INT_MAX_DIGITS		(11)
+
+///
+/// @brief		scan an integer at the beginning of a field
+/// @param		p [in] beginning of the field
+/// @param		pEnd [in] end of the buffer (or the field)
+/// @param		n [out] converted value (0 if the field is not a number,
+///				INT_MIN or INT_MAX if it is out of the range of int)
+/// @return		position where the scan stopped
+/// @remark		Leading zeros are skipped and at most SCAN_INT_MAX_DIGITS
+///				significant digits are accumulated, so a long digit run
+///				cannot overflow; the remaining digits are scanned and
+///				saturate the value.
+///
+static inline const char* ScanInt(const char* p, const char* pEnd, int& n)
+{
+	/// skip leading blanks
+	while (p < pEnd && isBlank(*p))
+		++p;
+
+	/// sign
+	//@{
+	bool bNegative = false;
+	if (p < pEnd && (*p == '-' || *p == '+'))
+	{
+		bNegative = (*p == '-');
+		++p;
+	}
+	//@}
+
+	/// leading zeros
+	while (p < pEnd && *p == '0')
+		++p;
+
+	/// significant digits (beyond the cap the value is out of range anyway)
+	long long nValue = 0;
+	for (int nDigits = 0; p < pEnd && isDigit(*p); ++p, ++nDigits)
+	{
+		if (nDigits < SCAN_INT_MAX_DIGITS)
+			nValue = nValue * 10 + (*p - '0');
+		else
+			nValue = (long long)INT_MAX + 1;
+	}
+
+	/// saturate to the range of int
+	if (bNegative)
+		nValue = -nValue;
+	n = (nValue < INT_MIN) ? INT_MIN : (nValue > INT_MAX) ? INT_MAX \
+		: int(nValue);
+	return p;
+}
+
+///
+/// @brief		parse a floating-point field
+/// @param		p [in] beginning of the field
+/// @param		pEnd [in] end of the field
+/// @return		converted value (0 if the field is not a number)
+///
+float ParseFloat(const char* p, const char* pEnd)
+{
+	float f = 0.f;
+
+	ScanFloat(p, pEnd, f);
+
+	return f;
+}
+
+///
+/// @brief		parse an integer field
+/// @param		p [in] beginning of the field
+/// @param		pEnd [in] end of the field
+/// @return		converted value (0 if the field is not a number)
+///
+int ParseInt(const char* p, const char* pEnd)
+{
+	int n = 0;
+
+	ScanInt(p, pEnd, n);
+
+	return n;
+}
+
+///
+/// @brief		move to the next field of the line
+/// @param		p [in] position where the scan of the current field stopped
+/// @param		pEnd [in] end of the buffer
+/// @param		bMore [in/out] false if the line has no more fields
+/// @return		beginning of the next field
+///
+static inline const char* NextField(const char* p, const char* pEnd, \
+	bool& bMore)
+{
+	p = FieldEnd(p, pEnd);
+
+	bMore = bMore && (p < pEnd) && (*p == ',');
+
+	return bMore ? p + 1 : p;
+}
+
+///
+/// @brief		parse a line of the input file
+///
+/// @param		p [in] beginning of the line
+/// @param		pEnd [in] end of the buffer
+/// @param		sRecord [out] parsed record (valid only if bValid is true)
+/// @param		bValid [out] false if the line is a comment or blank line
+/// @param		pbGyro [out] set to true if the line has the angular velocity
+///				field (optional; left unchanged otherwise)
+///
+/// @return		beginning of the next line (pEnd if it was the last line)
+///
+/// @remark		each field is scanned only once; the line end is found while
+///				scanning the fields.
+///
+const char* ParseRecordLine(const char* p, const char* pEnd, \
+	SRecord& sRecord, bool& bValid, bool* pbGyro)
+{
+	/// skip leading blanks
+	while (p < pEnd && isBlank(*p))
+		++p;
+
+	/// skip comment lines and blank lines
+	if (p == pEnd || *p == '\n' || *p == '#')
+	{
+		const char* pEol = static_cast<const char*>(memchr(p, '\n', pEnd - p));
+		bValid = false;
+		return pEol ? pEol + 1 : pEnd;
+	}
+
+	/// whether the line has more fields
+	bool bMore = true;
+
+	/// get 'time' field (seconds and exact nanoseconds)
+	p = ScanFloat(p, pEnd, sRecord.time, &sRecord.time_ns);
+	p = NextField(p, pEnd, bMore);
+
+	/// get 'steering_angle' field
+	sRecord.steering_angle = 0.f;
+	if (bMore)
+		p = NextField(ScanFloat(p, pEnd, sRecord.steering_angle), pEnd, bMore);
+
+	/// get 'encoder_ticks' field
+	sRecord.encoder_ticks = 0;
+	if (bMore)
+		p = NextField(ScanInt(p, pEnd, sRecord.encoder_ticks), pEnd, bMore);
+
+	/// get 'angular_velocity' field (optional)
+	sRecord.angular_velocity = 0.f;
+	if (bMore)
+	{
+		p = ScanFloat(p, pEnd, sRecord.angular_velocity);
+		if (pbGyro)
+			*pbGyro = true;
+	}
+
+	/// skip the rest of the line
+	//@{
+	const char* pEol = static_cast<const char*>(memchr(p, '\n', pEnd - p));
+	bValid = true;
+	return pEol ? pEol + 1 : pEnd;
+	//@}
+}
+
+///
+/// @brief		parse all records in the buffer and append them
+/// @param		pBegin [in] beginning of the buffer
+/// @param		pEnd [in] end of the buffer
+/// @param		vRecord [out] vector to append records to
+/// @param		pbGyro [out] whether a record has the angular velocity field
+///				(optional)
+/// @return		number of appended records
+///
+int ParseRecords(const char* pBegin, const char* pEnd, \
+	std::vector<SRecord>& vRecord, bool* pbGyro)
+{
+	/// reserve once with the number of lines estimated from a sample
+	//@{
+	const size_t nSize = size_t(pEnd - pBegin);
+	const size_t nSample = (nSize < 65536) ? nSize : 65536;
+	size_t nLines = 1;
+	for (const char* p = pBegin; p < pBegin + nSample; ++nLines)
+	{
+		p = static_cast<const char*>(memchr(p, '\n', pBegin + nSample - p));
+		if (!p)
+			break;
+		++p;
+	}
+	if (nSample < nSize)
+		nLines = size_t(double(nLines) * nSize / nSample * 1.125) + 1;
+	vRecord.reserve(vRecord.size() + nLines);
+	//@}
+
+	/// temporary struct to read a record
+	SRecord sRecord;
+
+	/// whether a line has a record
+	bool bValid = false;
+
+	/// number of appended records
+	int nRecords = 0;
+
+	if (pbGyro)
+		*pbGyro = false;
+
+	/// iterate each line of the buffer
+	for (const char* p = pBegin; p < pEnd; )
+	{
+		p = ParseRecordLine(p, pEnd, sRecord, bValid, pbGyro);
+		if (bValid)
+		{
+			vRecord.push_back(sRecord);
+			++nRecords;
+		}
+	}
+
+	return nRecords;
+}
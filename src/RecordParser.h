@@ -0,0 +1,37 @@
+///
+/// @file		RecordParser.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		In-place parser for input records (NN_input.csv)
+///
+/// @remark		The parser scans a character buffer (e.g. a memory-mapped
+///				file) without copying lines and without any allocation per
+///				line. Number fields are converted with the same result as
+///				float(atof()) and atoi() used by the previous parser.
+///
+
+#ifndef _RECORD_PARSER_H_
+#define _RECORD_PARSER_H_
+
+#include <cstddef>		// NULL
+#include <vector>		// std::vector
+
+#include "Record.h"		// SRecord
+
+/// parse a floating-point field [p..pEnd) (same result as float(atof()))
+float ParseFloat(const char* p, const char* pEnd);
+
+/// parse an integer field [p..pEnd) (as atoi(), saturated to INT_MIN..INT_MAX)
+int ParseInt(const char* p, const char* pEnd);
+
+/// parse a line of the input file and return the beginning of the next line
+const char* ParseRecordLine(const char* p, const char* pEnd, \
+	SRecord& sRecord, bool& bValid, bool* pbGyro = NULL);
+
+/// parse all records in the buffer [pBegin..pEnd) and append them
+int ParseRecords(const char* pBegin, const char* pEnd, \
+	std::vector<SRecord>& vRecord, bool* pbGyro = NULL);
+
+#endif // _RECORD_PARSER_H_
@@ -0,0 +1,305 @@
+///
+/// @file		RecordStream.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Reads input records one by one from stdin, a pipe or a file
+///
+
+#include <cerrno>			// errno, EINTR
+#include <cstring>			// memchr, memmove
+#include <fcntl.h>			// open, O_RDONLY
+#include <sys/stat.h>		// fstat, S_IFREG
+
+#if defined(WIN32)
+#	include <io.h>			// _read, _close
+#	define read		_read
+#	define close	_close
+#else
+#	include <unistd.h>		// read, close
+#endif
+
+#include "RecordStream.h"
+#include "RecordParser.h"	// ParseRecordLine
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CRecordStream::CRecordStream()
+: m_fd(-1)
+, m_bOwned(false)
+, m_bEof(false)
+, m_bDiscard(false)
+, m_nBegin(0)
+, m_nEnd(0)
+, m_bChecked(false)
+, m_bArchive(false)
+, m_nChunk(0)
+, m_nRecord(0)
+{
+}
+
+///
+/// @brief		destructor (closes the stream)
+/// @param		N/A
+/// @return		N/A
+///
+CRecordStream::~CRecordStream()
+{
+	Close();
+}
+
+///
+/// @brief		open a file or a named pipe
+/// @param		sFilename [in] filename, or "-" for the standard input
+/// @return		0 on success, -1 if occurred error
+///
+int CRecordStream::Open(const std::string& sFilename)
+{
+	Close();
+
+	if (sFilename == "-")
+	{
+		m_fd = 0;
+		m_bOwned = false;
+	}
+	else
+	{
+		m_fd = open(sFilename.c_str(), O_RDONLY);
+		m_bOwned = true;
+		m_sFilename = sFilename;
+	}
+
+	if (m_fd == -1)
+		return -1;
+
+	m_vBuffer.resize(RECORD_STREAM_BUFFER_SIZE);
+	m_nBegin = m_nEnd = 0;
+	m_bEof = false;
+	m_bDiscard = false;
+	m_bChecked = false;
+
+	return 0;
+}
+
+///
+/// @brief		close the stream
+/// @param		N/A
+/// @return		void
+///
+void CRecordStream::Close()
+{
+	if (m_fd != -1 && m_bOwned)
+		close(m_fd);
+
+	m_fd = -1;
+	m_bOwned = false;
+	m_sFilename.clear();
+
+	m_archive.Close();
+	m_bArchive = false;
+	m_vChunk.clear();
+	m_nChunk = m_nRecord = 0;
+}
+
+///
+/// @brief		read more bytes from the stream into the buffer
+/// @param		N/A
+/// @return		number of bytes read, 0 at the end of the stream, -1 on error
+/// @remark		returns as soon as any bytes are available (no full buffer
+///				is waited for, unlike fread)
+///
+int CRecordStream::Fill()
+{
+	/// move the unparsed partial line to the beginning of the buffer
+	if (m_nBegin > 0)
+	{
+		memmove(&m_vBuffer[0], &m_vBuffer[m_nBegin], m_nEnd - m_nBegin);
+		m_nEnd -= m_nBegin;
+		m_nBegin = 0;
+	}
+
+	/// drop a line longer than the buffer
+	if (m_nEnd == m_vBuffer.size())
+	{
+		m_nBegin = m_nEnd = 0;
+		m_bDiscard = true;
+	}
+
+	int n = 0;
+	do
+	{
+		n = int(read(m_fd, &m_vBuffer[m_nEnd], \
+			unsigned(m_vBuffer.size() - m_nEnd)));
+	} while (n < 0 && errno == EINTR);
+
+	if (n > 0)
+		m_nEnd += n;
+	else if (n == 0)
+		m_bEof = true;
+
+	return n;
+}
+
+///
+/// @brief		check whether the stream is a record archive
+/// @param		N/A
+/// @return		0 on success, -1 if occurred error (invalid archive)
+/// @remark		reads until the header of an archive, a line or the end of
+///				the stream is buffered; the bytes stay in the buffer
+///
+int CRecordStream::CheckArchive()
+{
+	m_bChecked = true;
+
+	/// a line shorter than the header is not an archive
+	while (m_nEnd < sizeof(SRecordArchiveHeader) && !m_bEof && \
+		!memchr(&m_vBuffer[0], '\n', m_nEnd))
+	{
+		if (Fill() < 0)
+			return -1;
+	}
+
+	if (!IsRecordArchive(&m_vBuffer[0], m_nEnd))
+		return 0;
+
+	m_bArchive = true;
+
+	/// map a regular file
+	struct stat st;
+	if (!m_sFilename.empty() && fstat(m_fd, &st) == 0 && \
+		(st.st_mode & S_IFMT) == S_IFREG)
+		return m_archive.Open(m_sFilename);
+
+	/// read a pipe to its end (the chunk index is at the end)
+	while (!m_bEof)
+	{
+		if (m_nEnd == m_vBuffer.size())
+			m_vBuffer.resize(m_vBuffer.size() * 2);
+		if (Fill() < 0)
+			return -1;
+	}
+
+	return m_archive.Attach(&m_vBuffer[0], m_nEnd);
+}
+
+///
+/// @brief		read the next record of a record archive
+/// @param		record [out] record read
+/// @return		1 if a record was read, 0 at the end of the archive, -1 if
+///				a chunk is corrupted
+///
+int CRecordStream::ReadArchive(SRecord& record)
+{
+	/// decode the next chunk
+	while (m_nRecord == m_vChunk.size())
+	{
+		if (m_nChunk == m_archive.GetChunkCount())
+			return 0;
+
+		m_vChunk.resize(m_archive.GetChunk(m_nChunk).count);
+		if (m_archive.DecodeChunk(m_nChunk, &m_vChunk[0]) != 0)
+			return -1;
+		++m_nChunk;
+		m_nRecord = 0;
+	}
+
+	record = m_vChunk[m_nRecord++];
+	return 1;
+}
+
+///
+/// @brief		read the next record
+/// @param		record [out] record read
+/// @return		1 if a record was read, 0 at the end of the stream, -1 on error
+///
+int CRecordStream::Read(SRecord& record)
+{
+	if (m_fd == -1)
+		return -1;
+
+	/// record archive
+	//@{
+	if (!m_bChecked && CheckArchive() != 0)
+		return -1;
+	if (m_bArchive)
+		return ReadArchive(record);
+	//@}
+
+	for (;;)
+	{
+		const char* pBegin = &m_vBuffer[0] + m_nBegin;
+		const char* pEnd = &m_vBuffer[0] + m_nEnd;
+		const char* pEol = static_cast<const char*>( \
+			memchr(pBegin, '\n', pEnd - pBegin));
+
+		/// a complete line is buffered (or the last line without '\n')
+		if (pEol || (m_bEof && pBegin < pEnd))
+		{
+			const char* pLineEnd = pEol ? pEol + 1 : pEnd;
+			bool bValid = false;
+
+			if (!m_bDiscard)
+				ParseRecordLine(pBegin, pLineEnd, record, bValid);
+			m_bDiscard = false;
+
+			m_nBegin = size_t(pLineEnd - &m_vBuffer[0]);
+			if (bValid)
+				return 1;
+			continue;
+		}
+
+		if (m_bEof)
+			return 0;
+
+		/// wait for more bytes
+		if (Fill() < 0)
+			return -1;
+	}
+}
+
+///
+/// @brief		check whether a complete record line is already buffered
+/// @param		N/A
+/// @return		true if Read() returns a record without reading the stream
+/// @remark		buffered comment lines and blank lines are skipped here, so
+///				false means that Read() will wait for the producer. Callers
+///				flush their output at that point.
+///
+bool CRecordStream::HasBufferedRecord()
+{
+	/// the records of an archive are decoded without waiting
+	if (m_bArchive)
+		return m_nRecord < m_vChunk.size() || \
+			m_nChunk < m_archive.GetChunkCount();
+
+	while (m_nBegin < m_nEnd)
+	{
+		const char* pBegin = &m_vBuffer[0] + m_nBegin;
+		const char* pEnd = &m_vBuffer[0] + m_nEnd;
+		const char* pEol = static_cast<const char*>( \
+			memchr(pBegin, '\n', pEnd - pBegin));
+
+		/// incomplete line
+		if (!pEol && !m_bEof)
+			return false;
+
+		/// first non-blank character of the line
+		const char* p = pBegin;
+		while (p < pEnd && (*p == ' ' || *p == '\t' || *p == '\r'))
+			++p;
+
+		/// a record line
+		if (!m_bDiscard && p < pEnd && *p != '\n' && *p != '#')
+			return true;
+
+		/// skip a comment line, a blank line or the rest of a long line
+		m_bDiscard = false;
+		m_nBegin = pEol ? size_t(pEol + 1 - &m_vBuffer[0]) : m_nEnd;
+	}
+
+	return false;
+}
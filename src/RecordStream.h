@@ -0,0 +1,114 @@
+///
+/// @file		RecordStream.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Reads input records one by one from stdin, a pipe or a file
+///
+/// @remark		Memory use is bounded by the read buffer regardless of the
+///				stream length. Records are returned as soon as their line is
+///				complete, so a live producer (data logger) is not delayed.
+///
+///				A stream that starts with the header of a record archive
+///				(RecordArchive.h) is decoded chunk by chunk instead. A
+///				regular file is memory-mapped; an archive from a pipe is read
+///				to its end first, since its chunk index is at the end.
+///
+
+#ifndef _RECORD_STREAM_H_
+#define _RECORD_STREAM_H_
+
+#include <string>		// std::string
+#include <vector>		// std::vector
+
+#include "Record.h"		// SRecord
+#include "RecordArchive.h"	// CRecordArchiveReader
+
+/// size of the read buffer (bytes, also the longest accepted line)
+#define RECORD_STREAM_BUFFER_SIZE	(64 * 1024)
+
+/// @brief		Reads input records one by one from a stream
+class CRecordStream
+{
+public:
+	/// constructor
+	explicit CRecordStream();
+
+	/// destructor (closes the stream)
+	virtual ~CRecordStream();
+
+	/// open a file or a named pipe ("-" for stdin)
+	int Open(const std::string& sFilename);
+
+	/// close the stream
+	void Close();
+
+	/// read the next record (blocks until a line is complete)
+	int Read(SRecord& record);
+
+	/// check whether a complete record line is already buffered
+	bool HasBufferedRecord();
+
+private:
+	/// read more bytes from the stream into the buffer
+	int Fill();
+
+	/// check whether the stream is a record archive (first Read())
+	int CheckArchive();
+
+	/// read the next record of a record archive
+	int ReadArchive(SRecord& record);
+
+private:
+	/// non construction-copyable
+	CRecordStream(const CRecordStream&);
+
+	/// non copyable
+	const CRecordStream& operator=(const CRecordStream&);
+
+private:
+	/// file descriptor (-1 if not opened)
+	int m_fd;
+
+	/// whether the descriptor is owned (not stdin)
+	bool m_bOwned;
+
+	/// whether the end of the stream was reached
+	bool m_bEof;
+
+	/// whether the current line is too long and being discarded
+	bool m_bDiscard;
+
+	/// read buffer
+	std::vector<char> m_vBuffer;
+
+	/// first unparsed byte in the buffer
+	size_t m_nBegin;
+
+	/// end of the valid bytes in the buffer
+	size_t m_nEnd;
+
+	/// filename (empty for stdin)
+	std::string m_sFilename;
+
+	/// whether the stream was checked for a record archive
+	bool m_bChecked;
+
+	/// whether the stream is a record archive
+	bool m_bArchive;
+
+	/// reader of the record archive
+	CRecordArchiveReader m_archive;
+
+	/// decoded records of the current chunk of the archive
+	std::vector<SRecord> m_vChunk;
+
+	/// next chunk of the archive to decode
+	size_t m_nChunk;
+
+	/// next record in m_vChunk
+	size_t m_nRecord;
+};
+
+#endif // _RECORD_STREAM_H_
@@ -0,0 +1,282 @@
+///
+/// @file		SimdMath.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		SIMD wrappers and vector angle/trigonometric kernels
+///
+/// @remark		Internal header of the SIMD kernels (FleetTricycle.cpp,
+///				math2.cpp). Other code uses the array functions of math2.h.
+///
+
+#ifndef _SIMD_MATH_H_
+#define _SIMD_MATH_H_
+
+#include "math2.h"		// M_PI
+
+//==============================================================================
+//
+// SIMD wrappers
+// -------------
+//
+// The kernels are written once against these thin wrappers. AVX2 is used
+// when the compiler targets it (-mavx2, /arch:AVX2), SSE2 otherwise. Without
+// either of them SIMD_ENABLED is 0 and the callers use their scalar code.
+//
+//==============================================================================
+
+#if defined(__AVX2__)
+#	include <immintrin.h>
+#	define SIMD_LANES		(8)
+#	define SIMD_ENABLED		(1)
+
+typedef __m256  vfloat;
+typedef __m256i vint;
+
+static inline vfloat vLoad(const float* p) { return _mm256_loadu_ps(p); }
+static inline void   vStore(float* p, const vfloat v) { _mm256_storeu_ps(p, v); }
+static inline vfloat vSet(const float f) { return _mm256_set1_ps(f); }
+static inline vfloat vAdd(const vfloat a, const vfloat b) { return _mm256_add_ps(a, b); }
+static inline vfloat vSub(const vfloat a, const vfloat b) { return _mm256_sub_ps(a, b); }
+static inline vfloat vMul(const vfloat a, const vfloat b) { return _mm256_mul_ps(a, b); }
+static inline vfloat vDiv(const vfloat a, const vfloat b) { return _mm256_div_ps(a, b); }
+static inline vfloat vAnd(const vfloat a, const vfloat b) { return _mm256_and_ps(a, b); }
+static inline vfloat vAndNot(const vfloat a, const vfloat b) { return _mm256_andnot_ps(a, b); }
+static inline vfloat vOr(const vfloat a, const vfloat b) { return _mm256_or_ps(a, b); }
+static inline vfloat vXor(const vfloat a, const vfloat b) { return _mm256_xor_ps(a, b); }
+static inline vfloat vSqrt(const vfloat v) { return _mm256_sqrt_ps(v); }
+static inline vfloat vLess(const vfloat a, const vfloat b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+static inline vfloat vSelect(const vfloat m, const vfloat a, const vfloat b) { return _mm256_blendv_ps(b, a, m); }
+static inline vfloat vInt2Float(const vint v) { return _mm256_cvtepi32_ps(v); }
+static inline vint   vFloat2Int(const vfloat v) { return _mm256_cvttps_epi32(v); }
+static inline vfloat vCastInt(const vint v) { return _mm256_castsi256_ps(v); }
+static inline vint   viCastFloat(const vfloat v) { return _mm256_castps_si256(v); }
+static inline vint   viLoad(const int* p) { return _mm256_loadu_si256((const __m256i*)p); }
+static inline vint   viSet(const int n) { return _mm256_set1_epi32(n); }
+static inline vint   viAdd(const vint a, const vint b) { return _mm256_add_epi32(a, b); }
+static inline vint   viSub(const vint a, const vint b) { return _mm256_sub_epi32(a, b); }
+static inline vint   viAnd(const vint a, const vint b) { return _mm256_and_si256(a, b); }
+static inline vint   viAndNot(const vint a, const vint b) { return _mm256_andnot_si256(a, b); }
+static inline vint   viEqual(const vint a, const vint b) { return _mm256_cmpeq_epi32(a, b); }
+static inline vint   viShl29(const vint a) { return _mm256_slli_epi32(a, 29); }
+static inline vint   viShr23(const vint a) { return _mm256_srli_epi32(a, 23); }
+
+#elif defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#	include <emmintrin.h>
+#	define SIMD_LANES		(4)
+#	define SIMD_ENABLED		(1)
+
+typedef __m128  vfloat;
+typedef __m128i vint;
+
+static inline vfloat vLoad(const float* p) { return _mm_loadu_ps(p); }
+static inline void   vStore(float* p, const vfloat v) { _mm_storeu_ps(p, v); }
+static inline vfloat vSet(const float f) { return _mm_set1_ps(f); }
+static inline vfloat vAdd(const vfloat a, const vfloat b) { return _mm_add_ps(a, b); }
+static inline vfloat vSub(const vfloat a, const vfloat b) { return _mm_sub_ps(a, b); }
+static inline vfloat vMul(const vfloat a, const vfloat b) { return _mm_mul_ps(a, b); }
+static inline vfloat vDiv(const vfloat a, const vfloat b) { return _mm_div_ps(a, b); }
+static inline vfloat vAnd(const vfloat a, const vfloat b) { return _mm_and_ps(a, b); }
+static inline vfloat vAndNot(const vfloat a, const vfloat b) { return _mm_andnot_ps(a, b); }
+static inline vfloat vOr(const vfloat a, const vfloat b) { return _mm_or_ps(a, b); }
+static inline vfloat vXor(const vfloat a, const vfloat b) { return _mm_xor_ps(a, b); }
+static inline vfloat vSqrt(const vfloat v) { return _mm_sqrt_ps(v); }
+static inline vfloat vLess(const vfloat a, const vfloat b) { return _mm_cmplt_ps(a, b); }
+static inline vfloat vSelect(const vfloat m, const vfloat a, const vfloat b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+static inline vfloat vInt2Float(const vint v) { return _mm_cvtepi32_ps(v); }
+static inline vint   vFloat2Int(const vfloat v) { return _mm_cvttps_epi32(v); }
+static inline vfloat vCastInt(const vint v) { return _mm_castsi128_ps(v); }
+static inline vint   viCastFloat(const vfloat v) { return _mm_castps_si128(v); }
+static inline vint   viLoad(const int* p) { return _mm_loadu_si128((const __m128i*)p); }
+static inline vint   viSet(const int n) { return _mm_set1_epi32(n); }
+static inline vint   viAdd(const vint a, const vint b) { return _mm_add_epi32(a, b); }
+static inline vint   viSub(const vint a, const vint b) { return _mm_sub_epi32(a, b); }
+static inline vint   viAnd(const vint a, const vint b) { return _mm_and_si128(a, b); }
+static inline vint   viAndNot(const vint a, const vint b) { return _mm_andnot_si128(a, b); }
+static inline vint   viEqual(const vint a, const vint b) { return _mm_cmpeq_epi32(a, b); }
+static inline vint   viShl29(const vint a) { return _mm_slli_epi32(a, 29); }
+static inline vint   viShr23(const vint a) { return _mm_srli_epi32(a, 23); }
+
+#else
+#	define SIMD_LANES		(1)
+#	define SIMD_ENABLED		(0)
+#endif
+
+#if (SIMD_ENABLED)
+///
+/// @brief		round toward negative infinity (|v| < 2^31)
+/// @param		v [in] values to round
+/// @return		floor(v)
+///
+static inline vfloat vFloor(const vfloat v)
+{
+	vfloat t = vInt2Float(vFloat2Int(v));
+
+	/// truncation rounds negative values up, correct them by one
+	return vSub(t, vAnd(vLess(v, t), vSet(1.f)));
+}
+
+///
+/// @brief		subtract k turns from the angles (Cody-Waite, two constants)
+/// @param		v [in] angles (rad)
+/// @param		k [in] number of turns (integral values, |k| < 2^16)
+/// @return		v - k * (M_PI + M_PI)
+/// @remark		k * 6.28125 is exact, so only the small remainder of 2 * M_PI
+///				is rounded and the result is nearly the double precision one.
+///
+static inline vfloat vSubTurns(const vfloat v, const vfloat k)
+{
+	vfloat r = vSub(v, vMul(k, vSet(6.28125f)));
+
+	return vSub(r, vMul(k, vSet(1.9353071795864769e-3f)));
+}
+
+///
+/// @brief		get +1 / -1 / 0 for the angles above / below / in the range
+/// @param		r [in] angles (rad)
+/// @return		+1 for r >= M_PI, -1 for r < -M_PI, 0 otherwise
+/// @remark		no float lies on M_PI, so 3.1415925f (the largest float below
+///				M_PI) gives the exact comparisons
+///
+static inline vfloat vOutOfRange(const vfloat r)
+{
+	const vfloat vOne = vSet(1.f);
+
+	return vSub(vAnd(vLess(vSet(3.1415925f), r), vOne), \
+		vAnd(vLess(r, vSet(-3.1415925f)), vOne));
+}
+
+///
+/// @brief		clamp the angles (rad) at most one turn out of range
+/// @param		v [in] angles (rad) to clamp (|v| < 3 * M_PI)
+/// @return		clamped angles (rad) [-M_PI..+M_PI)
+/// @remark		Cheaper than vAngleClamp() (no floor) for the per-step wraps of
+///				the integrators. Same values as AngleClamp() in that range.
+///
+static inline vfloat vAngleWrap(const vfloat v)
+{
+	return vSubTurns(v, vOutOfRange(v));
+}
+
+///
+/// @brief		clamp the angle (rad) between [-M_PI..+M_PI) range
+/// @param		v [in] angles (rad) to clamp
+/// @return		clamped angles (rad)
+/// @remark		Branch-free version of AngleClamp() in math2.h. Angles which
+///				are already in range are returned unchanged (bit-exact). The
+///				number of turns is estimated in float (forced to 0 in range)
+///				and the results which are still out of range, because the
+///				estimate is off by one or the result is rounded onto a
+///				boundary, are wrapped once more.
+///
+static inline vfloat vAngleClamp(const vfloat v)
+{
+	const vfloat vSignMask = vSet(-0.f);
+	vfloat k = vFloor(vMul(vAdd(v, vSet(float(M_PI))), \
+		vSet(float(0.5 / M_PI))));
+
+	/// k = 0 where v is in range (|k| is 0 or 1 there, so clear its bits)
+	k = vAnd(k, vLess(vSet(3.1415925f), vAndNot(vSignMask, v)));
+	vfloat r = vSubTurns(v, k);
+
+	return vSubTurns(r, vOutOfRange(r));
+}
+
+///
+/// @brief		compute sine and cosine at once
+/// @param		x [in] angles (rad)
+/// @param		s [out] sine of the angles
+/// @param		c [out] cosine of the angles
+/// @return		void
+/// @remark		Cephes sinf/cosf polynomials with Cody-Waite range reduction
+///				by M_PI/4. Max absolute error is 8e-8 for |x| < 8192 rad.
+///
+static inline void vSinCos(const vfloat x, vfloat& s, vfloat& c)
+{
+	const vfloat vSignMask = vSet(-0.f);
+
+	/// take the absolute value and keep the sign for the sine
+	vfloat xAbs = vAndNot(vSignMask, x);
+	vfloat signSin = vAnd(x, vSignMask);
+
+	/// octant of the angle (j = (j + 1) & ~1)
+	vint j = vFloat2Int(vMul(xAbs, vSet(1.27323954473516f)));	///< 4 / M_PI
+	j = viAnd(viAdd(j, viSet(1)), viSet(~1));
+	vfloat y = vInt2Float(j);
+
+	/// sign bits and polynomial selection mask
+	vfloat signFlipSin = vCastInt(viShl29(viAnd(j, viSet(4))));
+	vfloat signCos = vCastInt(viShl29(viAndNot(viSub(j, viSet(2)), viSet(4))));
+	vfloat polyMask = vCastInt(viEqual(viAnd(j, viSet(2)), viSet(0)));
+	signSin = vXor(signSin, signFlipSin);
+
+	/// extended precision modular arithmetic (x - j * M_PI / 4)
+	xAbs = vSub(xAbs, vMul(y, vSet(0.78515625f)));
+	xAbs = vSub(xAbs, vMul(y, vSet(2.4187564849853515625e-4f)));
+	xAbs = vSub(xAbs, vMul(y, vSet(3.77489497744594108e-8f)));
+	vfloat z = vMul(xAbs, xAbs);
+
+	/// cosine polynomial for [0..M_PI/4]
+	vfloat yc = vSet(2.443315711809948e-5f);
+	yc = vAdd(vMul(yc, z), vSet(-1.388731625493765e-3f));
+	yc = vAdd(vMul(yc, z), vSet(4.166664568298827e-2f));
+	yc = vMul(vMul(yc, z), z);
+	yc = vSub(yc, vMul(z, vSet(0.5f)));
+	yc = vAdd(yc, vSet(1.f));
+
+	/// sine polynomial for [0..M_PI/4]
+	vfloat ys = vSet(-1.9515295891e-4f);
+	ys = vAdd(vMul(ys, z), vSet(8.3321608736e-3f));
+	ys = vAdd(vMul(ys, z), vSet(-1.6666654611e-1f));
+	ys = vAdd(vMul(vMul(ys, z), xAbs), xAbs);
+
+	/// select the polynomial and apply the sign
+	s = vXor(vSelect(polyMask, ys, yc), signSin);
+	c = vXor(vSelect(polyMask, yc, ys), signCos);
+}
+
+///
+/// @brief		compute the natural logarithm
+/// @param		x [in] positive normal values
+/// @return		log(x)
+/// @remark		Cephes logf polynomial on the mantissa in [sqrt(0.5)..sqrt(2)).
+///				Max error is about 2 ULP. Zero, negative and denormal inputs
+///				are not handled (callers pass values in (0..1]).
+///
+static inline vfloat vLog(const vfloat x)
+{
+	const vfloat vOne = vSet(1.f);
+
+	/// x = m * 2^e with m in [0.5..1)
+	vfloat e = vInt2Float(viSub(viShr23(viCastFloat(x)), viSet(126)));
+	vfloat m = vOr(vAnd(x, vCastInt(viSet(0x807FFFFF))), vSet(0.5f));
+
+	/// move m below sqrt(0.5) up to [sqrt(0.5)..sqrt(2)) and subtract 1
+	vfloat bLow = vLess(m, vSet(0.707106781186547524f));
+	e = vSub(e, vAnd(bLow, vOne));
+	m = vSub(vAdd(m, vAnd(bLow, m)), vOne);
+	vfloat z = vMul(m, m);
+
+	/// polynomial of log(1 + m)
+	vfloat y = vSet(7.0376836292e-2f);
+	y = vAdd(vMul(y, m), vSet(-1.1514610310e-1f));
+	y = vAdd(vMul(y, m), vSet(1.1676998740e-1f));
+	y = vAdd(vMul(y, m), vSet(-1.2420140846e-1f));
+	y = vAdd(vMul(y, m), vSet(1.4249322787e-1f));
+	y = vAdd(vMul(y, m), vSet(-1.6668057665e-1f));
+	y = vAdd(vMul(y, m), vSet(2.0000714765e-1f));
+	y = vAdd(vMul(y, m), vSet(-2.4999993993e-1f));
+	y = vAdd(vMul(y, m), vSet(3.3333331174e-1f));
+	y = vMul(vMul(y, m), z);
+
+	/// add e * log(2) in two parts
+	y = vAdd(y, vMul(e, vSet(-2.12194440e-4f)));
+	y = vSub(y, vMul(z, vSet(0.5f)));
+
+	return vAdd(vAdd(m, y), vMul(e, vSet(0.693359375f)));
+}
+#endif // (SIMD_ENABLED)
+
+#endif // _SIMD_MATH_H_
@@ -0,0 +1,151 @@
+///
+/// @file		SpscRing.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Lock-free single-producer/single-consumer ring buffer
+///
+/// @remark		Slots are filled and drained in place (Begin/End pairs), so a
+///				slot may hold a whole batch without being copied. The producer
+///				and the consumer indices live on separate cache lines and each
+///				side caches the other side's index to avoid cache-line
+///				ping-pong. Wait*() functions spin, then yield, which gives the
+///				backpressure between pipeline stages.
+///
+
+#ifndef _SPSC_RING_H_
+#define _SPSC_RING_H_
+
+#include <atomic>			// std::atomic
+#include <cstddef>			// size_t
+#include <thread>			// std::this_thread::yield
+#include <vector>			// std::vector
+
+/// size of a cache line (bytes)
+#define SPSC_CACHE_LINE		(64)
+
+/// number of spins before yielding in Wait*()
+#define SPSC_SPIN_COUNT		(64)
+
+/// @brief		Lock-free single-producer/single-consumer ring buffer
+template<typename T>
+class TSpscRing
+{
+public:
+	/// constructor (nCapacity is rounded up to a power of 2)
+	explicit TSpscRing(const size_t nCapacity)
+	: m_nHead(0), m_nTailCache(0), m_nTail(0), m_nHeadCache(0)
+	{
+		size_t n = 2;
+		while (n < nCapacity)
+			n <<= 1;
+
+		m_vSlot.resize(n);
+		m_nMask = n - 1;
+	}
+
+	/// destructor
+	virtual ~TSpscRing() {}
+
+	/// get the number of slots
+	size_t GetCapacity() const { return m_nMask + 1; }
+
+	/// producer: get the next free slot (0 if the ring is full)
+	T* BeginPush()
+	{
+		const size_t nHead = m_nHead.load(std::memory_order_relaxed);
+
+		if (nHead - m_nTailCache > m_nMask)
+		{
+			m_nTailCache = m_nTail.load(std::memory_order_acquire);
+			if (nHead - m_nTailCache > m_nMask)
+				return 0;
+		}
+
+		return &m_vSlot[nHead & m_nMask];
+	}
+
+	/// producer: publish the slot returned by BeginPush()
+	void EndPush()
+	{
+		m_nHead.store(m_nHead.load(std::memory_order_relaxed) + 1, \
+			std::memory_order_release);
+	}
+
+	/// consumer: get the oldest filled slot (0 if the ring is empty)
+	T* BeginPop()
+	{
+		const size_t nTail = m_nTail.load(std::memory_order_relaxed);
+
+		if (nTail == m_nHeadCache)
+		{
+			m_nHeadCache = m_nHead.load(std::memory_order_acquire);
+			if (nTail == m_nHeadCache)
+				return 0;
+		}
+
+		return &m_vSlot[nTail & m_nMask];
+	}
+
+	/// consumer: release the slot returned by BeginPop()
+	void EndPop()
+	{
+		m_nTail.store(m_nTail.load(std::memory_order_relaxed) + 1, \
+			std::memory_order_release);
+	}
+
+	/// producer: wait for a free slot (backpressure)
+	T* WaitPush()
+	{
+		T* pSlot = 0;
+		for (int n = 0; !(pSlot = BeginPush()); ++n)
+			Backoff(n);
+		return pSlot;
+	}
+
+	/// consumer: wait for a filled slot
+	T* WaitPop()
+	{
+		T* pSlot = 0;
+		for (int n = 0; !(pSlot = BeginPop()); ++n)
+			Backoff(n);
+		return pSlot;
+	}
+
+private:
+	/// spin for a while, then give the core to the other stages
+	static void Backoff(const int nTries)
+	{
+		if (nTries >= SPSC_SPIN_COUNT)
+			std::this_thread::yield();
+	}
+
+private:
+	/// non construction-copyable
+	TSpscRing(const TSpscRing&);
+
+	/// non copyable
+	const TSpscRing& operator=(const TSpscRing&);
+
+private:
+	/// slots and index mask (capacity - 1)
+	//@{
+	std::vector<T> m_vSlot;
+	size_t m_nMask;
+	//@}
+
+	/// producer side: next slot to fill, cached consumer index
+	//@{
+	alignas(SPSC_CACHE_LINE) std::atomic<size_t> m_nHead;
+	size_t m_nTailCache;
+	//@}
+
+	/// consumer side: next slot to drain, cached producer index
+	//@{
+	alignas(SPSC_CACHE_LINE) std::atomic<size_t> m_nTail;
+	size_t m_nHeadCache;
+	//@}
+};
+
+#endif // _SPSC_RING_H_
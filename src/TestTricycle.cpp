@@ -8,11 +8,15 @@
 ///
 
 #include <iostream>			// std::cout
-#include <sstream>			// std::stringstream, std::istringstream
+#include <sstream>			// std::stringstream
 #include <fstream>			// std::fstream
 #include <iomanip>			// std::setw, std::fill
-#include <cstdlib>			// atof, atoi
 #include <cstdio>			// popen, fprintf
+#include <cstring>			// memset
+#include <chrono>			// std::chrono::steady_clock
+#include <algorithm>		// std::max
+#include <thread>			// std::thread
+#include <cmath>			// sqrt
 
 #if defined(WIN32)
 #	include <conio.h>		// getch
@@ -24,6 +28,15 @@
 #include "TestTricycle.h"
 #include "Tricycle.h"		// CTricycle
 #include "VirtualGyro.h"	// CVirtualGyro
+#include "MappedFile.h"		// CMappedFile
+#include "RecordParser.h"	// ParseRecords
+#include "RecordArchive.h"	// CRecordArchiveReader, CRecordArchiveWriter
+#include "RecordStream.h"	// CRecordStream
+#include "ParallelReplay.h"	// CParallelReplay
+#include "SpscRing.h"		// TSpscRing
+#include "EkfTricycle.h"	// CEkfTricycle
+#include "MonteCarlo.h"		// CMonteCarlo
+#include "OdometryServer.h"	// COdometryClient
 
 #if defined(__linux__)
 ///
@@ -50,6 +63,22 @@ int getch()
 }
 #endif // defined(__linux__)
 
+/// type definition of a batch of input records (parse -> estimate)
+typedef struct _tagSRecordBatch
+{
+	size_t nCount;		///< number of records
+	bool bLast;			///< whether this is the last batch
+	SRecord record[PIPELINE_BATCH_SIZE];	///< records
+} SRecordBatch;
+
+/// type definition of a batch of poses and contours (estimate -> write)
+typedef struct _tagSPoseBatch
+{
+	size_t nCount;		///< number of poses
+	bool bLast;			///< whether this is the last batch
+	SPoseLogRecord record[PIPELINE_BATCH_SIZE];	///< poses and contours
+} SPoseBatch;
+
 ///
 /// @brief		constructor
 /// @param		N/A
@@ -57,6 +86,8 @@ int getch()
 ///
 CTestTricycle::CTestTricycle()
 : m_nTestCase(0)
+, m_bBinaryOutput(false)
+, m_bGyroInput(false)
 #if defined(WIN32)
 , m_pGnuPlot(0)
 #else
@@ -77,25 +108,76 @@ CTestTricycle::~CTestTricycle()
 ///
 /// @brief		run a test case
 /// @param		nTestCase [in] test case number
+/// @param		bBinaryOutput [in] write the binary pose log (NN_pose.bin)
+///				instead of the text files and the plot
+/// @param		bPipeline [in] run parsing, estimation and writing on their
+///				own threads (see RunPipeline())
 /// @return		0 on success, < 0 if occurred error
 ///
-int CTestTricycle::Run(const int nTestCase)
+int CTestTricycle::Run(const int nTestCase, const bool bBinaryOutput, \
+	const bool bPipeline)
 {
-	/// robot pose (x, y, heading)
-	SPose pose;
+	/// select the output format
+	m_bBinaryOutput = bBinaryOutput;
 
 	/// set filenames for input, pose, and contour
 	SetFilename(nTestCase);
 
-	/// read the input file
-	if (ReadInputFile() != 0)
+	/// estimate the input file into the result files
+	if (RunFiles(bPipeline) != 0)
+		return -1;
+
+	/// the binary pose log is not plotted
+	if (m_bBinaryOutput)
+	{
+		std::cout << "Pose log: " << m_sFilenamePoseLog << std::endl;
+		return 0;
+	}
+
+	/// draw a result plot
+	DrawGnuplot();
+
+	/// wait for user's key press
+	//@{
+	std::cout << "Press any key in this window to quit." << std::endl;
+	getch();
+	//@}
+
+#if defined(WIN32)
+	if (m_pGnuPlot)
+		delete m_pGnuPlot;	///< delete CpGnuplot instance
+#else // defined(WIN32)
+#endif // defined(WIN32)
+
+	return 0;
+}
+
+///
+/// @brief		estimate the poses of the input file into the result files
+/// @param		bPipeline [in] run parsing, estimation and writing on their
+///				own threads (see RunPipeline())
+/// @return		0 on success, < 0 if occurred error
+/// @remark		Run() without the plot: m_sFilenameInput, the result
+///				filenames and m_bBinaryOutput are set by the caller.
+///
+int CTestTricycle::RunFiles(const bool bPipeline)
+{
+	/// robot pose (x, y, heading)
+	SPose pose;
+
+	/// read the input file (the pipeline parses it in its own stage)
+	if (!bPipeline && ReadInputFile() != 0)
 	{
 		std::cout << "Error occurred in ReadInputFile()." << std::endl;
 		return -1;
 	}
 
 	/// create result files (pose, contour)
-	CreateResultFiles();
+	if (CreateResultFiles() != 0)
+	{
+		std::cout << "Error occurred in CreateResultFiles()." << std::endl;
+		return -1;
+	}
 
 	/// write initial pose to output files
 	//@{
@@ -104,70 +186,761 @@ int CTestTricycle::Run(const int nTestCase)
 	//@}
 
 	/// calculate odometry for each record
+	if (bPipeline)
+	{
+		if (RunPipeline() != 0)
+		{
+			std::cout << "Error occurred in RunPipeline()." << std::endl;
+			return -1;
+		}
+	}
+	else
+	{
+		//@{
+		for (std::vector<SRecord>::iterator it = m_vRecord.begin(); \
+			it != m_vRecord.end(); ++it)
+		{
+			/*
+			std::cout << "time: ";
+			std::cout.setf(std::ios::fixed);
+			std::cout.precision(3);
+			std::cout << it->time << ", ";
+			std::cout.unsetf(std::ios::fixed);
+
+			std::cout << "steering_angle: ";
+			std::cout.setf(std::ios::fixed);
+			std::cout.precision(3);
+			std::cout << it->steering_angle << ", ";
+			std::cout.unsetf(std::ios::fixed);
+
+			std::cout << "encoder_ticks: ";
+			std::cout << std::setfill('0') << std::setw(3);
+			std::cout << it->encoder_ticks << ", ";
+
+			std::cout << "angular_velocity: ";
+			std::cout.setf(std::ios::fixed);
+			std::cout.precision(3);
+			std::cout << it->angular_velocity << std::endl;
+			std::cout.unsetf(std::ios::fixed);
+			*/
+
+			/// update virtual gyro
+			CVirtualGyro::GetInstance()->UpdateNs(it->time_ns, it->steering_angle, it->encoder_ticks);
+
+			/// calculate robot pose
+			pose = CTricycle::GetInstance()->EstimateNs( \
+				it->time_ns, \
+				it->steering_angle, \
+				it->encoder_ticks, \
+				CVirtualGyro::GetInstance()->GetAngVel());
+
+			/// write a robot pose to the output files (pose, contour)
+			Write(Ns2Sec(it->time_ns), pose);
+		}
+		//@}
+	}
+
+	/// close result files (pose, contour)
+	if (CloseResultFiles() != 0)
+	{
+		std::cout << "Error occurred in CloseResultFiles()." << std::endl;
+		return -1;
+	}
+
+	return 0;
+}
+
+///
+/// @brief		estimate poses from a stream of records as they arrive
+///
+/// @param		sInput [in] input file or named pipe ("-" for stdin)
+/// @param		sOutput [in] output pose file ("-" for stdout)
+///
+/// @return		0 on success, < 0 if occurred error
+///
+/// @remark		Each record goes through the virtual gyro and the estimator
+///				as soon as its line is complete, and the pose is written in
+///				the NN_pose.txt format. Memory use does not depend on the
+///				stream length. The output is flushed whenever the input has
+///				no more buffered records, i.e. before waiting for the
+///				producer.
+///
+int CTestTricycle::RunStream(const std::string& sInput, \
+	const std::string& sOutput)
+{
+	/// input record stream
+	CRecordStream stream;
+
+	/// record read from the stream
+	SRecord record;
+
+	/// robot pose (x, y, heading)
+	SPose pose;
+
+	/// result of reading a record
+	int rc = 0;
+
+	if (stream.Open(sInput) != 0)
+	{
+		std::cerr << "Cannot open the input: " << sInput << std::endl;
+		return -1;
+	}
+
+	/// output file (stdout by default)
+	FILE* fp = (sOutput == "-") ? stdout : fopen(sOutput.c_str(), "w");
+	if (!fp)
+	{
+		std::cerr << "Cannot open the output: " << sOutput << std::endl;
+		return -1;
+	}
+
+	/// write comment (attribute of each field) and the initial pose
 	//@{
-	for (std::vector<SRecord>::iterator it = m_vRecord.begin(); \
-		it != m_vRecord.end(); ++it)
-	{
-		/*
-		std::cout << "time: ";
-		std::cout.setf(std::ios::fixed);
-		std::cout.precision(3);
-		std::cout << it->time << ", ";
-		std::cout.unsetf(std::ios::fixed);
-
-		std::cout << "steering_angle: ";
-		std::cout.setf(std::ios::fixed);
-		std::cout.precision(3);
-		std::cout << it->steering_angle << ", ";
-		std::cout.unsetf(std::ios::fixed);
-
-		std::cout << "encoder_ticks: ";
-		std::cout << std::setfill('0') << std::setw(3);
-		std::cout << it->encoder_ticks << ", ";
-
-		std::cout << "angular_velocity: ";
-		std::cout.setf(std::ios::fixed);
-		std::cout.precision(3);
-		std::cout << it->angular_velocity << std::endl;
-		std::cout.unsetf(std::ios::fixed);
-		*/
+	fputs("#time\trobot_x\trobot_y\trobot_q\n", fp);
+	CTricycle::GetInstance()->GetRobotPose(pose);
+	fprintf(fp, "%f\t%f\t%f\t%f\n", 0.f, pose.x, pose.y, pose.q);
+	fflush(fp);
+	//@}
 
+	/// calculate odometry for each record as it arrives
+	while ((rc = stream.Read(record)) > 0)
+	{
 		/// update virtual gyro
-		CVirtualGyro::GetInstance()->Update(it->time, it->steering_angle, it->encoder_ticks);
+		CVirtualGyro::GetInstance()->UpdateNs(record.time_ns, \
+			record.steering_angle, record.encoder_ticks);
 
 		/// calculate robot pose
-		pose = estimate( \
-			it->time, \
-			it->steering_angle, \
-			it->encoder_ticks, \
+		pose = CTricycle::GetInstance()->EstimateNs(record.time_ns, \
+			record.steering_angle, record.encoder_ticks, \
 			CVirtualGyro::GetInstance()->GetAngVel());
 
-		/// write a robot pose to the output files (pose, contour)
-		Write(it->time, pose);
+		/// write a robot pose
+		fprintf(fp, "%f\t%f\t%f\t%f\n", Ns2Sec(record.time_ns), pose.x, \
+			pose.y, pose.q);
+
+		/// flush before waiting for the producer
+		if (!stream.HasBufferedRecord())
+			fflush(fp);
+	}
+
+	if (fp != stdout)
+		fclose(fp);
+	else
+		fflush(fp);
+
+	if (rc < 0)
+	{
+		std::cerr << "Error occurred while reading " << sInput << std::endl;
+		return -1;
+	}
+
+	return 0;
+}
+
+///
+/// @brief		estimate poses of a stream of records on an odometry server
+///
+/// @param		sSocket [in] socket of the server (--serve)
+/// @param		sInput [in] input file, named pipe or "-" for stdin
+/// @param		sOutput [in] output pose file or "-" for stdout
+///
+/// @return		0 on success, -1 if occurred error
+///
+/// @remark		Opens stream 0 with the selected chassis and integrator, and
+///				sends the records that are already buffered (at most
+///				CLIENT_BATCH_SIZE) in one batch before reading the responses.
+///				The output is the same as RunStream(). The round-trip time per
+///				batch is reported to stderr.
+///
+int CTestTricycle::RunClient(const std::string& sSocket, \
+	const std::string& sInput, const std::string& sOutput)
+{
+	/// connection to the server
+	COdometryClient client;
+
+	/// input record stream
+	CRecordStream stream;
+
+	/// records, requests and responses of a batch
+	SRecord record[CLIENT_BATCH_SIZE];
+	SOdomRequest request[CLIENT_BATCH_SIZE];
+	SOdomResponse response[CLIENT_BATCH_SIZE];
+
+	/// round trips (count, sum and max in ns)
+	long long nBatches = 0, nRecords = 0, nSumNs = 0, nMaxNs = 0;
+
+	/// result of reading a record
+	int rc = 0;
+
+	/// whether the server closed the connection
+	bool bLost = false;
+
+	if (client.Connect(sSocket) != 0)
+	{
+		std::cerr << "Cannot connect to the server: " << sSocket << std::endl;
+		return -1;
+	}
+
+	if (stream.Open(sInput) != 0)
+	{
+		std::cerr << "Cannot open the input: " << sInput << std::endl;
+		return -1;
+	}
+
+	/// index of the selected chassis
+	int nChassis = 0;
+	while (nChassis + 1 < CTricycle::GetChassisCount() && \
+		&CTricycle::GetChassisAt(nChassis) != \
+		&CTricycle::GetInstance()->GetChassis())
+		++nChassis;
+
+	/// open stream 0 (the response holds the initial pose)
+	//@{
+	memset(request, 0, sizeof(request));
+	request[0].type = ODOM_REQ_OPEN;
+	request[0].encoder_ticks = nChassis | \
+		(CTricycle::GetInstance()->GetIntegrator() << 8);
+	if (client.Send(request, 1) != 0 || client.Receive(response, 1) != 0 || \
+		response[0].status != ODOM_OK)
+	{
+		std::cerr << "Cannot open a stream on " << sSocket << std::endl;
+		return -1;
 	}
 	//@}
 
-	/// close result files (pose, contour)
-	CloseResultFiles();
+	/// output file (stdout by default)
+	FILE* fp = (sOutput == "-") ? stdout : fopen(sOutput.c_str(), "w");
+	if (!fp)
+	{
+		std::cerr << "Cannot open the output: " << sOutput << std::endl;
+		return -1;
+	}
 
-	/// draw a result plot
-	DrawGnuplot();
+	/// write comment (attribute of each field) and the initial pose
+	fputs("#time\trobot_x\trobot_y\trobot_q\n", fp);
+	fprintf(fp, "%f\t%f\t%f\t%f\n", 0.f, response[0].x, response[0].y, \
+		response[0].q);
+	fflush(fp);
 
-	/// wait for user's key press
+	for (;;)
+	{
+		/// the next record (blocks), then the buffered ones
+		//@{
+		size_t nCount = 0;
+		while (nCount < CLIENT_BATCH_SIZE && (nCount == 0 || \
+			stream.HasBufferedRecord()))
+		{
+			if ((rc = stream.Read(record[nCount])) <= 0)
+				break;
+
+			SOdomRequest& r = request[nCount];
+			r.type = ODOM_REQ_ESTIMATE;
+			r.stream = 0;
+			r.seq = uint32_t(nRecords + nCount);
+			r.time_ns = record[nCount].time_ns;
+			r.steering_angle = record[nCount].steering_angle;
+			r.encoder_ticks = record[nCount].encoder_ticks;
+			++nCount;
+		}
+		if (nCount == 0)
+			break;
+		//@}
+
+		/// one round trip per batch
+		//@{
+		const std::chrono::steady_clock::time_point tBegin = \
+			std::chrono::steady_clock::now();
+		if (client.Send(request, nCount) != 0 || \
+			client.Receive(response, nCount) != 0)
+		{
+			std::cerr << "Connection lost: " << sSocket << std::endl;
+			bLost = true;
+			break;
+		}
+		const long long nNs = (long long)std::chrono::duration_cast< \
+			std::chrono::nanoseconds>(std::chrono::steady_clock::now() - \
+			tBegin).count();
+		++nBatches;
+		nRecords += (long long)nCount;
+		nSumNs += nNs;
+		nMaxNs = std::max(nMaxNs, nNs);
+		//@}
+
+		/// write the robot poses
+		for (size_t i = 0; i < nCount; ++i)
+			fprintf(fp, "%f\t%f\t%f\t%f\n", Ns2Sec(record[i].time_ns), \
+				response[i].x, response[i].y, response[i].q);
+		fflush(fp);
+
+		if (rc <= 0)
+			break;
+	}
+
+	if (fp != stdout)
+		fclose(fp);
+
+	fprintf(stderr, "records: %lld, batches: %lld, round trip mean %.1f us, " \
+		"max %.1f us\n", nRecords, nBatches, \
+		nBatches ? nSumNs / 1e3 / nBatches : 0., nMaxNs / 1e3);
+
+	if (bLost)
+		return -1;
+
+	if (rc < 0)
+	{
+		std::cerr << "Error occurred while reading " << sInput << std::endl;
+		return -1;
+	}
+
+	return 0;
+}
+
+///
+/// @brief		replay an input file on all cores (offline reprocessing)
+///
+/// @param		sInput [in] input file (NN_input.csv format)
+/// @param		sOutput [in] output pose file ("-" for stdout, "" for none)
+/// @param		nThreads [in] number of threads (<= 0: hardware threads)
+/// @param		bCheck [in] compare with the sequential estimators
+///
+/// @return		0 on success, < 0 if occurred error
+///
+/// @remark		Throughput is reported to stderr. With bCheck, the maximum
+///				deviation from CParallelReplay::RunSequential() and from the
+///				float CTricycle path is reported as well.
+///
+int CTestTricycle::RunReplay(const std::string& sInput, \
+	const std::string& sOutput, const int nThreads, const bool bCheck)
+{
+	/// parallel replay engine
+	CParallelReplay replay(nThreads);
+
+	/// pose after each record
+	std::vector<SPose> vPose;
+
+	/// read all records
+	m_sFilenameInput = sInput;
+	if (ReadInputFile() != 0)
+	{
+		std::cerr << "Cannot open the input: " << sInput << std::endl;
+		return -1;
+	}
+	vPose.resize(m_vRecord.size());
+
+	/// replay all records
 	//@{
-	std::cout << "Press any key in this window to quit." << std::endl;
-	getch();
+	const std::chrono::steady_clock::time_point tBegin = \
+		std::chrono::steady_clock::now();
+
+	if (m_vRecord.size() && \
+		replay.Run(&m_vRecord[0], m_vRecord.size(), &vPose[0]) != 0)
+		return -1;
+
+	const double fSec = std::chrono::duration<double>( \
+		std::chrono::steady_clock::now() - tBegin).count();
 	//@}
 
-#if defined(WIN32)
-	if (m_pGnuPlot)
-		delete m_pGnuPlot;	///< delete CpGnuplot instance
-#else // defined(WIN32)
-#endif // defined(WIN32)
+	fprintf(stderr, "records: %lu, threads: %d, %.6f sec, %.0f records/s\n", \
+		(unsigned long)m_vRecord.size(), replay.GetThreads(), fSec, \
+		(fSec > 0.) ? m_vRecord.size() / fSec : 0.);
+
+	/// compare with the sequential estimators
+	if (bCheck && m_vRecord.size())
+	{
+		/// pose of the sequential (double) replay and the float estimator
+		std::vector<SPose> vSeq(m_vRecord.size());
+		SPose pose;
+
+		/// reentrant float estimator of the selected chassis
+		const STricycleChassis& chassis = CTricycle::GetInstance()->GetChassis();
+		SEstimatorState state;
+
+		/// maximum deviation (position, heading)
+		float fSeqPos = 0.f, fSeqQ = 0.f, fEstPos = 0.f, fEstQ = 0.f;
+
+		replay.RunSequential(&m_vRecord[0], m_vRecord.size(), \
+			&vSeq[0]);
+
+		for (size_t i = 0; i < m_vRecord.size(); ++i)
+		{
+			const SRecord& r = m_vRecord[i];
+
+			pose = Step(chassis, INTEGRATOR_EULER, state, r);
+
+			fSeqPos = std::max(fSeqPos, std::max( \
+				fabsf(vPose[i].x - vSeq[i].x), fabsf(vPose[i].y - vSeq[i].y)));
+			fSeqQ = std::max(fSeqQ, \
+				fabsf(AngleDiff(vPose[i].q, vSeq[i].q)));
+			fEstPos = std::max(fEstPos, std::max( \
+				fabsf(vPose[i].x - pose.x), fabsf(vPose[i].y - pose.y)));
+			fEstQ = std::max(fEstQ, fabsf(AngleDiff(vPose[i].q, pose.q)));
+		}
+
+		fprintf(stderr, "max deviation from sequential: %g m, %g rad\n", \
+			fSeqPos, fSeqQ);
+		fprintf(stderr, "max deviation from estimate(): %g m, %g rad\n", \
+			fEstPos, fEstQ);
+	}
+
+	if (sOutput.empty())
+		return 0;
+
+	/// output file (stdout for "-")
+	FILE* fp = (sOutput == "-") ? stdout : fopen(sOutput.c_str(), "w");
+	if (!fp)
+	{
+		std::cerr << "Cannot open the output: " << sOutput << std::endl;
+		return -1;
+	}
+
+	/// write in the NN_pose.txt format
+	//@{
+	fputs("#time\trobot_x\trobot_y\trobot_q\n", fp);
+	fprintf(fp, "%f\t%f\t%f\t%f\n", 0.f, 0.f, 0.f, 0.f);
+	for (size_t i = 0; i < vPose.size(); ++i)
+		fprintf(fp, "%f\t%f\t%f\t%f\n", Ns2Sec(m_vRecord[i].time_ns), \
+			vPose[i].x, vPose[i].y, vPose[i].q);
+	//@}
+
+	if (fp != stdout)
+		fclose(fp);
+	else
+		fflush(fp);
 
 	return 0;
 }
 
+///
+/// @brief		estimate poses and covariances of an input file with the EKF
+///
+/// @param		sInput [in] input file (NN_input.csv format)
+/// @param		sOutput [in] output file ("-" for stdout, "" for none)
+///
+/// @return		0 on success, < 0 if occurred error
+///
+/// @remark		The angular velocity column of the input is the gyro
+///				measurement; an input without that column is estimated by
+///				the steering kinematics alone (the pose of NN_pose.txt).
+///				Each output line is the NN_pose.txt line followed by the
+///				variances of x, y and heading. The update rate is reported
+///				to stderr.
+///
+int CTestTricycle::RunEkf(const std::string& sInput, const std::string& sOutput)
+{
+	/// extended Kalman filter
+	CEkfTricycle ekf;
+
+	/// pose and covariance after each record
+	std::vector<SPose> vPose;
+	std::vector<SPoseCov> vCov;
+
+	/// read all records
+	m_sFilenameInput = sInput;
+	if (ReadInputFile() != 0)
+	{
+		std::cerr << "Cannot open the input: " << sInput << std::endl;
+		return -1;
+	}
+	vPose.resize(m_vRecord.size());
+	vCov.resize(m_vRecord.size());
+
+	/// the gyro rate is a measurement only when the input has the column
+	ekf.SetGyroInput(m_bGyroInput);
+
+	/// filter all records
+	//@{
+	const std::chrono::steady_clock::time_point tBegin = \
+		std::chrono::steady_clock::now();
+
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+	{
+		const SRecord& r = m_vRecord[i];
+
+		vPose[i] = ekf.EstimateNs(r.time_ns, r.steering_angle, \
+			r.encoder_ticks, r.angular_velocity);
+		ekf.GetCovariance(vCov[i]);
+	}
+
+	const double fSec = std::chrono::duration<double>( \
+		std::chrono::steady_clock::now() - tBegin).count();
+	//@}
+
+	fprintf(stderr, "records: %lu, %.6f sec, %.1f kHz\n", \
+		(unsigned long)m_vRecord.size(), fSec, \
+		(fSec > 0.) ? m_vRecord.size() / fSec * 1e-3 : 0.);
+
+	if (sOutput.empty())
+		return 0;
+
+	/// output file (stdout for "-")
+	FILE* fp = (sOutput == "-") ? stdout : fopen(sOutput.c_str(), "w");
+	if (!fp)
+	{
+		std::cerr << "Cannot open the output: " << sOutput << std::endl;
+		return -1;
+	}
+
+	fputs("#time\trobot_x\trobot_y\trobot_q\tvar_x\tvar_y\tvar_q\n", fp);
+	fprintf(fp, "%f\t%f\t%f\t%f\t%g\t%g\t%g\n", 0.f, 0.f, 0.f, 0.f, \
+		0.f, 0.f, 0.f);
+	for (size_t i = 0; i < vPose.size(); ++i)
+		fprintf(fp, "%f\t%f\t%f\t%f\t%g\t%g\t%g\n", \
+			Ns2Sec(m_vRecord[i].time_ns), vPose[i].x, vPose[i].y, \
+			vPose[i].q, vCov[i].xx, vCov[i].yy, vCov[i].qq);
+
+	if (fp != stdout)
+		fclose(fp);
+	else
+		fflush(fp);
+
+	return 0;
+}
+
+///
+/// @brief		pose mean and covariance of noisy gyro realizations of an input
+///				file (Monte Carlo)
+///
+/// @param		sInput [in] input filename
+/// @param		sOutput [in] output filename ("-": stdout, "": none)
+/// @param		nRuns [in] number of realizations
+/// @param		nThreads [in] number of worker threads (0: hardware threads)
+///
+/// @return		0 on success, -1 if occurred error
+///
+/// @remark		The realizations use the error model of the virtual gyro
+///				(--gyro-noise, --gyro-drift, --seed). Each output line holds
+///				the mean pose, the covariance and the 1-sigma error ellipse of
+///				the position after a record.
+///
+int CTestTricycle::RunMonteCarlo(const std::string& sInput, \
+	const std::string& sOutput, const int nRuns, const int nThreads)
+{
+	/// Monte Carlo over the gyro error model
+	CMonteCarlo mc(CVirtualGyro::GetInstance()->GetErrorModel(), nRuns, \
+		nThreads);
+
+	/// read all records
+	m_sFilenameInput = sInput;
+	if (ReadInputFile() != 0)
+	{
+		std::cerr << "Cannot open the input: " << sInput << std::endl;
+		return -1;
+	}
+
+	/// run all realizations
+	//@{
+	const std::chrono::steady_clock::time_point tBegin = \
+		std::chrono::steady_clock::now();
+
+	if (mc.Run(m_vRecord.data(), m_vRecord.size()) != 0)
+	{
+		std::cerr << "Cannot run the realizations: " << nRuns << std::endl;
+		return -1;
+	}
+
+	const double fSec = std::chrono::duration<double>( \
+		std::chrono::steady_clock::now() - tBegin).count();
+	//@}
+
+	/// final error ellipse
+	float fMajor = 0.f, fMinor = 0.f, fAngle = 0.f;
+	const size_t nLast = mc.GetSize() - 1;
+	CMonteCarlo::GetErrorEllipse(mc.GetCovariance(nLast), fMajor, fMinor, \
+		fAngle);
+
+	const double fSteps = double(mc.GetRuns()) * double(m_vRecord.size());
+	fprintf(stderr, "runs: %d, records: %lu, threads: %d, %.6f sec, " \
+		"%.1f M steps/s\n", mc.GetRuns(), (unsigned long)m_vRecord.size(), \
+		mc.GetThreads(), fSec, (fSec > 0.) ? fSteps / fSec * 1e-6 : 0.);
+	fprintf(stderr, "final ellipse: %g x %g m at %f rad, stdev_q: %g rad\n", \
+		fMajor, fMinor, fAngle, sqrt(mc.GetCovariance(nLast).qq));
+
+	if (sOutput.empty())
+		return 0;
+
+	/// output file (stdout for "-")
+	FILE* fp = (sOutput == "-") ? stdout : fopen(sOutput.c_str(), "w");
+	if (!fp)
+	{
+		std::cerr << "Cannot open the output: " << sOutput << std::endl;
+		return -1;
+	}
+
+	fputs("#time\tmean_x\tmean_y\tmean_q\tcov_xx\tcov_xy\tcov_yy\t" \
+		"var_q\tellipse_a\tellipse_b\tellipse_q\n", fp);
+	fprintf(fp, "%f\t%f\t%f\t%f\t%g\t%g\t%g\t%g\t%g\t%g\t%f\n", 0.f, 0.f, \
+		0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f, 0.f);
+	for (size_t i = 0; i < mc.GetSize(); ++i)
+	{
+		const SPose& mean = mc.GetMean(i);
+		const SPoseCov& cov = mc.GetCovariance(i);
+
+		CMonteCarlo::GetErrorEllipse(cov, fMajor, fMinor, fAngle);
+		fprintf(fp, "%f\t%f\t%f\t%f\t%g\t%g\t%g\t%g\t%g\t%g\t%f\n", \
+			Ns2Sec(m_vRecord[i].time_ns), mean.x, mean.y, mean.q, cov.xx, \
+			cov.xy, cov.yy, cov.qq, fMajor, fMinor, fAngle);
+	}
+
+	if (fp != stdout)
+		fclose(fp);
+	else
+		fflush(fp);
+
+	return 0;
+}
+
+///
+/// @brief		calculate odometry with a three-stage threaded pipeline
+///
+/// @param		N/A
+///
+/// @return		0 on success, < 0 if occurred error
+///
+/// @remark		Stage 1 parses the memory-mapped input file (or decodes the
+///				chunks of a record archive), stage 2 runs the virtual gyro
+///				and the estimator and stage 3 (calling thread) writes the
+///				result files. Batches of PIPELINE_BATCH_SIZE go
+///				through lock-free SPSC rings of PIPELINE_RING_SIZE batches; a
+///				stage waits when its output ring is full, so the throughput
+///				is bounded by the slowest stage. The output is the same as
+///				the sequential loop of Run().
+///
+int CTestTricycle::RunPipeline()
+{
+	/// memory-mapped input file
+	CMappedFile file;
+
+	/// rings between the stages
+	TSpscRing<SRecordBatch> ringRecord(PIPELINE_RING_SIZE);
+	TSpscRing<SPoseBatch> ringPose(PIPELINE_RING_SIZE);
+
+	/// reader of a record archive input
+	CRecordArchiveReader archive;
+
+	/// whether the input is a record archive
+	bool bArchive = false;
+
+	/// whether a chunk of the archive was corrupted (stage 1)
+	bool bDecodeError = false;
+
+	/// result of the write stage
+	int rc = 0;
+
+	if (file.Open(m_sFilenameInput) != 0)
+		return -1;
+
+	bArchive = IsRecordArchive(file.GetData(), file.GetSize());
+	if (bArchive && archive.Attach(file.GetData(), file.GetSize()) != 0)
+		return -1;
+
+	/// stage 1: parse lines (or decode chunks) into record batches
+	std::thread parser([&]()
+	{
+		SRecordBatch* pBatch = ringRecord.WaitPush();
+		pBatch->nCount = 0;
+
+		/// keep the record at nCount and push the batch when it is full
+		auto push = [&]()
+		{
+			if (++pBatch->nCount < PIPELINE_BATCH_SIZE)
+				return;
+
+			pBatch->bLast = false;
+			ringRecord.EndPush();
+			pBatch = ringRecord.WaitPush();
+			pBatch->nCount = 0;
+		};
+
+		if (bArchive)
+		{
+			std::vector<SRecord> vChunk;
+			for (size_t c = 0; c < archive.GetChunkCount(); ++c)
+			{
+				vChunk.resize(archive.GetChunk(c).count);
+				if (archive.DecodeChunk(c, &vChunk[0]) != 0)
+				{
+					bDecodeError = true;
+					break;
+				}
+				for (size_t i = 0; i < vChunk.size(); ++i)
+				{
+					pBatch->record[pBatch->nCount] = vChunk[i];
+					push();
+				}
+			}
+		}
+		else
+		{
+			const char* p = file.GetData();
+			const char* pEnd = p + file.GetSize();
+			bool bValid = false;
+
+			while (p < pEnd)
+			{
+				p = ParseRecordLine(p, pEnd, pBatch->record[pBatch->nCount], \
+					bValid);
+				if (bValid)
+					push();
+			}
+		}
+		pBatch->bLast = true;
+		ringRecord.EndPush();
+	});
+
+	/// stage 2: estimate poses and contours
+	std::thread estimator([&]()
+	{
+		CTricycle* pTricycle = CTricycle::GetInstance();
+		CVirtualGyro* pGyro = CVirtualGyro::GetInstance();
+
+		for (bool bLast = false; !bLast; )
+		{
+			const SRecordBatch* pIn = ringRecord.WaitPop();
+			SPoseBatch* pOut = ringPose.WaitPush();
+
+			for (size_t i = 0; i < pIn->nCount; ++i)
+			{
+				const SRecord& r = pIn->record[i];
+				SPoseLogRecord& out = pOut->record[i];
+
+				pGyro->UpdateNs(r.time_ns, r.steering_angle, r.encoder_ticks);
+				out.time = Ns2Sec(r.time_ns);
+				out.pose = pTricycle->EstimateNs(r.time_ns, r.steering_angle, \
+					r.encoder_ticks, pGyro->GetAngVel());
+				pTricycle->GetRobotContour(out.posFW, out.posLW, out.posRW);
+			}
+			pOut->nCount = pIn->nCount;
+			pOut->bLast = bLast = pIn->bLast;
+
+			ringRecord.EndPop();
+			ringPose.EndPush();
+		}
+	});
+
+	/// stage 3: write the result files
+	for (bool bLast = false; !bLast; )
+	{
+		const SPoseBatch* pIn = ringPose.WaitPop();
+
+		for (size_t i = 0; i < pIn->nCount; ++i)
+		{
+			if (WriteRecord(pIn->record[i]) != 0)
+				rc = -1;
+		}
+		bLast = pIn->bLast;
+
+		ringPose.EndPop();
+	}
+
+	parser.join();
+	estimator.join();
+
+	if (bDecodeError)
+		rc = -1;
+
+	return rc;
+}
+
 ///
 /// @brief		set input, pose, contour filename
 /// @param		N/A
@@ -241,79 +1014,139 @@ int CTestTricycle::SetFilename(const int nTestCase)
 	//std::cout << m_sFilenameContour << std::endl;
 	//@}
 
+	/// set the filename for writing the binary pose log
+	//@{
+	ss.str(std::string());			///< clear
+	ss << std::setfill('0') << std::setw(2) << nTestCase;
+	ss << "_pose.bin";				///< E.g., '01_pose.bin'
+	m_sFilenamePoseLog = str + ss.str();
+	//@}
+
 	return 0;
 }
 
 ///
-/// @brief		read the input file
-/// @param		N/A
-/// @return		0 on success, < 0 if occurred error
+/// @brief		convert an input file between CSV and the record archive
+///
+/// @param		sInput [in] input filename (NN_input.csv or record archive)
+/// @param		sOutput [in] output filename (record archive or CSV)
+///
+/// @return		0 on success, -1 if occurred error
 ///
-int CTestTricycle::ReadInputFile()
+/// @remark		The input is read by ReadInputFile(), so the same records
+///				are archived as the estimator would read. An archive is
+///				written back as CSV with the exact timestamps (9 decimals);
+///				the angular velocity column is kept only if the original
+///				input had it (RECORD_ARCHIVE_FLAG_GYRO).
+///
+int CTestTricycle::ConvertArchive(const std::string& sInput, \
+	const std::string& sOutput)
 {
-	///< file stream for input
-	std::fstream fsFileInput;
-
-	///< temporary struct to read a record from input file
-	SRecord sRecord;
+	bool bArchive = false;
 
-	///< string for getline
-	std::string str;
+	/// read all records
+	m_sFilenameInput = sInput;
+	if (ReadInputFile(&bArchive) != 0)
+	{
+		std::cerr << "Cannot open the input: " << sInput << std::endl;
+		return -1;
+	}
 
-	/// open input file
-	fsFileInput.open(m_sFilenameInput, std::fstream::in);
+	/// CSV to record archive
+	if (!bArchive)
+	{
+		CRecordArchiveWriter writer;
+		if (writer.Open(sOutput, RECORD_ARCHIVE_QUANTUM, \
+			m_bGyroInput ? RECORD_ARCHIVE_FLAG_GYRO : 0) != 0)
+		{
+			std::cerr << "Cannot open the output: " << sOutput << std::endl;
+			return -1;
+		}
+		for (size_t i = 0; i < m_vRecord.size(); ++i)
+			writer.Write(m_vRecord[i]);
+		if (writer.Close() != 0)
+		{
+			std::cerr << "Cannot write the output: " << sOutput << std::endl;
+			return -1;
+		}
+		return 0;
+	}
 
-	/// if file open is failed
-	if (!fsFileInput.is_open())
+	/// record archive to CSV
+	//@{
+	FILE* fp = fopen(sOutput.c_str(), "w");
+	if (!fp)
+	{
+		std::cerr << "Cannot open the output: " << sOutput << std::endl;
 		return -1;
+	}
 
-	/// iterate each record of the input file
-	while (std::getline(fsFileInput, str))
+	fputs(m_bGyroInput ? \
+		"#archive\n#time,steering_angle,encoder_ticks,angular_velocity\n" : \
+		"#archive\n#time,steering_angle,encoder_ticks\n", fp);
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
 	{
-		/// if the line is start with '#' (comment line), skip parsing
-		if (str.at(0) == '#')
-			continue;
+		const SRecord& r = m_vRecord[i];
+		const unsigned long long nNs = (r.time_ns < 0) ? \
+			0ULL - (unsigned long long)r.time_ns : (unsigned long long)r.time_ns;
+
+		fprintf(fp, "%s%llu.%09llu,%.9g,%d", (r.time_ns < 0) ? "-" : "", \
+			nNs / 1000000000ULL, nNs % 1000000000ULL, r.steering_angle, \
+			r.encoder_ticks);
+		if (m_bGyroInput)
+			fprintf(fp, ",%.9g", r.angular_velocity);
+		fputc('\n', fp);
+	}
 
-		//std::cout << str << std::endl;
+	if (fclose(fp) != 0)
+	{
+		std::cerr << "Cannot write the output: " << sOutput << std::endl;
+		return -1;
+	}
+	//@}
 
-		/// save to istringstream to use getline()
-		std::istringstream iss(str);
+	return 0;
+}
 
-		/// get 'time' field
-		//@{
-		std::getline(iss, str, ',');
-		sRecord.time = float(atof(str.c_str()));
-		/*float time = atof(str.c_str());
-		std::cout.setf(std::ios::fixed);
-		std::cout.precision(3);
-		std::cout << "time: " << time << ", ";
-		std::cout.unsetf(std::ios::fixed);*/
-		//@}
+///
+/// @brief		read the input file
+/// @param		pbArchive [out] whether the file is a record archive
+///				(optional)
+/// @return		0 on success, < 0 if occurred error
+/// @remark		the file is memory-mapped and parsed in place; a record
+///				archive (RecordArchive.h) is decoded into m_vRecord instead.
+///				m_bGyroInput tells whether the records carry a gyro rate.
+///
+int CTestTricycle::ReadInputFile(bool* pbArchive)
+{
+	/// memory-mapped input file
+	CMappedFile file;
 
-		/// get 'steering_angle' field
-		//@{
-		std::getline(iss, str, ',');
-		sRecord.steering_angle = float(atof(str.c_str()));
-		/*float steering_angle = atof(str.c_str());
-		std::cout.setf(std::ios::fixed);
-		std::cout.precision(3);
-		std::cout << "steering_angle: " << steering_angle << ", ";
-		std::cout.unsetf(std::ios::fixed);*/
-		//@}
+	/// open input file
+	if (file.Open(m_sFilenameInput) != 0)
+		return -1;
 
-		/// get 'encoder_ticks' field
-		//@{
-		std::getline(iss, str, ',');
-		sRecord.encoder_ticks = atoi(str.c_str());
-		/* float encoder_ticks = atoi(str.c_str());
-		std::cout << std::setfill('0') << std::setw(3);
-		std::cout << "encoder_ticks: " << encoder_ticks << ", ";*/
-		//@}
+	m_vRecord.clear();
+	m_bGyroInput = false;
 
-		/// add a record to the vector
-		m_vRecord.push_back(sRecord);
+	/// decode all records of the record archive
+	const bool bArchive = IsRecordArchive(file.GetData(), file.GetSize());
+	if (pbArchive)
+		*pbArchive = bArchive;
+	if (bArchive)
+	{
+		CRecordArchiveReader reader;
+		if (reader.Attach(file.GetData(), file.GetSize()) != 0 || \
+			reader.Read(m_vRecord) < 0)
+			return -1;
+		m_bGyroInput = (reader.GetFlags() & RECORD_ARCHIVE_FLAG_GYRO) != 0;
+		return 0;
 	}
 
+	/// parse all records of the input file
+	ParseRecords(file.GetData(), file.GetData() + file.GetSize(), m_vRecord, \
+		&m_bGyroInput);
+
 	return 0;
 }
 
@@ -324,22 +1157,26 @@ int CTestTricycle::ReadInputFile()
 ///
 int CTestTricycle::CreateResultFiles()
 {
+	/// create the binary pose log
+	if (m_bBinaryOutput)
+		return m_poseLog.Open(m_sFilenamePoseLog);
+
 	/// create a file to save poses of robot center (trajectory)
 	m_fsFilePose.open(m_sFilenamePose);
 
 	/// write comment (attribute of each field)
 	m_fsFilePose << "#time\t" \
-		<< "robot_x\t"  << "robot_y\t"  << "robot_q" << std::endl;
+		<< "robot_x\t"  << "robot_y\t"  << "robot_q" << "\n";
 
 	/// create a file to save polygon shapes of the robot
 	m_fsFileContour.open(m_sFilenameContour);
 
 	/// write 1st line comment
-	m_fsFileContour << "#robot_x\t" << "robot_y\t" << std::endl \
-		<< "#LWheel_x\t" << "LWheel_y\t" << std::endl \
-		<< "#FWheel_x\t" << "FWheel_y\t" << std::endl \
-		<< "#RWheel_x\t" << "RWheel_y\t" << std::endl \
-		<< "#robot_x\t" << "robot_y" << std::endl << std::endl;
+	m_fsFileContour << "#robot_x\t" << "robot_y\t" << "\n" \
+		<< "#LWheel_x\t" << "LWheel_y\t" << "\n" \
+		<< "#FWheel_x\t" << "FWheel_y\t" << "\n" \
+		<< "#RWheel_x\t" << "RWheel_y\t" << "\n" \
+		<< "#robot_x\t" << "robot_y" << "\n" << "\n";
 
 	// no errors
 	return 0;
@@ -352,6 +1189,10 @@ int CTestTricycle::CreateResultFiles()
 ///
 int CTestTricycle::CloseResultFiles()
 {
+	/// close the binary pose log (writes the block index)
+	if (m_bBinaryOutput)
+		return m_poseLog.Close();
+
 	/// close files
 	m_fsFilePose.close();
 	m_fsFileContour.close();
@@ -370,31 +1211,53 @@ int CTestTricycle::CloseResultFiles()
 ///
 /// @return		0 if no errors, -1 if failed
 ///
-int CTestTricycle::Write(const float time, const SPose pose)
+int CTestTricycle::Write(const double time, const SPose pose)
 {
-	/// positions of front and left/right wheel
-	SPos posFW, posLW, posRW;
+	/// pose and contour (positions of front and left/right wheel)
+	SPoseLogRecord record;
+
+	record.time = time;
+	record.pose = pose;
+	CTricycle::GetInstance()->GetRobotContour(record.posFW, record.posLW, \
+		record.posRW);
+
+	return WriteRecord(record);
+}
+
+///
+/// @brief		write a pose and its contour to the files (pose, contour)
+/// @param		record [in] time, pose and contour
+/// @return		0 if no errors
+///
+int CTestTricycle::WriteRecord(const SPoseLogRecord& record)
+{
+	const SPose& pose = record.pose;
+	const SPos& posFW = record.posFW;
+	const SPos& posLW = record.posLW;
+	const SPos& posRW = record.posRW;
+
+	/// write a record to the binary pose log
+	if (m_bBinaryOutput)
+		return m_poseLog.Write(record);
 
 	/// check logical errors of file stream
 	if (m_fsFilePose.fail() || m_fsFileContour.fail())
 		return -1;
 
 	/// save a robot pose of robot center to 'pose.txt' file
+	/// ('\n' instead of std::endl: the stream is flushed when closed)
 	m_fsFilePose << std::fixed;	/// set fixed format
-	m_fsFilePose << time << "\t";
-	m_fsFilePose << pose.x << "\t" << pose.y << "\t" << pose.q << std::endl;
-
-	/// get the robot contour (positions of front/left/right wheel)
-	CTricycle::GetInstance()->GetRobotContour(posFW, posLW, posRW);
+	m_fsFilePose << record.time << "\t";
+	m_fsFilePose << pose.x << "\t" << pose.y << "\t" << pose.q << "\n";
 
 	/// save a robot polygon shape to 'contour.txt' file
 	m_fsFileContour << std::fixed;	/// set fixed format
-	m_fsFileContour << pose.x  << "\t" << pose.y  << std::endl;
-	m_fsFileContour << posLW.x << "\t" << posLW.y << std::endl;
-	m_fsFileContour << posFW.x << "\t" << posFW.y << std::endl;
-	m_fsFileContour << posRW.x << "\t" << posRW.y << std::endl;
-	m_fsFileContour << pose.x  << "\t" << pose.y  << std::endl;
-	m_fsFileContour << std::endl;		/// need a blank line to seperate polygons
+	m_fsFileContour << pose.x  << "\t" << pose.y  << "\n";
+	m_fsFileContour << posLW.x << "\t" << posLW.y << "\n";
+	m_fsFileContour << posFW.x << "\t" << posFW.y << "\n";
+	m_fsFileContour << posRW.x << "\t" << posRW.y << "\n";
+	m_fsFileContour << pose.x  << "\t" << pose.y  << "\n";
+	m_fsFileContour << "\n";		/// need a blank line to seperate polygons
 
 	// no errors
 	return 0;
@@ -17,28 +17,27 @@
 
 #include "Singleton.h"		// TSingleton
 #include "Pose.h"			// SPos, SPose
+#include "Record.h"			// SRecord
+#include "PoseLog.h"		// CPoseLogWriter
 
 #if defined(WIN32)
 #	include "pGNUPlot.h"	// CpGnuplot
 #endif
 
+/// number of records per batch of the pipeline (RunPipeline())
+#define PIPELINE_BATCH_SIZE		(256)
+
+/// number of batches per ring buffer of the pipeline (RunPipeline())
+#define PIPELINE_RING_SIZE		(64)
+
+/// maximum number of records per request batch of RunClient()
+#define CLIENT_BATCH_SIZE		(64)
+
 /// @brief		Test class to test Tricycle class
 class CTestTricycle : public TSingleton<CTestTricycle>
 {
-public:
-	typedef struct _tagSRecord
-	{
-		float time;
-		float steering_angle;
-		int   encoder_ticks;
-		float angular_velocity;
-
-		/// default constructor
-		explicit _tagSRecord()
-		: time(0.f)
-		, steering_angle(0.f)
-		, encoder_ticks(0) {}
-	} SRecord;
+	/// microbenchmark of ReadInputFile() and Write(), checks of RunFiles()
+	friend class CTricycleBench;
 
 public:
 	/// constructor
@@ -48,14 +47,42 @@ public:
 	virtual ~CTestTricycle();
 
 	/// perform test case
-	int Run(const int nTestCase);
+	int Run(const int nTestCase, const bool bBinaryOutput = false, \
+		const bool bPipeline = false);
+
+	/// estimate poses from a stream of records as they arrive
+	int RunStream(const std::string& sInput, const std::string& sOutput);
+
+	/// estimate poses of a stream of records on an odometry server
+	int RunClient(const std::string& sSocket, const std::string& sInput, \
+		const std::string& sOutput);
+
+	/// replay an input file on all cores (offline reprocessing)
+	int RunReplay(const std::string& sInput, const std::string& sOutput, \
+		const int nThreads = 0, const bool bCheck = false);
+
+	/// estimate poses and covariances of an input file with the EKF
+	int RunEkf(const std::string& sInput, const std::string& sOutput);
+
+	/// pose mean and covariance of noisy gyro realizations of an input file
+	int RunMonteCarlo(const std::string& sInput, const std::string& sOutput, \
+		const int nRuns, const int nThreads = 0);
+
+	/// convert an input file between CSV and the record archive
+	int ConvertArchive(const std::string& sInput, const std::string& sOutput);
 
 private:
 	/// set input, pose, contour filename
 	int SetFilename(const int nTestCase);
 
-	/// read test case file
-	int ReadInputFile();
+	/// estimate the input file into the result files (Run() without plot)
+	int RunFiles(const bool bPipeline);
+
+	/// read test case file (CSV or record archive)
+	int ReadInputFile(bool* pbArchive = 0);
+
+	/// calculate odometry with a three-stage threaded pipeline
+	int RunPipeline();
 
 	/// create result files
 	int CreateResultFiles();
@@ -64,7 +91,10 @@ private:
 	int CloseResultFiles();
 
 	/// write pose information to the files (pose, contour)
-	int Write(const float time, const SPose pose);
+	int Write(const double time, const SPose pose);
+
+	/// write a pose and its contour to the files (pose, contour)
+	int WriteRecord(const SPoseLogRecord& record);
 
 	/// draw a plot to see the result
 	void DrawGnuplot(const bool bSetRange = false, \
@@ -91,15 +121,27 @@ private:
 	/// filename for writing contour data
 	std::string m_sFilenameContour;
 
+	/// filename for writing the binary pose log
+	std::string m_sFilenamePoseLog;
+
+	/// whether to write the binary pose log instead of text files
+	bool m_bBinaryOutput;
+
 	/// file stream to save poses of robot center (trajectory)
 	std::ofstream m_fsFilePose;
 
 	/// file stream to save robot polygon shapes of the robot
 	std::ofstream m_fsFileContour;
 
+	/// writer of the binary pose log (poses and contours)
+	CPoseLogWriter m_poseLog;
+
 	/// vector for records of input file
 	std::vector<SRecord> m_vRecord;
 
+	/// whether the input file has the angular velocity (gyro) column
+	bool m_bGyroInput;
+
 #if defined(WIN32)
 	/// CpGnuplot instance pointer
 	CpGnuplot* m_pGnuPlot;
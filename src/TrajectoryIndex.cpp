@@ -0,0 +1,682 @@
+///
+/// @file		TrajectoryIndex.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Spatial index over estimated trajectories
+///
+
+#include <algorithm>		// std::min, std::max, std::sort, std::unique
+#include <cmath>			// floor, sqrt
+#include <cstdio>			// fopen, fwrite, fclose
+#include <cstring>			// memcpy, memcmp
+#include <thread>			// std::thread::hardware_concurrency
+#include <utility>			// std::pair
+
+#include "TrajectoryIndex.h"
+#include "ParallelFor.h"	// ParallelFor
+
+/// magic string of the header
+static const char s_szMagic[8] = "TRCTRAJ";
+
+/// number of tracked points of a sample (robot, front, left, right wheel)
+#define TRAJ_POINTS		(4)
+
+/// type definition of a bounding box
+typedef struct _tagSTrajBox
+{
+	double x0, y0;		///< smallest corner
+	double x1, y1;		///< largest corner
+
+	/// default constructor (empty box)
+	_tagSTrajBox() : x0(1e300), y0(1e300), x1(-1e300), y1(-1e300) {}
+
+	/// grow the box to a point
+	void Add(const double x, const double y)
+	{
+		x0 = std::min(x0, x); y0 = std::min(y0, y);
+		x1 = std::max(x1, x); y1 = std::max(y1, y);
+	}
+
+	/// grow the box to another box
+	void Add(const _tagSTrajBox& box)
+	{
+		x0 = std::min(x0, box.x0); y0 = std::min(y0, box.y0);
+		x1 = std::max(x1, box.x1); y1 = std::max(y1, box.y1);
+	}
+} STrajBox;
+
+/// type definition of a run of a cell made by a build task
+typedef struct _tagSTrajCellRun
+{
+	unsigned cell;		///< cell (row * cols + col)
+	STrajectoryRun run;	///< segments
+} STrajCellRun;
+
+///
+/// @brief		get a tracked point of a sample
+/// @param		s [in] sample
+/// @param		k [in] point (0: robot, 1: front, 2: left, 3: right wheel)
+/// @return		position (m)
+///
+static inline SPos SamplePoint(const STrajectorySample& s, const int k)
+{
+	switch (k)
+	{
+	case 0: return SPos(s.pose.x, s.pose.y);
+	case 1: return s.posFW;
+	case 2: return s.posLW;
+	default: return s.posRW;
+	}
+}
+
+///
+/// @brief		get the index of the sample at the end of a segment
+/// @param		pSample [in] samples
+/// @param		nSamples [in] number of samples
+/// @param		i [in] segment
+/// @return		i + 1, or i if the segment is a single point
+///
+static inline size_t SegmentEnd(const STrajectorySample* pSample, \
+	const size_t nSamples, const size_t i)
+{
+	return (i + 1 < nSamples && !(pSample[i + 1].flags & TRAJ_SAMPLE_BREAK)) \
+		? i + 1 : i;
+}
+
+///
+/// @brief		get the cell of a coordinate
+/// @param		v [in] coordinate (m)
+/// @param		dOrigin [in] coordinate of the corner of the grid (m)
+/// @param		dCell [in] size of a cell (m)
+/// @param		nCells [in] number of cells along the axis
+/// @return		cell along the axis (clamped)
+///
+static inline unsigned CellOf(const double v, const double dOrigin, \
+	const double dCell, const unsigned nCells)
+{
+	const double c = floor((v - dOrigin) / dCell);
+	if (c <= 0.)
+		return 0;
+	if (c >= double(nCells - 1))
+		return nCells - 1;
+	return unsigned(c);
+}
+
+///
+/// @brief		constructor
+/// @param		nThreads [in] number of worker threads (0: all cores)
+/// @return		N/A
+///
+CTrajectoryIndexWriter::CTrajectoryIndexWriter(const int nThreads)
+: m_nThreads(nThreads)
+{
+	if (m_nThreads <= 0)
+		m_nThreads = int(std::thread::hardware_concurrency());
+	if (m_nThreads <= 0)
+		m_nThreads = 1;
+}
+
+///
+/// @brief		build the index of samples
+/// @param		vSample [in] samples in time order (trajectories separated
+///				by TRAJ_SAMPLE_BREAK)
+/// @param		dCellSize [in] size of a cell (m); grows if the bounding box
+///				would need more than TRAJ_INDEX_MAX_CELLS cells
+/// @return		0 on success, -1 if occurred error
+/// @remark		The bounding box and the runs of TRAJ_INDEX_TASK_SIZE
+///				samples are made on worker threads; the runs are then counted
+///				and scattered per cell in task order, which keeps the runs of
+///				a cell in time order.
+///
+int CTrajectoryIndexWriter::Build(const std::vector<STrajectorySample>& vSample, \
+	const double dCellSize)
+{
+	m_vImage.clear();
+
+	const size_t nSamples = vSample.size();
+	if (!(dCellSize > 0.) || nSamples >= 0xffffffffULL)
+		return -1;
+
+	const STrajectorySample* pSample = nSamples ? &vSample[0] : 0;
+	const size_t nTasks = (nSamples + TRAJ_INDEX_TASK_SIZE - 1) \
+		/ TRAJ_INDEX_TASK_SIZE;
+
+	/// bounding box of the samples
+	//@{
+	std::vector<STrajBox> vTaskBox(nTasks);
+	ParallelFor(m_nThreads, nTasks, [&](const size_t t)
+	{
+		const size_t nEnd = std::min(nSamples, (t + 1) * TRAJ_INDEX_TASK_SIZE);
+		for (size_t i = t * TRAJ_INDEX_TASK_SIZE; i < nEnd; ++i)
+		{
+			for (int k = 0; k < TRAJ_POINTS; ++k)
+			{
+				const SPos p = SamplePoint(pSample[i], k);
+				vTaskBox[t].Add(p.x, p.y);
+			}
+		}
+	});
+
+	STrajBox box;
+	for (size_t t = 0; t < nTasks; ++t)
+		box.Add(vTaskBox[t]);
+	if (!nSamples)
+		box.Add(0., 0.);
+	//@}
+
+	/// grid over the bounding box
+	//@{
+	STrajectoryIndexHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, s_szMagic, sizeof(s_szMagic));
+	header.version = TRAJ_INDEX_VERSION;
+	header.sampleSize = sizeof(STrajectorySample);
+	header.sampleCount = nSamples;
+
+	double dCell = dCellSize;
+	for (;;)
+	{
+		header.originX = floor(box.x0 / dCell) * dCell;
+		header.originY = floor(box.y0 / dCell) * dCell;
+		const double dCols = floor((box.x1 - header.originX) / dCell) + 1.;
+		const double dRows = floor((box.y1 - header.originY) / dCell) + 1.;
+		if (dCols * dRows <= double(TRAJ_INDEX_MAX_CELLS))
+		{
+			header.cols = unsigned(dCols);
+			header.rows = unsigned(dRows);
+			break;
+		}
+		dCell *= 2.;
+	}
+	header.cellSize = dCell;
+	const size_t nCells = size_t(header.cols) * header.rows;
+	//@}
+
+	/// runs of consecutive segments per cell, per task
+	//@{
+	std::vector<std::vector<STrajCellRun> > vTaskRun(nTasks);
+	ParallelFor(m_nThreads, nTasks, [&](const size_t t)
+	{
+		std::vector<STrajCellRun>& vRun = vTaskRun[t];
+
+		/// cells of the previous segment and their runs
+		std::vector<std::pair<unsigned, size_t> > vPrev, vCur;
+
+		const size_t nEnd = std::min(nSamples, (t + 1) * TRAJ_INDEX_TASK_SIZE);
+		for (size_t i = t * TRAJ_INDEX_TASK_SIZE; i < nEnd; ++i)
+		{
+			const size_t j = SegmentEnd(pSample, nSamples, i);
+
+			STrajBox seg;
+			for (int k = 0; k < TRAJ_POINTS; ++k)
+			{
+				const SPos a = SamplePoint(pSample[i], k);
+				const SPos b = SamplePoint(pSample[j], k);
+				seg.Add(a.x, a.y);
+				seg.Add(b.x, b.y);
+			}
+
+			const unsigned cx0 = CellOf(seg.x0, header.originX, dCell, header.cols);
+			const unsigned cx1 = CellOf(seg.x1, header.originX, dCell, header.cols);
+			const unsigned cy0 = CellOf(seg.y0, header.originY, dCell, header.rows);
+			const unsigned cy1 = CellOf(seg.y1, header.originY, dCell, header.rows);
+
+			vCur.clear();
+			for (unsigned cy = cy0; cy <= cy1; ++cy)
+			{
+				for (unsigned cx = cx0; cx <= cx1; ++cx)
+				{
+					const unsigned nCell = cy * header.cols + cx;
+
+					/// extend the run of the previous segment in this cell
+					size_t r = vRun.size();
+					for (size_t p = 0; p < vPrev.size(); ++p)
+					{
+						if (vPrev[p].first == nCell)
+						{
+							r = vPrev[p].second;
+							break;
+						}
+					}
+
+					if (r < vRun.size())
+						++vRun[r].run.count;
+					else
+					{
+						STrajCellRun run;
+						run.cell = nCell;
+						run.run.first = unsigned(i);
+						run.run.count = 1;
+						vRun.push_back(run);
+					}
+					vCur.push_back(std::make_pair(nCell, r));
+				}
+			}
+			vPrev.swap(vCur);
+		}
+	});
+	//@}
+
+	/// count the runs per cell and lay out the file
+	//@{
+	std::vector<unsigned long long> vOffset(nCells + 1, 0);
+	for (size_t t = 0; t < nTasks; ++t)
+	{
+		for (size_t r = 0; r < vTaskRun[t].size(); ++r)
+			++vOffset[vTaskRun[t][r].cell + 1];
+	}
+	for (size_t c = 0; c < nCells; ++c)
+		vOffset[c + 1] += vOffset[c];
+	header.runCount = vOffset[nCells];
+
+	const size_t nSampleOffset = sizeof(STrajectoryIndexHeader);
+	const size_t nCellOffset = nSampleOffset + \
+		nSamples * sizeof(STrajectorySample);
+	const size_t nRunOffset = nCellOffset + \
+		(nCells + 1) * sizeof(unsigned long long);
+	m_vImage.resize(nRunOffset + size_t(header.runCount) * \
+		sizeof(STrajectoryRun));
+
+	memcpy(&m_vImage[0], &header, sizeof(header));
+	if (nSamples)
+		memcpy(&m_vImage[nSampleOffset], pSample, \
+			nSamples * sizeof(STrajectorySample));
+	memcpy(&m_vImage[nCellOffset], &vOffset[0], \
+		vOffset.size() * sizeof(unsigned long long));
+	//@}
+
+	/// scatter the runs in task order
+	//@{
+	STrajectoryRun* pRun = reinterpret_cast<STrajectoryRun*>( \
+		&m_vImage[0] + nRunOffset);
+	for (size_t t = 0; t < nTasks; ++t)
+	{
+		for (size_t r = 0; r < vTaskRun[t].size(); ++r)
+			pRun[vOffset[vTaskRun[t][r].cell]++] = vTaskRun[t][r].run;
+	}
+	//@}
+
+	return 0;
+}
+
+///
+/// @brief		write the built index to a file
+/// @param		sFilename [in] index filename
+/// @return		0 on success, -1 if occurred error
+///
+int CTrajectoryIndexWriter::Write(const std::string& sFilename) const
+{
+	if (m_vImage.empty())
+		return -1;
+
+	FILE* fp = fopen(sFilename.c_str(), "wb");
+	if (!fp)
+		return -1;
+
+	const bool bWritten = fwrite(&m_vImage[0], 1, m_vImage.size(), fp) \
+		== m_vImage.size();
+
+	return (fclose(fp) == 0 && bWritten) ? 0 : -1;
+}
+
+///
+/// @brief		constructor
+/// @param		N/A
+/// @return		N/A
+///
+CTrajectoryIndex::CTrajectoryIndex()
+: m_pSamples(0)
+, m_nSamples(0)
+, m_pCells(0)
+, m_pRuns(0)
+{
+	memset(&m_header, 0, sizeof(m_header));
+}
+
+///
+/// @brief		map an index file and validate it
+/// @param		sFilename [in] index filename
+/// @return		0 on success, -1 if occurred error
+///
+int CTrajectoryIndex::Open(const std::string& sFilename)
+{
+	Close();
+
+	if (m_file.Open(sFilename) != 0)
+		return -1;
+
+	if (Attach(m_file.GetData(), m_file.GetSize()) != 0)
+	{
+		Close();
+		return -1;
+	}
+
+	return 0;
+}
+
+///
+/// @brief		validate an index in a buffer kept by the caller
+/// @param		pData [in] first byte of the index (8-byte aligned)
+/// @param		nSize [in] size of the index (bytes)
+/// @return		0 on success, -1 if the index is not valid
+///
+int CTrajectoryIndex::Attach(const char* pData, const size_t nSize)
+{
+	if (!pData || nSize < sizeof(STrajectoryIndexHeader))
+		return -1;
+
+	STrajectoryIndexHeader header;
+	memcpy(&header, pData, sizeof(header));
+
+	if (memcmp(header.magic, s_szMagic, sizeof(header.magic)) || \
+		header.version != TRAJ_INDEX_VERSION || \
+		header.sampleSize != sizeof(STrajectorySample) || \
+		!(header.cellSize > 0.) || !header.cols || !header.rows)
+		return -1;
+
+	/// check that the sections fill the buffer exactly
+	//@{
+	const unsigned long long nCells = \
+		(unsigned long long)header.cols * header.rows;
+	if (header.sampleCount > nSize / sizeof(STrajectorySample) || \
+		header.runCount > nSize / sizeof(STrajectoryRun) || \
+		nCells >= nSize / sizeof(unsigned long long))
+		return -1;
+
+	const unsigned long long nCellOffset = sizeof(STrajectoryIndexHeader) + \
+		header.sampleCount * sizeof(STrajectorySample);
+	const unsigned long long nRunOffset = nCellOffset + \
+		(nCells + 1) * sizeof(unsigned long long);
+	if (nRunOffset + header.runCount * sizeof(STrajectoryRun) != nSize)
+		return -1;
+
+	const unsigned long long* pCells = \
+		reinterpret_cast<const unsigned long long*>(pData + nCellOffset);
+	if (pCells[0] != 0 || pCells[nCells] != header.runCount)
+		return -1;
+	//@}
+
+	m_header = header;
+	m_pSamples = reinterpret_cast<const STrajectorySample*>( \
+		pData + sizeof(STrajectoryIndexHeader));
+	m_nSamples = size_t(header.sampleCount);
+	m_pCells = pCells;
+	m_pRuns = reinterpret_cast<const STrajectoryRun*>(pData + nRunOffset);
+
+	return 0;
+}
+
+///
+/// @brief		unmap the index file
+/// @param		N/A
+/// @return		void
+///
+void CTrajectoryIndex::Close()
+{
+	m_file.Close();
+
+	memset(&m_header, 0, sizeof(m_header));
+	m_pSamples = 0;
+	m_nSamples = 0;
+	m_pCells = 0;
+	m_pRuns = 0;
+}
+
+///
+/// @brief		get the segments of the cells overlapping a box
+/// @param		x0, y0 [in] smallest corner of the box (m)
+/// @param		x1, y1 [in] largest corner of the box (m)
+/// @param		vSegment [out] segments (sorted, unique)
+/// @return		void
+///
+void CTrajectoryIndex::Collect(const double x0, const double y0, \
+	const double x1, const double y1, std::vector<unsigned>& vSegment) const
+{
+	vSegment.clear();
+
+	const double dCell = m_header.cellSize;
+	if (x1 < m_header.originX || y1 < m_header.originY || \
+		x0 >= m_header.originX + dCell * m_header.cols || \
+		y0 >= m_header.originY + dCell * m_header.rows)
+		return;
+
+	const unsigned cx0 = CellOf(x0, m_header.originX, dCell, m_header.cols);
+	const unsigned cx1 = CellOf(x1, m_header.originX, dCell, m_header.cols);
+	const unsigned cy0 = CellOf(y0, m_header.originY, dCell, m_header.rows);
+	const unsigned cy1 = CellOf(y1, m_header.originY, dCell, m_header.rows);
+
+	for (unsigned cy = cy0; cy <= cy1; ++cy)
+	{
+		for (unsigned cx = cx0; cx <= cx1; ++cx)
+		{
+			const size_t nCell = size_t(cy) * m_header.cols + cx;
+			const unsigned long long nEnd = \
+				std::min(m_pCells[nCell + 1], m_header.runCount);
+			for (unsigned long long r = m_pCells[nCell]; r < nEnd; ++r)
+			{
+				const STrajectoryRun& run = m_pRuns[r];
+				const unsigned long long nLast = std::min<unsigned long long>( \
+					(unsigned long long)run.first + run.count, m_nSamples);
+				for (unsigned long long i = run.first; i < nLast; ++i)
+					vSegment.push_back(unsigned(i));
+			}
+		}
+	}
+
+	/// a segment over several cells is found in each of them
+	std::sort(vSegment.begin(), vSegment.end());
+	vSegment.erase(std::unique(vSegment.begin(), vSegment.end()), \
+		vSegment.end());
+}
+
+///
+/// @brief		append the interval of a segment between two parameters
+/// @param		nSegment [in] segment
+/// @param		s0 [in] first parameter (0: start sample)
+/// @param		s1 [in] last parameter (1: end sample)
+/// @param		vInterval [in/out] intervals (merged by MergeIntervals())
+/// @return		void
+///
+void CTrajectoryIndex::AddInterval(const unsigned nSegment, const double s0, \
+	const double s1, std::vector<STimeInterval>& vInterval) const
+{
+	const double t0 = m_pSamples[nSegment].time;
+	const double t1 = m_pSamples[SegmentEnd(m_pSamples, m_nSamples, \
+		nSegment)].time;
+
+	STimeInterval interval;
+	interval.begin = t0 + s0 * (t1 - t0);
+	interval.end = t0 + s1 * (t1 - t0);
+	vInterval.push_back(interval);
+}
+
+///
+/// @brief		merge intervals into their union
+/// @param		vInterval [in/out] intervals in any order; disjoint intervals
+///				in time order
+/// @return		void
+/// @remark		The tracked points of a segment (and the pieces of a point
+///				inside a polygon) give separate intervals; a gap between
+///				them is kept, touching or overlapping intervals are joined.
+///
+static void MergeIntervals(std::vector<STimeInterval>& vInterval)
+{
+	std::sort(vInterval.begin(), vInterval.end(), \
+		[](const STimeInterval& a, const STimeInterval& b)
+		{ return a.begin < b.begin; });
+
+	size_t n = 0;
+	for (size_t i = 0; i < vInterval.size(); ++i)
+	{
+		if (n > 0 && vInterval[i].begin <= vInterval[n - 1].end)
+			vInterval[n - 1].end = std::max(vInterval[n - 1].end, \
+				vInterval[i].end);
+		else
+			vInterval[n++] = vInterval[i];
+	}
+	vInterval.resize(n);
+}
+
+///
+/// @brief		get the time intervals within a distance of a point
+/// @param		x, y [in] point (m)
+/// @param		dRadius [in] distance (m)
+/// @param		vInterval [out] intervals when the robot point or a wheel was
+///				within dRadius of the point, in time order
+/// @return		0 on success, -1 if no index is opened or dRadius < 0
+///
+int CTrajectoryIndex::QueryRadius(const double x, const double y, \
+	const double dRadius, std::vector<STimeInterval>& vInterval) const
+{
+	vInterval.clear();
+	if (!m_pSamples || !(dRadius >= 0.))
+		return -1;
+
+	std::vector<unsigned> vSegment;
+	Collect(x - dRadius, y - dRadius, x + dRadius, y + dRadius, vSegment);
+
+	const double r2 = dRadius * dRadius;
+	for (size_t n = 0; n < vSegment.size(); ++n)
+	{
+		const unsigned i = vSegment[n];
+		const size_t j = SegmentEnd(m_pSamples, m_nSamples, i);
+
+		/// |a + s * d - p| <= r for s in [s0, s1] of each tracked point
+		for (int k = 0; k < TRAJ_POINTS; ++k)
+		{
+			const SPos a = SamplePoint(m_pSamples[i], k);
+			const SPos b = SamplePoint(m_pSamples[j], k);
+			const double dx = double(b.x) - a.x, dy = double(b.y) - a.y;
+			const double fx = double(a.x) - x, fy = double(a.y) - y;
+
+			const double qa = dx * dx + dy * dy;
+			const double qb = 2. * (fx * dx + fy * dy);
+			const double qc = fx * fx + fy * fy - r2;
+
+			double s0 = 0., s1 = 1.;
+			if (qa <= 0.)
+			{
+				if (qc > 0.)
+					continue;
+			}
+			else
+			{
+				const double dDisc = qb * qb - 4. * qa * qc;
+				if (dDisc < 0.)
+					continue;
+				const double dSqrt = sqrt(dDisc);
+				s0 = std::max(0., (-qb - dSqrt) / (2. * qa));
+				s1 = std::min(1., (-qb + dSqrt) / (2. * qa));
+				if (s0 > s1)
+					continue;
+			}
+
+			AddInterval(i, s0, s1, vInterval);
+		}
+	}
+
+	MergeIntervals(vInterval);
+
+	return 0;
+}
+
+///
+/// @brief		check whether a point is inside a polygon (even-odd rule)
+/// @param		vVertex [in] vertices of the polygon
+/// @param		x, y [in] point (m)
+/// @return		true if inside
+///
+static bool IsInside(const std::vector<SPos>& vVertex, const double x, \
+	const double y)
+{
+	bool bInside = false;
+
+	for (size_t i = 0, j = vVertex.size() - 1; i < vVertex.size(); j = i++)
+	{
+		const double xi = vVertex[i].x, yi = vVertex[i].y;
+		const double xj = vVertex[j].x, yj = vVertex[j].y;
+
+		if ((yi > y) != (yj > y) && \
+			x < (xj - xi) * (y - yi) / (yj - yi) + xi)
+			bInside = !bInside;
+	}
+
+	return bInside;
+}
+
+///
+/// @brief		get the time intervals inside a polygon
+/// @param		vVertex [in] vertices of the polygon (3 or more, any order)
+/// @param		vInterval [out] intervals when the robot point or a wheel was
+///				inside the polygon, in time order
+/// @return		0 on success, -1 if no index is opened or the polygon has
+///				less than 3 vertices
+/// @remark		each tracked point of a segment is split at its crossings of
+///				the edges, and each piece is tested at its middle; the
+///				pieces inside are kept apart (a concave polygon may be left
+///				and entered again within a segment)
+///
+int CTrajectoryIndex::QueryPolygon(const std::vector<SPos>& vVertex, \
+	std::vector<STimeInterval>& vInterval) const
+{
+	vInterval.clear();
+	if (!m_pSamples || vVertex.size() < 3)
+		return -1;
+
+	STrajBox box;
+	for (size_t v = 0; v < vVertex.size(); ++v)
+		box.Add(vVertex[v].x, vVertex[v].y);
+
+	std::vector<unsigned> vSegment;
+	Collect(box.x0, box.y0, box.x1, box.y1, vSegment);
+
+	std::vector<double> vParam;
+	for (size_t n = 0; n < vSegment.size(); ++n)
+	{
+		const unsigned i = vSegment[n];
+		const size_t j = SegmentEnd(m_pSamples, m_nSamples, i);
+
+		for (int k = 0; k < TRAJ_POINTS; ++k)
+		{
+			const SPos a = SamplePoint(m_pSamples[i], k);
+			const SPos b = SamplePoint(m_pSamples[j], k);
+			const double dx = double(b.x) - a.x, dy = double(b.y) - a.y;
+
+			/// parameters of the crossings of the edges
+			//@{
+			vParam.assign(1, 0.);
+			for (size_t e = 0, f = vVertex.size() - 1; e < vVertex.size(); \
+				f = e++)
+			{
+				const double ex = double(vVertex[e].x) - vVertex[f].x;
+				const double ey = double(vVertex[e].y) - vVertex[f].y;
+				const double dDenom = dx * ey - dy * ex;
+				if (dDenom == 0.)
+					continue;
+
+				const double px = double(vVertex[f].x) - a.x;
+				const double py = double(vVertex[f].y) - a.y;
+				const double s = (px * ey - py * ex) / dDenom;
+				const double u = (px * dy - py * dx) / dDenom;
+				if (s > 0. && s < 1. && u >= 0. && u <= 1.)
+					vParam.push_back(s);
+			}
+			vParam.push_back(1.);
+			std::sort(vParam.begin(), vParam.end());
+			//@}
+
+			for (size_t p = 0; p + 1 < vParam.size(); ++p)
+			{
+				const double s = 0.5 * (vParam[p] + vParam[p + 1]);
+				if (IsInside(vVertex, a.x + s * dx, a.y + s * dy))
+					AddInterval(i, vParam[p], vParam[p + 1], vInterval);
+			}
+		}
+	}
+
+	MergeIntervals(vInterval);
+
+	return 0;
+}
@@ -0,0 +1,211 @@
+///
+/// @file		TrajectoryIndex.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Spatial index over estimated trajectories ("when was the
+///				vehicle near P")
+///
+/// @remark		File layout (native little-endian byte order):
+///
+///				+------------------------------+ 0
+///				| STrajectoryIndexHeader       |
+///				+------------------------------+ sizeof(header)
+///				| STrajectorySample * N        | poses and wheel contours
+///				+------------------------------+ cell offset
+///				| unsigned long long * (C + 1) | first run of each cell
+///				+------------------------------+ run offset
+///				| STrajectoryRun * R           | runs of segments per cell
+///				+------------------------------+ end of file
+///
+///				Segment i joins sample i and sample i + 1 (a single point if
+///				sample i + 1 starts a new trajectory, TRAJ_SAMPLE_BREAK). The
+///				world is a uniform grid of square cells over the bounding box
+///				of the samples; a segment belongs to every cell that its
+///				bounding box overlaps. Consecutive segments of the same cell
+///				are stored as one run, so a vehicle standing or crossing a
+///				cell costs one entry, and the runs of a cell are in time order
+///				(compressed sparse rows: C + 1 offsets, then the runs).
+///
+///				A query looks up the cells of its bounding box and tests the
+///				segments of their runs exactly: the robot point and the three
+///				wheels move linearly between two samples, so the part of a
+///				segment near a point or inside a polygon is a set of exact
+///				sub-intervals of its time. The sub-intervals of all segments
+///				and points are merged into their union (the gaps between
+///				them are kept) and returned in time order. The file is
+///				mapped read-only, so a query needs neither a replay nor a
+///				load.
+///
+
+#ifndef _TRAJECTORY_INDEX_H_
+#define _TRAJECTORY_INDEX_H_
+
+#include <string>			// std::string
+#include <vector>			// std::vector
+
+#include "Pose.h"			// SPos, SPose
+#include "MappedFile.h"		// CMappedFile
+
+/// default size of a cell (m)
+#define TRAJ_INDEX_CELL_SIZE	(1.0)
+
+/// largest number of cells (the cells grow beyond it)
+#define TRAJ_INDEX_MAX_CELLS	(1 << 24)
+
+/// number of samples per task of the parallel build
+#define TRAJ_INDEX_TASK_SIZE	(65536)
+
+/// version of the file format
+#define TRAJ_INDEX_VERSION		(1)
+
+/// the sample starts a new trajectory (no segment from the previous one)
+#define TRAJ_SAMPLE_BREAK		(1U)
+
+/// type definition of a sample of a trajectory (48 bytes)
+typedef struct _tagSTrajectorySample
+{
+	double   time;		///< timestamp (unit: sec)
+	SPose    pose;		///< robot pose (x, y, heading)
+	SPos     posFW;		///< position of the front wheel
+	SPos     posLW;		///< position of the left wheel
+	SPos     posRW;		///< position of the right wheel
+	unsigned flags;		///< TRAJ_SAMPLE_BREAK
+} STrajectorySample;
+
+/// type definition of the file header (64 bytes)
+typedef struct _tagSTrajectoryIndexHeader
+{
+	char     magic[8];		///< "TRCTRAJ" + '\0'
+	unsigned version;		///< TRAJ_INDEX_VERSION
+	unsigned sampleSize;	///< sizeof(STrajectorySample)
+	double   cellSize;		///< size of a cell (m)
+	double   originX;		///< x of the corner of cell (0, 0) (m)
+	double   originY;		///< y of the corner of cell (0, 0) (m)
+	unsigned cols;			///< number of cells along x
+	unsigned rows;			///< number of cells along y
+	unsigned long long sampleCount;	///< number of samples
+	unsigned long long runCount;	///< number of runs
+} STrajectoryIndexHeader;
+
+/// type definition of a run of consecutive segments in a cell (8 bytes)
+typedef struct _tagSTrajectoryRun
+{
+	unsigned first;		///< first segment
+	unsigned count;		///< number of segments
+} STrajectoryRun;
+
+/// type definition of a time interval
+typedef struct _tagSTimeInterval
+{
+	double begin;		///< start (unit: sec)
+	double end;			///< end (unit: sec)
+} STimeInterval;
+
+/// @brief		Builder of the trajectory index (in memory, then a file)
+class CTrajectoryIndexWriter
+{
+public:
+	/// constructor
+	explicit CTrajectoryIndexWriter(const int nThreads = 0);
+
+	/// destructor
+	virtual ~CTrajectoryIndexWriter() {}
+
+	/// build the index of samples
+	int Build(const std::vector<STrajectorySample>& vSample, \
+		const double dCellSize = TRAJ_INDEX_CELL_SIZE);
+
+	/// write the built index to a file
+	int Write(const std::string& sFilename) const;
+
+	/// get the built index (the bytes of the file)
+	const std::vector<char>& GetImage() const { return m_vImage; }
+
+private:
+	/// non construction-copyable
+	CTrajectoryIndexWriter(const CTrajectoryIndexWriter&);
+
+	/// non copyable
+	const CTrajectoryIndexWriter& operator=(const CTrajectoryIndexWriter&);
+
+private:
+	/// number of worker threads (the caller included)
+	int m_nThreads;
+
+	/// header, samples, cell offsets and runs
+	std::vector<char> m_vImage;
+};
+
+/// @brief		Memory-mapped trajectory index
+class CTrajectoryIndex
+{
+public:
+	/// constructor
+	explicit CTrajectoryIndex();
+
+	/// destructor
+	virtual ~CTrajectoryIndex() {}
+
+	/// map an index file and validate it
+	int Open(const std::string& sFilename);
+
+	/// validate an index in a buffer kept by the caller
+	int Attach(const char* pData, const size_t nSize);
+
+	/// unmap the index file
+	void Close();
+
+	/// get the number of samples
+	size_t GetCount() const { return m_nSamples; }
+
+	/// get a sample
+	const STrajectorySample& GetSample(const size_t nIndex) const \
+		{ return m_pSamples[nIndex]; }
+
+	/// get the time intervals within a distance of a point
+	int QueryRadius(const double x, const double y, const double dRadius, \
+		std::vector<STimeInterval>& vInterval) const;
+
+	/// get the time intervals inside a polygon
+	int QueryPolygon(const std::vector<SPos>& vVertex, \
+		std::vector<STimeInterval>& vInterval) const;
+
+private:
+	/// get the segments of the cells overlapping a box
+	void Collect(const double x0, const double y0, const double x1, \
+		const double y1, std::vector<unsigned>& vSegment) const;
+
+	/// append the interval of a segment between two parameters
+	void AddInterval(const unsigned nSegment, const double s0, \
+		const double s1, std::vector<STimeInterval>& vInterval) const;
+
+private:
+	/// non construction-copyable
+	CTrajectoryIndex(const CTrajectoryIndex&);
+
+	/// non copyable
+	const CTrajectoryIndex& operator=(const CTrajectoryIndex&);
+
+private:
+	/// mapped index file (not opened after Attach())
+	CMappedFile m_file;
+
+	/// header of the index
+	STrajectoryIndexHeader m_header;
+
+	/// first sample
+	const STrajectorySample* m_pSamples;
+
+	/// number of samples
+	size_t m_nSamples;
+
+	/// first run of each cell (cols * rows + 1)
+	const unsigned long long* m_pCells;
+
+	/// first run
+	const STrajectoryRun* m_pRuns;
+};
+
+#endif // _TRAJECTORY_INDEX_H_
@@ -7,32 +7,115 @@
 /// @brief		Calculates odometry for the Tricycle-drive
 ///
 
+#include <cstring>			// strcmp
+
 #include "Tricycle.h"
 #include "VirtualGyro.h"	// CVirtualGyro
+#include "PoseShm.h"		// CPoseShmPublisher
+
+/// dispatch table of the chassis variants (the first one is the default)
+static const STricycleChassis s_chassis[] =
+{
+	TTricycle<SGeometryStandard>::MakeChassis("standard"),
+};
+
+/// names of the integrators (EIntegrator)
+static const char* s_szIntegrator[INTEGRATOR_COUNT] =
+{
+	"euler",
+	"midpoint",
+	"arc",
+	"rk4",
+};
 
 ///
-/// @brief		get positions of the front wheel and rear wheels
+/// @brief		default constructor (standard chassis)
+/// @param		N/A
+/// @return		N/A
 ///
-/// @param		posFW [out] position of the front wheel
-/// @param		posLW [out] position of the left wheel
-/// @param		posRW [out] position of the right wheel
+CTricycle::CTricycle()
+: m_pPublisher(0)
+, m_pChassis(&s_chassis[0])
+, m_nIntegrator(INTEGRATOR_EULER)
+, m_pfnEstimate(s_chassis[0].pfnEstimate)
+, m_pfnGetRobotContour(s_chassis[0].pfnGetRobotContour)
+, m_pfnDist2Ticks(s_chassis[0].pfnDist2Ticks)
+{
+}
+
 ///
-/// @return		void
+/// @brief		get the number of chassis variants
+/// @param		N/A
+/// @return		number of entries of the dispatch table
 ///
-void CTricycle::GetRobotContour(SPos& posFW, SPos& posLW, SPos& posRW)
+int CTricycle::GetChassisCount()
 {
-	/// distance between a rear wheel and robot center
-	float fDistRearWheelFromCenter = m_fDistBtwRearWheels / 2.f;
-
-	/// angle to calculate wheel position
-	float fAngle = DEG2RAD(90.f) - m_pose.q;
-
-	posFW.x = m_pose.x + m_fDistBtwFrontRear * cosf(m_pose.q);
-	posFW.y = m_pose.y + m_fDistBtwFrontRear * sinf(m_pose.q);
-	posLW.x = m_pose.x - fDistRearWheelFromCenter * cosf(fAngle);
-	posLW.y = m_pose.y + fDistRearWheelFromCenter * sinf(fAngle);
-	posRW.x = m_pose.x + fDistRearWheelFromCenter * cosf(fAngle);
-	posRW.y = m_pose.y - fDistRearWheelFromCenter * sinf(fAngle);
+	return int(sizeof(s_chassis) / sizeof(s_chassis[0]));
+}
+
+///
+/// @brief		get a chassis variant of the dispatch table
+/// @param		nIndex [in] index (0..GetChassisCount()-1)
+/// @return		chassis variant
+///
+const STricycleChassis& CTricycle::GetChassisAt(const int nIndex)
+{
+	return s_chassis[nIndex];
+}
+
+///
+/// @brief		select the chassis variant by name
+/// @param		szName [in] name of the chassis variant
+/// @return		0 on success, -1 if the name is unknown
+/// @remark		select before the first Estimate() call
+///
+int CTricycle::SetChassis(const char* szName)
+{
+	for (int i = 0; i < GetChassisCount(); ++i)
+	{
+		if (strcmp(s_chassis[i].szName, szName))
+			continue;
+
+		m_pChassis = &s_chassis[i];
+		m_pfnEstimate = m_pChassis->pfnEstimateBy[m_nIntegrator];
+		m_pfnGetRobotContour = m_pChassis->pfnGetRobotContour;
+		m_pfnDist2Ticks = m_pChassis->pfnDist2Ticks;
+		return 0;
+	}
+
+	return -1;
+}
+
+///
+/// @brief		get the name of an integrator
+/// @param		nIntegrator [in] integrator (EIntegrator)
+/// @return		name of the integrator
+///
+const char* CTricycle::GetIntegratorName(const int nIntegrator)
+{
+	return s_szIntegrator[nIntegrator];
+}
+
+///
+/// @brief		select the integrator by name
+/// @param		szName [in] name of the integrator (euler, midpoint, arc, rk4)
+/// @return		0 on success, -1 if the name is unknown
+/// @remark		select before the first Estimate() call; the selection is
+///				kept by SetChassis()
+///
+int CTricycle::SetIntegrator(const char* szName)
+{
+	for (int i = 0; i < INTEGRATOR_COUNT; ++i)
+	{
+		if (strcmp(s_szIntegrator[i], szName))
+			continue;
+
+		m_nIntegrator = i;
+		m_pfnEstimate = m_pChassis->pfnEstimateBy[i];
+		return 0;
+	}
+
+	return -1;
 }
 
 ///
@@ -49,64 +132,111 @@ void CTricycle::GetRobotContour(SPos& posFW, SPos& posLW, SPos& posRW)
 /// @return		new estimated pose. Tuple (x, y, heading) representing the
 ///				estimated pose of the platform (unit: m, m, rad)
 ///
+/// @remark		the angular velocity is taken from CVirtualGyro, and the pose
+///				is added to the pose history (GetRobotPoseAt()). The float
+///				time is converted to nanoseconds (EstimateNs()).
+///
 SPose CTricycle::Estimate(float time, float steering_angle, int encoder_ticks, \
 	float angular_velocity)
 {
-	// Front wheel radius = 0.2 m
-	// Back wheels radius = 0.2 m
-	// Distance from front wheel to back axis (r) = 1m
-	// Distance between rear wheels (d) = 0.75m
-	// Front wheel encoder = 512 ticks per revolution
-
-	// circumference of a wheel:
-	//     2 * M_PI * 0.2 = 0.4 * M_PI = 1.2566370614359172953850573533118f (m)
-	// distance per tick:
-	//     (0.4 * M_PI) / 512 = 0.00245436926061702596754894014319 (m/pulse)
-
-	/// previous timestamp (sec)
-	static float fPrevTime = 0.f;
-
-	/// time difference since previous time
-	float fDiffTime = time - fPrevTime;
+	return EstimateNs(Sec2Ns(time), steering_angle, encoder_ticks, \
+		angular_velocity);
+}
 
-	/// distance of the front steering wheel
-	float fFrontWheelDist = encoder_ticks * m_fFrontDistPerTick;
+///
+/// @brief		pose estimator with a timestamp in nanoseconds
+///
+/// @param		nTimeNs [in] time of reading of the input data (unit: ns)
+/// @param		steering_angle [in] steering wheel angle (unit: rad)
+/// @param		encoder_ticks [in] number of ticks from the traction motor
+///				encoder (unit: ticks (integer))
+/// @param		angular_velocity [in] not used (taken from CVirtualGyro)
+///
+/// @return		new estimated pose (x, y, heading) (unit: m, m, rad)
+///
+/// @remark		Time differences are exact, so a process may run for days
+///				(SRecord::time_ns). Pair with CVirtualGyro::UpdateNs(). The
+///				pose and contour are published by SetPublisher()'s publisher.
+///
+SPose CTricycle::EstimateNs(const long long nTimeNs, \
+	const float steering_angle, const int encoder_ticks, \
+	float angular_velocity)
+{
+	/// get the angular velocity from gyro (rad/s)
+	float fW = CVirtualGyro::GetInstance()->GetAngVel();
 
-	/// front wheel velocity (m/s)
-	//@{
-	float fFrontWheelVel = 0.f;
-	if (!almostZero(fDiffTime))	///< prevent divide by zero
-		fFrontWheelVel = fFrontWheelDist / fDiffTime;
-	//@}
+	/// estimate, record and publish the pose
+	const SPose pose = m_pfnEstimate(m_state, nTimeNs, steering_angle, \
+		encoder_ticks, fW);
+	Commit(nTimeNs, pose);
 
-	/// angle difference (rad)
-	/*float fDiffQ = (fFrontWheelVel / m_fDistBtwFrontRear) \
-		* sinf(steering_angle);*/
+	return pose;
+}
 
-	/// get the angular velocity from gyro (rad/s)
-	float fW = CVirtualGyro::GetInstance()->GetAngVel();
+///
+/// @brief		update CVirtualGyro with a record and estimate the pose
+///
+/// @param		record [in] input record (time_ns, steering, ticks)
+///
+/// @return		new estimated pose (x, y, heading) (unit: m, m, rad)
+///
+/// @remark		CVirtualGyro::UpdateNs() and EstimateNs() of the record, so
+///				the error model of the gyro applies; record.angular_velocity
+///				is not used
+///
+SPose CTricycle::Step(const SRecord& record)
+{
+	CVirtualGyro::GetInstance()->UpdateNs(record.time_ns, \
+		record.steering_angle, record.encoder_ticks);
 
-	/// consider time difference
-	m_pose.q += fW * fDiffTime;
+	return EstimateNs(record.time_ns, record.steering_angle, \
+		record.encoder_ticks, record.angular_velocity);
+}
 
-	/// clamp angle
-	m_pose.q = AngleClamp(m_pose.q);
+///
+/// @brief		get the state of the estimator
+/// @param		N/A
+/// @return		pose state of this object and state of CVirtualGyro
+///
+SEstimatorState CTricycle::GetState() const
+{
+	SEstimatorState state;
+	state.pose = m_state;
+	state.gyro = CVirtualGyro::GetInstance()->GetState();
 
-	/// differences of robot position (x, y)
-	float fDiffX = (fFrontWheelVel * fDiffTime) * cosf(steering_angle) \
-		* cosf(m_pose.q);
-	float fDiffY = (fFrontWheelVel * fDiffTime) * cosf(steering_angle) \
-		* sinf(m_pose.q);
+	return state;
+}
 
-	/// update the robot pose
-	m_pose.x += fDiffX;
-	m_pose.y += fDiffY;
+///
+/// @brief		restore a state of the estimator
+/// @param		state [in] pose state and state of CVirtualGyro
+/// @return		void
+///
+void CTricycle::SetState(const SEstimatorState& state)
+{
+	m_state = state.pose;
+	CVirtualGyro::GetInstance()->SetState(state.gyro);
+}
 
-	/// update timestamp for the next time
-	fPrevTime = time;
+///
+/// @brief		add an estimated pose to the history and publish it
+/// @param		nTimeNs [in] time of the pose (ns)
+/// @param		pose [in] estimated pose
+/// @return		void
+///
+void CTricycle::Commit(const long long nTimeNs, const SPose& pose)
+{
+	m_history.Push(Ns2Sec(nTimeNs), pose);
 
-	/// return robot pose (x, y, heading)
-	return m_pose;
+	/// publish the pose and contour to local consumers
+	if (m_pPublisher)
+	{
+		SPoseLogRecord record;
+		record.time = Ns2Sec(nTimeNs);
+		record.pose = pose;
+		m_pfnGetRobotContour(pose, record.posFW, record.posLW, record.posRW);
+		m_pPublisher->Publish(record);
+	}
 }
 
 ///
@@ -123,6 +253,10 @@ SPose CTricycle::Estimate(float time, float steering_angle, int encoder_ticks, \
 /// @return		new estimated pose. Tuple (x, y, heading) representing the
 ///				estimated pose of the platform (unit: m, m, rad)
 ///
+/// @remark		CTricycle::Estimate() of the singleton: the angular velocity
+///				is taken from CVirtualGyro (with its error model), which the
+///				caller updates with the same record first
+///
 SPose estimate(float time, float steering_angle, int encoder_ticks, \
 	float angular_velocity)
 {
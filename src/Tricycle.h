@@ -12,7 +12,7 @@
 
 #include <iostream>		// std::cout
 #include <fstream>		// std::ofstream
-#include <cmath>		// sinf, cosf
+#include <cmath>		// std::cos, std::sin, std::fabs, floorf
 #include <cstdio>		// _popen, _pclose, fprintf
 
 #if defined(WIN32)
@@ -22,64 +22,448 @@
 
 #include "Singleton.h"	// TSingleton
 #include "Pose.h"		// SPos, SPose
-#include "math2.h"		// M_PI
+#include "math2.h"		// M_PI, AngleClamp, SinCos, KahanAdd, Ns2Sec
 
-/// PLATFORM DEPENDENT VARIABLES
-//@{
-/// front wheel radius (unit: m)
-#define FRONT_WHEEL_RADIUS		(0.2f)
+#include "TricycleGeometry.h"	// SGeometryStandard, ...
+#include "PoseHistory.h"	// CPoseHistory
+#include "GyroState.h"		// SGyroState, GyroStep
+#include "Record.h"			// SRecord
+
+class CPoseShmPublisher;
+
+/// @brief		integration scheme of the pose over a sample interval
+///
+/// @remark		Every scheme holds the steering angle of the record over the
+///				interval. With steady steering, arc and RK4 polling every 5th
+///				record stay below Euler at the full rate (tricycle_bench
+///				checks it). When the steering changes between polls, that
+///				held steering dominates the error: the higher orders gain
+///				little, and MIDPOINT can be worse than EULER (e.g. a slalom
+///				polled every 5th record).
+///
+enum EIntegrator
+{
+	INTEGRATOR_EULER = 0,	///< heading first, then along the new heading
+	INTEGRATOR_MIDPOINT,	///< along the heading at the middle of interval
+	INTEGRATOR_ARC,			///< exact constant-curvature arc
+	INTEGRATOR_RK4,			///< 4th-order Runge-Kutta (Simpson's rule)
+	INTEGRATOR_COUNT		///< number of integrators
+};
+
+/// @brief		State of a pose estimator over a scalar type (float or double)
+///
+/// @remark		The position is integrated with Kahan compensation (fErrX,
+///				fErrY), so the rounding error does not grow with the number
+///				of records. The timestamp is an integer in nanoseconds, so a
+///				time difference is exact whatever the run time is.
+///
+template<typename T>
+struct TTricycleState
+{
+	TPose<T> pose;			///< current robot pose
+	T fErrX;				///< compensation of pose.x (Kahan)
+	T fErrY;				///< compensation of pose.y (Kahan)
+	long long nPrevTimeNs;	///< previous timestamp (ns)
 
-/// rear wheel radius (unit: m) - not used
-#define REAR_WHEEL_RADIUS		(0.2f)
+	/// default constructor
+	TTricycleState() : fErrX(T(0)), fErrY(T(0)), nPrevTimeNs(0) {}
+};
 
-/// distance from front wheel to back axis (r) (unit: m)
-#define DIST_BTW_FRONT_REAR		(1.f)
+/// type definition of the state of a pose estimator
+typedef TTricycleState<float> STricycleState;
 
-/// distance between rear wheel (d) (unit: meter) - used for drawing
-#define DIST_BTW_REAR_WHEELS	(0.75f)
+/// @brief		State of an estimator with its virtual gyro (value type)
+///
+/// @remark		Step() reads nothing but its arguments (no singleton, no
+///				static variable), so a state can be copied (checkpoint),
+///				reset (assign a default state) and owned by any thread
+///				without locking.
+///
+typedef struct _tagSEstimatorState
+{
+	STricycleState pose;	///< pose, compensations and previous timestamp
+	SGyroState gyro;		///< noise-free virtual gyro
+} SEstimatorState;
 
-/// number of ticks per revolution of the front wheel
-#define TICKS_PER_REVOLUTION	(512)
+/// type definition of a chassis variant (entry of the dispatch table)
+typedef struct _tagSTricycleChassis
+{
+	/// name of the chassis variant
+	const char* szName;
+
+	/// geometry (copied from the policy for drawing and the virtual gyro)
+	//@{
+	float fFrontWheelRadius;	///< front wheel radius (m)
+	float fDistBtwFrontRear;	///< distance from front wheel to back axis (m)
+	float fDistBtwRearWheels;	///< distance between rear wheels (m)
+	int   nTicksPerRevolution;	///< ticks per revolution of the front wheel
+	float fFrontDistPerTick;	///< distance per a tick of the front wheel (m)
+	//@}
+
+	/// pose estimator of the variant
+	SPose (*pfnEstimate)(STricycleState& state, const long long nTimeNs, \
+		const float steering_angle, const int encoder_ticks, \
+		const float angular_velocity);
+
+	/// pose estimators of the variant by integrator (EIntegrator)
+	SPose (*pfnEstimateBy[INTEGRATOR_COUNT])(STricycleState& state, \
+		const long long nTimeNs, const float steering_angle, \
+		const int encoder_ticks, const float angular_velocity);
+
+	/// pose estimator of the variant in double
+	SPoseD (*pfnEstimateD)(TTricycleState<double>& state, \
+		const long long nTimeNs, const double steering_angle, \
+		const int encoder_ticks, const double angular_velocity);
+
+	/// contour of the front wheel and rear wheels of the variant
+	void (*pfnGetRobotContour)(const SPose& pose, SPos& posFW, SPos& posLW, \
+		SPos& posRW);
+
+	/// front wheel distance to the number of encoder ticks of the variant
+	int (*pfnDist2Ticks)(const float fDist);
+} STricycleChassis;
+
+/// @brief		Pose estimator of a chassis variant with compile-time geometry
+template<typename TGeometry>
+class TTricycle
+{
+public:
+	/// geometry of the variant
+	typedef TGeometry Geometry;
+
+	/// circumference of the front steering wheel (m)
+	static constexpr float fFrontWheelCircum = \
+		float(2.f * M_PI * TGeometry::fFrontWheelRadius);
+
+	/// distance per a tick of the front wheel (m/tick)
+	static constexpr float fFrontDistPerTick = \
+		fFrontWheelCircum / TGeometry::nTicksPerRevolution;
+
+	/// convert front wheel distance to the number of encoder ticks
+	static int Dist2Ticks(const float fDist)
+	{
+		return int(floorf(fDist / fFrontDistPerTick + 0.5f));
+	}
+
+	/// get the contour of the front wheel and rear wheels
+	static void GetRobotContour(const SPose& pose, SPos& posFW, SPos& posLW, \
+		SPos& posRW);
+
+	/// pose estimator (T: float or double, nIntegrator: EIntegrator)
+	template<typename T, int nIntegrator = INTEGRATOR_EULER>
+	static TPose<T> Estimate(TTricycleState<T>& state, \
+		const long long nTimeNs, const T steering_angle, \
+		const int encoder_ticks, const T angular_velocity);
+
+	/// make the dispatch table entry of the variant
+	static STricycleChassis MakeChassis(const char* szName);
+
+private:
+	/// not constructible (static members only)
+	TTricycle();
+};
+
+/// out-of-class definitions of the derived constants
+//@{
+template<typename TGeometry>
+constexpr float TTricycle<TGeometry>::fFrontWheelCircum;
+template<typename TGeometry>
+constexpr float TTricycle<TGeometry>::fFrontDistPerTick;
 //@}
 
+///
+/// @brief		get positions of the front wheel and rear wheels
+///
+/// @param		pose [in] robot pose
+/// @param		posFW [out] position of the front wheel
+/// @param		posLW [out] position of the left wheel
+/// @param		posRW [out] position of the right wheel
+///
+/// @return		void
+///
+template<typename TGeometry> inline
+void TTricycle<TGeometry>::GetRobotContour(const SPose& pose, SPos& posFW, \
+	SPos& posLW, SPos& posRW)
+{
+	/// distance between a rear wheel and robot center
+	const float fDistRearWheelFromCenter = TGeometry::fDistBtwRearWheels / 2.f;
+
+	/// angle to calculate wheel position
+	float fAngle = DEG2RAD(90.f) - pose.q;
+
+	/// sine and cosine of both angles (one range reduction per angle)
+	float fSinQ, fCosQ, fSinAngle, fCosAngle;
+	SinCos(pose.q, fSinQ, fCosQ);
+	SinCos(fAngle, fSinAngle, fCosAngle);
+
+	posFW.x = pose.x + TGeometry::fDistBtwFrontRear * fCosQ;
+	posFW.y = pose.y + TGeometry::fDistBtwFrontRear * fSinQ;
+	posLW.x = pose.x - fDistRearWheelFromCenter * fCosAngle;
+	posLW.y = pose.y + fDistRearWheelFromCenter * fSinAngle;
+	posRW.x = pose.x + fDistRearWheelFromCenter * fCosAngle;
+	posRW.y = pose.y - fDistRearWheelFromCenter * fSinAngle;
+}
+
+///
+/// @brief		pose estimator of the variant
+///
+/// @param		state [in/out] pose, compensations and previous timestamp
+/// @param		nTimeNs [in] time of reading of the input data (unit: ns)
+/// @param		steering_angle [in] steering wheel angle (unit: rad)
+/// @param		encoder_ticks [in] number of ticks from the traction motor
+///				encoder (unit: ticks (integer))
+/// @param		angular_velocity [in] angular velocity of the platform around
+///				the Z axis (unit: rad/s)
+///
+/// @return		new estimated pose (x, y, heading) (unit: m, m, rad)
+///
+/// @remark		The inputs are constant over the interval, so the robot moves
+///				on an arc. EULER moves along the new heading (error O(dt)),
+///				MIDPOINT along the heading at the middle of the interval and
+///				RK4 weights the start, middle and end headings 1:4:1 (both
+///				O(dt^2) or better); ARC follows the arc exactly, with its
+///				chord of length sinc(dq / 2) along the middle heading.
+///
+template<typename TGeometry>
+template<typename T, int nIntegrator> inline
+TPose<T> TTricycle<TGeometry>::Estimate(TTricycleState<T>& state, \
+	const long long nTimeNs, const T steering_angle, const int encoder_ticks, \
+	const T angular_velocity)
+{
+	/// time difference since previous time (exact in nanoseconds)
+	T fDiffTime = T(Ns2Sec(nTimeNs - state.nPrevTimeNs));
+
+	/// update timestamp for the next time (stored apart from the pose, so
+	/// that the next call does not wait for the pose computation)
+	state.nPrevTimeNs = nTimeNs;
+
+	/// distance of the front steering wheel
+	T fFrontWheelDist = encoder_ticks * T(fFrontDistPerTick);
+
+	/// front wheel velocity (m/s)
+	//@{
+	T fFrontWheelVel = T(0);
+	if (!almostZero(fDiffTime))	///< prevent divide by zero
+		fFrontWheelVel = fFrontWheelDist / fDiffTime;
+	//@}
+
+	/// heading at the beginning and change of heading over the interval
+	const T fPrevQ = state.pose.q;
+	const T fDiffQ = angular_velocity * fDiffTime;
+
+	/// consider time difference
+	state.pose.q += fDiffQ;
+
+	/// clamp angle
+	state.pose.q = AngleClamp(state.pose.q);
+
+	/// distance travelled along the heading
+	const T fDist = (fFrontWheelVel * fDiffTime) * std::cos(steering_angle);
+
+	/// cosine and sine of the heading, weighted over the interval
+	T fSinQ, fCosQ;
+	if (nIntegrator == INTEGRATOR_EULER)
+	{
+		SinCos(state.pose.q, fSinQ, fCosQ);
+	}
+	else if (nIntegrator == INTEGRATOR_MIDPOINT)
+	{
+		SinCos(fPrevQ + fDiffQ / T(2), fSinQ, fCosQ);
+	}
+	else if (nIntegrator == INTEGRATOR_ARC)
+	{
+		/// sinc(dq / 2), by its series near zero (straight motion)
+		const T h = fDiffQ / T(2);
+		const T fSinc = (std::fabs(h) < T(1e-3)) ? T(1) - h * h / T(6) \
+			: std::sin(h) / h;
+
+		SinCos(fPrevQ + h, fSinQ, fCosQ);
+		fSinQ *= fSinc;
+		fCosQ *= fSinc;
+	}
+	else
+	{
+		/// dx/dt = v cos(q(t)) with q(t) linear in t: k2 = k3 at the middle
+		T fSin0, fCos0, fSinM, fCosM, fSin1, fCos1;
+		SinCos(fPrevQ, fSin0, fCos0);
+		SinCos(fPrevQ + fDiffQ / T(2), fSinM, fCosM);
+		SinCos(fPrevQ + fDiffQ, fSin1, fCos1);
+
+		fSinQ = (fSin0 + T(4) * fSinM + fSin1) / T(6);
+		fCosQ = (fCos0 + T(4) * fCosM + fCos1) / T(6);
+	}
+
+	/// differences of robot position (x, y)
+	T fDiffX = fDist * fCosQ;
+	T fDiffY = fDist * fSinQ;
+
+	/// update the robot pose (compensated sums)
+	KahanAdd(state.pose.x, state.fErrX, fDiffX);
+	KahanAdd(state.pose.y, state.fErrY, fDiffY);
+
+	/// return robot pose (x, y, heading)
+	return state.pose;
+}
+
+///
+/// @brief		make the dispatch table entry of the variant
+/// @param		szName [in] name of the chassis variant
+/// @return		dispatch table entry
+///
+template<typename TGeometry>
+STricycleChassis TTricycle<TGeometry>::MakeChassis(const char* szName)
+{
+	STricycleChassis chassis;
+
+	chassis.szName = szName;
+	chassis.fFrontWheelRadius = TGeometry::fFrontWheelRadius;
+	chassis.fDistBtwFrontRear = TGeometry::fDistBtwFrontRear;
+	chassis.fDistBtwRearWheels = TGeometry::fDistBtwRearWheels;
+	chassis.nTicksPerRevolution = TGeometry::nTicksPerRevolution;
+	chassis.fFrontDistPerTick = fFrontDistPerTick;
+	chassis.pfnEstimate = &Estimate<float>;
+	chassis.pfnEstimateBy[INTEGRATOR_EULER] = \
+		&Estimate<float, INTEGRATOR_EULER>;
+	chassis.pfnEstimateBy[INTEGRATOR_MIDPOINT] = \
+		&Estimate<float, INTEGRATOR_MIDPOINT>;
+	chassis.pfnEstimateBy[INTEGRATOR_ARC] = &Estimate<float, INTEGRATOR_ARC>;
+	chassis.pfnEstimateBy[INTEGRATOR_RK4] = &Estimate<float, INTEGRATOR_RK4>;
+	chassis.pfnEstimateD = &Estimate<double>;
+	chassis.pfnGetRobotContour = &GetRobotContour;
+	chassis.pfnDist2Ticks = &Dist2Ticks;
+
+	return chassis;
+}
+
+///
+/// @brief		estimate the pose of a record (compile-time geometry)
+/// @param		state [in/out] state of the estimator
+/// @param		record [in] input record (time_ns, steering, ticks)
+/// @return		new estimated pose (x, y, heading) (unit: m, m, rad)
+/// @remark		the gyro and the integrator inline into the caller's loop
+///
+template<typename TGeometry, int nIntegrator = INTEGRATOR_EULER> inline
+SPose Step(SEstimatorState& state, const SRecord& record)
+{
+	GyroStep(state.gyro, TTricycle<TGeometry>::fFrontDistPerTick, \
+		TGeometry::fDistBtwFrontRear, record.time_ns, record.steering_angle, \
+		record.encoder_ticks);
+
+	return TTricycle<TGeometry>::template Estimate<float, nIntegrator>( \
+		state.pose, record.time_ns, record.steering_angle, \
+		record.encoder_ticks, state.gyro.fAngVel);
+}
+
+///
+/// @brief		estimate the pose of a record (runtime chassis)
+/// @param		chassis [in] chassis variant (CTricycle::GetChassisAt())
+/// @param		nIntegrator [in] integrator (EIntegrator)
+/// @param		state [in/out] state of the estimator
+/// @param		record [in] input record (time_ns, steering, ticks)
+/// @return		new estimated pose (x, y, heading) (unit: m, m, rad)
+/// @remark		one indirect call to the integrator of the chassis
+///
+inline SPose Step(const STricycleChassis& chassis, const int nIntegrator, \
+	SEstimatorState& state, const SRecord& record)
+{
+	GyroStep(state.gyro, chassis.fFrontDistPerTick, chassis.fDistBtwFrontRear, \
+		record.time_ns, record.steering_angle, record.encoder_ticks);
+
+	return chassis.pfnEstimateBy[nIntegrator](state.pose, record.time_ns, \
+		record.steering_angle, record.encoder_ticks, state.gyro.fAngVel);
+}
+
 /// @brief		Pose estimator class for the Tricycle mobile robot
+///
+/// @remark		The chassis variant is selected at runtime with SetChassis().
+///				The selection copies the function pointers of the variant, so
+///				a call costs one indirect call and never tests the variant.
+///				Hot loops may use TTricycle<TGeometry> directly to inline the
+///				kernel.
+///
+///				The gyro of the object is CVirtualGyro (with its error
+///				model): EstimateNs() reads it after the caller's UpdateNs(),
+///				and Step() does both, so the two may be mixed record by
+///				record. The angular_velocity arguments are not used.
+///
 class CTricycle : public TSingleton<CTricycle>
 {
 public:
-	/// default constructor
-	explicit CTricycle()
-	: m_fFrontWheelRadius(FRONT_WHEEL_RADIUS)
-	, m_fDistBtwFrontRear(DIST_BTW_FRONT_REAR)
-	, m_fDistBtwRearWheels(DIST_BTW_REAR_WHEELS)
-	, m_nTicksPerRevolution(TICKS_PER_REVOLUTION)
-	, m_fFrontWheelCircum(2.f * M_PI * m_fFrontWheelRadius)
-	, m_fFrontDistPerTick(m_fFrontWheelCircum / m_nTicksPerRevolution) {}
+	/// default constructor (standard chassis)
+	explicit CTricycle();
 
 	/// default destructor
 	virtual ~CTricycle() {}
 
+	/// get the number of chassis variants
+	static int GetChassisCount();
+
+	/// get a chassis variant of the dispatch table
+	static const STricycleChassis& GetChassisAt(const int nIndex);
+
+	/// select the chassis variant by name
+	int SetChassis(const char* szName);
+
+	/// get the selected chassis variant
+	const STricycleChassis& GetChassis() const { return *m_pChassis; }
+
+	/// get the name of an integrator (EIntegrator)
+	static const char* GetIntegratorName(const int nIntegrator);
+
+	/// select the integrator by name (euler, midpoint, arc, rk4)
+	int SetIntegrator(const char* szName);
+
+	/// get the selected integrator (EIntegrator)
+	int GetIntegrator() const { return m_nIntegrator; }
+
 	/// convert front wheel distance to the number of encoder ticks
-	static int Dist2Ticks(const float fDist, const float fTimeGap = 1.f)
-	{
-		return int(fDist * TICKS_PER_REVOLUTION);
-	}
+	int Dist2Ticks(const float fDist) const { return m_pfnDist2Ticks(fDist); }
 
 	/// get the distance from front wheel to back axis (m)
-	float GetDistBtwFrontRear() { return m_fDistBtwFrontRear; }
+	float GetDistBtwFrontRear() { return m_pChassis->fDistBtwFrontRear; }
 
 	/// get the distance per a tick of the front wheel (m/tick)
-	float GetFrontDistPerTick() { return m_fFrontDistPerTick; }
+	float GetFrontDistPerTick() { return m_pChassis->fFrontDistPerTick; }
 
 	/// get the robot pose
-	void GetRobotPose(SPose& pose) { pose = m_pose; }
+	void GetRobotPose(SPose& pose) { pose = m_state.pose; }
+
+	/// get the robot pose at a past timestamp (any thread, wait-free)
+	int GetRobotPoseAt(const double time, SPose& pose) const
+	{
+		return m_history.Query(time, pose);
+	}
+
+	/// get the history of estimated poses
+	const CPoseHistory& GetHistory() const { return m_history; }
+
+	/// publish each estimated pose and contour (0: stop publishing)
+	void SetPublisher(CPoseShmPublisher* pPublisher) \
+		{ m_pPublisher = pPublisher; }
 
 	/// get the contour of the front wheel and rear wheels
-	void GetRobotContour(SPos& posFW, SPos& posLW, SPos& posRW);
+	void GetRobotContour(SPos& posFW, SPos& posLW, SPos& posRW)
+	{
+		m_pfnGetRobotContour(m_state.pose, posFW, posLW, posRW);
+	}
 
 	/// pose estimator
 	SPose Estimate(const float time, const float steering_angle, \
 		const int encoder_ticks, float angular_velocity);
 
+	/// pose estimator with a timestamp in nanoseconds (long runs)
+	SPose EstimateNs(const long long nTimeNs, const float steering_angle, \
+		const int encoder_ticks, float angular_velocity);
+
+	/// update CVirtualGyro with a record and estimate the pose
+	SPose Step(const SRecord& record);
+
+	/// get the state of the estimator (CVirtualGyro included)
+	SEstimatorState GetState() const;
+
+	/// restore a state of the estimator (e.g. a default state to reset)
+	void SetState(const SEstimatorState& state);
+
 private:
 	/// non construction-copyable
 	CTricycle(const CTricycle&);
@@ -88,26 +472,33 @@ private:
 	const CTricycle& operator=(const CTricycle&);
 
 private:
-	/// current robot pose
-	SPose m_pose;
+	/// add an estimated pose to the history and publish it
+	void Commit(const long long nTimeNs, const SPose& pose);
 
-	/// front wheel radius (m)
-	const float m_fFrontWheelRadius;
+private:
+	/// current robot pose, compensations and previous timestamp (the gyro
+	/// is CVirtualGyro)
+	STricycleState m_state;
 
-	/// distance from front wheel to back axis (m)
-	const float m_fDistBtwFrontRear;
+	/// history of estimated poses (filled by Estimate())
+	CPoseHistory m_history;
 
-	/// distance between rear wheel (d) (unit: meter)
-	const float m_fDistBtwRearWheels;
+	/// publisher of live poses (not owned, 0: none)
+	CPoseShmPublisher* m_pPublisher;
 
-	/// number of ticks per revolution of the front wheel
-	const int   m_nTicksPerRevolution;
+	/// selected chassis variant
+	const STricycleChassis* m_pChassis;
 
-	/// circumference of the front steering wheel (m)
-	const float m_fFrontWheelCircum;
+	/// selected integrator (EIntegrator)
+	int m_nIntegrator;
 
-	/// distance per a tick of the front wheel
-	const float m_fFrontDistPerTick;
+	/// functions of the selected chassis variant
+	//@{
+	SPose (*m_pfnEstimate)(STricycleState&, const long long, const float, \
+		const int, const float);
+	void (*m_pfnGetRobotContour)(const SPose&, SPos&, SPos&, SPos&);
+	int (*m_pfnDist2Ticks)(const float);
+	//@}
 };
 
 /// Pose estimator interface function for the Tricycle mobile robot
@@ -0,0 +1,3576 @@
+///
+/// @file		TricycleBench.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Microbenchmarks of the pose estimator (tricycle_bench)
+///
+/// @remark		Runs every benchmark on synthetic inputs of 1e3, 1e4, ...
+///				records and prints ns/record (p50, p99) and throughput as
+///				JSON. Per-record kernels are timed in batches of records;
+///				file operations are timed per repetition.
+///
+
+#include <algorithm>		// std::sort, std::min, std::max
+#include <chrono>			// std::chrono::steady_clock
+#include <cfloat>			// FLT_EPSILON
+#include <cmath>			// ceil, sin, sqrt, nextafter
+#include <cstdio>			// fprintf, snprintf, remove
+#include <cstdlib>			// atof, strtod
+#include <cstring>			// strcmp, strstr, memcmp, strspn
+#include <iostream>			// std::cerr
+#include <string>			// std::string
+#include <thread>			// std::thread
+#include <vector>			// std::vector
+
+#include "Tricycle.h"		// CTricycle
+#include "VirtualGyro.h"	// CVirtualGyro
+#include "FleetTricycle.h"	// CFleetTricycle
+#include "EkfTricycle.h"	// CEkfTricycle
+#include "PoseHistory.h"	// CPoseHistory
+#include "TestTricycle.h"	// CTestTricycle
+#include "math2.h"			// AngleClampN, SinCosN
+#include "Random.h"			// CRandom
+#include "MappedFile.h"		// CMappedFile
+#include "RecordParser.h"	// ParseRecords
+#include "RecordArchive.h"	// CRecordArchiveWriter
+#include "PoseShm.h"		// CPoseShmPublisher, CPoseShmSubscriber
+#include "FixedTricycle.h"	// FixedStep, MakeFixedChassis
+#include "EstimatorJournal.h"	// CEstimatorJournal
+#include "TrajectoryIndex.h"	// CTrajectoryIndexWriter, CTrajectoryIndex
+#include "PoseGraph.h"		// CPoseGraph
+#include "ParallelReplay.h"	// CParallelReplay
+#include "PoseLog.h"		// SPoseLogRecord, CPoseLogReader
+#include "RecordFormat.h"	// FormatFixed6
+#include "BatchRunner.h"	// CBatchRunner
+#include "OdometryServer.h"	// COdometryServer, COdometryClient
+
+#if defined(__linux__)
+#	include <fcntl.h>		// open
+#	include <signal.h>		// kill, SIGTERM
+#	include <sys/stat.h>	// mkfifo
+#	include <sys/wait.h>	// waitpid
+#	include <unistd.h>		// fork, dup, dup2, usleep
+#endif
+
+#if defined(_MSC_VER)
+#	include <intrin.h>		// __rdtsc
+#elif defined(__x86_64__) || defined(__i386__)
+#	include <x86intrin.h>	// __rdtsc
+#endif
+
+/// minimum number of timing samples per benchmark
+#define BENCH_MIN_SAMPLES	(100)
+
+/// number of records per timing sample of the per-record kernels
+#define BENCH_BATCH_SIZE	(1024)
+
+/// number of vehicles of the fleet benchmark
+#define BENCH_FLEET_SIZE	(256)
+
+/// number of angles per call of the array kernel benchmarks
+#define BENCH_ARRAY_SIZE	(256)
+
+/// number of records of the synthetic accuracy scenarios (100 Hz)
+#define BENCH_SCENARIO_SIZE	(10000)
+
+/// decimation of the accuracy check (input records per estimator step)
+#define BENCH_ACCURACY_DECIMATION	(5)
+
+/// rounding of the float positions of the accuracy check (m)
+#define BENCH_ACCURACY_EPS		(1e-6)
+
+/// largest position deviation of the fixed-point estimator from double (m)
+#define BENCH_FIXED_MAX_POS		(1e-3)
+
+/// largest heading deviation of the fixed-point estimator from double (rad)
+#define BENCH_FIXED_MAX_Q		(1e-4)
+
+/// largest distance of a corrected record from the last one (records)
+#define BENCH_JOURNAL_MAX_LAG	(1000)
+
+/// number of records between two corrections of the journal check
+#define BENCH_JOURNAL_PERIOD	(100)
+
+/// radius of the queries of the trajectory index benchmark (m)
+#define BENCH_INDEX_RADIUS		(0.5)
+
+/// number of queries checked against a scan of all segments
+#define BENCH_INDEX_CHECKS		(16)
+
+/// parameters per segment of the brute-force reference of the index check
+#define BENCH_INDEX_STEPS		(64)
+
+/// times this close to an interval boundary are not checked (sec)
+#define BENCH_INDEX_TIME_EPS	(1e-6)
+
+/// records replayed per estimator mode and scenario of the golden check
+#define BENCH_GOLDEN_RECORDS	(1000000)
+
+/// points of a contour block of NN_contour.txt (robot, LW, FW, RW, robot)
+#define BENCH_GOLDEN_CONTOUR	(5)
+
+/// nodes between two absolute fixes of the pose-graph benchmark
+#define BENCH_GRAPH_FIX_PERIOD	(10000)
+
+/// nodes between two loop closures of the pose-graph benchmark
+#define BENCH_GRAPH_LOOP_PERIOD	(5000)
+
+/// nodes spanned by a loop closure of the pose-graph benchmark
+#define BENCH_GRAPH_LOOP_SPAN	(1000)
+
+/// nodes added per Update() of the pose-graph benchmark
+#define BENCH_GRAPH_BATCH		(1000)
+
+/// scale error of the odometry of the pose-graph benchmark
+#define BENCH_GRAPH_SCALE		(1.01)
+
+/// heading error of the odometry per record of the pose-graph benchmark (rad)
+#define BENCH_GRAPH_BIAS		(1e-5)
+
+/// largest deviation of the incremental graph after Optimize() (m)
+#define BENCH_GRAPH_MAX_DIFF	(1e-4)
+
+/// attempts to connect to the server of the archive check (10 ms apart)
+#define BENCH_SERVER_WAIT		(500)
+
+/// estimator modes of the golden check
+enum EBenchGoldenMode
+{
+	GOLDEN_ESTIMATE = 0,	///< CTricycle + CVirtualGyro singletons
+	GOLDEN_STEP,			///< Step() with the runtime chassis
+	GOLDEN_STEP_STANDARD,	///< Step<SGeometryStandard>()
+	GOLDEN_JOURNAL,			///< CEstimatorJournal::Append()
+	GOLDEN_PARALLEL,		///< CParallelReplay::Run()
+	GOLDEN_FLEET,			///< CFleetTricycle::Estimate() (SIMD)
+	GOLDEN_FIXED,			///< FixedStep() (integer only)
+	GOLDEN_EKF,				///< CEkfTricycle::EstimateNs() without gyro
+	GOLDEN_EKF_GYRO,		///< CEkfTricycle::EstimateNs() + virtual gyro
+	GOLDEN_MODE_COUNT
+};
+
+/// type definition of an estimator mode and its tolerances
+typedef struct _tagSBenchGoldenMode
+{
+	const char* szName;		///< name of the mode
+	double      time;		///< tolerance of the time (unit: sec)
+	double      position;	///< tolerance of robot x, y (unit: m)
+	double      heading;	///< tolerance of robot q (unit: rad)
+	double      contour;	///< tolerance of the contour points (unit: m)
+} SBenchGoldenMode;
+
+/// estimator modes (the golden files have 6 decimals, and their times are
+/// float seconds, e.g. 16.200001, while the outputs take them from ns)
+static const SBenchGoldenMode s_goldenMode[GOLDEN_MODE_COUNT] =
+{
+	{ "CTricycle::EstimateNs",		5e-6, 1e-5, 1e-5, 1e-5 },
+	{ "Step",						5e-6, 1e-5, 1e-5, 1e-5 },
+	{ "Step<SGeometryStandard>",	5e-6, 1e-5, 1e-5, 1e-5 },
+	{ "EstimatorJournal::Append",	5e-6, 1e-5, 1e-5, 1e-5 },
+	{ "ParallelReplay::Run",		5e-6, 1e-5, 1e-5, 1e-5 },
+	{ "FleetTricycle::Estimate",	5e-6, 1e-5, 1e-5, 1e-5 },
+	{ "FixedTricycle::Step",		5e-6, 1e-4, 1e-4, 1e-4 },
+	{ "EkfTricycle::EstimateNs",	5e-6, 1e-5, 1e-5, 1e-5 },
+	{ "EkfTricycle::EstimateNs (gyro)",	5e-6, 1e-5, 1e-5, 1e-5 },
+};
+
+/// entry points of the program (main.cpp) of the golden file check
+enum EBenchEntry
+{
+	ENTRY_RUN = 0,			///< Run() without the plot (text files)
+	ENTRY_RUN_PIPELINE,		///< Run() --pipeline
+	ENTRY_RUN_BINARY,		///< Run() --binary (CPoseLogWriter)
+	ENTRY_STREAM,			///< --stream from a file
+	ENTRY_STREAM_PIPE,		///< --stream from a named pipe
+	ENTRY_BATCH,			///< --batch (FormatPoseLine(), FormatFixed6())
+	ENTRY_BATCH_BINARY,		///< --batch --binary (CPoseLogWriter)
+	ENTRY_CLIENT,			///< --client on a --serve child process
+	ENTRY_COUNT
+};
+
+/// type definition of an entry point and the files it writes
+typedef struct _tagSBenchEntry
+{
+	const char* szName;		///< name of the entry point
+	bool        contour;	///< writes NN_contour.txt
+	bool        binary;		///< writes NN_pose.bin instead of text files
+	bool        posix;		///< needs Linux (named pipe, --serve)
+} SBenchEntry;
+
+/// entry points
+static const SBenchEntry s_entry[ENTRY_COUNT] =
+{
+	{ "Run",				true,	false,	false },
+	{ "Run --pipeline",		true,	false,	false },
+	{ "Run --binary",		false,	true,	false },
+	{ "--stream",			false,	false,	false },
+	{ "--stream (pipe)",	false,	false,	true },
+	{ "--batch",			true,	false,	false },
+	{ "--batch --binary",	false,	true,	false },
+	{ "--client",			false,	false,	true },
+};
+
+/// chassis of the integrator benchmarks
+typedef TTricycle<SGeometryStandard> TBenchTricycle;
+
+/// type definition of a benchmark result
+typedef struct _tagSBenchResult
+{
+	std::string name;		///< benchmark name
+	long long   records;	///< number of input records
+	int         samples;	///< number of timing samples
+	double      p50;		///< median (unit: ns/record)
+	double      p99;		///< 99th percentile (unit: ns/record)
+	double      throughput;	///< records per second
+} SBenchResult;
+
+/// type definition of an integrator accuracy result
+typedef struct _tagSBenchAccuracy
+{
+	std::string name;		///< integrator benchmark name
+	std::string scenario;	///< scenario name
+	int         decimation;	///< input records per estimator step
+	long long   steps;		///< number of estimator steps
+	double      maxError;	///< max position error (unit: m)
+	double      finalError;	///< position error at the last step (unit: m)
+	double      p50;		///< median cost per step (unit: ns, 0: not timed)
+} SBenchAccuracy;
+
+/// type definition of a check of the integrators at a larger interval
+typedef struct _tagSBenchAccuracyCheck
+{
+	std::string scenario;	///< scenario name (steady steering)
+	double      euler;		///< max error of Euler at the full rate (m)
+	double      arc;		///< max error of arc at the decimation (m)
+	double      rk4;		///< max error of RK4 at the decimation (m)
+	bool        pass;		///< arc and RK4 not above Euler
+} SBenchAccuracyCheck;
+
+/// type definition of a check of the fixed-point estimator against double
+typedef struct _tagSBenchFixedCheck
+{
+	std::string scenario;	///< scenario name
+	long long   records;	///< number of records
+	double      maxPos;		///< max position deviation (unit: m)
+	double      maxQ;		///< max heading deviation (unit: rad)
+	double      maxPosFloat;	///< same of the float Step() (unit: m)
+	double      maxQFloat;	///< same of the float Step() (unit: rad)
+	bool        pass;		///< within BENCH_FIXED_MAX_POS and _MAX_Q
+} SBenchFixedCheck;
+
+/// type definition of a check of the journal against a full replay
+typedef struct _tagSBenchJournalCheck
+{
+	std::string scenario;	///< scenario name
+	long long   records;	///< number of records
+	int         corrections;	///< number of corrected records
+	long long   reestimated;	///< records estimated again
+	bool        pass;		///< poses identical to a full replay
+} SBenchJournalCheck;
+
+/// type definition of a check of the trajectory index against a scan
+typedef struct _tagSBenchIndexCheck
+{
+	long long   records;	///< number of samples
+	int         queries;	///< number of checked queries
+	int         mismatches;	///< queries unlike the scan or the reference
+	bool        pass;		///< no mismatch
+} SBenchIndexCheck;
+
+/// type definition of a check of the pose-graph optimizer
+typedef struct _tagSBenchGraphCheck
+{
+	long long   records;	///< number of nodes
+	int         iterations;	///< Gauss-Newton iterations of Optimize()
+	double      seconds;	///< time of Optimize() (unit: sec)
+	double      rmsOdometry;	///< position error of the odometry (unit: m)
+	double      rmsOptimized;	///< same after Optimize() (unit: m)
+	double      rmsIncremental;	///< same after the Update() (unit: m)
+	double      maxDiff;	///< incremental then Optimize() vs batch (unit: m)
+	bool        pass;		///< converged, no worse, within the tolerance
+} SBenchGraphCheck;
+
+/// type definition of a golden check (estimator mode and scenario)
+typedef struct _tagSBenchGolden
+{
+	std::string mode;		///< estimator mode
+	std::string scenario;	///< scenario name
+	long long   records;	///< number of records
+	double      maxTime;	///< max time deviation (unit: sec)
+	double      maxPos;		///< max position deviation (unit: m)
+	double      maxQ;		///< max heading deviation (unit: rad)
+	double      maxContour;	///< max contour deviation (unit: m)
+	int         mismatches;	///< lines or values outside the tolerances
+	double      throughput;	///< records per second of the replay
+	bool        pass;		///< all fields within the tolerances
+} SBenchGolden;
+
+/// type definition of a replay of a record archive through an entry point
+typedef struct _tagSBenchArchiveCheck
+{
+	std::string mode;		///< entry point (command line option)
+	std::string scenario;	///< scenario name
+	long long   records;	///< number of records
+	int         mismatches;	///< output lines other than the reference
+	bool        pass;		///< succeeded and no mismatch
+} SBenchArchiveCheck;
+
+/// type definition of a round trip CSV -> record archive -> CSV
+typedef struct _tagSBenchRoundTrip
+{
+	std::string scenario;	///< scenario name
+	long long   records;	///< number of records
+	double      maxSteer;	///< max steering angle deviation (unit: rad)
+	double      maxAngVel;	///< max angular velocity deviation (unit: rad/s)
+	double      maxPos;		///< max position deviation from golden (unit: m)
+	double      maxQ;		///< max heading deviation from golden (unit: rad)
+	bool        pass;		///< lossless but the angles, within tolerances
+} SBenchRoundTrip;
+
+/// type definition of a cycle count (time stamp counter per record)
+typedef struct _tagSBenchCycles
+{
+	std::string name;		///< kernel name
+	long long   records;	///< number of input records
+	double      cycles;		///< cycles per record
+} SBenchCycles;
+
+/// type definition of a scenario of the accuracy benchmark
+typedef struct _tagSBenchScenario
+{
+	std::string name;				///< scenario name
+	std::vector<SRecord> vRecord;	///< input records
+} SBenchScenario;
+
+/// @brief		Microbenchmarks of the pose estimator
+class CTricycleBench
+{
+public:
+	/// constructor
+	explicit CTricycleBench(const std::string& sDir, const std::string& sFilter, \
+		const std::string& sScenarioDir)
+	: m_sDir(sDir), m_sFilter(sFilter), m_sScenarioDir(sScenarioDir)
+	, m_fSink(0.f) {}
+
+	/// run all benchmarks for the sizes nMin, 10 * nMin, ... nMax
+	void Run(const long long nMin, const long long nMax);
+
+	/// print results as JSON
+	void PrintJson(FILE* fp) const;
+
+	/// check whether a correctness check failed
+	bool HasFailure() const;
+
+private:
+	/// generate synthetic records
+	void MakeRecords(const long long nRecords);
+
+	/// check whether a benchmark is selected
+	bool IsSelected(const char* szName) const;
+
+	/// make the synthetic scenarios and read those of --scenarios
+	void MakeScenarios(std::vector<SBenchScenario>& vScenario);
+
+	/// time a per-record kernel in batches
+	template<typename F>
+	void MeasureKernel(const char* szName, F kernel, \
+		const long long nRecordsPerCall = 1);
+
+	/// run an entry point of the program on an input file
+	int RunEntryPoint(const int nEntry, const std::string& sInput, \
+		const std::string& sOutput);
+
+	/// add a result from timing samples (ns/record)
+	void AddResult(const char* szName, std::vector<double>& vSamples, \
+		const double dSeconds, const long long nProcessed);
+
+	/// benchmarks
+	//@{
+	void BenchEstimate();
+	void BenchIntegrators();
+	template<int nIntegrator>
+	void BenchIntegrator(const float* pAngVel);
+	void BenchAccuracy();
+	void BenchFixed();
+	void CheckFixed();
+	void BenchJournal();
+	void CheckJournal();
+	void BenchTrajectoryIndex();
+	void BenchPoseGraph();
+	void CheckGolden();
+	void CheckGoldenFiles();
+	void CheckArchive();
+	void BenchGyroUpdate();
+	void BenchGetRobotContour();
+	void BenchFleetEstimate();
+	void BenchArrayKernels();
+	void BenchEkfEstimate();
+	void BenchHistoryQuery();
+	void BenchPoseShm();
+	void BenchReadInputFile();
+	void BenchReadArchive();
+	void BenchWrite(const bool bBinary);
+	//@}
+
+private:
+	/// directory for temporary files
+	std::string m_sDir;
+
+	/// run only benchmarks whose name contains this string
+	std::string m_sFilter;
+
+	/// directory of NN_input.csv scenarios of the accuracy benchmark
+	std::string m_sScenarioDir;
+
+	/// synthetic records
+	std::vector<SRecord> m_vRecord;
+
+	/// results
+	std::vector<SBenchResult> m_vResult;
+
+	/// accuracy results of the integrators
+	std::vector<SBenchAccuracy> m_vAccuracy;
+
+	/// checks of the integrators at a larger interval
+	std::vector<SBenchAccuracyCheck> m_vAccuracyCheck;
+
+	/// checks of the fixed-point estimator
+	std::vector<SBenchFixedCheck> m_vFixedCheck;
+
+	/// cycle counts
+	std::vector<SBenchCycles> m_vCycles;
+
+	/// checks of the journal
+	std::vector<SBenchJournalCheck> m_vJournalCheck;
+
+	/// checks of the trajectory index
+	std::vector<SBenchIndexCheck> m_vIndexCheck;
+
+	/// checks of the pose-graph optimizer
+	std::vector<SBenchGraphCheck> m_vGraphCheck;
+
+	/// golden checks of the estimator modes
+	std::vector<SBenchGolden> m_vGolden;
+
+	/// replays of record archives through the entry points
+	std::vector<SBenchArchiveCheck> m_vArchiveCheck;
+
+	/// round trips CSV -> record archive -> CSV
+	std::vector<SBenchRoundTrip> m_vRoundTrip;
+
+	/// sink for computed values (keeps the compiler from removing them)
+	volatile float m_fSink;
+};
+
+/// clock of the benchmarks
+typedef std::chrono::steady_clock BenchClock;
+
+///
+/// @brief		elapsed time between two time points
+/// @param		t0 [in] start time
+/// @param		t1 [in] end time
+/// @return		elapsed time (unit: ns)
+///
+static inline double ElapsedNs(const BenchClock::time_point& t0, \
+	const BenchClock::time_point& t1)
+{
+	return std::chrono::duration<double, std::nano>(t1 - t0).count();
+}
+
+///
+/// @brief		read the time stamp counter
+/// @param		N/A
+/// @return		counter (0 if the processor has none)
+/// @remark		counts at the reference clock of the processor (rdtsc); on a
+///				controller the cycle counter of the core (e.g. DWT_CYCCNT)
+///				takes its place
+///
+static inline unsigned long long ReadCycles()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+	return (unsigned long long)__rdtsc();
+#else
+	return 0ULL;
+#endif
+}
+
+///
+/// @brief		percentile of sorted samples (nearest rank)
+/// @param		v [in] sorted samples
+/// @param		p [in] percentile [0..1]
+/// @return		sample at the percentile
+///
+static double Percentile(const std::vector<double>& v, const double p)
+{
+	if (v.empty())
+		return 0.;
+
+	const size_t nRank = size_t(ceil(p * double(v.size())));
+
+	return v[nRank > 0 ? nRank - 1 : 0];
+}
+
+///
+/// @brief		heading change of the noise-free virtual gyro over a record
+/// @param		fPrevSteer [in] previous steering angle (rad)
+/// @param		fSteer [in] steering angle (rad)
+/// @param		nTicks [in] encoder ticks of the record
+/// @return		heading change (rad), as CVirtualGyro::UpdateNs()
+///
+template<typename T>
+static inline T GyroDiffAngle(const T fPrevSteer, const T fSteer, \
+	const int nTicks)
+{
+	return nTicks * T(TBenchTricycle::fFrontDistPerTick) / T(2) \
+		/ T(SGeometryStandard::fDistBtwFrontRear) \
+		* T(sin((fPrevSteer + fSteer) / T(2)));
+}
+
+///
+/// @brief		estimate poses polling every nDecimation-th input record
+/// @param		vRecord [in] input records
+/// @param		nDecimation [in] input records per estimator step
+/// @param		vPose [out] pose after each step
+/// @return		void
+/// @remark		Between two polls the encoder counts on and a rate gyro
+///				integrates the heading change, so the ticks and the heading
+///				changes of the skipped records are summed. The steering angle
+///				is the one of the polled record.
+///
+template<typename T, int nIntegrator>
+static void IntegrateDecimated(const std::vector<SRecord>& vRecord, \
+	const size_t nDecimation, std::vector<SPoseD>& vPose)
+{
+	TTricycleState<T> state;
+	T fPrevSteer = T(0);
+
+	vPose.clear();
+	for (size_t i = nDecimation - 1; i < vRecord.size(); i += nDecimation)
+	{
+		const SRecord& r = vRecord[i];
+
+		/// ticks and heading change since the previous poll
+		//@{
+		int nTicks = 0;
+		T fDiffQ = T(0);
+		for (size_t j = i + 1 - nDecimation; j <= i; ++j)
+		{
+			const T fSteer = T(vRecord[j].steering_angle);
+			nTicks += vRecord[j].encoder_ticks;
+			fDiffQ += GyroDiffAngle(fPrevSteer, fSteer, \
+				vRecord[j].encoder_ticks);
+			fPrevSteer = fSteer;
+		}
+		//@}
+
+		const T fDiffTime = T(Ns2Sec(r.time_ns - state.nPrevTimeNs));
+		const T fW = almostZero(fDiffTime) ? T(0) : fDiffQ / fDiffTime;
+		const TPose<T> pose = TBenchTricycle::Estimate<T, nIntegrator>( \
+			state, r.time_ns, T(r.steering_angle), nTicks, fW);
+
+		vPose.push_back(SPoseD(pose.x, pose.y, pose.q));
+	}
+}
+
+///
+/// @brief		estimate poses in float with an integrator chosen at run time
+/// @param		nIntegrator [in] integrator (EIntegrator)
+/// @param		vRecord [in] input records
+/// @param		nDecimation [in] input records per estimator step
+/// @param		vPose [out] pose after each step
+/// @return		void
+///
+static void IntegrateDecimated(const int nIntegrator, \
+	const std::vector<SRecord>& vRecord, const size_t nDecimation, \
+	std::vector<SPoseD>& vPose)
+{
+	switch (nIntegrator)
+	{
+	case INTEGRATOR_EULER:
+		IntegrateDecimated<float, INTEGRATOR_EULER>(vRecord, nDecimation, vPose);
+		break;
+	case INTEGRATOR_MIDPOINT:
+		IntegrateDecimated<float, INTEGRATOR_MIDPOINT>(vRecord, nDecimation, \
+			vPose);
+		break;
+	case INTEGRATOR_ARC:
+		IntegrateDecimated<float, INTEGRATOR_ARC>(vRecord, nDecimation, vPose);
+		break;
+	default:
+		IntegrateDecimated<float, INTEGRATOR_RK4>(vRecord, nDecimation, vPose);
+		break;
+	}
+}
+
+///
+/// @brief		make a synthetic scenario at 100 Hz
+/// @param		szName [in] scenario name
+/// @param		fSteerAmp [in] amplitude of the steering angle (rad)
+/// @param		fSteerPeriod [in] period of the steering angle (sec, 0:
+///				constant steering)
+/// @param		nTicks [in] encoder ticks per record
+/// @return		scenario
+///
+static SBenchScenario MakeScenario(const char* szName, const float fSteerAmp, \
+	const float fSteerPeriod, const int nTicks)
+{
+	SBenchScenario scenario;
+
+	scenario.name = szName;
+	scenario.vRecord.resize(BENCH_SCENARIO_SIZE);
+	for (size_t i = 0; i < scenario.vRecord.size(); ++i)
+	{
+		SRecord& r = scenario.vRecord[i];
+		r.time_ns = (long long)(i + 1) * 10000000LL;
+		r.time = float(Ns2Sec(r.time_ns));
+		r.steering_angle = (fSteerPeriod > 0.f) ? float(fSteerAmp \
+			* sin(2. * M_PI * Ns2Sec(r.time_ns) / fSteerPeriod)) : fSteerAmp;
+		r.encoder_ticks = nTicks;
+	}
+
+	return scenario;
+}
+
+///
+/// @brief		generate synthetic records
+/// @param		nRecords [in] number of records
+/// @return		void
+/// @remark		100 Hz, steering as a bounded random walk, 0..63 ticks.
+///				A fixed-seed LCG makes runs repeatable.
+///
+void CTricycleBench::MakeRecords(const long long nRecords)
+{
+	unsigned nSeed = 12345u;
+	float fSteer = 0.f;
+
+	m_vRecord.resize(size_t(nRecords));
+	for (long long i = 0; i < nRecords; ++i)
+	{
+		nSeed = nSeed * 1664525u + 1013904223u;
+
+		fSteer += (float((nSeed >> 8) & 0xFF) - 127.5f) * 0.0005f;
+		fSteer = std::max(-1.5f, std::min(1.5f, fSteer));
+
+		SRecord& r = m_vRecord[size_t(i)];
+		r.time_ns = (i + 1) * 10000000LL;
+		r.time = float(Ns2Sec(r.time_ns));
+		r.steering_angle = fSteer;
+		r.encoder_ticks = int((nSeed >> 20) & 0x3F);
+		r.angular_velocity = 0.f;
+	}
+}
+
+///
+/// @brief		check whether a benchmark is selected by --filter
+/// @param		szName [in] benchmark name
+/// @return		true if selected
+///
+bool CTricycleBench::IsSelected(const char* szName) const
+{
+	return m_sFilter.empty() || strstr(szName, m_sFilter.c_str());
+}
+
+///
+/// @brief		time a per-record kernel in batches
+/// @param		szName [in] benchmark name
+/// @param		kernel [in] callable with a record index
+/// @param		nRecordsPerCall [in] records processed by one kernel call
+/// @return		void
+/// @remark		passes over the records are repeated until at least
+///				BENCH_MIN_SAMPLES batches are timed
+///
+template<typename F>
+void CTricycleBench::MeasureKernel(const char* szName, F kernel, \
+	const long long nRecordsPerCall)
+{
+	const long long nCalls = (long long)(m_vRecord.size());
+	const long long nBatch = std::min<long long>(BENCH_BATCH_SIZE, \
+		std::max<long long>(1, nCalls / BENCH_MIN_SAMPLES));
+	const long long nBatches = nCalls / nBatch;
+	const long long nPasses = std::max<long long>(1, \
+		(BENCH_MIN_SAMPLES + nBatches - 1) / nBatches);
+
+	std::vector<double> vSamples;
+	vSamples.reserve(size_t(nBatches * nPasses));
+
+	double dTotalNs = 0.;
+	for (long long nPass = 0; nPass < nPasses; ++nPass)
+	{
+		for (long long b = 0; b < nBatches; ++b)
+		{
+			const long long nBegin = b * nBatch;
+			BenchClock::time_point t0 = BenchClock::now();
+			for (long long i = nBegin; i < nBegin + nBatch; ++i)
+				kernel(size_t(i));
+			BenchClock::time_point t1 = BenchClock::now();
+
+			const double dNs = ElapsedNs(t0, t1);
+			dTotalNs += dNs;
+			vSamples.push_back(dNs / double(nBatch * nRecordsPerCall));
+		}
+	}
+
+	AddResult(szName, vSamples, dTotalNs * 1e-9, \
+		nBatches * nBatch * nPasses * nRecordsPerCall);
+}
+
+///
+/// @brief		add a result from timing samples
+/// @param		szName [in] benchmark name
+/// @param		vSamples [in] timing samples (ns/record), sorted here
+/// @param		dSeconds [in] total measured time (sec)
+/// @param		nProcessed [in] total processed records
+/// @return		void
+///
+void CTricycleBench::AddResult(const char* szName, \
+	std::vector<double>& vSamples, const double dSeconds, \
+	const long long nProcessed)
+{
+	SBenchResult result;
+
+	std::sort(vSamples.begin(), vSamples.end());
+
+	result.name = szName;
+	result.records = (long long)(m_vRecord.size());
+	result.samples = int(vSamples.size());
+	result.p50 = Percentile(vSamples, 0.50);
+	result.p99 = Percentile(vSamples, 0.99);
+	result.throughput = (dSeconds > 0.) ? double(nProcessed) / dSeconds : 0.;
+
+	m_vResult.push_back(result);
+
+	std::cerr << "  " << szName << ": p50 " << result.p50 << " ns, p99 " \
+		<< result.p99 << " ns, " << result.throughput << " records/s" \
+		<< std::endl;
+}
+
+///
+/// @brief		benchmark of CTricycle::Estimate(), of the kernel in double and
+///				of Step()
+/// @param		N/A
+/// @return		void
+///
+void CTricycleBench::BenchEstimate()
+{
+	CTricycle* pTricycle = CTricycle::GetInstance();
+	const SRecord* pRecord = &m_vRecord[0];
+	volatile float& sink = m_fSink;
+
+	if (IsSelected("Estimate"))
+	{
+		MeasureKernel("Estimate", [=, &sink](const size_t i)
+		{
+			const SRecord& r = pRecord[i];
+			sink = pTricycle->EstimateNs(r.time_ns, r.steering_angle, \
+				r.encoder_ticks, r.angular_velocity).x;
+		});
+	}
+
+	if (IsSelected("Estimate<double>"))
+	{
+		TTricycleState<double> state;
+		TTricycleState<double>* pState = &state;
+
+		MeasureKernel("Estimate<double>", [=, &sink](const size_t i)
+		{
+			const SRecord& r = pRecord[i];
+			sink = float(TTricycle<SGeometryStandard>::Estimate<double>( \
+				*pState, r.time_ns, r.steering_angle, r.encoder_ticks, \
+				r.angular_velocity).x);
+		});
+	}
+
+	/// reentrant step with its gyro: inlined, and through the chassis table
+	//@{
+	if (IsSelected("Step"))
+	{
+		SEstimatorState state;
+		SEstimatorState* pState = &state;
+
+		MeasureKernel("Step", [=, &sink](const size_t i)
+		{
+			sink = Step<SGeometryStandard>(*pState, pRecord[i]).x;
+		});
+	}
+
+	if (IsSelected("Step(chassis)"))
+	{
+		SEstimatorState state;
+		SEstimatorState* pState = &state;
+		const STricycleChassis* pChassis = &CTricycle::GetChassisAt(0);
+
+		MeasureKernel("Step(chassis)", [=, &sink](const size_t i)
+		{
+			sink = Step(*pChassis, INTEGRATOR_EULER, *pState, pRecord[i]).x;
+		});
+	}
+	//@}
+}
+
+///
+/// @brief		benchmark of TTricycle::Estimate() with an integrator
+/// @param		pAngVel [in] angular velocity of each record (rad/s)
+/// @return		void
+///
+template<int nIntegrator>
+void CTricycleBench::BenchIntegrator(const float* pAngVel)
+{
+	const std::string sName = std::string("Estimate[") \
+		+ CTricycle::GetIntegratorName(nIntegrator) + "]";
+	if (!IsSelected(sName.c_str()))
+		return;
+
+	STricycleState state;
+	STricycleState* pState = &state;
+	const SRecord* pRecord = &m_vRecord[0];
+	volatile float& sink = m_fSink;
+
+	MeasureKernel(sName.c_str(), [=, &sink](const size_t i)
+	{
+		const SRecord& r = pRecord[i];
+		sink = TBenchTricycle::Estimate<float, nIntegrator>(*pState, \
+			r.time_ns, r.steering_angle, r.encoder_ticks, pAngVel[i]).x;
+	});
+}
+
+///
+/// @brief		benchmark of the integrators (cost per step)
+/// @param		N/A
+/// @return		void
+/// @remark		the angular velocities are computed beforehand, so that
+///				only the integration is timed
+///
+void CTricycleBench::BenchIntegrators()
+{
+	std::vector<float> vAngVel(m_vRecord.size());
+
+	long long nPrevTimeNs = 0;
+	float fPrevSteer = 0.f;
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+	{
+		const SRecord& r = m_vRecord[i];
+		const float fDiffTime = float(Ns2Sec(r.time_ns - nPrevTimeNs));
+		vAngVel[i] = almostZero(fDiffTime) ? 0.f : GyroDiffAngle(fPrevSteer, \
+			r.steering_angle, r.encoder_ticks) / fDiffTime;
+		nPrevTimeNs = r.time_ns;
+		fPrevSteer = r.steering_angle;
+	}
+
+	BenchIntegrator<INTEGRATOR_EULER>(&vAngVel[0]);
+	BenchIntegrator<INTEGRATOR_MIDPOINT>(&vAngVel[0]);
+	BenchIntegrator<INTEGRATOR_ARC>(&vAngVel[0]);
+	BenchIntegrator<INTEGRATOR_RK4>(&vAngVel[0]);
+}
+
+///
+/// @brief		make the synthetic scenarios and read those of --scenarios
+/// @param		vScenario [out] scenarios (random steering, circle, slalom and
+///				NN_input.csv of --scenarios)
+/// @return		void
+///
+void CTricycleBench::MakeScenarios(std::vector<SBenchScenario>& vScenario)
+{
+	MakeRecords(BENCH_SCENARIO_SIZE);
+	vScenario.push_back(SBenchScenario());
+	vScenario.back().name = "synthetic";
+	vScenario.back().vRecord = m_vRecord;
+	vScenario.push_back(MakeScenario("circle", 0.6f, 0.f, 40));
+	vScenario.push_back(MakeScenario("slalom", 0.8f, 4.f, 40));
+
+	for (int n = 1; !m_sScenarioDir.empty() && n < 100; ++n)
+	{
+		char szName[16];
+		snprintf(szName, sizeof(szName), "%02d_input.csv", n);
+
+		CMappedFile file;
+		if (file.Open(m_sScenarioDir + "/" + szName) != 0)
+			break;
+
+		vScenario.push_back(SBenchScenario());
+		vScenario.back().name = szName;
+		ParseRecords(file.GetData(), file.GetData() + file.GetSize(), \
+			vScenario.back().vRecord);
+	}
+}
+
+///
+/// @brief		check whether the steering angle stays constant between the
+///				polls of a decimation
+/// @param		vRecord [in] input records
+/// @param		k [in] input records per estimator step
+/// @return		true if no record after the first poll changes the steering
+///
+static bool IsSteadySteering(const std::vector<SRecord>& vRecord, \
+	const size_t k)
+{
+	for (size_t i = k; i < vRecord.size(); ++i)
+	{
+		if (vRecord[i].steering_angle != vRecord[i - 1].steering_angle)
+			return false;
+	}
+
+	return !vRecord.empty();
+}
+
+///
+/// @brief		accuracy of the integrators at larger sample intervals
+/// @param		N/A
+/// @return		void
+/// @remark		Each scenario is estimated in float polling every 1st, 2nd,
+///				3rd and 5th record, and compared with the exact arc in double
+///				at the full rate at the same records. The scenarios are
+///				synthetic (random steering, circle, slalom) and NN_input.csv
+///				of --scenarios.
+///
+///				Where the steering does not change after the first poll
+///				(IsSteadySteering(), e.g. circle and the turn and rotate
+///				scenarios), arc and RK4 polling every
+///				BENCH_ACCURACY_DECIMATION-th record must not be worse than
+///				Euler at the full rate (m_vAccuracyCheck). Where it changes
+///				between polls (synthetic, slalom), the held steering limits
+///				every integrator and midpoint can be worse than Euler, so
+///				nothing is checked.
+///
+void CTricycleBench::BenchAccuracy()
+{
+	static const int s_nDecimation[] = { 1, 2, 3, 5 };
+	static const size_t s_nDecimations = sizeof(s_nDecimation) / sizeof(int);
+
+	/// scenarios
+	std::vector<SBenchScenario> vScenario;
+	MakeScenarios(vScenario);
+
+	std::vector<SPoseD> vRef;
+	std::vector<SPoseD> vPose;
+	for (size_t s = 0; s < vScenario.size(); ++s)
+	{
+		const std::vector<SRecord>& vRecord = vScenario[s].vRecord;
+
+		/// reference: exact arc in double at the full rate
+		IntegrateDecimated<double, INTEGRATOR_ARC>(vRecord, 1, vRef);
+
+		/// max error of each integrator and decimation (< 0: not run)
+		double dMaxError[INTEGRATOR_COUNT][s_nDecimations];
+		for (int i = 0; i < INTEGRATOR_COUNT; ++i)
+			std::fill(dMaxError[i], dMaxError[i] + s_nDecimations, -1.);
+
+		for (int nIntegrator = 0; nIntegrator < INTEGRATOR_COUNT; \
+			++nIntegrator)
+		{
+			SBenchAccuracy result;
+			result.name = std::string("Estimate[") \
+				+ CTricycle::GetIntegratorName(nIntegrator) + "]";
+			if (!IsSelected(result.name.c_str()))
+				continue;
+
+			/// cost per step of the largest timed size
+			result.p50 = 0.;
+			for (size_t i = 0; i < m_vResult.size(); ++i)
+			{
+				if (m_vResult[i].name == result.name)
+					result.p50 = m_vResult[i].p50;
+			}
+
+			for (size_t d = 0; d < s_nDecimations; ++d)
+			{
+				const size_t k = size_t(s_nDecimation[d]);
+				IntegrateDecimated(nIntegrator, vRecord, k, vPose);
+
+				result.scenario = vScenario[s].name;
+				result.decimation = int(k);
+				result.steps = (long long)(vPose.size());
+				result.maxError = 0.;
+				result.finalError = 0.;
+				for (size_t i = 0; i < vPose.size(); ++i)
+				{
+					const SPoseD& ref = vRef[(i + 1) * k - 1];
+					const double dx = vPose[i].x - ref.x;
+					const double dy = vPose[i].y - ref.y;
+					result.finalError = sqrt(dx * dx + dy * dy);
+					result.maxError = std::max(result.maxError, \
+						result.finalError);
+				}
+
+				m_vAccuracy.push_back(result);
+				dMaxError[nIntegrator][d] = result.maxError;
+
+				std::cerr << "  " << result.name << " " << result.scenario \
+					<< " 1/" << k << ": max error " << result.maxError \
+					<< " m, final error " << result.finalError << " m" \
+					<< std::endl;
+			}
+		}
+
+		/// arc and RK4 at the larger interval against Euler at the full rate
+		//@{
+		const size_t d = s_nDecimations - 1;
+		if (s_nDecimation[d] != BENCH_ACCURACY_DECIMATION || \
+			!IsSteadySteering(vRecord, BENCH_ACCURACY_DECIMATION) || \
+			dMaxError[INTEGRATOR_EULER][0] < 0. || \
+			dMaxError[INTEGRATOR_ARC][d] < 0. || \
+			dMaxError[INTEGRATOR_RK4][d] < 0.)
+			continue;
+
+		SBenchAccuracyCheck check;
+		check.scenario = vScenario[s].name;
+		check.euler = dMaxError[INTEGRATOR_EULER][0];
+		check.arc = dMaxError[INTEGRATOR_ARC][d];
+		check.rk4 = dMaxError[INTEGRATOR_RK4][d];
+		check.pass = check.arc <= check.euler + BENCH_ACCURACY_EPS && \
+			check.rk4 <= check.euler + BENCH_ACCURACY_EPS;
+		m_vAccuracyCheck.push_back(check);
+
+		std::cerr << "  " << check.scenario << ": arc " << check.arc \
+			<< " m, rk4 " << check.rk4 << " m at 1/" \
+			<< BENCH_ACCURACY_DECIMATION << ", euler " << check.euler \
+			<< " m at 1/1" << (check.pass ? "" : " FAILED") << std::endl;
+		//@}
+	}
+}
+
+///
+/// @brief		benchmark of FixedStep() against Step() (ns and cycles)
+/// @param		N/A
+/// @return		void
+/// @remark		The steering angles are converted to binary angles
+///				beforehand, as a controller reads them from its sensor.
+///				Cycles are counted over one pass of all records.
+///
+void CTricycleBench::BenchFixed()
+{
+	const SFixedChassis fixedChassis = MakeFixedChassis( \
+		TBenchTricycle::fFrontDistPerTick, SGeometryStandard::fDistBtwFrontRear);
+
+	std::vector<int32_t> vSteer(m_vRecord.size());
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+		vSteer[i] = FixedRad2Bam(m_vRecord[i].steering_angle);
+
+	const SRecord* pRecord = &m_vRecord[0];
+	const int32_t* pSteer = &vSteer[0];
+	const SFixedChassis* pChassis = &fixedChassis;
+	volatile float& sink = m_fSink;
+
+	/// time per record
+	//@{
+	SFixedState fixedState;
+	SFixedState* pFixedState = &fixedState;
+	MeasureKernel("FixedTricycle::Step", [=, &sink](const size_t i)
+	{
+		FixedStep(*pChassis, *pFixedState, pRecord[i].time_ns, pSteer[i], \
+			pRecord[i].encoder_ticks);
+		sink = float(pFixedState->x);
+	});
+	//@}
+
+	/// cycles per record of the fixed-point and the float estimators
+	//@{
+	SBenchCycles cycles;
+	cycles.records = (long long)m_vRecord.size();
+
+	SFixedState fixedPass;
+	unsigned long long t0 = ReadCycles();
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+		FixedStep(fixedChassis, fixedPass, pRecord[i].time_ns, pSteer[i], \
+			pRecord[i].encoder_ticks);
+	unsigned long long t1 = ReadCycles();
+	sink = float(fixedPass.x);
+
+	cycles.name = "FixedTricycle::Step";
+	cycles.cycles = double(t1 - t0) / double(m_vRecord.size());
+	m_vCycles.push_back(cycles);
+
+	SEstimatorState floatPass;
+	t0 = ReadCycles();
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+		Step<SGeometryStandard>(floatPass, pRecord[i]);
+	t1 = ReadCycles();
+	sink = floatPass.pose.pose.x;
+
+	cycles.name = "Step";
+	cycles.cycles = double(t1 - t0) / double(m_vRecord.size());
+	m_vCycles.push_back(cycles);
+
+	std::cerr << "  cycles/record: FixedTricycle::Step " \
+		<< m_vCycles[m_vCycles.size() - 2].cycles << ", Step " \
+		<< cycles.cycles << std::endl;
+	//@}
+}
+
+///
+/// @brief		check the fixed-point estimator against double precision
+/// @param		N/A
+/// @return		void
+/// @remark		Every scenario (synthetic and NN_input.csv of --scenarios)
+///				goes through FixedStep(), the float Step() and the same model
+///				in double (Euler, noise-free gyro). A scenario passes if the
+///				fixed-point poses never deviate from double by more than
+///				BENCH_FIXED_MAX_POS and BENCH_FIXED_MAX_Q. The deviation of
+///				float is reported next to it: over long runs float rounding
+///				drifts more than the Q32.32 accumulator.
+///
+void CTricycleBench::CheckFixed()
+{
+	const SFixedChassis fixedChassis = MakeFixedChassis( \
+		TBenchTricycle::fFrontDistPerTick, SGeometryStandard::fDistBtwFrontRear);
+
+	std::vector<SBenchScenario> vScenario;
+	MakeScenarios(vScenario);
+
+	std::vector<SPoseD> vRef;
+	for (size_t s = 0; s < vScenario.size(); ++s)
+	{
+		const std::vector<SRecord>& vRecord = vScenario[s].vRecord;
+
+		/// reference: the same model in double
+		IntegrateDecimated<double, INTEGRATOR_EULER>(vRecord, 1, vRef);
+
+		SFixedState fixedState;
+		SEstimatorState floatState;
+
+		SBenchFixedCheck check;
+		check.scenario = vScenario[s].name;
+		check.records = (long long)vRecord.size();
+		check.maxPos = 0.;
+		check.maxQ = 0.;
+		check.maxPosFloat = 0.;
+		check.maxQFloat = 0.;
+
+		for (size_t i = 0; i < vRecord.size(); ++i)
+		{
+			const SRecord& r = vRecord[i];
+
+			FixedStep(fixedChassis, fixedState, r.time_ns, \
+				FixedRad2Bam(r.steering_angle), r.encoder_ticks);
+			const SPose pose = Step<SGeometryStandard>(floatState, r);
+			const SPose fixedPose = FixedGetPose(fixedState);
+
+			const SPoseD& ref = vRef[i];
+
+			check.maxPos = std::max(check.maxPos, std::max( \
+				fabs(fixedPose.x - ref.x), fabs(fixedPose.y - ref.y)));
+			check.maxQ = std::max(check.maxQ, \
+				fabs(AngleDiff(double(fixedPose.q), ref.q)));
+			check.maxPosFloat = std::max(check.maxPosFloat, std::max( \
+				fabs(pose.x - ref.x), fabs(pose.y - ref.y)));
+			check.maxQFloat = std::max(check.maxQFloat, \
+				fabs(AngleDiff(double(pose.q), ref.q)));
+		}
+
+		check.pass = check.maxPos <= BENCH_FIXED_MAX_POS && \
+			check.maxQ <= BENCH_FIXED_MAX_Q;
+		m_vFixedCheck.push_back(check);
+
+		std::cerr << "  FixedTricycle::Step " << check.scenario << ": max " \
+			<< check.maxPos << " m, " << check.maxQ << " rad" \
+			<< (check.pass ? "" : " FAILED") << " (float: " \
+			<< check.maxPosFloat << " m, " << check.maxQFloat << " rad)" \
+			<< std::endl;
+	}
+}
+
+///
+/// @brief		check whether a correctness check failed
+/// @param		N/A
+/// @return		true if an accuracy, a fixed-point, a journal, an index, a
+///				pose-graph, a golden or a record archive check failed
+///
+bool CTricycleBench::HasFailure() const
+{
+	for (size_t i = 0; i < m_vAccuracyCheck.size(); ++i)
+	{
+		if (!m_vAccuracyCheck[i].pass)
+			return true;
+	}
+
+	for (size_t i = 0; i < m_vFixedCheck.size(); ++i)
+	{
+		if (!m_vFixedCheck[i].pass)
+			return true;
+	}
+
+	for (size_t i = 0; i < m_vJournalCheck.size(); ++i)
+	{
+		if (!m_vJournalCheck[i].pass)
+			return true;
+	}
+
+	for (size_t i = 0; i < m_vIndexCheck.size(); ++i)
+	{
+		if (!m_vIndexCheck[i].pass)
+			return true;
+	}
+
+	for (size_t i = 0; i < m_vGraphCheck.size(); ++i)
+	{
+		if (!m_vGraphCheck[i].pass)
+			return true;
+	}
+
+	for (size_t i = 0; i < m_vGolden.size(); ++i)
+	{
+		if (!m_vGolden[i].pass)
+			return true;
+	}
+
+	for (size_t i = 0; i < m_vArchiveCheck.size(); ++i)
+	{
+		if (!m_vArchiveCheck[i].pass)
+			return true;
+	}
+
+	for (size_t i = 0; i < m_vRoundTrip.size(); ++i)
+	{
+		if (!m_vRoundTrip[i].pass)
+			return true;
+	}
+
+	return false;
+}
+
+///
+/// @brief		benchmark of CEstimatorJournal::Append() and of a late
+///				correction (Correct() and GetState())
+/// @param		N/A
+/// @return		void
+/// @remark		A correction goes to a record up to BENCH_JOURNAL_MAX_LAG
+///				records behind the last one, so its cost is the distance from
+///				the checkpoint before the corrected record to the end, not
+///				the length of the log.
+///
+void CTricycleBench::BenchJournal()
+{
+	CEstimatorJournal journal(CTricycle::GetChassisAt(0));
+	CEstimatorJournal* pJournal = &journal;
+	const SRecord* pRecord = &m_vRecord[0];
+	const size_t nRecords = m_vRecord.size();
+	volatile float& sink = m_fSink;
+
+	MeasureKernel("EstimatorJournal::Append", [=, &sink](const size_t i)
+	{
+		if (i == 0)
+			pJournal->Clear();
+		sink = pJournal->Append(pRecord[i]).x;
+	});
+
+	const size_t nMaxLag = std::min<size_t>(BENCH_JOURNAL_MAX_LAG, nRecords);
+	MeasureKernel("EstimatorJournal::Correct", [=, &sink](const size_t i)
+	{
+		const size_t nIndex = nRecords - 1 - (i * 7919) % nMaxLag;
+
+		SRecord record = pJournal->GetRecord(nIndex);
+		record.encoder_ticks ^= 1;
+		pJournal->Correct(nIndex, record);
+		sink = pJournal->GetState().pose.pose.x;
+	});
+}
+
+///
+/// @brief		check the poses of the journal after corrections against a
+///				full replay
+/// @param		N/A
+/// @return		void
+/// @remark		Every scenario is appended to a journal. After every
+///				BENCH_JOURNAL_PERIOD records, a record up to
+///				BENCH_JOURNAL_MAX_LAG records behind gets another tick count
+///				(as a late correction of a logger). A scenario passes if every
+///				pose equals (bit for bit) the one of Step() over the corrected
+///				records.
+///
+void CTricycleBench::CheckJournal()
+{
+	std::vector<SBenchScenario> vScenario;
+	MakeScenarios(vScenario);
+
+	for (size_t s = 0; s < vScenario.size(); ++s)
+	{
+		std::vector<SRecord>& vRecord = vScenario[s].vRecord;
+
+		SBenchJournalCheck check;
+		check.scenario = vScenario[s].name;
+		check.records = (long long)vRecord.size();
+		check.corrections = 0;
+		check.pass = true;
+
+		/// records with late corrections
+		CEstimatorJournal journal(CTricycle::GetChassisAt(0));
+		for (size_t i = 0; i < vRecord.size(); ++i)
+		{
+			journal.Append(vRecord[i]);
+			if (i % BENCH_JOURNAL_PERIOD != BENCH_JOURNAL_PERIOD - 1)
+				continue;
+
+			const size_t nLag = (size_t(check.corrections) * 7919) % \
+				std::min<size_t>(BENCH_JOURNAL_MAX_LAG, i + 1);
+			SRecord& record = vRecord[i - nLag];
+			record.encoder_ticks += (check.corrections % 2) ? 1 : -1;
+			journal.Correct(i - nLag, record);
+			++check.corrections;
+		}
+
+		/// full replay of the corrected records
+		SEstimatorState state;
+		for (size_t i = 0; i < vRecord.size(); ++i)
+		{
+			const SPose ref = Step(CTricycle::GetChassisAt(0), \
+				INTEGRATOR_EULER, state, vRecord[i]);
+
+			SPose pose;
+			journal.GetPose(i, pose);
+			if (pose.x != ref.x || pose.y != ref.y || pose.q != ref.q)
+				check.pass = false;
+		}
+		check.reestimated = journal.GetReestimatedCount();
+
+		m_vJournalCheck.push_back(check);
+
+		std::cerr << "  EstimatorJournal " << check.scenario << ": " \
+			<< check.corrections << " corrections, " << check.reestimated \
+			<< " records estimated again (" << check.records \
+			<< " records)" << (check.pass ? "" : " FAILED") << std::endl;
+	}
+}
+
+///
+/// @brief		check whether a point is inside a polygon (winding number)
+/// @param		vVertex [in] vertices of the polygon
+/// @param		x, y [in] point (m)
+/// @return		true if inside
+/// @remark		reference of the index check, independent of the even-odd
+///				test of CTrajectoryIndex
+///
+static bool IsInsidePolygon(const std::vector<SPos>& vVertex, const double x, \
+	const double y)
+{
+	int nWinding = 0;
+
+	for (size_t i = 0; i < vVertex.size(); ++i)
+	{
+		const SPos& a = vVertex[i];
+		const SPos& b = vVertex[(i + 1) % vVertex.size()];
+		const double dCross = (double(b.x) - a.x) * (y - a.y) - \
+			(x - a.x) * (double(b.y) - a.y);
+
+		if (a.y <= y && b.y > y && dCross > 0.)
+			++nWinding;
+		else if (a.y > y && b.y <= y && dCross < 0.)
+			--nWinding;
+	}
+
+	return nWinding != 0;
+}
+
+///
+/// @brief		check the intervals of a query against a brute-force
+///				reference
+/// @param		vSample [in] samples of the trajectory (no break)
+/// @param		x0, y0, x1, y1 [in] bounding box of the query region (m)
+/// @param		inside [in] callable: whether a point (x, y) is in the region
+/// @param		vInterval [in] intervals of the query
+/// @return		number of disagreements
+/// @remark		The intervals must be sorted and disjoint. Every segment
+///				whose bounding box meets the region is sampled at
+///				BENCH_INDEX_STEPS + 1 parameters; the robot point and the
+///				three wheels move linearly, and a time is in the query if
+///				one of them is in the region. Times within
+///				BENCH_INDEX_TIME_EPS of an interval boundary are skipped.
+///
+template<typename F>
+static int CheckIntervals(const std::vector<STrajectorySample>& vSample, \
+	const double x0, const double y0, const double x1, const double y1, \
+	F inside, const std::vector<STimeInterval>& vInterval)
+{
+	int nErrors = 0;
+
+	for (size_t n = 1; n < vInterval.size(); ++n)
+	{
+		if (!(vInterval[n].begin > vInterval[n - 1].end))
+			++nErrors;
+	}
+
+	for (size_t i = 0; i < vSample.size(); ++i)
+	{
+		const STrajectorySample& a = vSample[i];
+		const STrajectorySample& b = vSample[std::min(i + 1, \
+			vSample.size() - 1)];
+		const SPos pa[4] = { SPos(a.pose.x, a.pose.y), a.posFW, a.posLW, \
+			a.posRW };
+		const SPos pb[4] = { SPos(b.pose.x, b.pose.y), b.posFW, b.posLW, \
+			b.posRW };
+
+		/// segments away from the region
+		//@{
+		double bx0 = 1e300, by0 = 1e300, bx1 = -1e300, by1 = -1e300;
+		for (int k = 0; k < 4; ++k)
+		{
+			bx0 = std::min(bx0, double(std::min(pa[k].x, pb[k].x)));
+			by0 = std::min(by0, double(std::min(pa[k].y, pb[k].y)));
+			bx1 = std::max(bx1, double(std::max(pa[k].x, pb[k].x)));
+			by1 = std::max(by1, double(std::max(pa[k].y, pb[k].y)));
+		}
+		if (bx1 < x0 || by1 < y0 || bx0 > x1 || by0 > y1)
+			continue;
+		//@}
+
+		for (int m = 0; m <= BENCH_INDEX_STEPS; ++m)
+		{
+			const double s = double(m) / BENCH_INDEX_STEPS;
+			const double t = a.time + s * (b.time - a.time);
+
+			bool bReference = false;
+			for (int k = 0; k < 4 && !bReference; ++k)
+				bReference = inside(pa[k].x + s * (double(pb[k].x) - pa[k].x), \
+					pa[k].y + s * (double(pb[k].y) - pa[k].y));
+
+			bool bQuery = false, bBoundary = false;
+			for (size_t n = 0; n < vInterval.size(); ++n)
+			{
+				const STimeInterval& v = vInterval[n];
+				if (fabs(t - v.begin) < BENCH_INDEX_TIME_EPS || \
+					fabs(t - v.end) < BENCH_INDEX_TIME_EPS)
+					bBoundary = true;
+				if (t >= v.begin && t <= v.end)
+					bQuery = true;
+			}
+
+			if (!bBoundary && bReference != bQuery)
+				++nErrors;
+		}
+	}
+
+	return nErrors;
+}
+
+///
+/// @brief		check whether intervals are the expected ones
+/// @param		vInterval [in] intervals of a query
+/// @param		pExpected [in] begin and end of each expected interval
+/// @param		nExpected [in] number of expected intervals
+/// @return		true if they are (within BENCH_INDEX_TIME_EPS)
+///
+static bool IsExpected(const std::vector<STimeInterval>& vInterval, \
+	const double (*pExpected)[2], const size_t nExpected)
+{
+	if (vInterval.size() != nExpected)
+		return false;
+
+	for (size_t n = 0; n < nExpected; ++n)
+	{
+		if (fabs(vInterval[n].begin - pExpected[n][0]) > BENCH_INDEX_TIME_EPS || \
+			fabs(vInterval[n].end - pExpected[n][1]) > BENCH_INDEX_TIME_EPS)
+			return false;
+	}
+
+	return true;
+}
+
+///
+/// @brief		benchmark of the trajectory index (parallel build and radius
+///				query) and check of the queries against a scan
+/// @param		N/A
+/// @return		void
+/// @remark		The samples are the poses and contours of the synthetic
+///				records. A query is centered on a sample, so it always finds
+///				intervals; its time is reported per query. The check builds a
+///				second index of a single cell (every query scans all
+///				segments) and compares the intervals of radius, triangle and
+///				U (concave) queries, which must be identical, and checks
+///				them against a brute-force reference (CheckIntervals()). Two
+///				straight trajectories check a U crossed twice ([1, 2] and
+///				[8, 9] s) and a point passed by the robot and by its front
+///				wheel at different times.
+///
+void CTricycleBench::BenchTrajectoryIndex()
+{
+	const STricycleChassis& chassis = CTricycle::GetChassisAt(0);
+	const long long nRecords = (long long)(m_vRecord.size());
+
+	/// samples of the synthetic records
+	//@{
+	std::vector<STrajectorySample> vSample(m_vRecord.size());
+	SEstimatorState state;
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+	{
+		STrajectorySample& sample = vSample[i];
+		sample.time = Ns2Sec(m_vRecord[i].time_ns);
+		sample.pose = Step(chassis, INTEGRATOR_EULER, state, m_vRecord[i]);
+		chassis.pfnGetRobotContour(sample.pose, sample.posFW, sample.posLW, \
+			sample.posRW);
+		sample.flags = 0;
+	}
+	//@}
+
+	/// build (3..BENCH_MIN_SAMPLES repetitions, about 1e7 samples in total)
+	//@{
+	const long long nRepeat = std::max<long long>(3, \
+		std::min<long long>(BENCH_MIN_SAMPLES, 10000000LL / nRecords));
+
+	CTrajectoryIndexWriter writer;
+	std::vector<double> vSamples;
+	double dTotalNs = 0.;
+	for (long long n = 0; n < nRepeat; ++n)
+	{
+		BenchClock::time_point t0 = BenchClock::now();
+		writer.Build(vSample);
+		BenchClock::time_point t1 = BenchClock::now();
+
+		const double dNs = ElapsedNs(t0, t1);
+		dTotalNs += dNs;
+		vSamples.push_back(dNs / double(nRecords));
+	}
+	AddResult("TrajectoryIndex::Build", vSamples, dTotalNs * 1e-9, \
+		nRecords * nRepeat);
+	//@}
+
+	CTrajectoryIndex index;
+	if (index.Attach(&writer.GetImage()[0], writer.GetImage().size()) != 0)
+	{
+		std::cerr << "Cannot attach the trajectory index" << std::endl;
+		return;
+	}
+
+	/// radius queries around the samples
+	//@{
+	const CTrajectoryIndex* pIndex = &index;
+	const STrajectorySample* pSample = &vSample[0];
+	const size_t nSamples = vSample.size();
+	volatile float& sink = m_fSink;
+	MeasureKernel("TrajectoryIndex::QueryRadius", [=, &sink](const size_t i)
+	{
+		const SPose& pose = pSample[(i * 7919) % nSamples].pose;
+
+		std::vector<STimeInterval> vInterval;
+		pIndex->QueryRadius(pose.x, pose.y, BENCH_INDEX_RADIUS, vInterval);
+		sink = float(vInterval.size());
+	});
+	//@}
+
+	/// check against a single cell (scan of all segments) and against a
+	/// brute-force reference
+	//@{
+	CTrajectoryIndexWriter scanWriter;
+	CTrajectoryIndex scan;
+	scanWriter.Build(vSample, 1e9);
+	scan.Attach(&scanWriter.GetImage()[0], scanWriter.GetImage().size());
+
+	SBenchIndexCheck check;
+	check.records = nRecords;
+	check.queries = 3 * BENCH_INDEX_CHECKS + 2;
+	check.mismatches = 0;
+
+	std::vector<STimeInterval> vIndexed, vScanned;
+	for (int q = 0; q < BENCH_INDEX_CHECKS; ++q)
+	{
+		const SPose& pose = vSample[(size_t(q) * 7919) % nSamples].pose;
+		const float r = float(BENCH_INDEX_RADIUS);
+
+		index.QueryRadius(pose.x, pose.y, r, vIndexed);
+		scan.QueryRadius(pose.x, pose.y, r, vScanned);
+		if (vIndexed.size() != vScanned.size() || (!vIndexed.empty() && \
+			memcmp(&vIndexed[0], &vScanned[0], \
+				vIndexed.size() * sizeof(STimeInterval))) || \
+			CheckIntervals(vSample, pose.x - r, pose.y - r, pose.x + r, \
+				pose.y + r, [&](const double x, const double y)
+				{ return (x - pose.x) * (x - pose.x) + \
+					(y - pose.y) * (y - pose.y) <= double(r) * r; }, \
+				vIndexed) != 0)
+			++check.mismatches;
+
+		/// a triangle and a U (concave) around the sample
+		std::vector<SPos> vPolygon[2];
+		vPolygon[0].push_back(SPos(pose.x - r, pose.y - r));
+		vPolygon[0].push_back(SPos(pose.x + 2.f * r, pose.y));
+		vPolygon[0].push_back(SPos(pose.x, pose.y + r));
+
+		const float u[8][2] = { { -2.f, -2.f }, { 2.f, -2.f }, { 2.f, 2.f }, \
+			{ 0.5f, 2.f }, { 0.5f, -1.f }, { -0.5f, -1.f }, { -0.5f, 2.f }, \
+			{ -2.f, 2.f } };
+		for (int v = 0; v < 8; ++v)
+			vPolygon[1].push_back(SPos(pose.x + u[v][0] * r, \
+				pose.y + u[v][1] * r));
+
+		for (int p = 0; p < 2; ++p)
+		{
+			const std::vector<SPos>& vVertex = vPolygon[p];
+			const float fExtent = 2.f * r;
+
+			index.QueryPolygon(vVertex, vIndexed);
+			scan.QueryPolygon(vVertex, vScanned);
+			if (vIndexed.size() != vScanned.size() || (!vIndexed.empty() && \
+				memcmp(&vIndexed[0], &vScanned[0], \
+					vIndexed.size() * sizeof(STimeInterval))) || \
+				CheckIntervals(vSample, pose.x - fExtent, pose.y - fExtent, \
+					pose.x + fExtent, pose.y + fExtent, \
+					[&](const double x, const double y)
+					{ return IsInsidePolygon(vVertex, x, y); }, \
+					vIndexed) != 0)
+				++check.mismatches;
+		}
+	}
+
+	/// a robot crossing both arms of a U, and a robot and its front wheel
+	/// (6 m ahead) passing a point at different times (robot along x at
+	/// 1 m/s from the origin)
+	//@{
+	std::vector<STrajectorySample> vLine[2];
+	for (int c = 0; c < 2; ++c)
+	{
+		vLine[c].resize(2);
+		for (int n = 0; n < 2; ++n)
+		{
+			STrajectorySample& sample = vLine[c][n];
+			sample.time = 10. * n;
+			sample.pose = SPose(10.f * n, 0.f, 0.f);
+			sample.posFW = SPos(10.f * n + ((c == 0) ? 0.f : 6.f), 0.f);
+			sample.posLW = SPos(10.f * n, (c == 0) ? 0.f : 100.f);
+			sample.posRW = SPos(10.f * n, (c == 0) ? 0.f : 100.f);
+			sample.flags = 0;
+		}
+	}
+
+	CTrajectoryIndexWriter lineWriter[2];
+	CTrajectoryIndex line[2];
+	for (int c = 0; c < 2; ++c)
+	{
+		lineWriter[c].Build(vLine[c]);
+		line[c].Attach(&lineWriter[c].GetImage()[0], \
+			lineWriter[c].GetImage().size());
+	}
+
+	const float uLine[8][2] = { { 1.f, -3.f }, { 9.f, -3.f }, { 9.f, 1.f }, \
+		{ 8.f, 1.f }, { 8.f, -2.f }, { 2.f, -2.f }, { 2.f, 1.f }, \
+		{ 1.f, 1.f } };
+	std::vector<SPos> vU;
+	for (int v = 0; v < 8; ++v)
+		vU.push_back(SPos(uLine[v][0], uLine[v][1]));
+
+	const double dInside[2][2] = { { 1., 2. }, { 8., 9. } };
+	const double dNear[2][2] = { { 0.5, 1.5 }, { 6.5, 7.5 } };
+
+	line[0].QueryPolygon(vU, vIndexed);
+	if (!IsExpected(vIndexed, dInside, 2))
+		++check.mismatches;
+	line[1].QueryRadius(7., 0., 0.5, vIndexed);
+	if (!IsExpected(vIndexed, dNear, 2))
+		++check.mismatches;
+	//@}
+
+	check.pass = (check.mismatches == 0);
+	m_vIndexCheck.push_back(check);
+
+	std::cerr << "  TrajectoryIndex: " << writer.GetImage().size() \
+		<< " bytes, " << check.mismatches << " of " << check.queries \
+		<< " queries differ from a scan or the reference" \
+		<< (check.pass ? "" : " FAILED") << std::endl;
+	//@}
+}
+
+///
+/// @brief		get the pose of b in the frame of a
+/// @param		a [in] reference pose (x, y, heading)
+/// @param		b [in] pose (x, y, heading)
+/// @return		relative pose (x, y, heading)
+///
+static SPoseD Between(const SPoseD& a, const SPoseD& b)
+{
+	const double c = cos(a.q);
+	const double s = sin(a.q);
+	const double dx = b.x - a.x;
+	const double dy = b.y - a.y;
+
+	return SPoseD(c * dx + s * dy, -s * dx + c * dy, \
+		AngleClamp<double>(b.q - a.q));
+}
+
+///
+/// @brief		move a pose by a relative pose
+/// @param		a [in] pose (x, y, heading)
+/// @param		z [in] relative pose in the frame of a (x, y, heading)
+/// @return		moved pose (x, y, heading)
+///
+static SPoseD Compose(const SPoseD& a, const SPoseD& z)
+{
+	const double c = cos(a.q);
+	const double s = sin(a.q);
+
+	return SPoseD(a.x + c * z.x - s * z.y, a.y + s * z.x + c * z.y, \
+		AngleClamp<double>(a.q + z.q));
+}
+
+///
+/// @brief		add nodes and edges to the graph of the pose-graph benchmark
+/// @param		graph [in,out] pose graph
+/// @param		vOdometry [in] drifting odometry poses
+/// @param		vTruth [in] true poses
+/// @param		nBegin [in] first node to add
+/// @param		nEnd [in] node after the last one to add
+/// @return		void
+/// @remark		Odometry edges (1 mm, 0.5 mrad), a loop closure of
+///				BENCH_GRAPH_LOOP_SPAN nodes every BENCH_GRAPH_LOOP_PERIOD
+///				nodes (1 cm, 5 mrad) and an absolute fix every
+///				BENCH_GRAPH_FIX_PERIOD nodes from node 0 (5 cm, 10 mrad).
+///
+static void AddGraphNodes(CPoseGraph& graph, \
+	const std::vector<SPoseD>& vOdometry, const std::vector<SPoseD>& vTruth, \
+	const size_t nBegin, const size_t nEnd)
+{
+	for (size_t i = nBegin; i < nEnd; ++i)
+	{
+		graph.AddOdometry(vOdometry[i ? i - 1 : 0], vOdometry[i], 1e-3, 5e-4);
+
+		if (i % BENCH_GRAPH_LOOP_PERIOD == 0 && i >= BENCH_GRAPH_LOOP_SPAN)
+		{
+			const size_t j = i - BENCH_GRAPH_LOOP_SPAN;
+			graph.AddRelative(j, i, Between(vTruth[j], vTruth[i]), 1e-2, 5e-3);
+		}
+
+		if (i % BENCH_GRAPH_FIX_PERIOD == 0)
+			graph.AddAbsolute(i, vTruth[i], 5e-2, 1e-2);
+	}
+}
+
+///
+/// @brief		root mean square position error of the graph estimate
+/// @param		graph [in] pose graph
+/// @param		vTruth [in] true poses
+/// @return		RMS error (unit: m)
+///
+static double GraphRms(const CPoseGraph& graph, \
+	const std::vector<SPoseD>& vTruth)
+{
+	double dSum = 0.;
+	for (size_t i = 0; i < graph.GetCount(); ++i)
+	{
+		const SPoseD& pose = graph.GetPose(i);
+		const double dx = pose.x - vTruth[i].x;
+		const double dy = pose.y - vTruth[i].y;
+		dSum += dx * dx + dy * dy;
+	}
+
+	return graph.GetCount() ? sqrt(dSum / double(graph.GetCount())) : 0.;
+}
+
+///
+/// @brief		benchmark of the pose-graph optimizer (batch and incremental)
+///				and check of the drift it removes
+/// @param		N/A
+/// @return		void
+/// @remark		The true trajectory is the one of the synthetic records; the
+///				odometry has a scale error (BENCH_GRAPH_SCALE) and a heading
+///				bias (BENCH_GRAPH_BIAS), so it drifts. Optimize() is timed
+///				from the odometry per node; Update() is timed per node after
+///				every BENCH_GRAPH_BATCH new nodes. The check passes if
+///				Optimize() converges, neither estimate is worse than the
+///				odometry, and the incremental graph relinearized by
+///				Optimize() reaches the batch optimum within
+///				BENCH_GRAPH_MAX_DIFF.
+///
+void CTricycleBench::BenchPoseGraph()
+{
+	const STricycleChassis& chassis = CTricycle::GetChassisAt(0);
+	const size_t nRecords = m_vRecord.size();
+
+	/// true poses and drifting odometry
+	//@{
+	std::vector<SPoseD> vTruth(nRecords);
+	std::vector<SPoseD> vOdometry(nRecords);
+	SEstimatorState state;
+	for (size_t i = 0; i < nRecords; ++i)
+	{
+		const SPose pose = Step(chassis, INTEGRATOR_EULER, state, \
+			m_vRecord[i]);
+		vTruth[i] = SPoseD(pose.x, pose.y, pose.q);
+		if (i == 0)
+		{
+			vOdometry[i] = vTruth[i];
+			continue;
+		}
+
+		SPoseD z = Between(vTruth[i - 1], vTruth[i]);
+		z.x *= BENCH_GRAPH_SCALE;
+		z.y *= BENCH_GRAPH_SCALE;
+		z.q += BENCH_GRAPH_BIAS;
+		vOdometry[i] = Compose(vOdometry[i - 1], z);
+	}
+	//@}
+
+	SBenchGraphCheck check;
+	check.records = (long long)nRecords;
+	check.rmsOdometry = 0.;
+	for (size_t i = 0; i < nRecords; ++i)
+	{
+		const double dx = vOdometry[i].x - vTruth[i].x;
+		const double dy = vOdometry[i].y - vTruth[i].y;
+		check.rmsOdometry += dx * dx + dy * dy;
+	}
+	check.rmsOdometry = sqrt(check.rmsOdometry / double(nRecords));
+
+	/// batch (1..BENCH_MIN_SAMPLES repetitions, about 1e6 nodes in total)
+	//@{
+	const long long nRepeat = std::max<long long>(1, \
+		std::min<long long>(BENCH_MIN_SAMPLES, \
+			1000000LL / (long long)nRecords));
+
+	CPoseGraph graph;
+	std::vector<double> vSamples;
+	double dTotalNs = 0.;
+	for (long long n = 0; n < nRepeat; ++n)
+	{
+		graph.Clear();
+		AddGraphNodes(graph, vOdometry, vTruth, 0, nRecords);
+
+		BenchClock::time_point t0 = BenchClock::now();
+		check.iterations = graph.Optimize();
+		BenchClock::time_point t1 = BenchClock::now();
+
+		const double dNs = ElapsedNs(t0, t1);
+		dTotalNs += dNs;
+		check.seconds = dNs * 1e-9;
+		vSamples.push_back(dNs / double(nRecords));
+	}
+	AddResult("PoseGraph::Optimize", vSamples, dTotalNs * 1e-9, \
+		(long long)nRecords * nRepeat);
+	check.rmsOptimized = GraphRms(graph, vTruth);
+	//@}
+
+	/// incremental (an Update() after every BENCH_GRAPH_BATCH nodes)
+	//@{
+	CPoseGraph incremental;
+	int nFailed = 0;
+	vSamples.clear();
+	dTotalNs = 0.;
+	for (size_t nBegin = 0; nBegin < nRecords; nBegin += BENCH_GRAPH_BATCH)
+	{
+		const size_t nEnd = std::min<size_t>(nRecords, \
+			nBegin + BENCH_GRAPH_BATCH);
+		AddGraphNodes(incremental, vOdometry, vTruth, nBegin, nEnd);
+
+		BenchClock::time_point t0 = BenchClock::now();
+		if (incremental.Update() < 0)
+			++nFailed;
+		BenchClock::time_point t1 = BenchClock::now();
+
+		const double dNs = ElapsedNs(t0, t1);
+		dTotalNs += dNs;
+		vSamples.push_back(dNs / double(nEnd - nBegin));
+	}
+	AddResult("PoseGraph::Update", vSamples, dTotalNs * 1e-9, \
+		(long long)nRecords);
+	check.rmsIncremental = GraphRms(incremental, vTruth);
+	//@}
+
+	/// the relinearized incremental graph reaches the batch optimum
+	//@{
+	if (incremental.Optimize() < 0)
+		++nFailed;
+
+	check.maxDiff = 0.;
+	for (size_t i = 0; i < nRecords; ++i)
+	{
+		const SPoseD& a = graph.GetPose(i);
+		const SPoseD& b = incremental.GetPose(i);
+		check.maxDiff = std::max(check.maxDiff, \
+			sqrt((a.x - b.x) * (a.x - b.x) + (a.y - b.y) * (a.y - b.y)));
+	}
+
+	check.pass = nFailed == 0 && check.iterations > 0 && \
+		check.iterations < POSE_GRAPH_MAX_ITERATIONS && \
+		check.rmsOptimized <= check.rmsOdometry + 1e-9 && \
+		check.rmsIncremental <= check.rmsOdometry + 1e-9 && \
+		check.maxDiff <= BENCH_GRAPH_MAX_DIFF;
+	m_vGraphCheck.push_back(check);
+
+	std::cerr << "  PoseGraph: " << check.iterations << " iterations in " \
+		<< check.seconds << " s, RMS " << check.rmsOdometry << " m (odometry)" \
+		<< ", " << check.rmsOptimized << " m (optimized), " \
+		<< check.rmsIncremental << " m (incremental), " << check.maxDiff \
+		<< " m apart" << (check.pass ? "" : " FAILED") << std::endl;
+	//@}
+}
+
+///
+/// @brief		read the golden output of a scenario
+/// @param		sPose [in] NN_pose.txt
+/// @param		sContour [in] NN_contour.txt
+/// @param		vGolden [out] time, pose and contour of each line
+/// @return		0 on success, -1 if a file is missing or the files differ
+///				in length
+///
+static int ReadGolden(const std::string& sPose, const std::string& sContour, \
+	std::vector<SPoseLogRecord>& vGolden)
+{
+	vGolden.clear();
+
+	CMappedFile filePose, fileContour;
+	if (filePose.Open(sPose) != 0 || fileContour.Open(sContour) != 0)
+		return -1;
+
+	/// NN_pose.txt: time, x, y, q per line
+	//@{
+	std::string sText(filePose.GetData(), filePose.GetSize());
+	for (size_t nPos = 0; nPos < sText.size(); )
+	{
+		size_t nEnd = sText.find('\n', nPos);
+		if (nEnd == std::string::npos)
+			nEnd = sText.size();
+		const std::string sLine = sText.substr(nPos, nEnd - nPos);
+		nPos = nEnd + 1;
+
+		SPoseLogRecord record;
+		if (sLine.empty() || sLine[0] == '#' || sscanf(sLine.c_str(), \
+			"%lf %f %f %f", &record.time, &record.pose.x, &record.pose.y, \
+			&record.pose.q) != 4)
+			continue;
+		vGolden.push_back(record);
+	}
+	//@}
+
+	/// NN_contour.txt: blocks of robot, LW, FW, RW, robot (x, y per line)
+	//@{
+	sText.assign(fileContour.GetData(), fileContour.GetSize());
+	size_t nPoint = 0;
+	for (size_t nPos = 0; nPos < sText.size(); )
+	{
+		size_t nEnd = sText.find('\n', nPos);
+		if (nEnd == std::string::npos)
+			nEnd = sText.size();
+		const std::string sLine = sText.substr(nPos, nEnd - nPos);
+		nPos = nEnd + 1;
+
+		SPos pos;
+		if (sLine.empty() || sLine[0] == '#' || \
+			sscanf(sLine.c_str(), "%f %f", &pos.x, &pos.y) != 2)
+			continue;
+
+		const size_t nRecord = nPoint / BENCH_GOLDEN_CONTOUR;
+		if (nRecord >= vGolden.size())
+			return -1;
+
+		SPoseLogRecord& record = vGolden[nRecord];
+		switch (nPoint % BENCH_GOLDEN_CONTOUR)
+		{
+		case 1: record.posLW = pos; break;
+		case 2: record.posFW = pos; break;
+		case 3: record.posRW = pos; break;
+		default: break;
+		}
+		++nPoint;
+	}
+	//@}
+
+	return (nPoint == vGolden.size() * BENCH_GOLDEN_CONTOUR) ? 0 : -1;
+}
+
+///
+/// @brief		replay a scenario through an estimator mode
+/// @param		nMode [in] estimator mode (EBenchGoldenMode)
+/// @param		vRecord [in] input records
+/// @param		vOut [out] initial pose and the pose after each record, with
+///				their contours (as written to NN_pose.txt and NN_contour.txt)
+/// @return		void
+/// @remark		every mode starts from the origin at time 0
+///
+static void ReplayGolden(const int nMode, const std::vector<SRecord>& vRecord, \
+	std::vector<SPoseLogRecord>& vOut)
+{
+	const STricycleChassis& chassis = CTricycle::GetChassisAt(0);
+	const size_t nRecords = vRecord.size();
+
+	vOut.resize(nRecords + 1);
+	vOut[0].time = 0.;
+	vOut[0].pose = SPose();
+	for (size_t i = 0; i < nRecords; ++i)
+		vOut[i + 1].time = Ns2Sec(vRecord[i].time_ns);
+
+	switch (nMode)
+	{
+	case GOLDEN_ESTIMATE:
+	{
+		CTricycle* pTricycle = CTricycle::GetInstance();
+		CVirtualGyro* pGyro = CVirtualGyro::GetInstance();
+		pTricycle->SetState(SEstimatorState());
+		pGyro->SetState(SGyroState());
+		for (size_t i = 0; i < nRecords; ++i)
+		{
+			const SRecord& r = vRecord[i];
+			pGyro->UpdateNs(r.time_ns, r.steering_angle, r.encoder_ticks);
+			vOut[i + 1].pose = pTricycle->EstimateNs(r.time_ns, \
+				r.steering_angle, r.encoder_ticks, pGyro->GetAngVel());
+		}
+		break;
+	}
+	case GOLDEN_STEP:
+	{
+		SEstimatorState state;
+		for (size_t i = 0; i < nRecords; ++i)
+			vOut[i + 1].pose = Step(chassis, INTEGRATOR_EULER, state, \
+				vRecord[i]);
+		break;
+	}
+	case GOLDEN_STEP_STANDARD:
+	{
+		SEstimatorState state;
+		for (size_t i = 0; i < nRecords; ++i)
+			vOut[i + 1].pose = Step<SGeometryStandard>(state, vRecord[i]);
+		break;
+	}
+	case GOLDEN_JOURNAL:
+	{
+		CEstimatorJournal journal(chassis);
+		for (size_t i = 0; i < nRecords; ++i)
+			vOut[i + 1].pose = journal.Append(vRecord[i]);
+		break;
+	}
+	case GOLDEN_PARALLEL:
+	{
+		std::vector<SPose> vPose(nRecords);
+		CParallelReplay replay;
+		if (nRecords)
+			replay.Run(&vRecord[0], nRecords, &vPose[0]);
+		for (size_t i = 0; i < nRecords; ++i)
+			vOut[i + 1].pose = vPose[i];
+		break;
+	}
+	case GOLDEN_FLEET:
+	{
+		CFleetTricycle fleet(1);
+		for (size_t i = 0; i < nRecords; ++i)
+		{
+			const SRecord& r = vRecord[i];
+			fleet.Estimate(&r.time_ns, &r.steering_angle, &r.encoder_ticks);
+			fleet.GetRobotPose(0, vOut[i + 1].pose);
+		}
+		break;
+	}
+	case GOLDEN_FIXED:
+	{
+		const SFixedChassis fixedChassis = MakeFixedChassis( \
+			chassis.fFrontDistPerTick, chassis.fDistBtwFrontRear);
+		SFixedState state;
+		for (size_t i = 0; i < nRecords; ++i)
+		{
+			const SRecord& r = vRecord[i];
+			FixedStep(fixedChassis, state, r.time_ns, \
+				FixedRad2Bam(r.steering_angle), r.encoder_ticks);
+			vOut[i + 1].pose = FixedGetPose(state);
+		}
+		break;
+	}
+	case GOLDEN_EKF:
+	case GOLDEN_EKF_GYRO:
+	{
+		/// the gyro, if any, reads the rate of the steering kinematics
+		CEkfTricycle ekf;
+		ekf.SetGyroInput(nMode == GOLDEN_EKF_GYRO);
+		SGyroState gyro;
+		for (size_t i = 0; i < nRecords; ++i)
+		{
+			const SRecord& r = vRecord[i];
+			GyroStep(gyro, chassis.fFrontDistPerTick, \
+				chassis.fDistBtwFrontRear, r.time_ns, r.steering_angle, \
+				r.encoder_ticks);
+			vOut[i + 1].pose = ekf.EstimateNs(r.time_ns, r.steering_angle, \
+				r.encoder_ticks, gyro.fAngVel);
+		}
+		break;
+	}
+	default:
+		break;
+	}
+
+	for (size_t i = 0; i <= nRecords; ++i)
+		chassis.pfnGetRobotContour(vOut[i].pose, vOut[i].posFW, \
+			vOut[i].posLW, vOut[i].posRW);
+}
+
+///
+/// @brief		compare poses with the golden output of a scenario
+/// @param		vOut [in] time, pose and contour of each line
+/// @param		vGolden [in] golden output (ReadGolden())
+/// @param		mode [in] tolerances
+/// @param		golden [out] largest deviations, number of lines outside the
+///				tolerances (a missing or extra line included) and result
+/// @return		void
+///
+static void CompareGolden(const std::vector<SPoseLogRecord>& vOut, \
+	const std::vector<SPoseLogRecord>& vGolden, const SBenchGoldenMode& mode, \
+	SBenchGolden& golden)
+{
+	const size_t nLines = std::min(vOut.size(), vGolden.size());
+
+	golden.maxTime = 0.;
+	golden.maxPos = 0.;
+	golden.maxQ = 0.;
+	golden.maxContour = 0.;
+	golden.mismatches = int(std::max(vOut.size(), vGolden.size()) - nLines);
+
+	for (size_t i = 0; i < nLines; ++i)
+	{
+		const SPoseLogRecord& a = vOut[i];
+		const SPoseLogRecord& b = vGolden[i];
+		const SPos p[3] = { a.posLW, a.posFW, a.posRW };
+		const SPos q[3] = { b.posLW, b.posFW, b.posRW };
+
+		const double dTime = fabs(a.time - b.time);
+		const double dPos = double(std::max(fabsf(a.pose.x - b.pose.x), \
+			fabsf(a.pose.y - b.pose.y)));
+		const double dQ = double(fabsf(AngleDiff(a.pose.q, b.pose.q)));
+		double dContour = 0.;
+		for (int k = 0; k < 3; ++k)
+			dContour = std::max(dContour, double(std::max( \
+				fabsf(p[k].x - q[k].x), fabsf(p[k].y - q[k].y))));
+
+		golden.maxTime = std::max(golden.maxTime, dTime);
+		golden.maxPos = std::max(golden.maxPos, dPos);
+		golden.maxQ = std::max(golden.maxQ, dQ);
+		golden.maxContour = std::max(golden.maxContour, dContour);
+		if (dTime > mode.time || dPos > mode.position || \
+			dQ > mode.heading || dContour > mode.contour)
+			++golden.mismatches;
+	}
+
+	golden.pass = (golden.mismatches == 0);
+}
+
+///
+/// @brief		check every estimator mode against the golden output of the
+///				scenarios of --scenarios and measure its throughput
+/// @param		N/A
+/// @return		void
+/// @remark		A scenario is NN_input.csv with NN_pose.txt and
+///				NN_contour.txt (written by the original program). Each mode
+///				replays it from the origin; a mode passes if the time, the
+///				pose and the contour of every line are within the
+///				tolerances of the mode (s_goldenMode). The throughput is
+///				measured over BENCH_GOLDEN_RECORDS replayed records, with
+///				the contours.
+///
+void CTricycleBench::CheckGolden()
+{
+	if (m_sScenarioDir.empty())
+	{
+		std::cerr << "  no golden files (--scenarios)" << std::endl;
+		return;
+	}
+
+	std::vector<SBenchScenario> vScenario;
+	MakeScenarios(vScenario);
+
+	std::vector<SPoseLogRecord> vGolden, vOut;
+	for (size_t s = 0; s < vScenario.size(); ++s)
+	{
+		/// NN_input.csv -> NN_pose.txt, NN_contour.txt
+		const std::string& sName = vScenario[s].name;
+		const size_t nSuffix = sName.rfind("_input.csv");
+		if (nSuffix == std::string::npos)
+			continue;
+
+		const std::string sPrefix = m_sScenarioDir + "/" + \
+			sName.substr(0, nSuffix);
+		if (ReadGolden(sPrefix + "_pose.txt", sPrefix + "_contour.txt", \
+			vGolden) != 0)
+		{
+			std::cerr << "  " << sName << ": no golden output" << std::endl;
+			continue;
+		}
+
+		const std::vector<SRecord>& vRecord = vScenario[s].vRecord;
+		for (int nMode = 0; nMode < GOLDEN_MODE_COUNT; ++nMode)
+		{
+			const SBenchGoldenMode& mode = s_goldenMode[nMode];
+
+			SBenchGolden golden;
+			golden.mode = mode.szName;
+			golden.scenario = sName;
+			golden.records = (long long)vRecord.size();
+
+			/// replays (the first one is checked)
+			//@{
+			const long long nRepeat = std::max<long long>(1, \
+				BENCH_GOLDEN_RECORDS / std::max<long long>(1, golden.records));
+			BenchClock::time_point t0 = BenchClock::now();
+			for (long long n = 0; n < nRepeat; ++n)
+				ReplayGolden(nMode, vRecord, vOut);
+			BenchClock::time_point t1 = BenchClock::now();
+			const double dSeconds = ElapsedNs(t0, t1) * 1e-9;
+			golden.throughput = (dSeconds > 0.) ? \
+				double(nRepeat * golden.records) / dSeconds : 0.;
+			//@}
+
+			/// field deviations
+			CompareGolden(vOut, vGolden, mode, golden);
+
+			m_vGolden.push_back(golden);
+
+			std::cerr << "  " << golden.mode << " " << sName << ": max " \
+				<< golden.maxPos << " m, " << golden.maxQ << " rad, contour " \
+				<< golden.maxContour << " m, " << golden.throughput \
+				<< " records/s" << (golden.pass ? "" : " FAILED") << std::endl;
+		}
+	}
+}
+
+///
+/// @brief		format poses as CTestTricycle::Run() writes NN_pose.txt and
+///				NN_contour.txt
+/// @param		vPose [in] time, pose and contour of each line
+/// @param		sPose [out] text of NN_pose.txt (also of --stream, --client)
+/// @param		sContour [out] text of NN_contour.txt
+/// @return		void
+///
+static void FormatGolden(const std::vector<SPoseLogRecord>& vPose, \
+	std::string& sPose, std::string& sContour)
+{
+	char szLine[256];
+
+	sPose = "#time\trobot_x\trobot_y\trobot_q\n";
+	sContour = "#robot_x\trobot_y\t\n#LWheel_x\tLWheel_y\t\n" \
+		"#FWheel_x\tFWheel_y\t\n#RWheel_x\tRWheel_y\t\n#robot_x\trobot_y\n\n";
+	for (size_t i = 0; i < vPose.size(); ++i)
+	{
+		const SPoseLogRecord& r = vPose[i];
+
+		snprintf(szLine, sizeof(szLine), "%f\t%f\t%f\t%f\n", r.time, \
+			r.pose.x, r.pose.y, r.pose.q);
+		sPose += szLine;
+
+		snprintf(szLine, sizeof(szLine), \
+			"%f\t%f\n%f\t%f\n%f\t%f\n%f\t%f\n%f\t%f\n\n", r.pose.x, r.pose.y, \
+			r.posLW.x, r.posLW.y, r.posFW.x, r.posFW.y, r.posRW.x, r.posRW.y, \
+			r.pose.x, r.pose.y);
+		sContour += szLine;
+	}
+}
+
+///
+/// @brief		compare a result file with the expected text line by line
+/// @param		sFilename [in] result file
+/// @param		sExpected [in] expected text (e.g. of a golden file)
+/// @param		nFields [in] number of fields of a line (0: exact text)
+/// @param		pTolerance [in] tolerance of each field
+/// @param		nAngle [in] field of a heading (compared modulo 2 pi), or -1
+/// @param		pMax [in/out] largest deviation of each field
+/// @return		number of lines that differ (every expected line if the
+///				file is missing)
+/// @remark		Lines of the same text match. With nFields, other lines
+///				match if both have nFields numbers, each within its
+///				tolerance; a comment or blank line must be the same text.
+///
+static int DiffText(const std::string& sFilename, const std::string& sExpected, \
+	const int nFields = 0, const double* pTolerance = 0, const int nAngle = -1, \
+	double* pMax = 0)
+{
+	CMappedFile file;
+	std::string sText;
+	if (file.Open(sFilename) == 0)
+		sText.assign(file.GetData(), file.GetSize());
+
+	int nDiff = 0;
+	for (size_t a = 0, b = 0; a < sText.size() || b < sExpected.size(); )
+	{
+		const size_t nEndA = std::min(sText.find('\n', a), sText.size());
+		const size_t nEndB = std::min(sExpected.find('\n', b), \
+			sExpected.size());
+		const std::string sLineA = sText.substr(a, nEndA - a);
+		const std::string sLineB = sExpected.substr(b, nEndB - b);
+		a = std::min(nEndA + 1, sText.size());
+		b = std::min(nEndB + 1, sExpected.size());
+
+		if (sLineA == sLineB)
+			continue;
+		if (nFields <= 0 || sLineA.empty() || sLineB.empty() || \
+			sLineA[0] == '#' || sLineB[0] == '#')
+		{
+			++nDiff;
+			continue;
+		}
+
+		/// numbers of the lines
+		//@{
+		const char* pA = sLineA.c_str();
+		const char* pB = sLineB.c_str();
+		bool bMatch = true;
+		for (int f = 0; f < nFields; ++f)
+		{
+			char* pEndA = 0;
+			char* pEndB = 0;
+			const double va = strtod(pA, &pEndA);
+			const double vb = strtod(pB, &pEndB);
+			if (pEndA == pA || pEndB == pB)
+			{
+				bMatch = false;
+				break;
+			}
+			pA = pEndA;
+			pB = pEndB;
+
+			double d = fabs(va - vb);
+			if (f == nAngle)
+				d = fabs(AngleDiff(va, vb));
+			pMax[f] = std::max(pMax[f], d);
+			if (!(d <= pTolerance[f]))
+				bMatch = false;
+		}
+		if (strspn(pA, " \t\r") != strlen(pA) || \
+			strspn(pB, " \t\r") != strlen(pB))
+			bMatch = false;
+		//@}
+
+		if (!bMatch)
+			++nDiff;
+	}
+
+	return nDiff;
+}
+
+///
+/// @brief		send stdout to stderr (the entry points print their reports
+///				on stdout, where the bench prints its JSON)
+/// @param		N/A
+/// @return		descriptor of the former stdout (RestoreStdout()), -1 if
+///				stdout was kept
+///
+static int RedirectStdout()
+{
+	fflush(stdout);
+#if defined(__linux__)
+	const int fd = dup(1);
+	if (fd >= 0)
+		dup2(2, 1);
+	return fd;
+#else
+	return -1;
+#endif // defined(__linux__)
+}
+
+///
+/// @brief		restore stdout after RedirectStdout()
+/// @param		fd [in] descriptor returned by RedirectStdout()
+/// @return		void
+///
+static void RestoreStdout(const int fd)
+{
+	fflush(stdout);
+#if defined(__linux__)
+	if (fd >= 0)
+	{
+		dup2(fd, 1);
+		close(fd);
+	}
+#else
+	(void)fd;
+#endif // defined(__linux__)
+}
+
+#if defined(__linux__)
+///
+/// @brief		stop an odometry server started by StartServer()
+/// @param		pid [in] process id of the server
+/// @return		void
+///
+static void StopServer(const pid_t pid)
+{
+	kill(pid, SIGTERM);
+	waitpid(pid, 0, 0);
+}
+
+///
+/// @brief		run an odometry server (--serve) in a child process
+/// @param		sSocket [in] socket of the server
+/// @return		process id of the server, -1 if it does not accept clients
+///
+static pid_t StartServer(const std::string& sSocket)
+{
+	const pid_t pid = fork();
+	if (pid == 0)
+	{
+		COdometryServer server;
+		_exit((server.Run(sSocket) == 0) ? 0 : 1);
+	}
+	if (pid < 0)
+		return -1;
+
+	/// wait until it accepts clients
+	for (int n = 0; n < BENCH_SERVER_WAIT; ++n)
+	{
+		COdometryClient client;
+		if (client.Connect(sSocket) == 0)
+			return pid;
+		usleep(10000);
+	}
+
+	StopServer(pid);
+	return -1;
+}
+#endif // defined(__linux__)
+
+///
+/// @brief		run an entry point of the program on an input file
+/// @param		nEntry [in] entry point (EBenchEntry)
+/// @param		sInput [in] input file (CSV or record archive)
+/// @param		sOutput [in] prefix of the result files (_pose.txt,
+///				_contour.txt or _pose.bin)
+/// @return		0 on success, < 0 if occurred error (or the entry point
+///				needs another platform)
+/// @remark		The estimator and virtual gyro singletons are reset, so
+///				every entry point starts from the origin like a new process.
+///				The reports of the entry points go to stderr.
+///
+int CTricycleBench::RunEntryPoint(const int nEntry, const std::string& sInput, \
+	const std::string& sOutput)
+{
+	CTestTricycle* pTest = CTestTricycle::GetInstance();
+	const std::string sPose = sOutput + "_pose.txt";
+	const std::string sContour = sOutput + "_contour.txt";
+	const std::string sPoseLog = sOutput + "_pose.bin";
+	int rc = -1;
+
+	CTricycle::GetInstance()->SetState(SEstimatorState());
+	CVirtualGyro::GetInstance()->SetState(SGyroState());
+
+	const int fdStdout = RedirectStdout();
+
+	switch (nEntry)
+	{
+	case ENTRY_RUN:
+	case ENTRY_RUN_PIPELINE:
+	case ENTRY_RUN_BINARY:
+		pTest->m_sFilenameInput = sInput;
+		pTest->m_sFilenamePose = sPose;
+		pTest->m_sFilenameContour = sContour;
+		pTest->m_sFilenamePoseLog = sPoseLog;
+		pTest->m_bBinaryOutput = (nEntry == ENTRY_RUN_BINARY);
+		rc = pTest->RunFiles(nEntry == ENTRY_RUN_PIPELINE);
+		pTest->m_bBinaryOutput = false;
+		std::vector<SRecord>().swap(pTest->m_vRecord);
+		break;
+	case ENTRY_STREAM:
+		rc = pTest->RunStream(sInput, sPose);
+		break;
+	case ENTRY_BATCH:
+	case ENTRY_BATCH_BINARY:
+	{
+		/// <dir>/NN_pose.txt, ... -> <sOutput>_pose.txt, ...
+		const std::string sDir = sOutput + "_batch";
+		CBatchRunner batch(sDir, 1, nEntry == ENTRY_BATCH_BINARY);
+		batch.AddInput(sInput);
+		rc = batch.Run();
+
+		const std::string sPrefix = batch.GetOutputPrefix(sInput);
+		if (nEntry == ENTRY_BATCH_BINARY)
+			rename((sPrefix + "_pose.bin").c_str(), sPoseLog.c_str());
+		else
+		{
+			rename((sPrefix + "_pose.txt").c_str(), sPose.c_str());
+			rename((sPrefix + "_contour.txt").c_str(), sContour.c_str());
+		}
+		remove(sDir.c_str());
+		break;
+	}
+#if defined(__linux__)
+	case ENTRY_STREAM_PIPE:
+	{
+		/// the input is written to a named pipe (read to the end, not mapped)
+		CMappedFile file;
+		const std::string sFifo = sOutput + ".fifo";
+		unlink(sFifo.c_str());
+		if (file.Open(sInput) != 0 || mkfifo(sFifo.c_str(), 0600) != 0)
+			break;
+
+		std::thread producer([&]()
+		{
+			FILE* fp = fopen(sFifo.c_str(), "wb");
+			if (!fp)
+				return;
+			fwrite(file.GetData(), 1, file.GetSize(), fp);
+			fclose(fp);
+		});
+		rc = pTest->RunStream(sFifo, sPose);
+		producer.join();
+		unlink(sFifo.c_str());
+		break;
+	}
+	case ENTRY_CLIENT:
+	{
+		const std::string sSocket = sOutput + ".sock";
+		const pid_t pid = StartServer(sSocket);
+		if (pid < 0)
+			break;
+		rc = pTest->RunClient(sSocket, sInput, sPose);
+		StopServer(pid);
+		break;
+	}
+#endif // defined(__linux__)
+	default:
+		break;
+	}
+
+	RestoreStdout(fdStdout);
+
+	return rc;
+}
+
+///
+/// @brief		check the files written by the entry points of the program
+///				against the golden output of the scenarios of --scenarios
+/// @param		N/A
+/// @return		void
+/// @remark		Each NN_input.csv goes through every entry point (s_entry).
+///				The text files are diffed line by line with NN_pose.txt and
+///				NN_contour.txt: the comment lines must be the same and the
+///				fields within the tolerances of CTricycle::EstimateNs()
+///				(s_goldenMode). The binary pose logs are read back
+///				(CPoseLogReader) and compared record by record. FormatFixed6()
+///				is compared with printf("%f") over every value of the golden
+///				files, its neighbors and the values half a unit of the 6th
+///				decimal away. The throughput of an entry point is that of a
+///				single run, files included.
+///
+void CTricycleBench::CheckGoldenFiles()
+{
+	if (m_sScenarioDir.empty())
+		return;
+
+	std::vector<SBenchScenario> vScenario;
+	MakeScenarios(vScenario);
+
+	const SBenchGoldenMode& mode = s_goldenMode[GOLDEN_ESTIMATE];
+	const double dPoseTolerance[4] = { mode.time, mode.position, \
+		mode.position, mode.heading };
+	const double dContourTolerance[2] = { mode.contour, mode.contour };
+	const std::string sPrefix = m_sDir + "/bench_golden";
+	const std::string sPose = sPrefix + "_pose.txt";
+	const std::string sContour = sPrefix + "_contour.txt";
+	const std::string sPoseLog = sPrefix + "_pose.bin";
+
+	std::vector<SPoseLogRecord> vGolden, vOut;
+	for (size_t s = 0; s < vScenario.size(); ++s)
+	{
+		/// NN_input.csv -> NN_pose.txt, NN_contour.txt
+		//@{
+		const std::string& sName = vScenario[s].name;
+		const size_t nSuffix = sName.rfind("_input.csv");
+		if (nSuffix == std::string::npos)
+			continue;
+
+		const std::string sGolden = m_sScenarioDir + "/" + \
+			sName.substr(0, nSuffix);
+		CMappedFile filePose, fileContour;
+		if (ReadGolden(sGolden + "_pose.txt", sGolden + "_contour.txt", \
+			vGolden) != 0 || filePose.Open(sGolden + "_pose.txt") != 0 || \
+			fileContour.Open(sGolden + "_contour.txt") != 0)
+			continue;
+
+		const std::string sPoseText(filePose.GetData(), filePose.GetSize());
+		const std::string sContourText(fileContour.GetData(), \
+			fileContour.GetSize());
+		//@}
+
+		for (int nEntry = 0; nEntry < ENTRY_COUNT; ++nEntry)
+		{
+			const SBenchEntry& entry = s_entry[nEntry];
+#if !defined(__linux__)
+			if (entry.posix)
+				continue;
+#endif // !defined(__linux__)
+
+			SBenchGolden golden;
+			golden.mode = entry.szName;
+			golden.scenario = sName;
+			golden.records = (long long)vScenario[s].vRecord.size();
+
+			BenchClock::time_point t0 = BenchClock::now();
+			const int rc = RunEntryPoint(nEntry, \
+				m_sScenarioDir + "/" + sName, sPrefix);
+			BenchClock::time_point t1 = BenchClock::now();
+			const double dSeconds = ElapsedNs(t0, t1) * 1e-9;
+			golden.throughput = (dSeconds > 0.) ? \
+				double(golden.records) / dSeconds : 0.;
+
+			if (entry.binary)
+			{
+				/// records of the binary pose log
+				CPoseLogReader reader;
+				vOut.clear();
+				if (reader.Open(sPoseLog) == 0)
+				{
+					for (size_t i = 0; i < reader.GetCount(); ++i)
+						vOut.push_back(reader.GetRecord(i));
+				}
+				reader.Close();
+
+				CompareGolden(vOut, vGolden, mode, golden);
+			}
+			else
+			{
+				/// lines of the text files
+				double dMax[4] = { 0., 0., 0., 0. };
+				double dMaxContour[2] = { 0., 0. };
+
+				golden.mismatches = DiffText(sPose, sPoseText, 4, \
+					dPoseTolerance, 3, dMax);
+				if (entry.contour)
+					golden.mismatches += DiffText(sContour, sContourText, 2, \
+						dContourTolerance, -1, dMaxContour);
+
+				golden.maxTime = dMax[0];
+				golden.maxPos = std::max(dMax[1], dMax[2]);
+				golden.maxQ = dMax[3];
+				golden.maxContour = std::max(dMaxContour[0], dMaxContour[1]);
+				golden.pass = (golden.mismatches == 0);
+			}
+			golden.pass = golden.pass && rc == 0;
+
+			remove(sPose.c_str());
+			remove(sContour.c_str());
+			remove(sPoseLog.c_str());
+
+			m_vGolden.push_back(golden);
+
+			std::cerr << "  " << golden.mode << " " << sName << ": max " \
+				<< golden.maxPos << " m, " << golden.maxQ << " rad, contour " \
+				<< golden.maxContour << " m, " << golden.mismatches \
+				<< " lines differ, " << golden.throughput << " records/s" \
+				<< (golden.pass ? "" : " FAILED") << std::endl;
+		}
+
+		/// FormatFixed6() against printf("%f")
+		//@{
+		std::vector<double> vValue;
+		for (size_t i = 0; i < vGolden.size(); ++i)
+		{
+			const SPoseLogRecord& r = vGolden[i];
+			const double v[10] = { r.time, r.pose.x, r.pose.y, r.pose.q, \
+				r.posLW.x, r.posLW.y, r.posFW.x, r.posFW.y, r.posRW.x, \
+				r.posRW.y };
+			for (int k = 0; k < 10; ++k)
+			{
+				vValue.push_back(v[k]);
+				vValue.push_back(-v[k]);
+				vValue.push_back(nextafter(v[k], 1e300));
+				vValue.push_back(nextafter(v[k], -1e300));
+				vValue.push_back(v[k] + 5e-7);
+				vValue.push_back(v[k] - 5e-7);
+			}
+		}
+
+		SBenchGolden format;
+		format.mode = "FormatFixed6";
+		format.scenario = sName;
+		format.records = (long long)vValue.size();
+		format.maxTime = 0.;
+		format.maxPos = 0.;
+		format.maxQ = 0.;
+		format.maxContour = 0.;
+		format.mismatches = 0;
+
+		char szFast[64], szPrintf[64];
+		BenchClock::time_point t0 = BenchClock::now();
+		for (size_t i = 0; i < vValue.size(); ++i)
+			m_fSink = float(FormatFixed6(szFast, vValue[i]) - szFast);
+		BenchClock::time_point t1 = BenchClock::now();
+		for (size_t i = 0; i < vValue.size(); ++i)
+		{
+			const char* pEnd = FormatFixed6(szFast, vValue[i]);
+			snprintf(szPrintf, sizeof(szPrintf), "%f", vValue[i]);
+			if (std::string(szFast, size_t(pEnd - szFast)) != szPrintf)
+				++format.mismatches;
+		}
+
+		const double dSeconds = ElapsedNs(t0, t1) * 1e-9;
+		format.throughput = (dSeconds > 0.) ? \
+			double(format.records) / dSeconds : 0.;
+		format.pass = (format.mismatches == 0);
+		m_vGolden.push_back(format);
+
+		std::cerr << "  " << format.mode << " " << sName << ": " \
+			<< format.mismatches << " of " << format.records \
+			<< " values differ from printf, " << format.throughput \
+			<< " values/s" << (format.pass ? "" : " FAILED") << std::endl;
+		//@}
+	}
+}
+
+///
+/// @brief		replay record archives through the entry points of the
+///				program, and check the round trip CSV -> archive -> CSV
+/// @param		N/A
+/// @return		void
+/// @remark		Each NN_input.csv of --scenarios is converted by
+///				ConvertArchive() (--archive). The archive goes through
+///				Run() (without the plot), Run() --pipeline, --stream from the
+///				file and from a named pipe, --batch and --client (with a
+///				--serve child process); every result file must equal, line
+///				by line, the text of the records decoded from the archive
+///				and replayed by CTricycle::EstimateNs().
+///				The archive is converted back to CSV and again to an
+///				archive: the times and ticks must be exact, the angles
+///				within half the quantum, the second archive identical to
+///				the first, and the replay of the CSV within the golden
+///				tolerances (the quantum changes the last printed digits of
+///				some scenarios).
+///
+void CTricycleBench::CheckArchive()
+{
+	if (m_sScenarioDir.empty())
+	{
+		std::cerr << "  no scenarios (--scenarios)" << std::endl;
+		return;
+	}
+
+	std::vector<SBenchScenario> vScenario;
+	MakeScenarios(vScenario);
+
+	CTestTricycle* pTest = CTestTricycle::GetInstance();
+	const std::string sPrefix = m_sDir + "/bench_archive";
+	const std::string sArchive = sPrefix + "_input.trca";
+	const std::string sCsv = sPrefix + "_input.csv";
+	const std::string sArchive2 = sPrefix + "2_input.trca";
+	const std::string sPose = sPrefix + "_pose.txt";
+	const std::string sContour = sPrefix + "_contour.txt";
+
+	for (size_t s = 0; s < vScenario.size(); ++s)
+	{
+		const std::string& sName = vScenario[s].name;
+		const size_t nSuffix = sName.rfind("_input.csv");
+		if (nSuffix == std::string::npos)
+			continue;
+
+		/// round trip CSV -> archive -> CSV -> archive
+		//@{
+		SBenchRoundTrip trip;
+		trip.scenario = sName;
+		trip.records = 0;
+		trip.maxSteer = 0.;
+		trip.maxAngVel = 0.;
+		trip.maxPos = 0.;
+		trip.maxQ = 0.;
+		trip.pass = \
+			pTest->ConvertArchive(m_sScenarioDir + "/" + sName, sArchive) == 0 \
+			&& pTest->ConvertArchive(sArchive, sCsv) == 0;
+
+		std::vector<SRecord> vTrip;
+		bool bGyroTrip = false;
+		pTest->m_sFilenameInput = sCsv;
+		if (trip.pass && pTest->ReadInputFile() == 0)
+		{
+			vTrip.swap(pTest->m_vRecord);
+			bGyroTrip = pTest->m_bGyroInput;
+		}
+		trip.pass = trip.pass && pTest->ConvertArchive(sCsv, sArchive2) == 0;
+
+		std::vector<SRecord> vRecord;
+		pTest->m_sFilenameInput = m_sScenarioDir + "/" + sName;
+		if (pTest->ReadInputFile() == 0)
+			vRecord.swap(pTest->m_vRecord);
+		trip.records = (long long)vRecord.size();
+		trip.pass = trip.pass && vTrip.size() == vRecord.size() && \
+			bGyroTrip == pTest->m_bGyroInput;
+
+		for (size_t i = 0; trip.pass && i < vRecord.size(); ++i)
+		{
+			const SRecord& a = vTrip[i];
+			const SRecord& b = vRecord[i];
+			const double dSteer = fabs(double(a.steering_angle) - \
+				double(b.steering_angle));
+			const double dAngVel = fabs(double(a.angular_velocity) - \
+				double(b.angular_velocity));
+
+			trip.maxSteer = std::max(trip.maxSteer, dSteer);
+			trip.maxAngVel = std::max(trip.maxAngVel, dAngVel);
+			trip.pass = a.time_ns == b.time_ns && \
+				a.encoder_ticks == b.encoder_ticks && \
+				dSteer <= 0.5 * RECORD_ARCHIVE_QUANTUM + \
+					FLT_EPSILON * fabs(b.steering_angle) && \
+				dAngVel <= 0.5 * RECORD_ARCHIVE_QUANTUM + \
+					FLT_EPSILON * fabs(b.angular_velocity);
+		}
+
+		/// a second archive of the decoded records is the same file
+		CMappedFile fileArchive, fileArchive2;
+		trip.pass = trip.pass && fileArchive.Open(sArchive) == 0 && \
+			fileArchive2.Open(sArchive2) == 0 && \
+			fileArchive.GetSize() == fileArchive2.GetSize() && \
+			!memcmp(fileArchive.GetData(), fileArchive2.GetData(), \
+				fileArchive.GetSize());
+
+		/// the round-tripped input still gives the golden output
+		const std::string sGolden = m_sScenarioDir + "/" + \
+			sName.substr(0, nSuffix);
+		std::vector<SPoseLogRecord> vGolden, vOut;
+		if (trip.pass && ReadGolden(sGolden + "_pose.txt", \
+			sGolden + "_contour.txt", vGolden) == 0)
+		{
+			SBenchGolden golden;
+			ReplayGolden(GOLDEN_ESTIMATE, vTrip, vOut);
+			CompareGolden(vOut, vGolden, s_goldenMode[GOLDEN_ESTIMATE], golden);
+			trip.maxPos = golden.maxPos;
+			trip.maxQ = golden.maxQ;
+			trip.pass = golden.pass;
+		}
+		//@}
+
+		/// reference: the decoded records through CTricycle::EstimateNs()
+		//@{
+		std::vector<SRecord> vDecoded;
+		CRecordArchiveReader reader;
+		if (reader.Open(sArchive) == 0)
+			reader.Read(vDecoded);
+		reader.Close();
+
+		std::vector<SPoseLogRecord> vReference;
+		std::string sPoseText, sContourText;
+		ReplayGolden(GOLDEN_ESTIMATE, vDecoded, vReference);
+		FormatGolden(vReference, sPoseText, sContourText);
+		//@}
+
+		/// replays of the archive through the entry points (text files)
+		//@{
+		std::vector<SBenchArchiveCheck> vCheck;
+		for (int nEntry = 0; nEntry < ENTRY_COUNT; ++nEntry)
+		{
+			const SBenchEntry& entry = s_entry[nEntry];
+#if !defined(__linux__)
+			if (entry.posix)
+				continue;
+#endif // !defined(__linux__)
+			if (entry.binary)
+				continue;
+
+			SBenchArchiveCheck c;
+			c.mode = entry.szName;
+			c.scenario = sName;
+			c.records = (long long)vDecoded.size();
+
+			const int rc = RunEntryPoint(nEntry, sArchive, sPrefix);
+			c.mismatches = DiffText(sPose, sPoseText);
+			if (entry.contour)
+				c.mismatches += DiffText(sContour, sContourText);
+			c.pass = (rc == 0 && c.mismatches == 0 && !vDecoded.empty());
+			vCheck.push_back(c);
+
+			remove(sPose.c_str());
+			remove(sContour.c_str());
+		}
+		//@}
+
+		std::vector<SRecord>().swap(pTest->m_vRecord);
+		fileArchive.Close();
+		fileArchive2.Close();
+		remove(sArchive.c_str());
+		remove(sArchive2.c_str());
+		remove(sCsv.c_str());
+
+		m_vRoundTrip.push_back(trip);
+		std::cerr << "  CSV -> archive -> CSV " << sName << ": max steering " \
+			<< trip.maxSteer << " rad, max " << trip.maxPos << " m, " \
+			<< trip.maxQ << " rad from golden" \
+			<< (trip.pass ? "" : " FAILED") << std::endl;
+
+		for (size_t i = 0; i < vCheck.size(); ++i)
+		{
+			m_vArchiveCheck.push_back(vCheck[i]);
+			std::cerr << "  " << vCheck[i].mode << " " << sName << ": " \
+				<< vCheck[i].records << " records, " << vCheck[i].mismatches \
+				<< " lines differ" << (vCheck[i].pass ? "" : " FAILED") \
+				<< std::endl;
+		}
+	}
+}
+
+///
+/// @brief		benchmark of CVirtualGyro::Update()
+/// @param		N/A
+/// @return		void
+///
+void CTricycleBench::BenchGyroUpdate()
+{
+	CVirtualGyro* pGyro = CVirtualGyro::GetInstance();
+	const SRecord* pRecord = &m_vRecord[0];
+	volatile float& sink = m_fSink;
+
+	MeasureKernel("VirtualGyro::Update", [=, &sink](const size_t i)
+	{
+		const SRecord& r = pRecord[i];
+		pGyro->UpdateNs(r.time_ns, r.steering_angle, r.encoder_ticks);
+		sink = pGyro->GetAngVel();
+	});
+}
+
+///
+/// @brief		benchmark of CTricycle::GetRobotContour()
+/// @param		N/A
+/// @return		void
+///
+void CTricycleBench::BenchGetRobotContour()
+{
+	CTricycle* pTricycle = CTricycle::GetInstance();
+	volatile float& sink = m_fSink;
+
+	MeasureKernel("GetRobotContour", [=, &sink](const size_t)
+	{
+		SPos posFW, posLW, posRW;
+		pTricycle->GetRobotContour(posFW, posLW, posRW);
+		sink = posFW.x + posLW.y + posRW.x;
+	});
+}
+
+///
+/// @brief		benchmark of CFleetTricycle::Estimate() (per vehicle-record)
+/// @param		N/A
+/// @return		void
+///
+void CTricycleBench::BenchFleetEstimate()
+{
+	if (m_vRecord.size() <= BENCH_FLEET_SIZE)
+		return;
+
+	/// structure of arrays of the records
+	//@{
+	std::vector<long long> vTime(m_vRecord.size());
+	std::vector<float> vSteer(m_vRecord.size());
+	std::vector<int>   vTicks(m_vRecord.size());
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+	{
+		vTime[i]  = m_vRecord[i].time_ns;
+		vSteer[i] = m_vRecord[i].steering_angle;
+		vTicks[i] = m_vRecord[i].encoder_ticks;
+	}
+	//@}
+
+	CFleetTricycle fleet(BENCH_FLEET_SIZE);
+	const size_t nWindows = m_vRecord.size() - BENCH_FLEET_SIZE;
+	const long long* pTime = &vTime[0];
+	const float* pSteer = &vSteer[0];
+	const int*   pTicks = &vTicks[0];
+	CFleetTricycle* pFleet = &fleet;
+	volatile float& sink = m_fSink;
+
+	/// vehicle v of call i reads record (i + v): a sliding window
+	MeasureKernel("FleetTricycle::Estimate", [=, &sink](const size_t i)
+	{
+		const size_t k = i % nWindows;
+		pFleet->Estimate(pTime + k, pSteer + k, pTicks + k);
+		sink = pFleet->GetX()[0];
+	}, BENCH_FLEET_SIZE);
+}
+
+///
+/// @brief		benchmark of AngleClampN(), SinCosN() (per angle) and
+///				CRandom::FillGaussian() (per sample)
+/// @param		N/A
+/// @return		void
+/// @remark		the angles are the steering angles scaled by 4, so that
+///				about half of them are out of [-M_PI..+M_PI)
+///
+void CTricycleBench::BenchArrayKernels()
+{
+	if (m_vRecord.size() <= BENCH_ARRAY_SIZE)
+		return;
+
+	std::vector<float> vAngle(m_vRecord.size());
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+		vAngle[i] = 4.f * m_vRecord[i].steering_angle;
+
+	std::vector<float> vOut1(BENCH_ARRAY_SIZE);
+	std::vector<float> vOut2(BENCH_ARRAY_SIZE);
+	const size_t nWindows = m_vRecord.size() - BENCH_ARRAY_SIZE;
+	const float* pAngle = &vAngle[0];
+	float* pOut1 = &vOut1[0];
+	float* pOut2 = &vOut2[0];
+	volatile float& sink = m_fSink;
+
+	if (IsSelected("AngleClampN"))
+	{
+		MeasureKernel("AngleClampN", [=, &sink](const size_t i)
+		{
+			AngleClampN(pAngle + i % nWindows, pOut1, BENCH_ARRAY_SIZE);
+			sink = pOut1[0];
+		}, BENCH_ARRAY_SIZE);
+	}
+
+	if (IsSelected("SinCosN"))
+	{
+		MeasureKernel("SinCosN", [=, &sink](const size_t i)
+		{
+			SinCosN(pAngle + i % nWindows, pOut1, pOut2, BENCH_ARRAY_SIZE);
+			sink = pOut1[0] + pOut2[0];
+		}, BENCH_ARRAY_SIZE);
+	}
+
+	if (IsSelected("CRandom::FillGaussian"))
+	{
+		CRandom random;
+		CRandom* pRandom = &random;
+
+		MeasureKernel("CRandom::FillGaussian", [=, &sink](const size_t)
+		{
+			pRandom->FillGaussian(pOut1, BENCH_ARRAY_SIZE, 0.f, 1.f);
+			sink = pOut1[0];
+		}, BENCH_ARRAY_SIZE);
+	}
+}
+
+///
+/// @brief		benchmark of CEkfTricycle::EstimateNs()
+/// @param		N/A
+/// @return		void
+///
+void CTricycleBench::BenchEkfEstimate()
+{
+	CEkfTricycle ekf;
+	CEkfTricycle* pEkf = &ekf;
+	const SRecord* pRecord = &m_vRecord[0];
+	volatile float& sink = m_fSink;
+
+	MeasureKernel("EkfTricycle::Estimate", [=, &sink](const size_t i)
+	{
+		const SRecord& r = pRecord[i];
+		sink = pEkf->EstimateNs(r.time_ns, r.steering_angle, \
+			r.encoder_ticks, r.angular_velocity).x;
+	});
+}
+
+///
+/// @brief		benchmark of CPoseHistory::Query() (full history)
+/// @param		N/A
+/// @return		void
+///
+void CTricycleBench::BenchHistoryQuery()
+{
+	CPoseHistory history;
+	CPoseHistory* pHistory = &history;
+	const SRecord* pRecord = &m_vRecord[0];
+	volatile float& sink = m_fSink;
+
+	/// fill the history with the last records
+	const size_t nFirst = (m_vRecord.size() > POSE_HISTORY_SIZE) ? \
+		m_vRecord.size() - POSE_HISTORY_SIZE : 0;
+	for (size_t i = nFirst; i < m_vRecord.size(); ++i)
+		history.Push(Ns2Sec(pRecord[i].time_ns), SPose(float(i), 0.f, 0.f));
+
+	/// query between the records of the history
+	const double fBegin = Ns2Sec(pRecord[nFirst].time_ns);
+	const double fSpan = Ns2Sec(pRecord[m_vRecord.size() - 1].time_ns) - fBegin;
+	const size_t nRecords = m_vRecord.size();
+
+	MeasureKernel("PoseHistory::Query", [=, &sink](const size_t i)
+	{
+		SPose pose;
+		pHistory->Query(fBegin + fSpan * double(i) / double(nRecords), pose);
+		sink = pose.x;
+	});
+}
+
+///
+/// @brief		benchmark of CPoseShmPublisher::Publish() and
+///				CPoseShmSubscriber::GetLatest()
+/// @param		N/A
+/// @return		void
+///
+void CTricycleBench::BenchPoseShm()
+{
+	CPoseShmPublisher publisher;
+	CPoseShmSubscriber subscriber;
+
+	if (publisher.Open("/tricycle_bench") != 0 || \
+		subscriber.Open("/tricycle_bench") != 0)
+	{
+		std::cerr << "Cannot create the shared memory" << std::endl;
+		return;
+	}
+
+	CPoseShmPublisher* pPublisher = &publisher;
+	CPoseShmSubscriber* pSubscriber = &subscriber;
+	const SRecord* pRecord = &m_vRecord[0];
+	volatile float& sink = m_fSink;
+
+	if (IsSelected("PoseShm::Publish"))
+	{
+		MeasureKernel("PoseShm::Publish", [=](const size_t i)
+		{
+			SPoseLogRecord record;
+			record.time = Ns2Sec(pRecord[i].time_ns);
+			record.pose = SPose(float(i), pRecord[i].steering_angle, 0.f);
+			pPublisher->Publish(record);
+		});
+	}
+
+	if (IsSelected("PoseShm::GetLatest"))
+	{
+		MeasureKernel("PoseShm::GetLatest", [=, &sink](const size_t)
+		{
+			SPoseLogRecord record;
+			pSubscriber->GetLatest(record);
+			sink = record.pose.x;
+		});
+	}
+}
+
+///
+/// @brief		benchmark of CTestTricycle::ReadInputFile()
+/// @param		N/A
+/// @return		void
+///
+void CTricycleBench::BenchReadInputFile()
+{
+	CTestTricycle* pTest = CTestTricycle::GetInstance();
+	const long long nRecords = (long long)(m_vRecord.size());
+	const std::string sFilename = m_sDir + "/bench_input.csv";
+
+	/// write the synthetic records as NN_input.csv
+	//@{
+	FILE* fp = fopen(sFilename.c_str(), "w");
+	if (!fp)
+	{
+		std::cerr << "Cannot create " << sFilename << std::endl;
+		return;
+	}
+	fputs("#synthetic\n#time,steering_angle,encoder_ticks\n", fp);
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+		fprintf(fp, "%.2f,%.9f,%d\n", m_vRecord[i].time, \
+			m_vRecord[i].steering_angle, m_vRecord[i].encoder_ticks);
+	fclose(fp);
+	//@}
+
+	/// repetitions (3..BENCH_MIN_SAMPLES, about 1e7 records in total)
+	const long long nRepeat = std::max<long long>(3, \
+		std::min<long long>(BENCH_MIN_SAMPLES, 10000000LL / nRecords));
+
+	std::vector<double> vSamples;
+	double dTotalNs = 0.;
+	pTest->m_sFilenameInput = sFilename;
+	for (long long n = 0; n < nRepeat; ++n)
+	{
+		BenchClock::time_point t0 = BenchClock::now();
+		pTest->ReadInputFile();
+		BenchClock::time_point t1 = BenchClock::now();
+
+		const double dNs = ElapsedNs(t0, t1);
+		dTotalNs += dNs;
+		vSamples.push_back(dNs / double(nRecords));
+	}
+
+	/// release the records
+	std::vector<SRecord>().swap(pTest->m_vRecord);
+	remove(sFilename.c_str());
+
+	AddResult("ReadInputFile", vSamples, dTotalNs * 1e-9, nRecords * nRepeat);
+}
+
+///
+/// @brief		benchmark of CTestTricycle::ReadInputFile() with a record
+///				archive
+/// @param		N/A
+/// @return		void
+///
+void CTricycleBench::BenchReadArchive()
+{
+	CTestTricycle* pTest = CTestTricycle::GetInstance();
+	const long long nRecords = (long long)(m_vRecord.size());
+	const std::string sFilename = m_sDir + "/bench_input.trca";
+
+	/// write the synthetic records as a record archive
+	//@{
+	CRecordArchiveWriter writer;
+	if (writer.Open(sFilename) != 0)
+	{
+		std::cerr << "Cannot create " << sFilename << std::endl;
+		return;
+	}
+	for (size_t i = 0; i < m_vRecord.size(); ++i)
+		writer.Write(m_vRecord[i]);
+	writer.Close();
+	//@}
+
+	/// repetitions (3..BENCH_MIN_SAMPLES, about 1e7 records in total)
+	const long long nRepeat = std::max<long long>(3, \
+		std::min<long long>(BENCH_MIN_SAMPLES, 10000000LL / nRecords));
+
+	std::vector<double> vSamples;
+	double dTotalNs = 0.;
+	pTest->m_sFilenameInput = sFilename;
+	for (long long n = 0; n < nRepeat; ++n)
+	{
+		BenchClock::time_point t0 = BenchClock::now();
+		pTest->ReadInputFile();
+		BenchClock::time_point t1 = BenchClock::now();
+
+		const double dNs = ElapsedNs(t0, t1);
+		dTotalNs += dNs;
+		vSamples.push_back(dNs / double(nRecords));
+	}
+
+	/// release the records
+	std::vector<SRecord>().swap(pTest->m_vRecord);
+	remove(sFilename.c_str());
+
+	AddResult("ReadInputFile(archive)", vSamples, dTotalNs * 1e-9, \
+		nRecords * nRepeat);
+}
+
+///
+/// @brief		benchmark of CTestTricycle::Write()
+/// @param		bBinary [in] write the binary pose log instead of text files
+/// @return		void
+/// @remark		samples are batches of Write() calls; the throughput also
+///				includes creating and closing the files
+///
+void CTricycleBench::BenchWrite(const bool bBinary)
+{
+	CTestTricycle* pTest = CTestTricycle::GetInstance();
+	const long long nRecords = (long long)(m_vRecord.size());
+	const long long nBatch = std::min<long long>(BENCH_BATCH_SIZE, \
+		std::max<long long>(1, nRecords / BENCH_MIN_SAMPLES));
+	const char* szName = bBinary ? "Write(binary)" : "Write(text)";
+
+	pTest->m_bBinaryOutput = bBinary;
+	pTest->m_sFilenamePose = m_sDir + "/bench_pose.txt";
+	pTest->m_sFilenameContour = m_sDir + "/bench_contour.txt";
+	pTest->m_sFilenamePoseLog = m_sDir + "/bench_pose.bin";
+
+	std::vector<double> vSamples;
+	BenchClock::time_point tBegin = BenchClock::now();
+	if (pTest->CreateResultFiles() != 0)
+	{
+		std::cerr << "Cannot create the result files in " << m_sDir << std::endl;
+		return;
+	}
+	for (long long b = 0; b + nBatch <= nRecords; b += nBatch)
+	{
+		BenchClock::time_point t0 = BenchClock::now();
+		for (long long i = b; i < b + nBatch; ++i)
+		{
+			const SRecord& r = m_vRecord[size_t(i)];
+			pTest->Write(r.time, SPose(r.time, r.steering_angle, 0.f));
+		}
+		BenchClock::time_point t1 = BenchClock::now();
+		vSamples.push_back(ElapsedNs(t0, t1) / double(nBatch));
+	}
+	pTest->CloseResultFiles();
+	BenchClock::time_point tEnd = BenchClock::now();
+
+	remove(pTest->m_sFilenamePose.c_str());
+	remove(pTest->m_sFilenameContour.c_str());
+	remove(pTest->m_sFilenamePoseLog.c_str());
+
+	AddResult(szName, vSamples, ElapsedNs(tBegin, tEnd) * 1e-9, \
+		nRecords / nBatch * nBatch);
+}
+
+///
+/// @brief		run all benchmarks for the sizes nMin, 10 * nMin, ... nMax
+/// @param		nMin [in] smallest number of records
+/// @param		nMax [in] largest number of records
+/// @return		void
+///
+void CTricycleBench::Run(const long long nMin, const long long nMax)
+{
+	for (long long n = nMin; n <= nMax; n *= 10)
+	{
+		std::cerr << "records: " << n << std::endl;
+
+		MakeRecords(n);
+
+		if (IsSelected("Estimate") || IsSelected("Estimate<double>") || \
+			IsSelected("Step"))
+			BenchEstimate();
+		if (IsSelected("Estimate["))
+			BenchIntegrators();
+		if (IsSelected("FixedTricycle::Step"))
+			BenchFixed();
+		if (IsSelected("EstimatorJournal"))
+			BenchJournal();
+		if (IsSelected("TrajectoryIndex"))
+			BenchTrajectoryIndex();
+		if (IsSelected("PoseGraph"))
+			BenchPoseGraph();
+		if (IsSelected("VirtualGyro::Update"))
+			BenchGyroUpdate();
+		if (IsSelected("GetRobotContour"))
+			BenchGetRobotContour();
+		if (IsSelected("FleetTricycle::Estimate"))
+			BenchFleetEstimate();
+		if (IsSelected("AngleClampN") || IsSelected("SinCosN") || \
+			IsSelected("CRandom::FillGaussian"))
+			BenchArrayKernels();
+		if (IsSelected("EkfTricycle::Estimate"))
+			BenchEkfEstimate();
+		if (IsSelected("PoseHistory::Query"))
+			BenchHistoryQuery();
+		if (IsSelected("PoseShm::Publish") || IsSelected("PoseShm::GetLatest"))
+			BenchPoseShm();
+		if (IsSelected("ReadInputFile"))
+			BenchReadInputFile();
+		if (IsSelected("ReadInputFile(archive)"))
+			BenchReadArchive();
+		if (IsSelected("Write(text)"))
+			BenchWrite(false);
+		if (IsSelected("Write(binary)"))
+			BenchWrite(true);
+	}
+
+	if (IsSelected("Estimate["))
+	{
+		std::cerr << "accuracy" << std::endl;
+		BenchAccuracy();
+	}
+
+	if (IsSelected("FixedTricycle::Step"))
+	{
+		std::cerr << "fixed point" << std::endl;
+		CheckFixed();
+	}
+
+	if (IsSelected("EstimatorJournal"))
+	{
+		std::cerr << "journal" << std::endl;
+		CheckJournal();
+	}
+
+	if (IsSelected("Golden"))
+	{
+		std::cerr << "golden" << std::endl;
+		CheckGolden();
+		CheckGoldenFiles();
+	}
+
+	if (IsSelected("RecordArchive"))
+	{
+		std::cerr << "record archive" << std::endl;
+		CheckArchive();
+	}
+}
+
+///
+/// @brief		print results as JSON
+/// @param		fp [in] output file
+/// @return		void
+///
+void CTricycleBench::PrintJson(FILE* fp) const
+{
+	fprintf(fp, "{\n");
+	fprintf(fp, "  \"benchmark\": \"tricycle_bench\",\n");
+	fprintf(fp, "  \"simd_lanes\": %d,\n", CFleetTricycle::GetLanes());
+	fprintf(fp, "  \"results\": [\n");
+	for (size_t i = 0; i < m_vResult.size(); ++i)
+	{
+		const SBenchResult& r = m_vResult[i];
+		fprintf(fp, "    {\"name\": \"%s\", \"records\": %lld, " \
+			"\"samples\": %d, \"ns_per_record_p50\": %.3f, " \
+			"\"ns_per_record_p99\": %.3f, \"records_per_sec\": %.1f}%s\n", \
+			r.name.c_str(), r.records, r.samples, r.p50, r.p99, \
+			r.throughput, (i + 1 < m_vResult.size()) ? "," : "");
+	}
+	fprintf(fp, "  ],\n");
+	fprintf(fp, "  \"accuracy\": [\n");
+	for (size_t i = 0; i < m_vAccuracy.size(); ++i)
+	{
+		const SBenchAccuracy& a = m_vAccuracy[i];
+		fprintf(fp, "    {\"name\": \"%s\", \"scenario\": \"%s\", " \
+			"\"decimation\": %d, \"steps\": %lld, \"max_error_m\": %.9g, " \
+			"\"final_error_m\": %.9g, \"ns_per_step_p50\": %.3f}%s\n", \
+			a.name.c_str(), a.scenario.c_str(), a.decimation, a.steps, \
+			a.maxError, a.finalError, a.p50, \
+			(i + 1 < m_vAccuracy.size()) ? "," : "");
+	}
+	fprintf(fp, "  ],\n");
+	fprintf(fp, "  \"accuracy_check\": [\n");
+	for (size_t i = 0; i < m_vAccuracyCheck.size(); ++i)
+	{
+		const SBenchAccuracyCheck& c = m_vAccuracyCheck[i];
+		fprintf(fp, "    {\"scenario\": \"%s\", \"decimation\": %d, " \
+			"\"euler_full_rate_m\": %.9g, \"arc_m\": %.9g, " \
+			"\"rk4_m\": %.9g, \"pass\": %s}%s\n", c.scenario.c_str(), \
+			BENCH_ACCURACY_DECIMATION, c.euler, c.arc, c.rk4, \
+			c.pass ? "true" : "false", \
+			(i + 1 < m_vAccuracyCheck.size()) ? "," : "");
+	}
+	fprintf(fp, "  ],\n");
+	fprintf(fp, "  \"cycles\": [\n");
+	for (size_t i = 0; i < m_vCycles.size(); ++i)
+	{
+		const SBenchCycles& c = m_vCycles[i];
+		fprintf(fp, "    {\"name\": \"%s\", \"records\": %lld, " \
+			"\"cycles_per_record\": %.3f}%s\n", c.name.c_str(), c.records, \
+			c.cycles, (i + 1 < m_vCycles.size()) ? "," : "");
+	}
+	fprintf(fp, "  ],\n");
+	fprintf(fp, "  \"fixed_point\": [\n");
+	for (size_t i = 0; i < m_vFixedCheck.size(); ++i)
+	{
+		const SBenchFixedCheck& c = m_vFixedCheck[i];
+		fprintf(fp, "    {\"scenario\": \"%s\", \"records\": %lld, " \
+			"\"max_position_error_m\": %.9g, \"max_heading_error_rad\": " \
+			"%.9g, \"float_position_error_m\": %.9g, " \
+			"\"float_heading_error_rad\": %.9g, \"pass\": %s}%s\n", \
+			c.scenario.c_str(), c.records, c.maxPos, c.maxQ, \
+			c.maxPosFloat, c.maxQFloat, c.pass ? "true" : "false", \
+			(i + 1 < m_vFixedCheck.size()) ? "," : "");
+	}
+	fprintf(fp, "  ],\n");
+	fprintf(fp, "  \"journal\": [\n");
+	for (size_t i = 0; i < m_vJournalCheck.size(); ++i)
+	{
+		const SBenchJournalCheck& c = m_vJournalCheck[i];
+		fprintf(fp, "    {\"scenario\": \"%s\", \"records\": %lld, " \
+			"\"corrections\": %d, \"reestimated\": %lld, \"pass\": %s}%s\n", \
+			c.scenario.c_str(), c.records, c.corrections, c.reestimated, \
+			c.pass ? "true" : "false", \
+			(i + 1 < m_vJournalCheck.size()) ? "," : "");
+	}
+	fprintf(fp, "  ],\n");
+	fprintf(fp, "  \"trajectory_index\": [\n");
+	for (size_t i = 0; i < m_vIndexCheck.size(); ++i)
+	{
+		const SBenchIndexCheck& c = m_vIndexCheck[i];
+		fprintf(fp, "    {\"records\": %lld, \"queries\": %d, " \
+			"\"mismatches\": %d, \"pass\": %s}%s\n", c.records, c.queries, \
+			c.mismatches, c.pass ? "true" : "false", \
+			(i + 1 < m_vIndexCheck.size()) ? "," : "");
+	}
+	fprintf(fp, "  ],\n");
+	fprintf(fp, "  \"pose_graph\": [\n");
+	for (size_t i = 0; i < m_vGraphCheck.size(); ++i)
+	{
+		const SBenchGraphCheck& c = m_vGraphCheck[i];
+		fprintf(fp, "    {\"records\": %lld, \"iterations\": %d, " \
+			"\"seconds\": %.6f, \"odometry_rms_m\": %.9g, " \
+			"\"optimized_rms_m\": %.9g, \"incremental_rms_m\": %.9g, " \
+			"\"max_difference_m\": %.9g, \"pass\": %s}%s\n", c.records, \
+			c.iterations, c.seconds, c.rmsOdometry, c.rmsOptimized, \
+			c.rmsIncremental, c.maxDiff, c.pass ? "true" : "false", \
+			(i + 1 < m_vGraphCheck.size()) ? "," : "");
+	}
+	fprintf(fp, "  ],\n");
+	fprintf(fp, "  \"golden\": [\n");
+	for (size_t i = 0; i < m_vGolden.size(); ++i)
+	{
+		const SBenchGolden& g = m_vGolden[i];
+		fprintf(fp, "    {\"mode\": \"%s\", \"scenario\": \"%s\", " \
+			"\"records\": %lld, \"max_time_error_s\": %.9g, " \
+			"\"max_position_error_m\": %.9g, \"max_heading_error_rad\": " \
+			"%.9g, \"max_contour_error_m\": %.9g, \"mismatches\": %d, " \
+			"\"records_per_sec\": %.1f, \"pass\": %s}%s\n", g.mode.c_str(), \
+			g.scenario.c_str(), g.records, g.maxTime, g.maxPos, g.maxQ, \
+			g.maxContour, g.mismatches, g.throughput, \
+			g.pass ? "true" : "false", \
+			(i + 1 < m_vGolden.size()) ? "," : "");
+	}
+	fprintf(fp, "  ],\n");
+	fprintf(fp, "  \"record_archive\": [\n");
+	for (size_t i = 0; i < m_vArchiveCheck.size(); ++i)
+	{
+		const SBenchArchiveCheck& c = m_vArchiveCheck[i];
+		fprintf(fp, "    {\"mode\": \"%s\", \"scenario\": \"%s\", " \
+			"\"records\": %lld, \"mismatches\": %d, \"pass\": %s}%s\n", \
+			c.mode.c_str(), c.scenario.c_str(), c.records, c.mismatches, \
+			c.pass ? "true" : "false", \
+			(i + 1 < m_vArchiveCheck.size()) ? "," : "");
+	}
+	fprintf(fp, "  ],\n");
+	fprintf(fp, "  \"record_archive_round_trip\": [\n");
+	for (size_t i = 0; i < m_vRoundTrip.size(); ++i)
+	{
+		const SBenchRoundTrip& c = m_vRoundTrip[i];
+		fprintf(fp, "    {\"scenario\": \"%s\", \"records\": %lld, " \
+			"\"max_steering_error_rad\": %.9g, " \
+			"\"max_angular_velocity_error_rad_s\": %.9g, " \
+			"\"max_position_error_m\": %.9g, \"max_heading_error_rad\": " \
+			"%.9g, \"pass\": %s}%s\n", c.scenario.c_str(), c.records, \
+			c.maxSteer, c.maxAngVel, c.maxPos, c.maxQ, \
+			c.pass ? "true" : "false", \
+			(i + 1 < m_vRoundTrip.size()) ? "," : "");
+	}
+	fprintf(fp, "  ]\n");
+	fprintf(fp, "}\n");
+}
+
+///
+/// @brief		show usage of this program
+/// @param		exeFilename [in] executed filename
+/// @return		void
+///
+static void ShowUsage(const char* exeFilename)
+{
+	std::cerr << "Usage: " << exeFilename << " [--min N] [--max N] " \
+		"[--filter NAME] [--dir PATH] [--scenarios PATH] [--out FILE]" \
+		<< std::endl;
+	std::cerr << "  --min N        smallest number of records (default 1e3)" \
+		<< std::endl;
+	std::cerr << "  --max N        largest number of records (default 1e6, " \
+		"up to 1e8)" << std::endl;
+	std::cerr << "  --filter NAME  run only benchmarks containing NAME" \
+		<< std::endl;
+	std::cerr << "  --dir PATH     directory for temporary files (default .)" \
+		<< std::endl;
+	std::cerr << "  --scenarios PATH  directory of NN_input.csv for the " \
+		"integrator accuracy, the fixed-point, the journal and the " \
+		"record archive checks, " \
+		"with NN_pose.txt and NN_contour.txt for the golden check " \
+		"(e.g. result)" \
+		<< std::endl;
+	std::cerr << "  --out FILE     write JSON to FILE (default stdout)" \
+		<< std::endl;
+}
+
+///
+/// @brief		entry point of the benchmark
+/// @param		argc [in] the number of arguments
+/// @param		argv [in] string point array of arguments
+/// @return		0 on success, 1 if a check failed
+///
+int main(int argc, char* argv[])
+{
+	long long nMin = 1000;
+	long long nMax = 1000000;
+	std::string sFilter;
+	std::string sDir = ".";
+	std::string sScenarioDir;
+	std::string sOut;
+
+	/// parse arguments
+	for (int i = 1; i < argc; ++i)
+	{
+		if (i + 1 < argc && !strcmp(argv[i], "--min"))
+			nMin = (long long)(atof(argv[++i]));
+		else if (i + 1 < argc && !strcmp(argv[i], "--max"))
+			nMax = (long long)(atof(argv[++i]));
+		else if (i + 1 < argc && !strcmp(argv[i], "--filter"))
+			sFilter = argv[++i];
+		else if (i + 1 < argc && !strcmp(argv[i], "--dir"))
+			sDir = argv[++i];
+		else if (i + 1 < argc && !strcmp(argv[i], "--scenarios"))
+			sScenarioDir = argv[++i];
+		else if (i + 1 < argc && !strcmp(argv[i], "--out"))
+			sOut = argv[++i];
+		else
+		{
+			ShowUsage(argv[0]);
+			return 1;
+		}
+	}
+
+	if (nMin < 1 || nMax < nMin)
+	{
+		ShowUsage(argv[0]);
+		return 1;
+	}
+
+	CTricycleBench bench(sDir, sFilter, sScenarioDir);
+	bench.Run(nMin, nMax);
+
+	/// print the report
+	FILE* fp = sOut.empty() ? stdout : fopen(sOut.c_str(), "w");
+	if (!fp)
+	{
+		std::cerr << "Cannot create " << sOut << std::endl;
+		return 1;
+	}
+	bench.PrintJson(fp);
+	if (fp != stdout)
+		fclose(fp);
+
+	/// a failed check fails the run
+	return bench.HasFailure() ? 1 : 0;
+}
@@ -0,0 +1,38 @@
+///
+/// @file		TricycleGeometry.h
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Compile-time geometry policies of the Tricycle chassis variants
+///
+/// @remark		A policy only holds constexpr values. TTricycle<TGeometry>
+///				derives its constants (circumference, distance per tick) from
+///				them at compile time. To add a variant, add a policy with the
+///				measured geometry of the vehicle here and an entry to the
+///				chassis table in Tricycle.cpp.
+///
+
+#ifndef _TRICYCLE_GEOMETRY_H_
+#define _TRICYCLE_GEOMETRY_H_
+
+/// @brief		geometry of the standard chassis (default)
+typedef struct _tagSGeometryStandard
+{
+	/// front wheel radius (unit: m)
+	static constexpr float fFrontWheelRadius = 0.2f;
+
+	/// rear wheel radius (unit: m) - not used
+	static constexpr float fRearWheelRadius = 0.2f;
+
+	/// distance from front wheel to back axis (r) (unit: m)
+	static constexpr float fDistBtwFrontRear = 1.f;
+
+	/// distance between rear wheel (d) (unit: meter) - used for drawing
+	static constexpr float fDistBtwRearWheels = 0.75f;
+
+	/// number of ticks per revolution of the front wheel
+	static constexpr int nTicksPerRevolution = 512;
+} SGeometryStandard;
+
+#endif // _TRICYCLE_GEOMETRY_H_
@@ -9,9 +9,6 @@
 /// @remark		INACCURATE because of calculating with 'steering_angle' value.
 ///
 
-#include <cmath>		// sqrtf, logf, sinf
-#include <cstdlib>		// RAND_MAX
-
 #include "VirtualGyro.h"
 #include "Tricycle.h"	// CTriCycle
 
@@ -51,49 +48,60 @@
 /// @param		fTime [in] current time (sec)
 /// @param		fSteerRad [in] steering angle of the front wheel
 /// @return		void
-/// @remark		must be called at the beginning in the estimate()
+/// @remark		call before estimate() or CTricycle::Estimate() of the
+///				same record
 ///
 void CVirtualGyro::Update(const float fTime, const float fSteerRad, const int nEncoderTicks)
 {
-	static float fPrevTime = 0.f;		///< previous timestamp
-	static float fPrevSteerRad = 0.f;	///< previous steering angle (rad)
-	float  fDiffTime = 0.f;				///< difference since previous time (s)
-
-	/// difference since previous time (s)
-	fDiffTime = fTime - fPrevTime;
-
-	/// make the gyro angle (rad)
-	float fDiffAngleRad = (nEncoderTicks * CTricycle::GetInstance()->GetFrontDistPerTick()) / 2.f;
-	fDiffAngleRad /= CTricycle::GetInstance()->GetDistBtwFrontRear();
-	fDiffAngleRad *= sinf((fPrevSteerRad + fSteerRad) / 2.f);
-
-#if (APPLY_NOISE)
-#	error Not implemented.
-	// gaussian noise...
-#endif // (APPLY_NOISE)
-
-#if (APPLY_DRIFT)
-#	error Not implemented.
-	// unidirectional drift...
-#endif // (APPLY_DRIFT)
+	UpdateNs(Sec2Ns(fTime), fSteerRad, nEncoderTicks);
+}
 
-	/// update the angular velocity of the gyro
-	//@{
-	m_fAngVel = AngleDiff<float>(m_fAngleRad, m_fAngleRad + fDiffAngleRad);
-	m_fAngVel = AngleClamp(m_fAngVel);
-	if (!almostZero<float>(fDiffTime))	///< prevent divide by zero
-		m_fAngVel /= fDiffTime;			///< angular velocity (rad/s)
-	//@}
+///
+/// @brief		update angle and angular velocity of the gyro
+/// @param		nTimeNs [in] current time (ns)
+/// @param		fSteerRad [in] steering angle of the front wheel
+/// @param		nEncoderTicks [in] encoder ticks
+/// @return		void
+/// @remark		call before CTricycle::EstimateNs() of the same record
+///				(CTricycle::Step() does both)
+///
+void CVirtualGyro::UpdateNs(const long long nTimeNs, const float fSteerRad, \
+	const int nEncoderTicks)
+{
+	/// chassis of the gyro
+	const STricycleChassis& chassis = m_pChassis ? *m_pChassis \
+		: CTricycle::GetInstance()->GetChassis();
 
-	/// copy to the member variable 'm_fAngleRad'
-	m_fAngleRad = m_fAngleRad + fDiffAngleRad;
+	/// gaussian noise (samples are made GYRO_NOISE_BLOCK at a time)
+	float fNoiseRad = 0.f;
+	if (m_model.bApplyNoise)
+	{
+		if (m_nNoiseIndex >= GYRO_NOISE_BLOCK)
+		{
+			m_random.FillGaussian(&m_vNoise[0], GYRO_NOISE_BLOCK, 0.f, 1.f);
+			m_nNoiseIndex = 0;
+		}
+		fNoiseRad = m_model.fNoiseStdev * m_vNoise[m_nNoiseIndex++];
+	}
 
-	/// clamp gyro angle between [-M_PI..+M_PI)
-	m_fAngleRad = AngleClamp(m_fAngleRad);
+	/// unidirectional drift
+	const float fDriftRadPerSec = !m_model.bApplyDrift ? 0.f \
+		: (m_model.nDriftDir ? -1.f : 1.f) * m_model.fDriftRadPerSec;
 
-	/// update fPrevTime for the next time
-	fPrevTime = fTime;
+	GyroStep(m_state, chassis.fFrontDistPerTick, chassis.fDistBtwFrontRear, \
+		nTimeNs, fSteerRad, nEncoderTicks, fNoiseRad, fDriftRadPerSec);
+}
 
-	/// update fPrevSteerRad for the next time
-	fPrevSteerRad = fSteerRad;
+///
+/// @brief		set the error model
+/// @param		model [in] error model
+/// @return		void
+/// @remark		restarts the noise sequence from model.nSeed, so a run with
+///				the same model and inputs gives the same angular velocities
+///
+void CVirtualGyro::SetErrorModel(const SGyroErrorModel& model)
+{
+	m_model = model;
+	m_random.Seed(m_model.nSeed);
+	m_nNoiseIndex = GYRO_NOISE_BLOCK;
 }
@@ -12,15 +12,25 @@
 #ifndef _VIRTUAL_GYRO_H_
 #define _VIRTUAL_GYRO_H_
 
+#include <vector>			// std::vector
+
 #include "Singleton.h"		// TSingleton
 #include "math2.h"			// DEG2RAD
+#include "Random.h"			// CRandom, RANDOM_DEFAULT_SEED
+#include "Tricycle.h"		// STricycleChassis
+#include "GyroState.h"		// SGyroState, GyroStep
+
+//
+// The macros below are the defaults of SGyroErrorModel. The error model is
+// selected at runtime with CVirtualGyro::SetErrorModel().
+//
 
 /// whether to apply gaussian noise (CHAGEABLE!)
 /// 0: do not apply gaussian noise (update with steering angle difference only)
 /// 1: apply gaussian noise (update with steering angle difference and gaussian noise)
 #define APPLY_NOISE		(0)
 
-/// standard deviation of the gaussian noise
+/// standard deviation of the gaussian noise per update (rad)
 #define NOISE_STDEV		(DEG2RAD(0.1f))
 
 /// whether to apply angle drift (CHANGEABLE!)
@@ -37,20 +47,62 @@
 #define DRIFT_RAD_PER_MINUTE	(DEG2RAD(0.3f))
 
 /// angle error per second (DO NOT CHANGE!)
-#define DRIFT_RAD_PER_SECOND	(GYRO_ERR_PER_MINUTE / 60.f)
+#define DRIFT_RAD_PER_SECOND	(DRIFT_RAD_PER_MINUTE / 60.f)
+
+/// number of noise samples made at once (CRandom::FillGaussian)
+#define GYRO_NOISE_BLOCK		(256)
+
+/// @brief		error model of the virtual gyro
+typedef struct _tagSGyroErrorModel
+{
+	bool bApplyNoise;		///< whether to apply gaussian noise
+	float fNoiseStdev;		///< standard deviation of the noise per update (rad)
+	bool bApplyDrift;		///< whether to apply angle drift
+	int nDriftDir;			///< drift direction (0: CCW, 1: CW)
+	float fDriftRadPerSec;	///< angle drift per second (rad/s)
+	uint64_t nSeed;			///< seed of the noise generator
+
+	/// default constructor (macros above)
+	_tagSGyroErrorModel()
+	: bApplyNoise(APPLY_NOISE != 0), fNoiseStdev(NOISE_STDEV)
+	, bApplyDrift(APPLY_DRIFT != 0), nDriftDir(DRIFT_DIR)
+	, fDriftRadPerSec(DRIFT_RAD_PER_SECOND), nSeed(RANDOM_DEFAULT_SEED)
+	{}
+} SGyroErrorModel;
 
 /// @brief		Virtual gyro class for simulation
 class CVirtualGyro : public TSingleton<CVirtualGyro>
 {
 public:
-	explicit CVirtualGyro() : m_fAngVel(0.f), m_fAngleRad(0.f) {}
+	explicit CVirtualGyro()
+	: m_pChassis(0), m_random(m_model.nSeed), m_nNoiseIndex(GYRO_NOISE_BLOCK)
+	{ m_vNoise.resize(GYRO_NOISE_BLOCK); }
 	virtual ~CVirtualGyro() {}
 
 	/// update angle and angular velocity of the gyro
 	void Update(const float fTime, const float fSteerRad, const int nEncoderTicks);
 
+	/// update with a timestamp in nanoseconds (exact time differences)
+	void UpdateNs(const long long nTimeNs, const float fSteerRad, \
+		const int nEncoderTicks);
+
+	/// set the error model (restarts the noise sequence from its seed)
+	void SetErrorModel(const SGyroErrorModel& model);
+
+	/// get the error model
+	const SGyroErrorModel& GetErrorModel() const { return m_model; }
+
+	/// set the chassis of the gyro (0: the one selected in CTricycle)
+	void SetChassis(const STricycleChassis* pChassis) { m_pChassis = pChassis; }
+
 	/// get the angular velocity (rad/s)
-	float GetAngVel() { return m_fAngVel; }
+	float GetAngVel() { return m_state.fAngVel; }
+
+	/// get the state (angle, angular velocity, previous time and steering)
+	const SGyroState& GetState() const { return m_state; }
+
+	/// restore a state (the noise sequence continues where it is)
+	void SetState(const SGyroState& state) { m_state = state; }
 
 	/// get the gyro angle (rad)
 	//float GetAngleRad() { return m_fAngleRad; }
@@ -63,11 +115,21 @@ private:
 	const CVirtualGyro& operator=(const CVirtualGyro&);
 
 private:
-	/// angular velocity of the gyro (rad/s)
-	float m_fAngVel;
+	/// angle, angular velocity, previous timestamp and steering angle
+	SGyroState m_state;
+
+	/// chassis of the gyro (0: the one selected in CTricycle)
+	const STricycleChassis* m_pChassis;
+
+	/// error model
+	SGyroErrorModel m_model;
 
-	/// gyro angle (rad)
-	float m_fAngleRad;
+	/// noise generator and a block of standard normal samples
+	//@{
+	CRandom m_random;
+	std::vector<float> m_vNoise;
+	int m_nNoiseIndex;
+	//@}
 };
 
 #endif // _VIRTUAL_GYRO_H_
@@ -8,9 +8,22 @@
 ///
 
 #include <iostream>			// std::cout
-#include <cstdlib>			// atoi
+#include <cmath>			// fabsf
+#include <cstdio>			// printf, fflush
+#include <cstdlib>			// atoi, atoll, atof, strtoull
+#include <cstring>			// strcmp
+#include <string>			// std::string
+#include <vector>			// std::vector
+#include <thread>			// std::this_thread::yield
 
 #include "TestTricycle.h"	// CTestTricycle
+#include "Tricycle.h"		// CTricycle
+#include "VirtualGyro.h"	// CVirtualGyro, SGyroErrorModel
+#include "BatchRunner.h"	// CBatchRunner
+#include "PoseLog.h"		// CPoseLogReader
+#include "PoseShm.h"		// CPoseShmPublisher, CPoseShmSubscriber
+#include "OdometryServer.h"	// COdometryServer
+#include "TrajectoryIndex.h"	// CTrajectoryIndexWriter, CTrajectoryIndex
 
 #define TEST_CASE_NUM	(4)
 
@@ -21,8 +34,255 @@
 ///
 void ShowUsage(char* exeFilename)
 {
-	std::cout << "Usage: " << exeFilename << " <test_case_num>" << std::endl;
+	std::cout << "Usage: " << exeFilename << " <test_case_num> [--binary] " \
+		"[--pipeline]" << std::endl;
+	std::cout << "       " << exeFilename << " --query <pose_log.bin> <time>" \
+		<< std::endl;
+	std::cout << "       " << exeFilename << " --stream [<input>|-] [<output>|-]" \
+		<< std::endl;
+	std::cout << "       " << exeFilename << " --replay <input> [<output>|-] " \
+		"[--threads N] [--check]" << std::endl;
+	std::cout << "       " << exeFilename << " --ekf <input> [<output>|-]" \
+		<< std::endl;
+	std::cout << "       " << exeFilename << " --montecarlo <input> " \
+		"[<output>|-] [--runs K] [--threads N]" << std::endl;
+	std::cout << "       " << exeFilename << " --batch <output_dir> " \
+		"[--threads N] [--binary] <input|glob>..." << std::endl;
+	std::cout << "       " << exeFilename << " --archive <input> <output>" \
+		<< std::endl;
+	std::cout << "       " << exeFilename << " --subscribe [<name>] " \
+		"[--count N]" << std::endl;
+	std::cout << "       " << exeFilename << " --index <output> [--cell M] " \
+		"[--threads N] <pose_log.bin>..." << std::endl;
+	std::cout << "       " << exeFilename << " --near <index> <x> <y> " \
+		"<radius>" << std::endl;
+	std::cout << "       " << exeFilename << " --inside <index> <x1> <y1> " \
+		"<x2> <y2> <x3> <y3>..." << std::endl;
+	std::cout << "       " << exeFilename << " --serve [<socket>]" << std::endl;
+	std::cout << "       " << exeFilename << " --client <socket> " \
+		"[<input>|-] [<output>|-]" << std::endl;
+	std::cout << "Options: --chassis <name> --integrator <name> " \
+		"--gyro-noise <deg> --gyro-drift <deg/min> --seed <n> " \
+		"--publish <name> (before or after the others)" << std::endl;
 	std::cout << "Range of <test_case_num>: 1.." << TEST_CASE_NUM << std::endl;
+	std::cout << "--binary: write NN_pose.bin instead of the text files" \
+		<< std::endl;
+	std::cout << "--pipeline: parse, estimate and write on three threads" \
+		<< std::endl;
+	std::cout << "--query : print the pose at <time> from a binary pose log" \
+		<< std::endl;
+	std::cout << "--stream: estimate records from stdin or a named pipe as " \
+		"they arrive (default: stdin to stdout)" << std::endl;
+	std::cout << "--replay: estimate a whole input file on all cores and " \
+		"report throughput" << std::endl;
+	std::cout << "--ekf   : fuse the gyro rate and the steering kinematics " \
+		"(pose and variances)" << std::endl;
+	std::cout << "--montecarlo: mean pose and covariance ellipse of K noisy " \
+		"gyro realizations (default K: 1000)" << std::endl;
+	std::cout << "--batch : process many input files on all cores without " \
+		"plots (NN_input.csv -> NN_pose.txt, NN_contour.txt)" << std::endl;
+	std::cout << "--archive: convert NN_input.csv to a columnar record " \
+		"archive or back (input files may be either)" << std::endl;
+	std::cout << "--subscribe: print the poses of a --publish process as " \
+		"they arrive (default name: " POSE_SHM_DEFAULT_NAME ")" << std::endl;
+	std::cout << "--index: spatial index of the poses and wheels of binary " \
+		"pose logs (one trajectory per log, default cell: 1 m)" << std::endl;
+	std::cout << "--near  : time intervals when the robot or a wheel was " \
+		"within <radius> of (x, y)" << std::endl;
+	std::cout << "--inside: time intervals when the robot or a wheel was " \
+		"inside a polygon" << std::endl;
+	std::cout << "--serve : estimate the vehicle streams of many clients on a " \
+		"Unix domain socket (default: " ODOM_DEFAULT_SOCKET ")" << std::endl;
+	std::cout << "--client: estimate records like --stream on a --serve " \
+		"process" << std::endl;
+	std::cout << "--chassis: vehicle geometry (";
+	for (int i = 0; i < CTricycle::GetChassisCount(); ++i)
+		std::cout << (i ? ", " : "") << CTricycle::GetChassisAt(i).szName;
+	std::cout << ")" << std::endl;
+	std::cout << "--integrator: pose integration over a sample interval (";
+	for (int i = 0; i < INTEGRATOR_COUNT; ++i)
+		std::cout << (i ? ", " : "") << CTricycle::GetIntegratorName(i);
+	std::cout << ", not used by --replay)" << std::endl;
+	std::cout << "--publish: write each pose and contour to the shared " \
+		"memory <name> for local consumers" << std::endl;
+	std::cout << "--gyro-noise: gaussian noise of the virtual gyro per " \
+		"update (stdev, not used by --replay)" << std::endl;
+	std::cout << "--gyro-drift: drift of the virtual gyro (< 0: CW), " \
+		"--seed: seed of the noise" << std::endl;
+}
+
+///
+/// @brief		print the pose at a timestamp from a binary pose log
+/// @param		filename [in] binary pose log filename
+/// @param		time [in] timestamp (sec)
+/// @return		0 on success, -1 if occurred error
+///
+int QueryPoseLog(const char* filename, const double time)
+{
+	/// memory-mapped pose log
+	CPoseLogReader reader;
+
+	/// record found at the timestamp
+	SPoseLogRecord record;
+
+	if (reader.Open(filename) != 0)
+	{
+		std::cout << "Cannot open the pose log: " << filename << std::endl;
+		return -1;
+	}
+
+	if (reader.Find(time, record) != 0)
+	{
+		std::cout << "No pose at or before " << time << " sec." << std::endl;
+		return -1;
+	}
+
+	/// print in the same format as NN_pose.txt
+	std::cout << std::fixed;
+	std::cout << record.time << "\t" << record.pose.x << "\t" \
+		<< record.pose.y << "\t" << record.pose.q << std::endl;
+
+	return 0;
+}
+
+///
+/// @brief		print the poses of a --publish process as they arrive
+/// @param		szName [in] name of the shared-memory segment
+/// @param		nCount [in] number of poses to print (0: until killed)
+/// @return		0 on success, -1 if occurred error
+/// @remark		Starts from the latest pose and then prints every pose in
+///				the same format as NN_pose.txt. Poses overwritten before they
+///				were read (POSE_SHM_RING_SIZE behind) are skipped and counted
+///				on stderr. The publisher is never blocked.
+///
+int SubscribePoses(const char* szName, const long long nCount)
+{
+	CPoseShmSubscriber subscriber;
+
+	if (subscriber.Open(szName) != 0)
+	{
+		std::cerr << "No publisher: " << szName << std::endl;
+		return -1;
+	}
+
+	uint64_t nNext = subscriber.GetCount();
+	if (nNext)
+		--nNext;
+
+	for (long long n = 0; nCount <= 0 || n < nCount; )
+	{
+		SPoseLogRecord record;
+		const int rc = subscriber.Read(nNext, record);
+
+		/// not published yet
+		if (rc == -1)
+		{
+			std::this_thread::yield();
+			continue;
+		}
+
+		/// overwritten: continue from the oldest pose in the ring
+		if (rc == -2)
+		{
+			const uint64_t nCountNow = subscriber.GetCount();
+			const uint64_t nOldest = (nCountNow > POSE_SHM_RING_SIZE / 2) \
+				? nCountNow - POSE_SHM_RING_SIZE / 2 : 0;
+			std::cerr << "lost " << (nOldest - nNext) << " poses" << std::endl;
+			nNext = nOldest;
+			continue;
+		}
+
+		printf("%f\t%f\t%f\t%f\n", record.time, record.pose.x, \
+			record.pose.y, record.pose.q);
+		fflush(stdout);
+		++nNext;
+		++n;
+	}
+
+	return 0;
+}
+
+///
+/// @brief		build the spatial index of binary pose logs
+/// @param		sOutput [in] index filename
+/// @param		vInput [in] binary pose logs (in time order)
+/// @param		dCellSize [in] size of a cell (m)
+/// @param		nThreads [in] number of threads (0: all cores)
+/// @return		0 on success, -1 if occurred error
+///
+int BuildTrajectoryIndex(const std::string& sOutput, \
+	const std::vector<std::string>& vInput, const double dCellSize, \
+	const int nThreads)
+{
+	std::vector<STrajectorySample> vSample;
+
+	for (size_t f = 0; f < vInput.size(); ++f)
+	{
+		CPoseLogReader reader;
+		if (reader.Open(vInput[f]) != 0)
+		{
+			std::cerr << "Cannot open the pose log: " << vInput[f] << std::endl;
+			return -1;
+		}
+
+		for (size_t i = 0; i < reader.GetCount(); ++i)
+		{
+			const SPoseLogRecord& record = reader.GetRecord(i);
+
+			STrajectorySample sample;
+			sample.time = record.time;
+			sample.pose = record.pose;
+			sample.posFW = record.posFW;
+			sample.posLW = record.posLW;
+			sample.posRW = record.posRW;
+			sample.flags = (i == 0) ? TRAJ_SAMPLE_BREAK : 0;
+			vSample.push_back(sample);
+		}
+	}
+
+	CTrajectoryIndexWriter writer(nThreads);
+	if (writer.Build(vSample, dCellSize) != 0 || writer.Write(sOutput) != 0)
+	{
+		std::cerr << "Cannot write the index: " << sOutput << std::endl;
+		return -1;
+	}
+
+	std::cerr << vSample.size() << " samples, " << writer.GetImage().size() \
+		<< " bytes" << std::endl;
+
+	return 0;
+}
+
+///
+/// @brief		print the time intervals of a query of a spatial index
+/// @param		szIndex [in] index filename
+/// @param		vPoint [in] center of the circle (--near) or vertices of the
+///				polygon (--inside)
+/// @param		dRadius [in] radius of the circle (m, < 0: polygon)
+/// @return		0 on success, -1 if occurred error
+///
+int QueryTrajectoryIndex(const char* szIndex, const std::vector<SPos>& vPoint, \
+	const double dRadius)
+{
+	CTrajectoryIndex index;
+	if (index.Open(szIndex) != 0)
+	{
+		std::cerr << "Cannot open the index: " << szIndex << std::endl;
+		return -1;
+	}
+
+	std::vector<STimeInterval> vInterval;
+	const int rc = (dRadius >= 0.) ? \
+		index.QueryRadius(vPoint[0].x, vPoint[0].y, dRadius, vInterval) : \
+		index.QueryPolygon(vPoint, vInterval);
+	if (rc != 0)
+		return -1;
+
+	/// one interval per line (sec)
+	for (size_t i = 0; i < vInterval.size(); ++i)
+		printf("%f\t%f\n", vInterval[i].begin, vInterval[i].end);
+
+	return 0;
 }
 
 ///
@@ -36,12 +296,266 @@ int main(int argc, char* argv[])
 	/// test case number
 	int test_case = -1;
 
+	/// whether to write the binary pose log
+	bool bBinary = false;
+
+	/// whether to run parse/estimate/write on their own threads
+	bool bPipeline = false;
+
+	/// error model of the virtual gyro
+	SGyroErrorModel gyroModel;
+
+	/// publisher of live poses (--publish)
+	CPoseShmPublisher publisher;
+
+	/// take the global options (chassis, integrator, gyro errors) out of the
+	/// arguments
+	for (int i = 1; i < argc; )
+	{
+		if (strcmp(argv[i], "--chassis") && strcmp(argv[i], "--integrator") \
+			&& strcmp(argv[i], "--publish") && strcmp(argv[i], "--gyro-noise") \
+			&& strcmp(argv[i], "--gyro-drift") && strcmp(argv[i], "--seed"))
+		{
+			++i;
+			continue;
+		}
+
+		if (i + 1 >= argc)
+		{
+			ShowUsage(argv[0]);
+			return 1;
+		}
+
+		if (!strcmp(argv[i], "--chassis"))
+		{
+			if (CTricycle::GetInstance()->SetChassis(argv[i + 1]) != 0)
+			{
+				ShowUsage(argv[0]);
+				return 1;
+			}
+		}
+		else if (!strcmp(argv[i], "--integrator"))
+		{
+			if (CTricycle::GetInstance()->SetIntegrator(argv[i + 1]) != 0)
+			{
+				ShowUsage(argv[0]);
+				return 1;
+			}
+		}
+		else if (!strcmp(argv[i], "--publish"))
+		{
+			if (publisher.Open(argv[i + 1]) != 0)
+			{
+				std::cerr << "Cannot create the shared memory: " \
+					<< argv[i + 1] << std::endl;
+				return 1;
+			}
+			CTricycle::GetInstance()->SetPublisher(&publisher);
+		}
+		else if (!strcmp(argv[i], "--gyro-noise"))
+		{
+			gyroModel.bApplyNoise = true;
+			gyroModel.fNoiseStdev = DEG2RAD(float(atof(argv[i + 1])));
+		}
+		else if (!strcmp(argv[i], "--gyro-drift"))
+		{
+			const float fDegPerMin = float(atof(argv[i + 1]));
+			gyroModel.bApplyDrift = true;
+			gyroModel.nDriftDir = (fDegPerMin < 0.f) ? 1 : 0;
+			gyroModel.fDriftRadPerSec = DEG2RAD(fabsf(fDegPerMin)) / 60.f;
+		}
+		else
+		{
+			gyroModel.nSeed = strtoull(argv[i + 1], 0, 0);
+		}
+
+		for (int j = i; j + 2 <= argc; ++j)
+			argv[j] = argv[j + 2];
+		argc -= 2;
+	}
+	CVirtualGyro::GetInstance()->SetErrorModel(gyroModel);
+
+	/// query a binary pose log
+	if (argc == 4 && !strcmp(argv[1], "--query"))
+		return (QueryPoseLog(argv[2], atof(argv[3])) == 0) ? 0 : 1;
+
+	/// estimate a record stream (stdin, named pipe or file)
+	if (argc >= 2 && argc <= 4 && !strcmp(argv[1], "--stream"))
+	{
+		std::string sInput  = (argc >= 3) ? argv[2] : "-";
+		std::string sOutput = (argc >= 4) ? argv[3] : "-";
+		return (CTestTricycle::GetInstance()->RunStream(sInput, sOutput) == 0) \
+			? 0 : 1;
+	}
+
+	/// replay an input file on all cores
+	if (argc >= 3 && !strcmp(argv[1], "--replay"))
+	{
+		std::string sOutput;
+		int nThreads = 0;
+		bool bCheck = false;
+
+		for (int i = 3; i < argc; ++i)
+		{
+			if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+				nThreads = atoi(argv[++i]);
+			else if (!strcmp(argv[i], "--check"))
+				bCheck = true;
+			else
+				sOutput = argv[i];
+		}
+
+		return (CTestTricycle::GetInstance()->RunReplay(argv[2], sOutput, \
+			nThreads, bCheck) == 0) ? 0 : 1;
+	}
+
+	/// headless batch over many input files
+	if (argc >= 4 && !strcmp(argv[1], "--batch"))
+	{
+		int nThreads = 0;
+		bool bBatchBinary = false;
+		std::vector<std::string> vPattern;
+
+		for (int i = 3; i < argc; ++i)
+		{
+			if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+				nThreads = atoi(argv[++i]);
+			else if (!strcmp(argv[i], "--binary"))
+				bBatchBinary = true;
+			else
+				vPattern.push_back(argv[i]);
+		}
+
+		CBatchRunner batch(argv[2], nThreads, bBatchBinary);
+		for (size_t i = 0; i < vPattern.size(); ++i)
+			batch.AddInput(vPattern[i]);
+
+		return (batch.Run() == 0) ? 0 : 1;
+	}
+
+	/// extended Kalman filter over an input file
+	if ((argc == 3 || argc == 4) && !strcmp(argv[1], "--ekf"))
+		return (CTestTricycle::GetInstance()->RunEkf(argv[2], \
+			(argc == 4) ? argv[3] : "") == 0) ? 0 : 1;
+
+	/// Monte Carlo over noisy gyro realizations of an input file
+	if (argc >= 3 && !strcmp(argv[1], "--montecarlo"))
+	{
+		int nRuns = 1000;
+		int nThreads = 0;
+		std::string sOutput;
+
+		for (int i = 3; i < argc; ++i)
+		{
+			if (!strcmp(argv[i], "--runs") && i + 1 < argc)
+				nRuns = atoi(argv[++i]);
+			else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+				nThreads = atoi(argv[++i]);
+			else
+				sOutput = argv[i];
+		}
+
+		return (CTestTricycle::GetInstance()->RunMonteCarlo(argv[2], sOutput, \
+			nRuns, nThreads) == 0) ? 0 : 1;
+	}
+
+	/// print the poses of a --publish process
+	if (argc >= 2 && !strcmp(argv[1], "--subscribe"))
+	{
+		const char* szName = POSE_SHM_DEFAULT_NAME;
+		long long nCount = 0;
+
+		for (int i = 2; i < argc; ++i)
+		{
+			if (!strcmp(argv[i], "--count") && i + 1 < argc)
+				nCount = atoll(argv[++i]);
+			else
+				szName = argv[i];
+		}
+
+		return (SubscribePoses(szName, nCount) == 0) ? 0 : 1;
+	}
+
+	/// spatial index of binary pose logs
+	if (argc >= 4 && !strcmp(argv[1], "--index"))
+	{
+		double dCellSize = TRAJ_INDEX_CELL_SIZE;
+		int nThreads = 0;
+		std::vector<std::string> vInput;
+
+		for (int i = 3; i < argc; ++i)
+		{
+			if (!strcmp(argv[i], "--cell") && i + 1 < argc)
+				dCellSize = atof(argv[++i]);
+			else if (!strcmp(argv[i], "--threads") && i + 1 < argc)
+				nThreads = atoi(argv[++i]);
+			else
+				vInput.push_back(argv[i]);
+		}
+
+		return (BuildTrajectoryIndex(argv[2], vInput, dCellSize, \
+			nThreads) == 0) ? 0 : 1;
+	}
+
+	/// time intervals near a point
+	if (argc == 6 && !strcmp(argv[1], "--near"))
+	{
+		std::vector<SPos> vPoint(1, SPos(float(atof(argv[3])), \
+			float(atof(argv[4]))));
+		return (QueryTrajectoryIndex(argv[2], vPoint, atof(argv[5])) == 0) \
+			? 0 : 1;
+	}
+
+	/// time intervals inside a polygon
+	if (argc >= 9 && argc % 2 == 1 && !strcmp(argv[1], "--inside"))
+	{
+		std::vector<SPos> vPoint;
+		for (int i = 3; i + 1 < argc; i += 2)
+			vPoint.push_back(SPos(float(atof(argv[i])), \
+				float(atof(argv[i + 1]))));
+		return (QueryTrajectoryIndex(argv[2], vPoint, -1.) == 0) ? 0 : 1;
+	}
+
+	/// serve vehicle streams on a Unix domain socket
+	if ((argc == 2 || argc == 3) && !strcmp(argv[1], "--serve"))
+	{
+		COdometryServer server;
+		return (server.Run((argc == 3) ? argv[2] : ODOM_DEFAULT_SOCKET) == 0) \
+			? 0 : 1;
+	}
+
+	/// estimate a record stream on a --serve process
+	if (argc >= 3 && argc <= 5 && !strcmp(argv[1], "--client"))
+	{
+		std::string sInput  = (argc >= 4) ? argv[3] : "-";
+		std::string sOutput = (argc >= 5) ? argv[4] : "-";
+		return (CTestTricycle::GetInstance()->RunClient(argv[2], sInput, \
+			sOutput) == 0) ? 0 : 1;
+	}
+
+	/// convert an input file between CSV and the record archive
+	if (argc == 4 && !strcmp(argv[1], "--archive"))
+		return (CTestTricycle::GetInstance()->ConvertArchive(argv[2], \
+			argv[3]) == 0) ? 0 : 1;
+
 	/// check arguments
-	if (argc != 2)
+	if (argc < 2)
 	{
 		ShowUsage(argv[0]);
 		return 0;
 	}
+	for (int i = 2; i < argc; ++i)
+	{
+		if (!strcmp(argv[i], "--binary"))
+			bBinary = true;
+		else if (!strcmp(argv[i], "--pipeline"))
+			bPipeline = true;
+		else
+		{
+			ShowUsage(argv[0]);
+			return 0;
+		}
+	}
 
 	/// convert to integer
 	test_case = atoi(argv[1]);
@@ -54,7 +568,7 @@ int main(int argc, char* argv[])
 	}
 
 	/// run test code
-	CTestTricycle::GetInstance()->Run(test_case);
+	CTestTricycle::GetInstance()->Run(test_case, bBinary, bPipeline);
 
 	return 0;
 }
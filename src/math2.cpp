@@ -0,0 +1,81 @@
+///
+/// @file		math2.cpp
+/// @author		Junpyo Hong (jp7.hong@gmail.com)
+/// @date		Oct. 16, 2026
+/// @version	1.0
+///
+/// @brief		Array versions of the angle and trigonometric functions
+///
+
+#include "math2.h"
+#include "SimdMath.h"		// vfloat, vAngleClamp, vSinCos, SIMD_LANES
+
+
+///
+/// @brief		clamp the angles (rad) of an array between [-M_PI..+M_PI)
+/// @param		pIn [in] angles (rad) to clamp
+/// @param		pOut [out] clamped angles (rad) (may be pIn)
+/// @param		n [in] number of angles
+/// @return		void
+///
+void AngleClampN(const float* pIn, float* pOut, const size_t n)
+{
+	size_t i = 0;
+
+#if (SIMD_ENABLED)
+	for (; i + SIMD_LANES <= n; i += SIMD_LANES)
+		vStore(pOut + i, vAngleClamp(vLoad(pIn + i)));
+#endif // (SIMD_ENABLED)
+
+	for (; i < n; ++i)
+		pOut[i] = AngleClamp(pIn[i]);
+}
+
+///
+/// @brief		compute sine and cosine of the angles of an array at once
+/// @param		pX [in] angles (rad)
+/// @param		pSin [out] sine of the angles
+/// @param		pCos [out] cosine of the angles
+/// @param		n [in] number of angles
+/// @return		void
+/// @remark		the tail shorter than a vector goes through the same kernel
+///				(padded copy), so every element has the same error bound
+///
+void SinCosN(const float* pX, float* pSin, float* pCos, const size_t n)
+{
+	size_t i = 0;
+
+#if (SIMD_ENABLED)
+	vfloat s, c;
+
+	for (; i + SIMD_LANES <= n; i += SIMD_LANES)
+	{
+		vSinCos(vLoad(pX + i), s, c);
+		vStore(pSin + i, s);
+		vStore(pCos + i, c);
+	}
+
+	if (i < n)
+	{
+		float fX[SIMD_LANES] = { 0.f, };
+		float fSin[SIMD_LANES];
+		float fCos[SIMD_LANES];
+
+		for (size_t k = i; k < n; ++k)
+			fX[k - i] = pX[k];
+
+		vSinCos(vLoad(fX), s, c);
+		vStore(fSin, s);
+		vStore(fCos, c);
+
+		for (size_t k = i; k < n; ++k)
+		{
+			pSin[k] = fSin[k - i];
+			pCos[k] = fCos[k - i];
+		}
+	}
+#else // (SIMD_ENABLED)
+	for (; i < n; ++i)
+		SinCos(pX[i], pSin[i], pCos[i]);
+#endif // (SIMD_ENABLED)
+}
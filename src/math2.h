@@ -15,6 +15,7 @@
 #include <cmath>		// fabs, pow, log sqrt
 #include <limits>		// numeric_limits
 #include <cstring>		// memcpy
+#include <cstddef>		// size_t
 #include <cstdlib>		// srand
 #include <ctime>		// time
 
@@ -35,44 +36,149 @@
 //#	define DEG2RAD(d)	((d) * 0.01745329251994329576923690768489f)
 #endif
 
+///
+/// @brief		round toward negative infinity without a library call
+/// @param		v [in] value to round
+/// @return		floor(v)
+/// @remark		branch-free for |v| < 2^62 (truncation, then correction of
+///				negative values), floor() of <cmath> otherwise (incl. NaN)
+///
+inline double FloorFast(const double v)
+{
+	if (!(fabs(v) < 4.6e18))
+		return floor(v);
+
+	const double t = static_cast<double>(static_cast<long long>(v));
+
+	return t - static_cast<double>(t > v);
+}
+
 ///
 /// @brief		clamp the angle (rad) between [-M_PI..+M_PI) range
 /// @param		rad [in] angle (rad) to clamp
 /// @return		clamped angle (rad)
+/// @remark		Constant time: the number of turns is computed at once in
+///				double instead of looping (no hang on huge or infinite
+///				angles). Angles already in range are returned as they are,
+///				which keeps the wrap off the dependency chain of integrators
+///				whose heading rarely leaves the range. A single wrap gives the
+///				same value as subtracting (M_PI + M_PI) once.
 ///
 template<typename T> inline
 T AngleClamp(const T angleRad)
 {
-	T clapmedRad = angleRad;
+	const double v = angleRad;
+
+	if (v >= -M_PI && v < +M_PI)
+		return angleRad;
+
+	/// number of turns to remove
+	const double k = FloorFast((v + M_PI) * (0.5 / M_PI));
 
-	while (clapmedRad >= +M_PI)
-		clapmedRad -= (M_PI + M_PI);
-	while (clapmedRad < -M_PI)
-		clapmedRad += (M_PI + M_PI);
+	T clampedRad = static_cast<T>(v - k * (M_PI + M_PI));
 
-	return clapmedRad;
+	/// results rounded onto a range boundary (selects, no loop)
+	clampedRad = (clampedRad >= +M_PI) ? \
+		static_cast<T>(clampedRad - (M_PI + M_PI)) : clampedRad;
+	clampedRad = (clampedRad < -M_PI) ? \
+		static_cast<T>(clampedRad + (M_PI + M_PI)) : clampedRad;
+
+	return clampedRad;
 }
 
 ///
-/// @brief		get the angle difference (rad) [-M_PI..+M_PI)
+/// @brief		get the angle difference (rad) [-M_PI..+M_PI]
 ///				(shortest way, keep sign)
 /// @param		prevRad [in] previous angle
 /// @param		currRad [in] current angle
 /// @return		angle difference (rad)
+/// @remark		constant time, see AngleClamp()
 ///
 template<typename T> inline
 T AngleDiff(const T startRad, const T endRad)
 {
-	T diffRad = endRad - startRad;
+	const T diff = endRad - startRad;
+	const double d = diff;
+
+	if (d >= -M_PI && d <= +M_PI)
+		return diff;
+
+	/// number of turns to add
+	const double k = FloorFast((M_PI - d) * (0.5 / M_PI));
 
-	while (diffRad > +M_PI)
-		diffRad -= (M_PI + M_PI);
-	while (diffRad < -M_PI)
-		diffRad += (M_PI + M_PI);
+	T diffRad = static_cast<T>(d + k * (M_PI + M_PI));
+
+	/// results rounded out of the range (selects, no loop)
+	diffRad = (diffRad > +M_PI) ? \
+		static_cast<T>(diffRad - (M_PI + M_PI)) : diffRad;
+	diffRad = (diffRad < -M_PI) ? \
+		static_cast<T>(diffRad + (M_PI + M_PI)) : diffRad;
 
 	return diffRad;
 }
 
+///
+/// @brief		compute sine and cosine of the same angle at once
+/// @param		x [in] angle (rad)
+/// @param		s [out] sin(x)
+/// @param		c [out] cos(x)
+/// @return		void
+/// @remark		Same values as sinf()/cosf() (sin()/cos() for double), but
+///				with one shared range reduction where the C library has
+///				sincos().
+///
+//@{
+inline void SinCos(const float x, float& s, float& c)
+{
+#if defined(__GNUC__)
+	__builtin_sincosf(x, &s, &c);
+#else
+	s = sinf(x);
+	c = cosf(x);
+#endif
+}
+
+inline void SinCos(const double x, double& s, double& c)
+{
+#if defined(__GNUC__)
+	__builtin_sincos(x, &s, &c);
+#else
+	s = sin(x);
+	c = cos(x);
+#endif
+}
+//@}
+
+///
+/// @brief		clamp the angles (rad) of an array between [-M_PI..+M_PI)
+/// @param		pIn [in] angles (rad) to clamp
+/// @param		pOut [out] clamped angles (rad) (may be pIn)
+/// @param		n [in] number of angles
+/// @return		void
+/// @remark		SSE2/AVX2 kernel in math2.cpp (scalar AngleClamp() without
+///				SIMD). Angles already in range are returned unchanged. Wrapped
+///				angles differ from AngleClamp() by at most 1.5e-8 rad for
+///				|angle| < 100 rad and 1.2e-6 rad for |angle| < 2^16 rad.
+///				For arrays of lanes or records (CMonteCarlo); a per-record
+///				estimator wraps one angle with AngleClamp().
+///
+void AngleClampN(const float* pIn, float* pOut, const size_t n);
+
+///
+/// @brief		compute sine and cosine of the angles of an array at once
+/// @param		pX [in] angles (rad)
+/// @param		pSin [out] sine of the angles
+/// @param		pCos [out] cosine of the angles
+/// @param		n [in] number of angles
+/// @return		void
+/// @remark		SSE2/AVX2 kernel in math2.cpp (scalar SinCos() without SIMD).
+///				Max absolute error is 8e-8 for |x| < 8192 rad (1 ULP for
+///				|x| < M_PI) and 1e-6 for |x| < 2^16 rad (use AngleClampN()
+///				first for larger angles). For blocks of records
+///				(CParallelReplay); a per-record estimator uses SinCos().
+///
+void SinCosN(const float* pX, float* pSin, float* pCos, const size_t n);
+
 ///
 /// @brief		compare two float/double
 /// @param		v1 [in] one of two variables to compare
@@ -116,11 +222,54 @@ bool isRealZero(const T v)
 	return (!memcmp(&i, &v, sizeof(v)));
 }
 
+///
+/// @brief		add a value to a sum with Kahan compensation
+/// @param		sum [in/out] running sum
+/// @param		c [in/out] compensation (low-order part lost by the sum)
+/// @param		v [in] value to add
+/// @return		void
+/// @remark		The error of the sum stays within a few ULP of the sum,
+///				whatever the number of additions, instead of growing with it.
+///				It must not be compiled with -ffast-math (or /fp:fast).
+///
+template<typename T> inline
+void KahanAdd(T& sum, T& c, const T v)
+{
+	const T y = v - c;
+	const T t = sum + y;
+
+	c = (t - sum) - y;
+	sum = t;
+}
+
+///
+/// @brief		convert seconds to nanoseconds (rounded to nearest)
+/// @param		sec [in] time (sec), |sec| < 9.2e9
+/// @return		time (ns)
+///
+inline long long Sec2Ns(const double sec)
+{
+	return static_cast<long long>(floor(sec * 1e9 + 0.5));
+}
+
+///
+/// @brief		convert nanoseconds to seconds
+/// @param		ns [in] time or time difference (ns)
+/// @return		time (sec)
+/// @remark		take the difference of two timestamps in nanoseconds first,
+///				so that the difference is exact whatever the run time is
+///
+inline double Ns2Sec(const long long ns)
+{
+	return static_cast<double>(ns) * 1e-9;
+}
+
 ///
 /// @brief		produce a uniform random float between 0..1
 /// @param		N/A
 /// @return		uniform random float between 0..1
 /// @remark		https://stackoverflow.com/questions/686353/c-random-float-number-generation
+///				(global rand() state, not repeatable: see CRandom of Random.h)
 ///
 template<typename T> inline
 T rand_uniform_between_0_and_1()
@@ -142,6 +291,7 @@ T rand_uniform_between_0_and_1()
 /// @param		f [in] upper bound
 /// @return		uniform random float between 0..v
 /// @remark		https://stackoverflow.com/questions/686353/c-random-float-number-generation
+///				(global rand() state, not repeatable: see CRandom of Random.h)
 ///
 template<typename T> inline
 T rand_uniform_between_0_and_f(const T v)
@@ -166,6 +316,7 @@ T rand_uniform_between_0_and_f(const T v)
 /// @param		hi [in] upper bound
 /// @return		uniform random float between lo..hi
 /// @remark		https://stackoverflow.com/questions/686353/c-random-float-number-generation
+///				(global rand() state, not repeatable: see CRandom of Random.h)
 ///
 template<typename T> inline
 T rand_uniform_between_lo_and_hi(const T lo, const T hi)
@@ -191,6 +342,7 @@ T rand_uniform_between_lo_and_hi(const T lo, const T hi)
 /// @param		stdev [in] standard deviation value
 /// @return		gaussian random float
 /// @remark		https://stackoverflow.com/questions/19944111/creating-a-gaussian-random-generator-with-a-mean-and-standard-deviation
+///				(global rand() state, not repeatable: see CRandom of Random.h)
 ///
 template<typename T> inline
 T rand_gaussian(const T mean, const T stdev)